@@ -44,7 +44,8 @@ enum CompressionType
 	COMPRESSION_ZLIB9,
 	COMPRESSION_BTREE,
 	COMPRESSION_HUFF,
-	COMPRESSION_MAX = COMPRESSION_HUFF,
+	COMPRESSION_LZFAST,		///< TheSuperHackers @performance fast LZ codec with checksums, see LZFast.h
+	COMPRESSION_MAX = COMPRESSION_LZFAST,
 };
 
 class CompressionManager
@@ -22,6 +22,7 @@
 //////////////////////////////////////////////////////////////////////////////
 
 #include "Compression.h"
+#include "LZFast.h"
 
 //#define __MACTYPES__
 
@@ -58,6 +59,7 @@ const char *CompressionManager::getCompressionNameByType( CompressionType compTy
 		"ZLib 9 (slow)",
 		"BTree",
 		"Huff",
+		"LZFast",
 	};
 	return s_compressionNames[compType];
 }
@@ -80,6 +82,7 @@ const char *CompressionManager::getDecompressionNameByType( CompressionType comp
 		"d_ZLib9",
 		"d_BTree",
 		"d_Huff",
+		"d_LZFast",
 	};
 	return s_decompressionNames[compType];
 }
@@ -129,6 +132,8 @@ CompressionType CompressionManager::getCompressionType( const void *mem, Int len
 		return COMPRESSION_HUFF;
 	if ( memcmp( mem, "EAR\0", 4 ) == 0 )
 		return COMPRESSION_REFPACK;
+	if ( memcmp( mem, "FLZ\0", 4 ) == 0 )
+		return COMPRESSION_LZFAST;
 
 	return COMPRESSION_NONE;
 }
@@ -154,6 +159,8 @@ Int CompressionManager::getMaxCompressedSize( Int uncompressedLen, CompressionTy
 		case COMPRESSION_ZLIB8:
 		case COMPRESSION_ZLIB9:
 			return (Int)(ceil(uncompressedLen * 1.1 + 12 + 8));
+		case COMPRESSION_LZFAST:
+			return LZFast_getMaxFrameSize(uncompressedLen);
 	}
 
 	return 0;
@@ -180,6 +187,7 @@ Int CompressionManager::getUncompressedSize( const void *mem, Int len )
 		case COMPRESSION_BTREE:
 		case COMPRESSION_HUFF:
 		case COMPRESSION_REFPACK:
+		case COMPRESSION_LZFAST:
 			return *(Int *)(((UnsignedByte *)mem)+4);
 	}
 
@@ -191,11 +199,17 @@ Int CompressionManager::compressData( CompressionType compType, void *srcVoid, I
 	if (destLen < 8)
 		return 0;
 
-	destLen -= 8;
-
 	UnsignedByte *src = (UnsignedByte *)srcVoid;
 	UnsignedByte *dest = (UnsignedByte *)destVoid;
 
+	if (compType == COMPRESSION_LZFAST)
+	{
+		// the frame has its own header
+		return LZFast_compressFrame(src, srcLen, dest, destLen);
+	}
+
+	destLen -= 8;
+
 	if (compType == COMPRESSION_BTREE)
 	{
 		memcpy(dest, "EAB\0", 4);
@@ -279,6 +293,14 @@ Int CompressionManager::decompressData( void *srcVoid, Int srcLen, void *destVoi
 
 	CompressionType compType = getCompressionType(src, srcLen);
 
+	if (compType == COMPRESSION_LZFAST)
+	{
+		Int ret = LZFast_decompressFrame(src, srcLen, dest, destLen);
+		if (ret == 0 && getUncompressedSize(src, srcLen) != 0)
+			DEBUG_LOG(("LZFast decompression error (%d bytes long), the data is damaged or too big\n", srcLen));
+		return ret;
+	}
+
 	if (compType == COMPRESSION_BTREE)
 	{
 		Int slen = srcLen - 8;
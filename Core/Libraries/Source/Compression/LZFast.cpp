@@ -0,0 +1,608 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: LZFast.cpp //////////////////////////////////////////////////////////
+// See LZFast.h for the format.
+//////////////////////////////////////////////////////////////////////////////
+
+#include "LZFast.h"
+
+#include <string.h>
+#include <zlib.h>
+
+static const Int MIN_MATCH = 4;					///< shorter matches cost more than the literals they replace
+static const Int LAST_LITERALS = 5;			///< a block always ends in this many literals
+static const Int MATCH_FIND_LIMIT = 12;	///< no match starts in the last this many bytes of a block
+static const Int MAX_OFFSET = 65535;
+static const Int HASH_LOG = 12;					///< 4K entries of the hash table fit in the L1 cache
+static const Int SKIP_TRIGGER = 6;			///< the longer there hasn't been a match, the faster the search skips ahead
+
+static const char LZFastFrameId[4] = { 'F', 'L', 'Z', '\0' };
+
+//-----------------------------------------------------------------------------
+static inline UnsignedInt read32( const UnsignedByte *p )
+{
+	UnsignedInt v;
+	memcpy( &v, p, sizeof(v) );
+	return v;
+}
+
+//-----------------------------------------------------------------------------
+static inline UnsignedInt readLE32( const UnsignedByte *p )
+{
+	return (UnsignedInt)p[0] | ((UnsignedInt)p[1] << 8) | ((UnsignedInt)p[2] << 16) | ((UnsignedInt)p[3] << 24);
+}
+
+//-----------------------------------------------------------------------------
+static inline void writeLE32( UnsignedByte *p, UnsignedInt v )
+{
+	p[0] = (UnsignedByte)v;
+	p[1] = (UnsignedByte)(v >> 8);
+	p[2] = (UnsignedByte)(v >> 16);
+	p[3] = (UnsignedByte)(v >> 24);
+}
+
+//-----------------------------------------------------------------------------
+static inline UnsignedInt hashSequence( UnsignedInt sequence )
+{
+	return (sequence * 2654435761U) >> (32 - HASH_LOG);
+}
+
+//-----------------------------------------------------------------------------
+/** write a length that didn't fit into its 4 bits of the token */
+//-----------------------------------------------------------------------------
+static inline UnsignedByte *writeLength( UnsignedByte *op, Int len )
+{
+	for ( ; len >= 255; len -= 255 )
+		*op++ = 255;
+	*op++ = (UnsignedByte)len;
+	return op;
+}
+
+//-----------------------------------------------------------------------------
+/** read a length that didn't fit into its 4 bits of the token. Returns -1 if the block ends first. */
+//-----------------------------------------------------------------------------
+static inline Int readLength( const UnsignedByte *&ip, const UnsignedByte *iend, Int len )
+{
+	UnsignedByte b;
+	do
+	{
+		if ( ip >= iend || len > LZFAST_BLOCK_SIZE )
+			return -1;
+		b = *ip++;
+		len += b;
+	} while ( b == 255 );
+	return len;
+}
+
+//-----------------------------------------------------------------------------
+/** write one sequence: the literals from anchor, and then a match of matchLen (none if 0) */
+//-----------------------------------------------------------------------------
+static inline UnsignedByte *writeSequence( UnsignedByte *op, const UnsignedByte *oend,
+	const UnsignedByte *anchor, Int litLen, Int offset, Int matchLen )
+{
+	if ( oend - op < litLen + litLen / 255 + matchLen / 255 + 5 )
+		return NULL;
+
+	UnsignedByte *token = op++;
+	if ( litLen >= 15 )
+	{
+		*token = 15 << 4;
+		op = writeLength( op, litLen - 15 );
+	}
+	else
+	{
+		*token = (UnsignedByte)(litLen << 4);
+	}
+	memcpy( op, anchor, litLen );
+	op += litLen;
+
+	if ( matchLen == 0 )
+		return op;
+
+	*op++ = (UnsignedByte)offset;
+	*op++ = (UnsignedByte)(offset >> 8);
+
+	Int ml = matchLen - MIN_MATCH;
+	if ( ml >= 15 )
+	{
+		*token |= 15;
+		op = writeLength( op, ml - 15 );
+	}
+	else
+	{
+		*token |= (UnsignedByte)ml;
+	}
+	return op;
+}
+
+//-----------------------------------------------------------------------------
+Int LZFast_getMaxFrameSize( Int srcLen )
+{
+	// a block that doesn't get smaller is stored as it is, so no block grows by more than its size and checksum
+	Int numBlocks = (srcLen + LZFAST_BLOCK_SIZE - 1) / LZFAST_BLOCK_SIZE;
+	return LZFAST_HEADER_SIZE + srcLen + numBlocks * 8 + 8;
+}
+
+//-----------------------------------------------------------------------------
+Int LZFast_compressBlock( const UnsignedByte *src, Int srcLen, UnsignedByte *dest, Int destLen )
+{
+	if ( srcLen < 0 || srcLen > LZFAST_BLOCK_SIZE )
+		return 0;
+
+	UnsignedByte *op = dest;
+	const UnsignedByte *oend = dest + destLen;
+	Int anchor = 0;
+
+	if ( srcLen > MATCH_FIND_LIMIT )
+	{
+		Int hashTable[1 << HASH_LOG];
+		memset( hashTable, 0, sizeof(hashTable) );
+
+		const Int findLimit = srcLen - MATCH_FIND_LIMIT;
+		const Int matchLimit = srcLen - LAST_LITERALS;
+		Int ip = 1;
+		Int searched = 1 << SKIP_TRIGGER;
+
+		while ( ip < findLimit )
+		{
+			UnsignedInt sequence = read32( src + ip );
+			UnsignedInt h = hashSequence( sequence );
+			Int ref = hashTable[h];
+			hashTable[h] = ip;
+
+			if ( ip - ref > MAX_OFFSET || read32( src + ref ) != sequence )
+			{
+				ip += searched++ >> SKIP_TRIGGER;
+				continue;
+			}
+			searched = 1 << SKIP_TRIGGER;
+
+			// the match may well have started before where it was found
+			while ( ip > anchor && ref > 0 && src[ip - 1] == src[ref - 1] )
+			{
+				--ip;
+				--ref;
+			}
+
+			Int matchLen = MIN_MATCH;
+			while ( ip + matchLen < matchLimit && src[ip + matchLen] == src[ref + matchLen] )
+				++matchLen;
+
+			op = writeSequence( op, oend, src + anchor, ip - anchor, ip - ref, matchLen );
+			if ( op == NULL )
+				return 0;
+
+			ip += matchLen;
+			anchor = ip;
+
+			// remember where the match ended too, repeats often come in runs
+			if ( ip < findLimit )
+				hashTable[hashSequence( read32( src + ip - 2 ) )] = ip - 2;
+		}
+	}
+
+	op = writeSequence( op, oend, src + anchor, srcLen - anchor, 0, 0 );
+	if ( op == NULL )
+		return 0;
+
+	return op - dest;
+}
+
+//-----------------------------------------------------------------------------
+Int LZFast_decompressBlock( const UnsignedByte *src, Int srcLen, UnsignedByte *dest, Int destLen )
+{
+	const UnsignedByte *ip = src;
+	const UnsignedByte *iend = src + srcLen;
+	UnsignedByte *op = dest;
+	const UnsignedByte *oend = dest + destLen;
+
+	for (;;)
+	{
+		if ( ip >= iend )
+			return -1;
+		UnsignedByte token = *ip++;
+
+		Int litLen = token >> 4;
+		if ( litLen == 15 && (litLen = readLength( ip, iend, litLen )) < 0 )
+			return -1;
+		if ( litLen > iend - ip || litLen > oend - op )
+			return -1;
+		// short runs are copied 16 bytes at once where both buffers have room for it, what is copied
+		// past the end is overwritten by what comes next
+		if ( litLen <= 16 && iend - ip >= 16 && oend - op >= 16 )
+			memcpy( op, ip, 16 );
+		else
+			memcpy( op, ip, litLen );
+		op += litLen;
+		ip += litLen;
+
+		// the last sequence has no match
+		if ( ip == iend )
+			break;
+
+		if ( iend - ip < 2 )
+			return -1;
+		Int offset = ip[0] | (ip[1] << 8);
+		ip += 2;
+		if ( offset == 0 || offset > op - dest )
+			return -1;
+
+		Int matchLen = token & 15;
+		if ( matchLen == 15 && (matchLen = readLength( ip, iend, matchLen )) < 0 )
+			return -1;
+		matchLen += MIN_MATCH;
+		if ( matchLen > oend - op )
+			return -1;
+
+		const UnsignedByte *match = op - offset;
+		if ( offset >= 16 && matchLen <= 16 && oend - op >= 16 )
+		{
+			memcpy( op, match, 16 );
+			op += matchLen;
+		}
+		else if ( offset >= matchLen )
+		{
+			memcpy( op, match, matchLen );
+			op += matchLen;
+		}
+		else
+		{
+			// the match overlaps what it is copying, which is how runs are repeated. Everything from match
+			// on repeats every offset bytes, so each copy can be as long as all that was copied before it.
+			UnsignedByte *end = op + matchLen;
+			while ( op < end )
+			{
+				Int n = min( (Int)(op - match), (Int)(end - op) );
+				memcpy( op, match, n );
+				op += n;
+			}
+		}
+	}
+
+	return op - dest;
+}
+
+//-----------------------------------------------------------------------------
+/** compress one block of a frame into dest: its stored size, the block, and its checksum. Returns the
+	* number of bytes written, or 0 if they don't fit. */
+//-----------------------------------------------------------------------------
+static Int writeFrameBlock( const UnsignedByte *src, Int srcLen, UnsignedByte *dest, Int destLen, UnsignedInt *blockChecksum )
+{
+	if ( destLen < 8 )
+		return 0;
+
+	// a block is only worth keeping compressed if it got smaller
+	Int size = LZFast_compressBlock( src, srcLen, dest + 4, min( destLen - 8, srcLen - 1 ) );
+	UnsignedInt storedSize = size;
+	if ( size <= 0 )
+	{
+		if ( destLen - 8 < srcLen )
+			return 0;
+		memcpy( dest + 4, src, srcLen );
+		size = srcLen;
+		storedSize = srcLen | LZFAST_BLOCK_UNCOMPRESSED;
+	}
+
+	*blockChecksum = adler32( adler32( 0L, Z_NULL, 0 ), src, srcLen );
+	writeLE32( dest, storedSize );
+	writeLE32( dest + 4 + size, *blockChecksum );
+	return size + 8;
+}
+
+//-----------------------------------------------------------------------------
+Int LZFast_compressFrame( const UnsignedByte *src, Int srcLen, UnsignedByte *dest, Int destLen )
+{
+	if ( srcLen < 0 || destLen < LZFAST_HEADER_SIZE + 8 )
+		return 0;
+
+	memcpy( dest, LZFastFrameId, 4 );
+	writeLE32( dest + 4, srcLen );
+	Int pos = LZFAST_HEADER_SIZE;
+
+	UnsignedInt checksum = adler32( 0L, Z_NULL, 0 );
+	for ( Int done = 0; done < srcLen; )
+	{
+		Int blockLen = min( srcLen - done, (Int)LZFAST_BLOCK_SIZE );
+		UnsignedInt blockChecksum;
+		Int written = writeFrameBlock( src + done, blockLen, dest + pos, destLen - pos - 8, &blockChecksum );
+		if ( written == 0 )
+			return 0;
+
+		checksum = adler32( checksum, src + done, blockLen );
+		pos += written;
+		done += blockLen;
+	}
+
+	writeLE32( dest + pos, 0 );
+	writeLE32( dest + pos + 4, checksum );
+	return pos + 8;
+}
+
+//-----------------------------------------------------------------------------
+Int LZFast_decompressFrame( const UnsignedByte *src, Int srcLen, UnsignedByte *dest, Int destLen )
+{
+	if ( srcLen < LZFAST_HEADER_SIZE + 8 || memcmp( src, LZFastFrameId, 4 ) != 0 )
+		return 0;
+
+	Int expectedLen = (Int)readLE32( src + 4 );
+	if ( expectedLen < 0 || expectedLen > destLen )
+		return 0;
+
+	Int pos = LZFAST_HEADER_SIZE;
+	Int done = 0;
+	UnsignedInt checksum = adler32( 0L, Z_NULL, 0 );
+	for (;;)
+	{
+		if ( srcLen - pos < 4 )
+			return 0;
+		UnsignedInt storedSize = readLE32( src + pos );
+		pos += 4;
+		if ( storedSize == 0 )
+			break;
+
+		Int size = (Int)(storedSize & ~LZFAST_BLOCK_UNCOMPRESSED);
+		if ( size > srcLen - pos - 4 )
+			return 0;
+
+		Int blockLen;
+		Int room = min( expectedLen - done, (Int)LZFAST_BLOCK_SIZE );
+		if ( storedSize & LZFAST_BLOCK_UNCOMPRESSED )
+		{
+			if ( size > room )
+				return 0;
+			memcpy( dest + done, src + pos, size );
+			blockLen = size;
+		}
+		else
+		{
+			blockLen = LZFast_decompressBlock( src + pos, size, dest + done, room );
+			if ( blockLen < 0 )
+				return 0;
+		}
+
+		UnsignedInt blockChecksum = adler32( adler32( 0L, Z_NULL, 0 ), dest + done, blockLen );
+		if ( blockChecksum != readLE32( src + pos + size ) )
+			return 0;
+
+		checksum = adler32( checksum, dest + done, blockLen );
+		done += blockLen;
+		pos += size + 4;
+	}
+
+	if ( srcLen - pos < 4 || done != expectedLen || readLE32( src + pos ) != checksum )
+		return 0;
+
+	return done;
+}
+
+//-----------------------------------------------------------------------------
+// LZFastFrameWriter
+//-----------------------------------------------------------------------------
+
+LZFastFrameWriter::LZFastFrameWriter( WriteFunc writeFunc, void *userData ) :
+	m_writeFunc( writeFunc ),
+	m_userData( userData ),
+	m_expectedLen( 0 ),
+	m_totalLen( 0 ),
+	m_checksum( 0 ),
+	m_blockLen( 0 ),
+	m_failed( FALSE )
+{
+}
+
+//-----------------------------------------------------------------------------
+bool LZFastFrameWriter::begin( Int uncompressedLen )
+{
+	UnsignedByte header[LZFAST_HEADER_SIZE];
+	memcpy( header, LZFastFrameId, 4 );
+	writeLE32( header + 4, uncompressedLen );
+
+	m_expectedLen = uncompressedLen;
+	m_totalLen = 0;
+	m_checksum = adler32( 0L, Z_NULL, 0 );
+	m_blockLen = 0;
+	m_failed = !m_writeFunc( header, sizeof(header), m_userData );
+	return !m_failed;
+}
+
+//-----------------------------------------------------------------------------
+bool LZFastFrameWriter::write( const void *data, Int len )
+{
+	const UnsignedByte *src = (const UnsignedByte *)data;
+	while ( len > 0 && !m_failed )
+	{
+		// whole blocks are compressed straight from the caller's data
+		if ( m_blockLen == 0 && len >= LZFAST_BLOCK_SIZE )
+		{
+			flushBlock( src, LZFAST_BLOCK_SIZE );
+			src += LZFAST_BLOCK_SIZE;
+			len -= LZFAST_BLOCK_SIZE;
+			continue;
+		}
+
+		Int n = min( len, LZFAST_BLOCK_SIZE - m_blockLen );
+		memcpy( m_block + m_blockLen, src, n );
+		m_blockLen += n;
+		src += n;
+		len -= n;
+
+		if ( m_blockLen == LZFAST_BLOCK_SIZE )
+		{
+			flushBlock( m_block, m_blockLen );
+			m_blockLen = 0;
+		}
+	}
+	return !m_failed;
+}
+
+//-----------------------------------------------------------------------------
+bool LZFastFrameWriter::end( void )
+{
+	if ( m_blockLen > 0 && !m_failed )
+	{
+		flushBlock( m_block, m_blockLen );
+		m_blockLen = 0;
+	}
+
+	if ( m_failed || m_totalLen != m_expectedLen )
+		return FALSE;
+
+	UnsignedByte trailer[8];
+	writeLE32( trailer, 0 );
+	writeLE32( trailer + 4, m_checksum );
+	m_failed = !m_writeFunc( trailer, sizeof(trailer), m_userData );
+	return !m_failed;
+}
+
+//-----------------------------------------------------------------------------
+bool LZFastFrameWriter::flushBlock( const UnsignedByte *data, Int len )
+{
+	UnsignedInt blockChecksum;
+	Int written = writeFrameBlock( data, len, m_compressed, sizeof(m_compressed), &blockChecksum );
+	if ( written == 0 || !m_writeFunc( m_compressed, written, m_userData ) )
+	{
+		m_failed = TRUE;
+		return FALSE;
+	}
+
+	m_checksum = adler32( m_checksum, data, len );
+	m_totalLen += len;
+	return TRUE;
+}
+
+//-----------------------------------------------------------------------------
+// LZFastFrameReader
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+static bool readFully( LZFastFrameReader::ReadFunc readFunc, void *userData, void *data, Int len )
+{
+	UnsignedByte *dest = (UnsignedByte *)data;
+	while ( len > 0 )
+	{
+		Int n = readFunc( dest, len, userData );
+		if ( n <= 0 )
+			return FALSE;
+		dest += n;
+		len -= n;
+	}
+	return TRUE;
+}
+
+//-----------------------------------------------------------------------------
+LZFastFrameReader::LZFastFrameReader( ReadFunc readFunc, void *userData ) :
+	m_readFunc( readFunc ),
+	m_userData( userData ),
+	m_expectedLen( 0 ),
+	m_totalLen( 0 ),
+	m_checksum( 0 ),
+	m_blockLen( 0 ),
+	m_blockPos( 0 ),
+	m_done( FALSE ),
+	m_failed( FALSE )
+{
+}
+
+//-----------------------------------------------------------------------------
+bool LZFastFrameReader::begin( void )
+{
+	UnsignedByte header[LZFAST_HEADER_SIZE];
+	m_totalLen = 0;
+	m_checksum = adler32( 0L, Z_NULL, 0 );
+	m_blockLen = 0;
+	m_blockPos = 0;
+	m_done = FALSE;
+	m_failed = !readFully( m_readFunc, m_userData, header, sizeof(header) ) || memcmp( header, LZFastFrameId, 4 ) != 0;
+	m_expectedLen = m_failed ? 0 : (Int)readLE32( header + 4 );
+	if ( m_expectedLen < 0 )
+		m_failed = TRUE;
+	return !m_failed;
+}
+
+//-----------------------------------------------------------------------------
+bool LZFastFrameReader::readBlock( void )
+{
+	UnsignedByte word[4];
+	if ( !readFully( m_readFunc, m_userData, word, 4 ) )
+		return FALSE;
+
+	UnsignedInt storedSize = readLE32( word );
+	if ( storedSize == 0 )
+	{
+		if ( !readFully( m_readFunc, m_userData, word, 4 ) )
+			return FALSE;
+		m_done = TRUE;
+		m_blockLen = m_blockPos = 0;
+		return m_totalLen == m_expectedLen && readLE32( word ) == m_checksum;
+	}
+
+	Int size = (Int)(storedSize & ~LZFAST_BLOCK_UNCOMPRESSED);
+	if ( storedSize & LZFAST_BLOCK_UNCOMPRESSED )
+	{
+		if ( size > LZFAST_BLOCK_SIZE || !readFully( m_readFunc, m_userData, m_block, size ) )
+			return FALSE;
+		m_blockLen = size;
+	}
+	else
+	{
+		if ( size > (Int)sizeof(m_compressed) || !readFully( m_readFunc, m_userData, m_compressed, size ) )
+			return FALSE;
+		m_blockLen = LZFast_decompressBlock( m_compressed, size, m_block, LZFAST_BLOCK_SIZE );
+		if ( m_blockLen < 0 )
+			return FALSE;
+	}
+	m_blockPos = 0;
+
+	if ( !readFully( m_readFunc, m_userData, word, 4 ) )
+		return FALSE;
+	UnsignedInt blockChecksum = adler32( adler32( 0L, Z_NULL, 0 ), m_block, m_blockLen );
+	if ( blockChecksum != readLE32( word ) || m_blockLen > m_expectedLen - m_totalLen )
+		return FALSE;
+
+	m_checksum = adler32( m_checksum, m_block, m_blockLen );
+	m_totalLen += m_blockLen;
+	return TRUE;
+}
+
+//-----------------------------------------------------------------------------
+Int LZFastFrameReader::read( void *data, Int len )
+{
+	UnsignedByte *dest = (UnsignedByte *)data;
+	Int copied = 0;
+	while ( copied < len && !m_failed )
+	{
+		if ( m_blockPos == m_blockLen )
+		{
+			if ( m_done )
+				break;
+			if ( !readBlock() )
+			{
+				m_failed = TRUE;
+				break;
+			}
+			continue;
+		}
+
+		Int n = min( len - copied, m_blockLen - m_blockPos );
+		memcpy( dest + copied, m_block + m_blockPos, n );
+		m_blockPos += n;
+		copied += n;
+	}
+	return m_failed ? -1 : copied;
+}
@@ -0,0 +1,131 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: LZFast.h ////////////////////////////////////////////////////////////
+// TheSuperHackers @performance A byte oriented LZ77 codec that trades ratio for speed, so that it
+// decompresses at close to memory speed. There is no entropy coding: a block is a run of sequences,
+// each a token byte holding a literal length and a match length, the literals, and a two byte offset
+// back into the block for the match. Lengths that don't fit into the token continue in bytes of 255.
+//
+// Blocks are compressed independently, at most LZFAST_BLOCK_SIZE bytes each, so a frame can be
+// written and read a block at a time. A frame is laid out as:
+//   "FLZ\0", Int uncompressed size				(the header every CompressionManager format has)
+//   for each block: UnsignedInt stored size, the block, UnsignedInt Adler-32 of the block's data
+//                   (the stored size has LZFAST_BLOCK_UNCOMPRESSED set if the block is stored as is)
+//   UnsignedInt 0, UnsignedInt Adler-32 of all of the data
+// Everything is little endian.
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#ifndef __LZFAST_H__
+#define __LZFAST_H__
+
+#include "Lib/BaseTypeCore.h"
+
+enum
+{
+	LZFAST_BLOCK_SIZE = 64 * 1024,								///< most uncompressed bytes in one block
+	LZFAST_HEADER_SIZE = 8,
+};
+
+static const UnsignedInt LZFAST_BLOCK_UNCOMPRESSED = 0x80000000;	///< flag in a block's stored size
+
+/// the most bytes srcLen bytes can take when compressed as a single block
+inline Int LZFast_getMaxBlockSize( Int srcLen ) { return srcLen + srcLen / 255 + 16; }
+
+/// the most bytes srcLen bytes can take as a whole frame
+Int LZFast_getMaxFrameSize( Int srcLen );
+
+/// compress at most LZFAST_BLOCK_SIZE bytes into a block. Returns its size, or 0 if it doesn't fit destLen.
+Int LZFast_compressBlock( const UnsignedByte *src, Int srcLen, UnsignedByte *dest, Int destLen );
+
+/// decompress a block. Returns the number of bytes decompressed, or -1 if the block is damaged or
+/// doesn't fit destLen. Never reads or writes outside of the given buffers.
+Int LZFast_decompressBlock( const UnsignedByte *src, Int srcLen, UnsignedByte *dest, Int destLen );
+
+/// compress src into a frame in one go. Returns the frame's size, or 0 on error.
+Int LZFast_compressFrame( const UnsignedByte *src, Int srcLen, UnsignedByte *dest, Int destLen );
+
+/// decompress a whole frame in one go. Returns the number of bytes decompressed, or 0 if the frame is
+/// damaged, fails its checksums or doesn't fit destLen.
+Int LZFast_decompressFrame( const UnsignedByte *src, Int srcLen, UnsignedByte *dest, Int destLen );
+
+//-----------------------------------------------------------------------------
+/** Writes a frame a piece at a time, handing every finished block to a callback, so neither the data
+	* nor the frame has to be in memory all at once. */
+//-----------------------------------------------------------------------------
+class LZFastFrameWriter
+{
+public:
+	typedef bool (*WriteFunc)( const void *data, Int len, void *userData );	///< returns FALSE on error
+
+	LZFastFrameWriter( WriteFunc writeFunc, void *userData );
+
+	bool begin( Int uncompressedLen );				///< write the frame header. uncompressedLen is checked by end()
+	bool write( const void *data, Int len );
+	bool end( void );													///< write the last block and the frame's checksum
+
+private:
+	bool flushBlock( const UnsignedByte *data, Int len );
+
+	WriteFunc m_writeFunc;
+	void *m_userData;
+	Int m_expectedLen;
+	Int m_totalLen;
+	UnsignedInt m_checksum;
+	Int m_blockLen;
+	bool m_failed;
+	UnsignedByte m_block[LZFAST_BLOCK_SIZE];
+	UnsignedByte m_compressed[LZFAST_BLOCK_SIZE + LZFAST_BLOCK_SIZE / 255 + 16];
+};
+
+//-----------------------------------------------------------------------------
+/** Reads a frame a block at a time from a callback, checking every block as it goes. */
+//-----------------------------------------------------------------------------
+class LZFastFrameReader
+{
+public:
+	typedef Int (*ReadFunc)( void *data, Int len, void *userData );	///< returns the number of bytes read
+
+	LZFastFrameReader( ReadFunc readFunc, void *userData );
+
+	bool begin( void );												///< read the frame header
+	Int getUncompressedSize( void ) const { return m_expectedLen; }
+
+	/// decompress up to len more bytes into data. Returns the number of bytes, 0 at the end of the
+	/// frame, or -1 if the frame is damaged or fails its checksums.
+	Int read( void *data, Int len );
+
+private:
+	bool readBlock( void );
+
+	ReadFunc m_readFunc;
+	void *m_userData;
+	Int m_expectedLen;
+	Int m_totalLen;
+	UnsignedInt m_checksum;
+	Int m_blockLen;
+	Int m_blockPos;
+	bool m_done;
+	bool m_failed;
+	UnsignedByte m_block[LZFAST_BLOCK_SIZE];
+	UnsignedByte m_compressed[LZFAST_BLOCK_SIZE + LZFAST_BLOCK_SIZE / 255 + 16];
+};
+
+#endif // __LZFAST_H__
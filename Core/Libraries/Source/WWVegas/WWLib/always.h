@@ -120,6 +120,7 @@ extern void* createW3DMemPool(const char *poolName, int allocationSize);
 extern void* allocateFromW3DMemPool(void* p, int allocationSize);
 extern void* allocateFromW3DMemPool(void* p, int allocationSize, const char* msg, int unused);
 extern void freeFromW3DMemPool(void* pool, void* p);
+extern void flushW3DMemPoolThreadCache();	// call before a thread that allocates from the pools exits
 
 // ----------------------------------------------------------------------------
 #define W3DMPO_GLUE(ARGCLASS) \
@@ -171,6 +172,8 @@ public:
 
 	class W3DMPO { };
 
+	inline void flushW3DMemPoolThreadCache() { }
+
 #endif // (gth) removing the generals memory stuff from W3D
 
 
@@ -37,6 +37,29 @@
 
 class File;
 
+/**
+	* The bytes of a whole archive that is in memory. The archive and every RAMFile that is a view of
+	* one of its files hold a reference, so the bytes stay valid for as long as any of them is open.
+	*/
+class SharedArchiveData
+{
+public:
+	SharedArchiveData(const char *data, Int size);
+
+	void									addRef();
+	void									release();										///< deletes this when the last reference is gone. Safe to call from any thread.
+
+	const char*						getData() const { return m_data; }
+	Int										getSize() const { return m_size; }
+
+protected:
+	virtual ~SharedArchiveData();											///< derived classes let go of the bytes here
+
+	const char *m_data;
+	Int m_size;
+	volatile LONG m_refCount;
+};
+
 /**
   *	An archive file is itself a collection of sub files. Each file inside the archive file
 	* has a unique name by which it can be accessed. The ArchiveFile object class is the
@@ -55,23 +78,31 @@ public:
 
 	virtual bool					getFileInfo( const AsciiString& filename, FileInfo *fileInfo) const = 0;	///< fill in the fileInfo struct with info about the file requested.
 	virtual File*					openFile( const Char *filename, Int access = 0) = 0;	///< Open the specified file within the archive file
+	virtual bool					readFileData( const ArchivedFileInfo *fileInfo, char *buffer ) = 0;	///< Copy the data of one of our files into buffer. Safe to call from any thread.
 	virtual void					closeAllFiles( void ) = 0;									///< Close all file opened in this archive file
 	virtual AsciiString		getName( void ) = 0;												///< Returns the name of the archive file
 	virtual AsciiString		getPath( void ) = 0;												///< Returns full path and name of archive file
 	virtual void					setSearchPriority( Int new_priority ) = 0;	///< Set this archive file's search priority
 	virtual void					close( void ) = 0;													///< Close this archive file
+	virtual const char*		mapData( void ) { return m_data; }					///< Bring the whole archive into memory if it can be. Returns NULL if it can't. Main thread only.
 	void									attachFile(File *file);
+	void									attachData(SharedArchiveData *data);	///< the whole archive is in data, members can be read straight out of it. Takes over the caller's reference.
 
 	void									getFileListInDirectory(const AsciiString& currentDirectory, const AsciiString& originalDirectory, const AsciiString& searchName, FilenameList &filenameList, bool searchSubdirectories) const;
-	void									getFileListInDirectory(const DetailedArchivedDirectoryInfo *dirInfo, const AsciiString& currentDirectory, const AsciiString& searchName, FilenameList &filenameList, bool searchSubdirectories) const;
 
-	void									addFile(const AsciiString& path, const ArchivedFileInfo *fileInfo); ///< add this file to our directory tree.
+	void									reserveFiles(Int count);	///< make room for this many files before adding them
+	void									addFile(const char *path, const ArchivedFileInfo *fileInfo); ///< add this file to our directory.
+	void									addNormalizedFile(const AsciiString& path, const ArchivedFileInfo *fileInfo); ///< add this file, whose path is normalized already, to our directory.
+	const ArchivedFileInfoTable&	getArchivedFiles() const { return m_files; }
+	const ArchivedFileInfo *		getArchivedFileInfo(const AsciiString& filename) const;	///< return the ArchivedFileInfo from the directory.
+	const char *					getFileDataInMemory(const ArchivedFileInfo *fileInfo) const;	///< where the file's bytes are if the archive is in memory, otherwise NULL.
 
 protected:
-	const ArchivedFileInfo *		getArchivedFileInfo(const AsciiString& filename) const;	///< return the ArchivedFileInfo from the directory tree.
-
 	File *m_file; ///< file pointer to the archive file on disk.  Kept open so we don't have to continuously open and close the file all the time.
-	DetailedArchivedDirectoryInfo m_rootDirectory;
+	SharedArchiveData *m_sharedData;	///< the archive in memory, or NULL if it has to be read through m_file
+	const char *m_data;								///< m_sharedData's bytes
+	Int m_dataSize;
+	ArchivedFileInfoTable m_files;
 };
 
 #endif // __ARCHIVEFILE_H
\ No newline at end of file
@@ -80,69 +80,147 @@ class ArchiveFile;
 	* openFile() member searches all Archive files for the specified sub file.
 	*/
 //===============================
-class ArchivedDirectoryInfo;
-class DetailedArchivedDirectoryInfo;
-class ArchivedFileInfo;
 
-typedef std::map<AsciiString, DetailedArchivedDirectoryInfo> DetailedArchivedDirectoryInfoMap;
-typedef std::map<AsciiString, ArchivedDirectoryInfo> ArchivedDirectoryInfoMap;
-typedef std::map<AsciiString, ArchivedFileInfo> ArchivedFileInfoMap;
 typedef std::map<AsciiString, ArchiveFile *> ArchiveFileMap;
-typedef std::map<AsciiString, AsciiString> ArchivedFileLocationMap; // first string is the file name, second one is the archive filename.
 
-class ArchivedDirectoryInfo 
+/// Write path into buffer in the form the archive tables use: lower case, with '\\' between the
+/// directories and no leading or doubled separators. Returns FALSE if it doesn't fit.
+extern bool normalizeArchivePath(const char *path, char *buffer, Int bufferSize);
+
+class ArchivedFileInfo 
 {
 public:
-	AsciiString								m_directoryName;
-	ArchivedDirectoryInfoMap	m_directories;
-	ArchivedFileLocationMap		m_files;
+	UnsignedInt m_offset;
+	UnsignedInt m_size;
 
-	void clear()
+	ArchivedFileInfo()
 	{
-		m_directoryName.clear();
-		m_directories.clear();
-		m_files.clear();
+		clear();
 	}
 
+	void clear()
+	{
+		m_offset = 0;
+		m_size = 0;
+	}
 };
 
-class DetailedArchivedDirectoryInfo 
+/**
+	* Open-addressed hash table from normalized full paths of archived files to VALUE. All of the
+	* slots live in one array, so filling it with the tens of thousands of files in the BIG files
+	* costs a handful of allocations instead of a tree node per directory and file, and looking
+	* a file up is one hash and a short probe rather than a map search per directory.
+	*/
+template <class VALUE>
+class ArchivedPathTable
 {
 public:
-	AsciiString												m_directoryName;
-	DetailedArchivedDirectoryInfoMap	m_directories;
-	ArchivedFileInfoMap								m_files;
+	struct Slot
+	{
+		AsciiString m_path;		///< normalized path, empty if the slot is free
+		VALUE m_value;
+	};
+
+	ArchivedPathTable() : m_count(0) { }
 
 	void clear()
 	{
-		m_directoryName.clear();
-		m_directories.clear();
-		m_files.clear();
+		m_slots.clear();
+		m_count = 0;
 	}
-};
 
-class ArchivedFileInfo 
-{
-public:
-	AsciiString m_filename;
-	AsciiString m_archiveFilename;
-	UnsignedInt m_offset;
-	UnsignedInt m_size;
+	Int getCount() const { return m_count; }
+	Int getSlotCount() const { return (Int)m_slots.size(); }
+	const Slot &getSlot(Int i) const { return m_slots[i]; }
 
-	ArchivedFileInfo()
+	/// make room for count paths in all, so they go in without growing the table again
+	void reserve(Int count)
 	{
-		clear();
+		Int size = 16;
+		while (size < count * 2)
+			size *= 2;
+		if (size > (Int)m_slots.size())
+			rehash(size);
 	}
 
-	void clear()
+	/// return the value for path, which doesn't need to be normalized, or NULL if it isn't there
+	const VALUE *find(const char *path) const
 	{
-		m_filename.clear();
-		m_archiveFilename.clear();
-		m_offset = 0;
-		m_size = 0;
+		char normalized[_MAX_PATH];
+		if (m_slots.empty() || !normalizeArchivePath(path, normalized, sizeof(normalized)))
+			return NULL;
+
+		Int len = strlen(normalized);
+		Int mask = (Int)m_slots.size() - 1;
+		for (Int i = hashPath(normalized, len) & mask; ; i = (i + 1) & mask)
+		{
+			const Slot &slot = m_slots[i];
+			if (slot.m_path.isEmpty())
+				return NULL;
+			if (slot.m_path.getLength() == len && memcmp(slot.m_path.str(), normalized, len) == 0)
+				return &slot.m_value;
+		}
+	}
+
+	VALUE *find(const char *path)
+	{
+		return const_cast<VALUE *>(static_cast<const ArchivedPathTable *>(this)->find(path));
+	}
+
+	/// return the value for normalizedPath, adding a default one if it isn't there yet
+	VALUE &insert(const AsciiString &normalizedPath, bool *isNew = NULL)
+	{
+		if ((m_count + 1) * 2 > (Int)m_slots.size())
+			rehash(m_slots.empty() ? 16 : (Int)m_slots.size() * 2);
+
+		Slot &slot = findSlot(m_slots, normalizedPath);
+		if (isNew)
+			*isNew = slot.m_path.isEmpty();
+		if (slot.m_path.isEmpty())
+		{
+			slot.m_path = normalizedPath;
+			slot.m_value = VALUE();
+			++m_count;
+		}
+		return slot.m_value;
 	}
+
+private:
+	static Int hashPath(const char *path, Int len)
+	{
+		std::hash<std::string_view> hasher;
+		return (Int)hasher(std::string_view(path, len));
+	}
+
+	static Slot &findSlot(std::vector<Slot> &slots, const AsciiString &path)
+	{
+		Int mask = (Int)slots.size() - 1;
+		for (Int i = hashPath(path.str(), path.getLength()) & mask; ; i = (i + 1) & mask)
+		{
+			Slot &slot = slots[i];
+			if (slot.m_path.isEmpty() || slot.m_path == path)
+				return slot;
+		}
+	}
+
+	void rehash(Int size)
+	{
+		std::vector<Slot> slots(size);
+		for (typename std::vector<Slot>::iterator it = m_slots.begin(); it != m_slots.end(); ++it)
+		{
+			if (!it->m_path.isEmpty())
+				findSlot(slots, it->m_path) = *it;
+		}
+		m_slots.swap(slots);
+	}
+
+	std::vector<Slot> m_slots;	///< size is always a power of two, and at most half of them are used
+	Int m_count;
 };
 
+typedef ArchivedPathTable<ArchivedFileInfo> ArchivedFileInfoTable;		///< the files in one archive
+typedef ArchivedPathTable<ArchiveFile *> ArchivedFileLocationTable;	///< which archive each file comes from
+
 
 class ArchiveFileSystem : public SubsystemInterface
 {
@@ -172,14 +250,16 @@ class ArchiveFileSystem : public SubsystemInterface
 
 	// Unprotected this for copy-protection routines
 	AsciiString						getArchiveFilenameForFile(const AsciiString& filename) const;
+	ArchiveFile*					getArchiveFileForFile(const AsciiString& filename) const;	///< the archive the file would be opened from, or NULL
 	
 	void loadMods( void );
 
 protected:
-	virtual void					loadIntoDirectoryTree(const ArchiveFile *archiveFile, const AsciiString& archiveFilename, bool overwrite = FALSE);	///< load the archive file's header information and apply it to the global archive directory tree.
+	virtual void					loadIntoDirectoryTree(ArchiveFile *archiveFile, const AsciiString& archiveFilename, bool overwrite = FALSE);	///< add the archive's files to the global archive directory.
+	void									removeFromDirectoryTree(const ArchiveFile *archiveFile);	///< forget the files that come from this archive, before it is deleted.
 
 	ArchiveFileMap m_archiveFileMap;
-	ArchivedDirectoryInfo m_rootDirectory;
+	ArchivedFileLocationTable m_fileLocations;	///< the archive every file is opened from, the last one to overwrite it wins
 };
 
 
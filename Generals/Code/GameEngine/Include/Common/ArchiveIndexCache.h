@@ -0,0 +1,54 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include "Common/CacheFile.h"
+
+class ArchiveFile;
+
+// TheSuperHackers @performance Keeps the directory listings of the .big archives from the last run,
+// with the paths already normalized, so the next start doesn't have to read and parse the listing of
+// every archive again. An entry is only used while its archive still has the size, the write time and
+// the header it had when the entry was made.
+//
+// The archives are opened before the user data directory is known, since GameData.ini, which names
+// it, is read out of them. So the cache is kept in the working directory, which is the game's own,
+// next to the archives it describes. If that can't be written, every start reads the listings as before.
+
+class ArchiveIndexCache : public CacheFile
+{
+public:
+	enum { HEADER_SIZE = 0x10 };	///< the start of a BIG file: its id, size, number of files and listing size
+
+	ArchiveIndexCache();
+
+	/// add the files listed for archiveFilename last time to archiveFile, if the archive hasn't changed
+	/// since. header is the first HEADER_SIZE bytes of the archive.
+	bool find(const AsciiString &archiveFilename, const char *header, ArchiveFile *archiveFile);
+
+	/// remember the files that were just read from the directory listing of archiveFilename
+	void add(const AsciiString &archiveFilename, const char *header, const ArchiveFile *archiveFile);
+
+protected:
+	virtual bool isValidEntry(const char *files, Int size, Int numFiles) const;
+
+private:
+	static UnsignedInt getHeaderCRC(const char *header);
+};
+
+extern ArchiveIndexCache *TheArchiveIndexCache;
@@ -0,0 +1,119 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include "Common/ArchiveFileSystem.h"
+#include "Common/CriticalSection.h"
+#include "Common/FileSystem.h"
+
+#include <vector>
+
+class ArchiveFile;
+
+// TheSuperHackers @performance Reads the archived files a map is going to need on worker threads while
+// the main thread is busy creating the map's objects, so that by the time the models are loaded their
+// data is already in memory. Only files that come out of a .big archive are read ahead; a file that is
+// on disk by itself is left for the main thread, as it would win over the archived one anyway.
+//
+// Win32BIGFile::openFile() asks takeFile(), and gets the data that was read ahead, if there is any,
+// instead of reading it again. Whatever wasn't asked for is thrown away by stop(). A file in a BIG
+// file that is mapped is opened straight from the mapping, so it isn't copied; the workers only touch
+// its pages, so they are in memory by the time it's opened.
+//
+// Files that are only opened after the map is loaded, like the textures the models name and the sounds
+// of the map's templates, are read through without being kept, so the system has them cached by then.
+// The textures are only known once the models are read, so a subclass can look through every file a
+// worker reads with scanFile(), and queue what it finds with warmFile() when update() comes around.
+
+class AssetPrefetcher
+{
+public:
+	AssetPrefetcher();
+	virtual ~AssetPrefetcher();
+
+	/// start reading filenames on the worker threads, then read through backgroundFilenames when there's nothing else to do
+	void start(const FilenameList &filenames, const FilenameList &backgroundFilenames);
+	void stop();																///< wait for the worker threads and throw away what wasn't taken
+	void update();															///< queue up the files found in the files read so far. Call from the main thread only.
+
+	/// if filename has been read ahead, hand its data, allocated with new[], over to the caller.
+	/// Waits for the file if it is being read right now. Call from the main thread only.
+	bool takeFile(const Char *filename, char **data, Int *size);
+
+	Int getNumFiles() const { return m_numFiles; }	///< files passed to start() that will be read ahead
+	Int getNumDone() const { return m_numDone; }		///< of those, files that were read, failed, or were taken before being read
+
+protected:
+	virtual bool isScannedFile(const char *path) const { return FALSE; }	///< should the file at path go to scanFile() once it's read
+	/// Look through a file that was just read for the names of files it will load, and pass them to
+	/// foundFile(). Called on a worker thread, so it mustn't make AsciiStrings or touch shared state.
+	virtual void scanFile(const char *data, Int size) { }
+	virtual void queueFoundFile(const char *name) { }	///< called by update() for each name passed to foundFile(), to warmFile() what it refers to
+
+	void foundFile(const char *name, Int length);	///< remember a name scanFile() found until update() comes around
+	bool warmFile(const AsciiString &filename);		///< read filename through, if it's archived. Main thread only.
+
+private:
+	enum EntryState
+	{
+		ENTRY_QUEUED,
+		ENTRY_LOADING,
+		ENTRY_DONE,
+		ENTRY_FAILED,
+		ENTRY_TAKEN,
+	};
+
+	struct Entry
+	{
+		ArchiveFile *archive;
+		ArchivedFileInfo info;
+		const char *mappedData;	///< the file in its mapped archive, if it is; the workers only touch its pages
+		char *data;
+		volatile LONG state;		///< an EntryState
+		bool warmOnly;					///< read through and not kept, nobody takes it
+		bool scanned;						///< goes to scanFile() once it's read
+	};
+
+	static DWORD WINAPI workerThread(LPVOID param);
+	void work();
+	Entry *claimEntry();
+	void readEntry(Entry &entry);
+	void warmEntry(Entry &entry, char *&scratch, Int &scratchSize);
+	void touchPages(const char *data, Int size);
+	bool waitForBudget(Int size);
+	bool locateFile(const AsciiString &filename, char *normalized, Int normalizedSize, Entry &entry) const;
+
+	std::vector<Entry> m_entries;						///< the files to read now, then those found in them; never resized while the workers run
+	std::vector<Entry> m_backgroundEntries;	///< the files to read when there's nothing else to do
+	ArchivedPathTable<Int> m_index;					///< entry of each file that can be taken, by its path
+	ArchivedPathTable<bool> m_warmIndex;		///< the files that are only read through, by their path
+	std::vector<HANDLE> m_threads;
+	Int m_numFiles;
+	volatile LONG m_numEntries;							///< entries of m_entries the workers may read
+	volatile LONG m_nextEntry;
+	volatile LONG m_nextBackgroundEntry;
+	volatile LONG m_numDone;
+	volatile LONG m_bytesHeld;				///< bytes that were read and not taken yet
+	volatile LONG m_stopping;
+
+	CriticalSection m_foundNamesLock;
+	std::vector<char> m_foundNames;		///< zero terminated names found by scanFile() and not queued yet
+	volatile LONG m_hasFoundNames;
+};
+
+extern AssetPrefetcher *TheAssetPrefetcher;
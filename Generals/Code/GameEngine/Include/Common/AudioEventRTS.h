@@ -31,6 +31,7 @@
 #define _H_AUDIOEVENTRTS_
 
 #include "Common/AsciiString.h"
+#include "Common/FileSystem.h"
 #include "Common/GameAudio.h"
 #include "Common/GameMemory.h"
 #include "Common/GameType.h"
@@ -83,6 +84,10 @@ public:
 	void generateFilename( void );
 	AsciiString getFilename( void );
 
+	// Adds every file this event could play, attack and decay sounds included, to filenames. Unlike
+	// generateFilename it doesn't pick one, so it uses no random values and can be called any time.
+	void getAllFilenames( FilenameList &filenames ) const;
+
 	// The attack and decay sounds are generated in generatePlayInfo, because they will never be played more
 	// than once during a given sound event.
 	void generatePlayInfo( void );
@@ -155,10 +160,10 @@ public:
 
 	// This will return the directory leading up to the appropriate type, including the trailing '\\'
 	// If localized is true, we'll append a language specifc directory to the end of the path.
-	AsciiString generateFilenamePrefix( AudioType audioTypeToPlay, bool localized );
-	AsciiString generateFilenameExtension( AudioType audioTypeToPlay );
+	AsciiString generateFilenamePrefix( AudioType audioTypeToPlay, bool localized ) const;
+	AsciiString generateFilenameExtension( AudioType audioTypeToPlay ) const;
 protected:
-	void adjustForLocalization( AsciiString &strToAdjust );
+	void adjustForLocalization( AsciiString &strToAdjust ) const;
 
 protected:
 	AsciiString m_filenameToLoad;
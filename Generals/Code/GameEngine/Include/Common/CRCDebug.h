@@ -68,6 +68,7 @@
 	void dumpReal(Real r, AsciiString name, AsciiString fname, Int line);
 
 	void outputCRCDebugLines( void );
+	void benchmarkCRCKernels( const char *fileName );
 	void CRCDebugStartNewGame( void );
 	void outputCRCDumpLines( void );
 
@@ -103,6 +104,7 @@
 	extern AsciiString g_saveDebugCRCPerFrameDir;
 
 	extern bool g_logObjectCRCs;
+	extern bool g_verifyIncrementalCRC;
 
 #else // DEBUG_CRC
 
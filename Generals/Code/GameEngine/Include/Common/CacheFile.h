@@ -0,0 +1,78 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "Common/AsciiString.h"
+#include "Common/FileSystem.h"
+#include "Common/STLTypedefs.h"
+
+// TheSuperHackers @performance A file of data worked out from other files during one run, kept for
+// the next. There is an entry per file it was worked out from, by name, and an entry is only used
+// while that file still has the size and write time it had when the entry was made. Entries that
+// weren't used during a run are dropped when the cache is saved.
+//
+// The derived caches say what the data of an entry is, and check it when it is loaded.
+
+class CacheFile
+{
+public:
+	/// magic and version identify the cache file, format is anything else the entries depend on
+	CacheFile(UnsignedInt magic, UnsignedInt version, UnsignedInt format);
+	virtual ~CacheFile();
+
+	void load(const AsciiString &cacheFile);	///< read the cache left by the last run, if it is still good
+	void save();															///< write the cache back, if anything changed
+
+protected:
+	struct Entry
+	{
+		FileInfo info;				///< size and write time of the file when the entry was made
+		UnsignedInt check;		///< whatever else the entry has to match, e.g. a CRC
+		Int count;						///< number of items in data
+		const char *data;			///< points into m_cacheData, or is our own copy if owned
+		Int size;
+		bool owned;
+		bool used;						///< the entry was found or added during this run
+	};
+
+	/// true if an entry loaded from the cache file is whole, so using it can't run off its end
+	virtual bool isValidEntry(const char *data, Int size, Int count) const = 0;
+
+	/// the entry for filename, if its file still has the size and write time it had and the entry
+	/// has the same check, otherwise NULL. The entry is kept when the cache is saved.
+	Entry *findEntry(const AsciiString &filename, const FileInfo &info, UnsignedInt check);
+
+	/// make the entry for filename, with a copy of data, in place of any there was
+	void addEntry(const AsciiString &filename, const FileInfo &info, UnsignedInt check, Int count, const char *data, Int size);
+
+	void clear();
+
+private:
+	typedef std::hash_map< AsciiString, Entry, rts::hash<AsciiString>, rts::equal_to<AsciiString> > EntryMap;
+
+	static AsciiString makeKey(const AsciiString &filename);
+
+	UnsignedInt m_magic;
+	UnsignedInt m_version;
+	UnsignedInt m_format;
+	AsciiString m_cacheFile;
+	char *m_cacheData;			///< the cache file as it was loaded
+	EntryMap m_entries;
+	bool m_dirty;
+};
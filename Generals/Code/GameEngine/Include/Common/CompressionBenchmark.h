@@ -0,0 +1,27 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#if defined(RTS_DEBUG) || defined(RTS_INTERNAL)
+
+// TheSuperHackers @performance Compress and decompress every file matching fileMask (egs. Maps\*.map)
+// with every CompressionType, check that each one comes back the same, and log the ratio and the
+// throughput of each type. Files that are compressed already are decompressed first.
+void benchmarkCompression(const char *fileMask);
+
+#endif
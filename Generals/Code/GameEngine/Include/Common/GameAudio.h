@@ -372,6 +372,61 @@ class AudioManager : public SubsystemInterface
 		bool m_disallowSpeech			: 1;
 };
 
+//-------------------------------------------------------------------------------------------------
+/** An audio manager with no device behind it. Nothing is ever played; used when running
+	headless, so the audio events the logic raises are still accepted and looked up. */
+//-------------------------------------------------------------------------------------------------
+class AudioManagerDummy : public AudioManager
+{
+	public:
+#if defined(RTS_DEBUG) || defined(RTS_INTERNAL)
+		virtual void audioDebugDisplay(DebugDisplayInterface *dd, void *userData, FILE *fp = NULL ) {}
+#endif
+		virtual void stopAudio( AudioAffect which ) {}
+		virtual void pauseAudio( AudioAffect which ) {}
+		virtual void resumeAudio( AudioAffect which ) {}
+		virtual void pauseAmbient( bool shouldPause ) {}
+		virtual void killAudioEventImmediately( AudioHandle audioEvent ) {}
+		virtual void nextMusicTrack( void ) {}
+		virtual void prevMusicTrack( void ) {}
+		virtual bool isMusicPlaying( void ) const { return false; }
+		virtual bool hasMusicTrackCompleted( const AsciiString& trackName, Int numberOfTimes ) const { return false; }
+		virtual AsciiString getMusicTrackName( void ) const { return AsciiString::TheEmptyString; }
+		virtual void openDevice( void ) {}
+		virtual void closeDevice( void ) {}
+		virtual void *getDevice( void ) { return NULL; }
+		virtual void notifyOfAudioCompletion( UnsignedInt audioCompleted, UnsignedInt flags ) {}
+		virtual UnsignedInt getProviderCount( void ) const { return 0; }
+		virtual AsciiString getProviderName( UnsignedInt providerNum ) const { return AsciiString::TheEmptyString; }
+		virtual UnsignedInt getProviderIndex( AsciiString providerName ) const { return 0; }
+		virtual void selectProvider( UnsignedInt providerNdx ) {}
+		virtual void unselectProvider( void ) {}
+		virtual UnsignedInt getSelectedProvider( void ) const { return 0; }
+		virtual void setSpeakerType( UnsignedInt speakerType ) {}
+		virtual UnsignedInt getSpeakerType( void ) { return 0; }
+		virtual UnsignedInt getNum2DSamples( void ) const { return 0; }
+		virtual UnsignedInt getNum3DSamples( void ) const { return 0; }
+		virtual UnsignedInt getNumStreams( void ) const { return 0; }
+		virtual bool doesViolateLimit( AudioEventRTS *event ) const { return false; }
+		virtual bool isPlayingLowerPriority( AudioEventRTS *event ) const { return false; }
+		virtual bool isPlayingAlready( AudioEventRTS *event ) const { return false; }
+		virtual bool isObjectPlayingVoice( UnsignedInt objID ) const { return false; }
+		virtual void adjustVolumeOfPlayingAudio(AsciiString eventName, Real newVolume) {}
+		virtual void removePlayingAudio( AsciiString eventName ) {}
+		virtual void removeAllDisabledAudio() {}
+		virtual bool has3DSensitiveStreamsPlaying( void ) const { return false; }
+		virtual void *getHandleForBink( void ) { return NULL; }
+		virtual void releaseHandleForBink( void ) {}
+		virtual void friend_forcePlayAudioEventRTS(const AudioEventRTS* eventToPlay) {}
+		virtual void setPreferredProvider(AsciiString providerNdx) {}
+		virtual void setPreferredSpeaker(AsciiString speakerType) {}
+		virtual Real getFileLengthMS( AsciiString strToLoad ) const { return 0.0f; }	///< same as a device that failed to open, so scripts see the same lengths as -noaudio
+		virtual void closeAnySamplesUsingFile( const void *fileToClose ) {}
+
+	protected:
+		virtual void setDeviceListenerPosition( void ) {}
+};
+
 extern AudioManager *TheAudio;
 
 #endif // __COMMON_GAMEAUDIO_H_
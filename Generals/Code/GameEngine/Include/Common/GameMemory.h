@@ -179,6 +179,16 @@
 
 #endif // MEMORYPOOL_DEBUG
 
+/**
+	MEMORYPOOL_MAGAZINES gives every thread a small cache (a "magazine") of free blocks for each
+	pool, so that most allocates and frees never touch TheMemoryPoolCriticalSection; blocks move
+	between a magazine and its pool in batches. The debug bookkeeping (tag strings, checkpoints,
+	fill values, totals) must be done per block under the lock, so debug builds go without.
+*/
+#if !defined(MEMORYPOOL_DEBUG) && !defined(DISABLE_MEMORYPOOL_MAGAZINES)
+	#define MEMORYPOOL_MAGAZINES
+#endif
+
 // TheSuperHackers @compile xezon 30/03/2025 Define DISABLE_GAMEMEMORY to use a null implementations for Game Memory.
 // Useful for address sanitizer checks and other investigations.
 // Is included below the macros so that memory pool debug code can still be used.
@@ -226,6 +236,7 @@ class MemoryPool;
 class MemoryPoolFactory;
 class DynamicMemoryAllocator;
 class BlockCheckpointInfo;
+struct MemoryPoolMagazine;
 
 // TYPE DEFINES ///////////////////////////////////////////////////////////////
 
@@ -306,9 +317,13 @@ private:
 	Int								m_usedBlocksInPool;					///< total number of blocks in use in the pool.
 	Int								m_totalBlocksInPool;				///< total number of blocks in all blobs of this pool (used or not).
 	Int								m_peakUsedBlocksInPool;			///< high-water mark of m_usedBlocksInPool
+	Int								m_blobGrowthCount;					///< number of overflow blobs created since init
 	MemoryPoolBlob		*m_firstBlob;								///< head of linked list: first blob for this pool.
 	MemoryPoolBlob		*m_lastBlob;								///< tail of linked list: last blob for this pool. (needed for efficiency)
 	MemoryPoolBlob		*m_firstBlobWithFreeBlocks;	///< first blob in this pool that has at least one unallocated block.
+#ifdef MEMORYPOOL_MAGAZINES
+	Int								m_magazineSlot;							///< index of this pool's magazine in each thread's cache (-1 if none)
+#endif
 
 private:
 	/// create a new blob with the given number of blocks.
@@ -317,6 +332,20 @@ private:
 	/// destroy a blob.
 	Int freeBlob(MemoryPoolBlob *blob);
 
+	/// take a block from the blobs. (TheMemoryPoolCriticalSection must be held.)
+	MemoryPoolSingleBlock *allocateBlockFromBlobs(DECLARE_LITERALSTRING_ARG1);
+
+	/// give a block back to its blob. (TheMemoryPoolCriticalSection must be held.)
+	void freeBlockToBlobs(MemoryPoolSingleBlock *block);
+
+#ifdef MEMORYPOOL_MAGAZINES
+	/// return the calling thread's magazine for this pool, or null if magazines are not in use.
+	MemoryPoolMagazine *getThreadMagazine();
+
+	/// move a batch of blocks from the blobs into an empty magazine. (will throw on failure)
+	void refillMagazine(MemoryPoolMagazine *magazine);
+#endif
+
 public:
 
 	// 'public' funcs that are really only for use by MemoryPoolFactory
@@ -332,6 +361,9 @@ public:
 	#ifdef MEMORYPOOL_CHECKPOINTING
 		void debugResetCheckpoints();												///< throw away all checkpoint information for this pool.
 	#endif
+	#ifdef MEMORYPOOL_MAGAZINES
+		void flushMagazine(MemoryPoolMagazine *magazine, Int count);	///< return the oldest 'count' blocks in the magazine to the blobs
+	#endif
 
 public:
 
@@ -366,15 +398,24 @@ public:
 	/// return the number of blocks in use in this pool.
 	Int getUsedBlockCount();
 
-	/// return the total number of blocks in this pool. [ == getFreeBlockCount() + getUsedBlockCount() ]
+	/// return the number of free blocks held in threads' magazines, which no other thread can have.
+	Int getCachedBlockCount();
+
+	/// return the total number of blocks in this pool. [ == getFreeBlockCount() + getUsedBlockCount() + getCachedBlockCount() ]
 	Int getTotalBlockCount();
 
-	/// return the high-water mark for getUsedBlockCount()
+	/// return the high-water mark for getUsedBlockCount() + getCachedBlockCount()
 	Int getPeakBlockCount();
 
 	/// return the initial allocation count for this pool
 	Int getInitialBlockCount();
 
+	/// return the overflow allocation count for this pool
+	Int getOverflowBlockCount();
+
+	/// return the number of times this pool has had to grow past its initial blob
+	Int getBlobGrowthCount();
+
 	Int countBlobsInPool();
 
 	/// if this pool has any empty blobs, return them to the system.
@@ -550,6 +591,9 @@ public:
 
 	void memoryPoolUsageReport( const char* filename, FILE *appendToFileInstead = NULL );
 
+	/// write each pool's peak usage as a pool profile (see userMemoryManagerInitPools) to the given file.
+	void memoryPoolProfileReport( const char* filename );
+
 	#ifdef MEMORYPOOL_DEBUG
 
 		/// perform internal consistency checking
@@ -753,6 +797,10 @@ protected:
 protected: 
 
 	virtual MemoryPool *getObjectMemoryPool() = 0;
+
+	/** the pool this instance's memory goes back to once it is destroyed, or NULL if it
+		wasn't allocated from one (eg, GameMessages placed in TheGameMessageArena) */
+	virtual MemoryPool *getInstanceMemoryPool() { return getObjectMemoryPool(); }
 	
 public: 
 
@@ -760,9 +808,10 @@ public:
 	{	
 		if (this)
 		{
-			MemoryPool *pool = this->getObjectMemoryPool(); // save this, since the dtor will nuke our vtbl
+			MemoryPool *pool = this->getInstanceMemoryPool(); // save this, since the dtor will nuke our vtbl
 			this->~MemoryPoolObject();	// it's virtual, so the right one will be called.
-			pool->freeBlock((void *)this); 
+			if (pool)
+				pool->freeBlock((void *)this); 
 		}
 	} 
 };
@@ -776,11 +825,16 @@ inline MemoryPoolFactory *MemoryPool::getOwningFactory() { return m_factory; }
 inline MemoryPool *MemoryPool::getNextPoolInList() { return m_nextPoolInFactory; }
 inline const char *MemoryPool::getPoolName() { return m_poolName; }
 inline Int MemoryPool::getAllocationSize() { return m_allocationSize; }
-inline Int MemoryPool::getFreeBlockCount() { return getTotalBlockCount() - getUsedBlockCount(); }
-inline Int MemoryPool::getUsedBlockCount() { return m_usedBlocksInPool; }
+inline Int MemoryPool::getFreeBlockCount() { return getTotalBlockCount() - m_usedBlocksInPool; }
+inline Int MemoryPool::getUsedBlockCount() { return m_usedBlocksInPool - getCachedBlockCount(); }
+#ifndef MEMORYPOOL_MAGAZINES
+inline Int MemoryPool::getCachedBlockCount() { return 0; }
+#endif
 inline Int MemoryPool::getTotalBlockCount() { return m_totalBlocksInPool; }
 inline Int MemoryPool::getPeakBlockCount() { return m_peakUsedBlocksInPool; }
 inline Int MemoryPool::getInitialBlockCount() { return m_initialAllocationCount; }
+inline Int MemoryPool::getOverflowBlockCount() { return m_overflowAllocationCount; }
+inline Int MemoryPool::getBlobGrowthCount() { return m_blobGrowthCount; }
 
 // ----------------------------------------------------------------------------
 inline DynamicMemoryAllocator *DynamicMemoryAllocator::getNextDmaInList() { return m_nextDmaInFactory; }
@@ -817,6 +871,32 @@ extern bool isMemoryManagerOfficiallyInited();
 */
 extern void shutdownMemoryManager();
 
+/**
+	Return the blocks cached by the calling thread to their pools and free its magazines.
+	Threads other than the main thread should call this just before they exit, otherwise
+	their cached blocks stay out of the pools (see MemoryPool::getCachedBlockCount) for the
+	rest of the run. Threads in the W3D libraries call flushW3DMemPoolThreadCache instead.
+*/
+extern void flushMemoryPoolThreadCache();
+
+/**
+	Ask for a pool profile to be written to fileName at the end of the run, and log every
+	time a pool has to grow in the meantime. Play or replay a representative match with this,
+	then ship the result as Data\INI\MemoryPoolProfile.ini so those pools start big enough.
+*/
+extern void recordMemoryPoolProfile(const char *fileName);
+
+/// write the profile asked for by recordMemoryPoolProfile (if any).
+extern void writeMemoryPoolProfile();
+
+#if defined(RTS_DEBUG) || defined(RTS_INTERNAL)
+/**
+	Time allocate/free churn on some pools sized like the hot game pools, with and without
+	magazines, from one thread and from numThreads threads at once. Results go to the log.
+*/
+extern void benchmarkMemoryPools(Int numThreads);
+#endif
+
 extern MemoryPoolFactory *TheMemoryPoolFactory;
 extern DynamicMemoryAllocator *TheDynamicMemoryAllocator;
 
@@ -893,6 +973,18 @@ public:
 #endif //DISABLE_GAMEMEMORY
 
 
+// ----------------------------------------------------------------------------
+/**
+	Put one of these at the top of a thread function so the thread's cached pool
+	blocks are handed back however it exits. (see flushMemoryPoolThreadCache)
+*/
+class ScopedMemoryPoolThreadCache
+{
+public:
+	~ScopedMemoryPoolThreadCache() { flushMemoryPoolThreadCache(); }
+};
+
+
 // ----------------------------------------------------------------------------
 /**
 	A simple utility class to ensure exception safety; this holds a MemoryPoolObject
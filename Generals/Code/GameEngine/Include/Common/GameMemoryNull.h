@@ -134,6 +134,21 @@ extern bool isMemoryManagerOfficiallyInited();
 */
 extern void shutdownMemoryManager();
 
+/**
+	Return the blocks cached by the calling thread to their pools. (nothing is cached here.)
+*/
+extern void flushMemoryPoolThreadCache();
+
+/**
+	Pool profiles (see GameMemory.h). There are no pools here, so nothing is recorded.
+*/
+extern void recordMemoryPoolProfile(const char *fileName);
+extern void writeMemoryPoolProfile();
+
+#if defined(RTS_DEBUG) || defined(RTS_INTERNAL)
+extern void benchmarkMemoryPools(Int numThreads);
+#endif
+
 extern MemoryPoolFactory *TheMemoryPoolFactory;
 extern DynamicMemoryAllocator *TheDynamicMemoryAllocator;
 
@@ -166,7 +166,8 @@ public:
 	SaveCode saveGame( AsciiString filename, 
 										 UnicodeString desc, 
 										 SaveFileType saveType, 
-										 SnapshotType which = SNAPSHOT_SAVELOAD  );  ///< save a game
+										 SnapshotType which = SNAPSHOT_SAVELOAD,
+										 bool silent = FALSE );  ///< save a game (silent: don't tell the user it succeeded)
 	SaveCode missionSave( void );																	 ///< do a in between mission save
 	SaveCode loadGame( AvailableGameInfo gameInfo );							 ///< load a save file
 	SaveGameInfo *getSaveGameInfo( void ) { return &m_gameInfo; }
@@ -317,6 +317,20 @@ public:
 	bool m_buildMapCache;
 	AsciiString m_initialFile;				///< If this is specified, load a specific map/replay from the command-line
 	AsciiString m_pendingFile;				///< If this is specified, use this map at the next game start
+	UnsignedInt m_replayKeyframeInterval;	///< If nonzero, write a keyframe index for replays played back, one keyframe every this many frames
+	UnsignedInt m_replaySeekFrame;		///< If nonzero, seek replays played back to this frame using their keyframe index
+	bool m_replaySeekBenchmark;				///< Quit once m_replaySeekFrame has been reached
+	Int m_benchmarkRangeScans;				///< If nonzero, time range scans among this many objects on the first map loaded, then quit
+	Int m_benchmarkSleepyUpdates;			///< If nonzero, time the sleepy update heap over this many logic frames, then quit
+	bool m_headless;									///< Run without drawing or sound, e.g. to simulate replays
+	std::vector<AsciiString> m_simulateReplays;	///< Replays to simulate headless instead of running the shell
+	AsciiString m_replayReportFile;		///< Where to write the CRCs and scores of the replays simulated
+	AsciiString m_replayReferenceFile;	///< Report of a known good run to find where the replays simulated diverge from it
+	Int m_replayJobs;									///< How many replays to simulate at once, each in its own process. 0 for one per processor
+	bool m_replayChildProcess;				///< We were started by simulateReplaysInChildProcesses, which writes the desyncs and summary itself
+	bool m_sharedPaths;								///< Offer shared paths in the games we host (see GameInfo::getSharedPaths)
+	bool m_slicedPathSearches;				///< Offer time sliced path searches in the games we host (see GameInfo::getSlicedPathSearches)
+	Int m_maxMappedBIGFileMB;					///< How many MB of .big files may be mapped into memory at once (see Win32BIGFile::mapData)
 
 	Int m_maxParticleCount;						///< maximum number of particles that can exist
 	Int m_maxFieldParticleCount;			///< maximum number of field-type particles that can exist (roughly)
@@ -386,9 +386,13 @@ protected:
 	void unPrepFile();
 
 	void readLine( void );
+	char *nextToken( char *str, const char *seps );	///< strtok() over the current line, but keeping its place in m_tokenPos
 
-//	FILE *m_file;															///< file pointer of file currently loading
-	File *m_file;															///< file pointer of file currently loading
+	File *m_file;															///< file currently loading, kept open while its contents are scanned in place
+	char *m_fileData;													///< copy of the contents of the file currently loading, if they couldn't be scanned in place
+	const char *m_readPos;										///< start of the next line in the file's contents
+	const char *m_readEnd;										///< end of the file's contents
+	char *m_tokenPos;													///< where nextToken() continues in m_buffer
 	AsciiString m_filename;										///< filename of file currently loading
 	INILoadType m_loadType;										///< load time for current file
 	UnsignedInt m_lineNum;										///< current line number that's been read
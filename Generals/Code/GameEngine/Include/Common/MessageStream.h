@@ -81,6 +81,48 @@ enum GameMessageArgumentDataType : Int
 	ARGUMENTDATATYPE_UNKNOWN
 };
 
+/**
+ * A bump allocator for the messages the client creates each frame. Nearly every GameMessage
+ * is created, translated, executed and destroyed within a single frame, so rather than paying
+ * for a pool alloc/free per message and per argument, TheMessageStream carves them out of
+ * a handful of chunks that are rewound in one go once the logic has consumed the frame.
+ * The chunks are kept between frames, so a steady state costs no allocations at all.
+ */
+class GameMessageArena
+{
+public:
+
+	GameMessageArena( void );
+	~GameMessageArena();
+
+	void *allocate( Int numBytes );			///< return 8-byte aligned storage; it is never freed individually
+	void addMessage( void ) { ++m_liveMessages; }				///< a message was created in the arena
+	void releaseMessage( void );																///< a message created in the arena was destroyed
+	Int getLiveMessageCount( void ) const { return m_liveMessages; }
+	bool isTakingMessages( void ) const { return !m_rewindPending; }	///< false while waiting on messages that outlived the frame
+	void reset( void );									///< rewind to the first chunk, as soon as no messages are still alive
+
+private:
+
+	enum { CHUNK_SIZE = 16 * 1024 };
+
+	void rewind( void );
+
+	struct Chunk
+	{
+		Chunk *m_next;										///< next chunk in the arena
+		char m_data[CHUNK_SIZE];					///< storage handed out by allocate()
+	};
+
+	Chunk *m_firstChunk;								///< all chunks ever allocated, in order
+	Chunk *m_curChunk;									///< the chunk we are currently carving from
+	Int m_curOffset;										///< next free byte in m_curChunk
+	Int m_liveMessages;									///< messages created here and not yet destroyed
+	bool m_rewindPending;								///< reset() found messages alive; rewind when the last one goes
+};
+
+extern GameMessageArena *TheGameMessageArena;
+
 class GameMessageArgument : public MemoryPoolObject
 {
 	MEMORY_POOL_GLUE_WITH_USERLOOKUP_CREATE(GameMessageArgument, "GameMessageArgument")		
@@ -623,6 +665,19 @@ public:
 	void friend_setList(GameMessageList* m) { m_list = m; }
 	void friend_setPlayerIndex(Int i) { m_playerIndex = i; }
 
+	/// create a message that is only expected to live until the end of the frame (see GameMessageArena)
+	static GameMessage *newFrameMessage( Type type );
+
+	/// copy a frame message into pool memory, in the same list position, so it may outlive the frame
+	GameMessage *promote( void );
+
+	bool isFrameMessage( void ) const { return m_inFrameArena; }
+
+protected:
+
+	/// frame messages are torn down in place and their memory goes back with the arena
+	virtual MemoryPool *getInstanceMemoryPool( void );
+
 private:
 	// friend classes are bad. don't use them. no, really.
 	// if for no other reason than the fact that they subvert MemoryPoolObject. (srj)
@@ -639,6 +694,8 @@ private:
 
 	GameMessageArgument *m_argList, *m_argTail;						///< This message's arguments
 
+	bool m_inFrameArena;												///< This message and its arguments live in TheGameMessageArena
+
 	/// allocate a new argument, add it to list, return pointer to its data
 	GameMessageArgument *allocArg( void );
 
@@ -714,6 +771,7 @@ public:
 
 	// Methods NOT Inherited ------------------------------------------------------------------------
 	void propagateMessages( void );													///< Propagate messages through attached translators
+	void promoteMessages( void );														///< Move any frame messages still on the stream into pool memory
 
 	/** 
 		Attach a translator function to the stream at a priority value. Lower priorities are executed first.
@@ -36,6 +36,7 @@
 
 // INCLUDES ///////////////////////////////////////////////////////////////////////////////////////
 #include "Common/INI.h"
+#include "Common/FileSystem.h"
 #include "Common/GameMemory.h"
 #include "Common/NameKeyGenerator.h"
 #include "Common/Snapshot.h"
@@ -114,6 +115,9 @@ public:
 	virtual const W3DModelDrawModuleData* getAsW3DModelDrawModuleData() const { return NULL; }
 	virtual StaticGameLODLevel getMinimumRequiredGameLOD() const { return (StaticGameLODLevel)0;}
 
+	/// add the names of the files this module will load when it is first used, so they can be read ahead of time
+	virtual void getAssetFilenames( FilenameList &filenames ) const { }
+
 	static void buildFieldParse(MultiIniFieldParse& p) 
 	{
 		// nothing
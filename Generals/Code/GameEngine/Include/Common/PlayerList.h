@@ -153,6 +153,10 @@ public:
 	*/
 	PlayerMaskType getPlayersWithRelationship( Int srcPlayerIndex, UnsignedInt allowedRelationships );
 
+	/// anything that changes what PlayerList::crc reads must call this, or the game CRC goes stale
+	void invalidateCRC() { m_cachedCRC.invalidate(); }
+	CachedCRC *friend_getCachedCRC() { return &m_cachedCRC; }	///< for use only by GameLogic
+
 protected:
 
 	// snapshot methods
@@ -165,6 +169,7 @@ private:
 	Player				*m_local;
 	Int						m_playerCount;
 	Player				*m_players[MAX_PLAYER_COUNT];
+	CachedCRC			m_cachedCRC;			///< see invalidateCRC
 
 };
 
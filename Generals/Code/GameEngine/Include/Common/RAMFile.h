@@ -58,6 +58,7 @@
 //           Forward References
 //----------------------------------------------------------------------------
 
+class SharedArchiveData;
 
 
 //----------------------------------------------------------------------------
@@ -80,6 +81,9 @@ class RAMFile : public File
 		Char				*m_data;											///< File data in memory
 		Int					m_pos;												///< current read position
 		Int					m_size;												///< size of file in memory
+		SharedArchiveData	*m_sharedData;						///< if set, m_data looks into this archive's bytes rather than being our own copy
+
+		void				releaseData( void );									///< let go of m_data, however we got it
 		
 	public:
 		
@@ -100,6 +104,8 @@ class RAMFile : public File
 
 		virtual bool	open( File *file );																	///< Open file for fast RAM access
 		virtual bool	openFromArchive(File *archiveFile, const AsciiString& filename, Int offset, Int size); ///< copy file data from the given file at the given offset for the given size.
+		virtual bool	openFromSharedData(SharedArchiveData *data, const AsciiString& filename, Int offset, Int size); ///< look at the file data in an archive that is in memory, without copying it.
+		virtual bool	openFromBuffer(char *data, const AsciiString& filename, Int size); ///< take over data, which was allocated with new[], as the file data.
 		virtual bool	copyDataToFile(File *localFile);										///< write the contents of the RAM file to the given local file.  This could be REALLY slow.
 
 		/**
@@ -111,6 +117,7 @@ class RAMFile : public File
 		*/
 		virtual char* readEntireAndClose();
 		virtual File* convertToRAMFile();
+		virtual const char* getData( void ) { return m_data; }							///< the whole file, without copying it
 };
 
 
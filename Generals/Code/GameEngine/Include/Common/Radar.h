@@ -287,6 +287,18 @@ protected:
 
 };
 
+//-------------------------------------------------------------------------------------------------
+/** A radar that is never drawn; used when running headless. The objects and events the logic
+	hands the radar are still tracked by the base class. */
+//-------------------------------------------------------------------------------------------------
+class RadarDummy : public Radar
+{
+public:
+	virtual void draw( Int pixelX, Int pixelY, Int width, Int height ) {}
+	virtual void clearShroud() {}
+	virtual void setShroudLevel( Int x, Int y, CellShroudStatus setting ) {}
+};
+
 // EXTERNALS //////////////////////////////////////////////////////////////////////////////////////
 extern Radar *TheRadar;  ///< the radar singleton extern
 
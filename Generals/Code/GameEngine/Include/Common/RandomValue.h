@@ -38,6 +38,8 @@ extern void InitRandom( UnsignedInt seed );
 extern void InitGameLogicRandom( UnsignedInt seed ); ///< Set the GameLogic seed to a known value at game start
 extern UnsignedInt GetGameLogicRandomSeed( void );   ///< Get the seed (used for replays)
 extern UnsignedInt GetGameLogicRandomSeedCRC( void );///< Get the seed (used for CRCs)
+extern void GetGameLogicRandomState( UnsignedInt seed[6], UnsignedInt *baseSeed );				///< Get the full generator state (used for replay keyframes)
+extern void SetGameLogicRandomState( const UnsignedInt seed[6], UnsignedInt baseSeed );	///< Restore a state from GetGameLogicRandomState
 
 //--------------------------------------------------------------------------------------------------------------
 
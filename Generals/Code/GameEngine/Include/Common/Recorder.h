@@ -71,6 +71,16 @@ public:
 	bool testVersionPlayback(AsciiString filename);   ///< Returns if the playback is a valid playback file for this version or not.
 	AsciiString getCurrentReplayFilename( void );			///< valid during playback only
 	void stopPlayback();															///< Stops playback.  Its fine to call this even if not playing back a file.
+	bool isPlaybackInProgress();											///< Is a file being played back that still has commands left to execute?
+	bool sawCRCMismatch();														///< Has the file being played back gone out of sync?
+	UnsignedInt getLastCRCMatchFrame() { return m_lastCRCMatchFrame; }	///< Frame of the last CRC in the file being played back that matched ours
+	UnsignedInt getCRCMismatchFrame() { return m_crcMismatchFrame; }		///< Frame of the first CRC in the file being played back that didn't
+
+	// Methods dealing with replay keyframes. A replay can have a keyframe index next to it (<replay>.rpx)
+	// holding save game snapshots taken every few hundred frames during an earlier playback, so that
+	// playback can jump to any of them instead of simulating from frame 0.
+	void updateKeyframes();														///< Take, restore or time keyframes. Only call this between logic frames.
+	bool seekToFrame(UnsignedInt frame);							///< Restore the latest keyframe at or before frame. FALSE if there is none worth restoring.
 #if defined RTS_DEBUG || defined RTS_INTERNAL
 	bool analyzeReplay( AsciiString filename );
 	bool isAnalysisInProgress( void );
@@ -139,6 +149,22 @@ protected:
 
 	void cullBadCommands();														///< prevent the user from giving mouse commands that he shouldn't be able to do during playback.
 
+	struct ReplayKeyframe
+	{
+		UnsignedInt frame;															///< The logic frame the snapshot was taken before.
+		UnsignedInt replayOffset;												///< Offset in the replay of the first command at or after frame.
+		UnsignedInt dataOffset;													///< Offset in the index of the snapshot data.
+		UnsignedInt dataSize;														///< Size of the snapshot data.
+		UnsignedInt logicCRC;														///< The game logic CRC at frame, from playing straight through.
+	};
+	typedef std::vector<ReplayKeyframe> ReplayKeyframeVec;
+
+	AsciiString getReplayIndexPath(AsciiString filename);	///< Returns the path of the keyframe index that goes with a replay.
+	void openReplayIndex(AsciiString filename);				///< Open the keyframe index, for writing if -replayKeyframes was given, otherwise for seeking.
+	void closeReplayIndex();													///< Finish writing the keyframe index (if we were) and close it.
+	void writeKeyframe();															///< Append a keyframe for the current frame to the index.
+	bool restoreKeyframe(const ReplayKeyframe& keyframe);	///< Load a keyframe and resume playback from it.
+
 	FILE *m_file;
 	AsciiString m_fileName;
 	Int m_currentFilePosition;
@@ -153,6 +179,17 @@ protected:
 	Int m_originalGameMode; // valid in replays
 
 	UnsignedInt m_nextFrame;												///< The Frame that the next message is to be executed on.  This can be -1.
+
+	FILE *m_indexFile;																///< The keyframe index for the replay being played back, if any.
+	bool m_indexWriting;															///< Are we writing m_indexFile rather than seeking with it?
+	ReplayKeyframeVec m_keyframes;										///< The keyframes in m_indexFile.
+	bool m_restoringKeyframe;													///< The engine reset done by a keyframe load must not stop the playback.
+	UnsignedInt m_seekFrame;													///< Frame we are seeking to for -seekToFrame, or 0.
+	bool m_seekPending;																///< The keyframe for m_seekFrame has yet to be restored.
+	UnsignedInt m_seekStartTime;											///< When the seek started, for reporting how long it took.
+
+	UnsignedInt m_lastCRCMatchFrame;									///< A desync happened after this frame...
+	UnsignedInt m_crcMismatchFrame;										///< ...and at or before this one. 0 if there was none.
 };
 
 extern RecorderClass *TheRecorder;
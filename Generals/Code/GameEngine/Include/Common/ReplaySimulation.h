@@ -0,0 +1,57 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include "Common/AsciiString.h"
+
+#include <stdio.h>
+#include <vector>
+
+// TheSuperHackers @feature Plays back replays with nothing drawn and no sound, as fast as the logic
+// can go, and reports the CRC of every frame, the final scores and the logic frame rate. Run with
+// -headless -replay <file> [-replay <file> ...] [-replayReport <file>] [-jobs <n>] [-replayReference <file>].
+//
+// With more than one replay, each is simulated in its own child process, -jobs at a time (default:
+// one per processor). The children are told so with -replayChild, and write only their replay's
+// section of the report; the parent lists the desyncs and the summary once for all of them.
+// Given the report of a known good run with -replayReference, each replay's CRCs are bisected
+// against it to find the first frame, and the first MARKER: section of GameLogic::getCRC(),
+// where the two runs diverge.
+
+class ReplaySimulation
+{
+public:
+	enum Result
+	{
+		RESULT_OK = 0,				///< Played back to the end and stayed in sync.
+		RESULT_MISMATCH = 1,	///< Played back to the end but went out of sync.
+		RESULT_FAILED = 2,		///< Could not be played back.
+	};
+
+	// Simulates the replays, whose names may have wildcards, and returns the worst result of them so it
+	// can be used as the exit code of the process. The engine must have been initialized; argv is
+	// passed on to child processes.
+	static Int simulateReplays(const std::vector<AsciiString> &names, int argc, char *argv[]);
+
+	// Simulates a single replay, named relative to the replay directory, and writes its results to report.
+	static Result simulateReplay(const AsciiString &filename, FILE *report);
+
+private:
+	static Int simulateReplaysInChildProcesses(const std::vector<AsciiString> &filenames, FILE *report,
+		const AsciiString &reportPath, int argc, char *argv[]);
+};
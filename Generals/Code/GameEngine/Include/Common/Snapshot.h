@@ -69,5 +69,29 @@ protected:
 
 };
 
+//-------------------------------------------------------------------------------------------------
+/** The light CRC of a Snapshot, kept from one CRC check to the next. Whatever changes data the
+	snapshot's crc() reads must invalidate() it. Only CRC kernels newer than CRC_KERNEL_LEGACY
+	use it (see XferCRC::xferCachedSnapshot) */
+//-------------------------------------------------------------------------------------------------
+class CachedCRC
+{
+
+friend class XferCRC;
+
+public:
+
+	CachedCRC( void ) : m_crc( 0 ), m_dirty( TRUE ) { }
+
+	void invalidate( void ) { m_dirty = TRUE; }		///< the snapshot has changed since m_crc
+	bool isDirty( void ) const { return m_dirty; }
+
+protected:
+
+	UnsignedInt m_crc;						///< CRC of the snapshot, unless m_dirty
+	bool m_dirty;									///< true if m_crc must be recomputed
+
+};
+
 #endif // __SNAPSHOT_H_
 
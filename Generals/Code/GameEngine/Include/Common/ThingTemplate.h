@@ -507,6 +507,7 @@ public:
 	const AudioEventRTS *getSoundFalling() const							{ return getAudio(TTAUDIO_soundFalling); }
 
 	const AudioEventRTS *getPerUnitSound(const AsciiString& soundName) const;
+	void getAudioFilenames(FilenameList &filenames) const;	///< every file the sounds of this template could play
 	const FXList* getPerUnitFX(const AsciiString& fxName) const;
 
 	UnsignedInt getThreatValue() const								{ return m_threatValue; }
@@ -48,6 +48,7 @@
 
 // FORWARD REFERENCES /////////////////////////////////////////////////////////////////////////////
 class Snapshot;
+class CachedCRC;
 typedef Int Color;
 enum ObjectID : Int;
 enum DrawableID : Int;
@@ -105,6 +106,7 @@ enum XferOptions : UnsignedInt
 {
 	XO_NONE										= 0x00000000,
 	XO_NO_POST_PROCESSING			= 0x00000001,
+	XO_NO_CACHED_CRCS					= 0x00000002,		///< XferCRC recomputes every CachedCRC, and leaves them as they are
 
 	XO_ALL										= 0xFFFFFFFF  // keep this last please
 };
@@ -112,6 +114,20 @@ enum XferOptions : UnsignedInt
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 typedef Int XferBlockSize;
 
+//-------------------------------------------------------------------------------------------------
+/** The checksum an XferCRC computes. Every machine in a game must use the same one, so
+	the host picks it and sends it with the game options (see GameInfo::getCRCKernel).
+	Never change what an existing kernel computes; add a new one instead. */
+//-------------------------------------------------------------------------------------------------
+enum CRCKernel : Int
+{
+	CRC_KERNEL_LEGACY = 0,			///< one serial rotate-add per 4 bytes of each xfer
+	CRC_KERNEL_LANES,						///< 4 interleaved rotate-add lanes over the whole byte stream
+
+	CRC_KERNEL_COUNT,
+	CRC_KERNEL_NEWEST = CRC_KERNEL_COUNT - 1
+};
+
 //-------------------------------------------------------------------------------------------------
 //-------------------------------------------------------------------------------------------------
 class Xfer
@@ -129,6 +145,7 @@ public:
 	virtual void setOptions( UnsignedInt options ) { BitSet( m_options, options ); }
 	virtual void clearOptions( UnsignedInt options ) { BitClear( m_options, options ); }
 	virtual UnsignedInt getOptions( void ) { return m_options; }
+	virtual CRCKernel getCRCKernel( void ) { return CRC_KERNEL_LEGACY; }	///< the checksum an XFER_CRC xfer computes
 	virtual void open( AsciiString identifier ) = 0;		///< xfer open event
 	virtual void close( void ) = 0;											///< xfer close event
 	virtual Int beginBlock( void ) = 0;									///< xfer begin block event
@@ -136,6 +153,7 @@ public:
 	virtual void skip( Int dataSize ) = 0;							///< xfer skip data
 
 	virtual void xferSnapshot( Snapshot *snapshot ) = 0;		///< entry point for xfering a snapshot
+	virtual void xferCachedSnapshot( Snapshot *snapshot, CachedCRC *cachedCRC );	///< xferSnapshot, for snapshots with a CachedCRC
 
 	//
 	// default transfer methods, these call the implementation method with the data
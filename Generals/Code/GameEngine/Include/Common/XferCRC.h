@@ -45,7 +45,7 @@ class XferCRC : public Xfer
 
 public:
 
-	XferCRC( void );
+	XferCRC( CRCKernel kernel = CRC_KERNEL_LEGACY );
 	virtual ~XferCRC( void );
 
 	// Xfer methods
@@ -56,17 +56,35 @@ public:
 	virtual void skip( Int dataSize );							///< skip xfer event
 
 	virtual void xferSnapshot( Snapshot *snapshot );		///< entry point for xfering a snapshot
+	virtual void xferCachedSnapshot( Snapshot *snapshot, CachedCRC *cachedCRC );	///< xfers the snapshot's own CRC, with a newer kernel
 
 	// Xfer CRC methods
 	virtual UnsignedInt getCRC( void );										///< get computed CRC in network byte order
+	virtual CRCKernel getCRCKernel( void ) { return m_kernel; }
 
 protected:
 
 	virtual void xferImplementation( void *data, Int dataSize );
 
+	void resetCRC( void );												///< start over from an empty stream
+	UnsignedInt calcSnapshotCRC( Snapshot *snapshot );		///< CRC of the snapshot on its own, from scratch
 	void addCRC( UnsignedInt val );								///< CRC a 4-byte block
-
-	UnsignedInt m_crc;
+	void addLaneWords( const UnsignedByte *data, Int numWords );	///< mix whole words into m_lanes
+
+	enum 
+	{ 
+		NUM_LANES = 4,
+		LANE_BUFFER_SIZE = 256			///< must be a multiple of NUM_LANES * 4
+	};
+
+	CRCKernel m_kernel;
+	UnsignedInt m_crc;														///< CRC_KERNEL_LEGACY only
+
+	// CRC_KERNEL_LANES only. small xfers are gathered in m_laneBuffer, and mixed a buffer at a time.
+	UnsignedInt m_lanes[ NUM_LANES ];
+	UnsignedInt m_laneBytes;											///< total bytes mixed into m_lanes
+	Int m_laneBufferUsed;
+	UnsignedByte m_laneBuffer[ LANE_BUFFER_SIZE ];
 
 };
 
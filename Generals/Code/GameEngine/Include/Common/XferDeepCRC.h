@@ -46,7 +46,7 @@ class XferDeepCRC : public XferCRC
 
 public:
 
-	XferDeepCRC( void );
+	XferDeepCRC( CRCKernel kernel = CRC_KERNEL_LEGACY );
 	virtual ~XferDeepCRC( void );
 
 	// Xfer methods
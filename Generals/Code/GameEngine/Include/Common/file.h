@@ -173,6 +173,8 @@ class File : public MemoryPoolObject
 		*/
 		virtual char* readEntireAndClose() = 0;
 		virtual File* convertToRAMFile() = 0;
+
+		virtual const char* getData( void ) { return NULL; }							///< the whole file, if it is in memory. Only good until the file is closed.
 };
 
 
@@ -214,6 +214,55 @@ protected:
 	DisplayString *m_copyrightDisplayString;///< this'll hold the display string
 };
 
+//-------------------------------------------------------------------------------------------------
+/** A display with no device behind it. Nothing is ever drawn; used when running headless,
+	so the views, lights and shroud changes the game makes still have somewhere to go. */
+//-------------------------------------------------------------------------------------------------
+class DisplayDummy : public Display
+{
+public:
+	virtual void doSmartAssetPurgeAndPreload(const char* usageFileName) {}
+#if defined(RTS_DEBUG) || defined(RTS_INTERNAL)
+	virtual void dumpAssetUsage(const char* mapname) {}
+#endif
+	virtual VideoBuffer*	createVideoBuffer( void ) { return NULL; }	///< so playMovie stops again straight away
+	virtual void setClipRegion( IRegion2D *region ) {}
+	virtual	bool isClippingEnabled( void ) { return false; }
+	virtual	void enableClipping( bool onoff ) {}
+	virtual void draw( void ) {}
+	virtual void setTimeOfDay( TimeOfDay tod ) {}
+	virtual void createLightPulse( const Coord3D *pos, const RGBColor *color, Real innerRadius,Real attenuationWidth,
+																 UnsignedInt increaseFrameTime, UnsignedInt decayFrameTime ) {}
+	virtual void drawLine( Int startX, Int startY, Int endX, Int endY,
+												 Real lineWidth, UnsignedInt lineColor ) {}
+	virtual void drawLine( Int startX, Int startY, Int endX, Int endY,
+												 Real lineWidth, UnsignedInt lineColor1, UnsignedInt lineColor2 ) {}
+	virtual void drawOpenRect( Int startX, Int startY, Int width, Int height,
+														 Real lineWidth, UnsignedInt lineColor ) {}
+	virtual void drawFillRect( Int startX, Int startY, Int width, Int height,
+														 UnsignedInt color ) {}
+	virtual void drawRectClock(Int startX, Int startY, Int width, Int height, Int percent, UnsignedInt color) {}
+	virtual void drawRemainingRectClock(Int startX, Int startY, Int width, Int height, Int percent, UnsignedInt color) {}
+	virtual void drawImage( const Image *image, Int startX, Int startY,
+													Int endX, Int endY, Color color = 0xFFFFFFFF, DrawImageMode mode=DRAW_IMAGE_ALPHA) {}
+	virtual void drawVideoBuffer( VideoBuffer *buffer, Int startX, Int startY,
+													Int endX, Int endY ) {}
+	virtual void setShroudLevel(Int x, Int y, CellShroudStatus setting ) {}
+	virtual void clearShroud() {}
+	virtual void setBorderShroudLevel(UnsignedByte level) {}
+#if defined(RTS_DEBUG) || defined(RTS_INTERNAL)
+	virtual void dumpModelAssets(const char *path) {}
+#endif
+	virtual void preloadModelAssets( AsciiString model ) {}
+	virtual void preloadTextureAssets( AsciiString texture ) {}
+	virtual void takeScreenShot(void) {}
+	virtual void toggleMovieCapture(void) {}
+	virtual void toggleLetterBox(void) {}
+	virtual void enableLetterBox(bool enable) {}
+	virtual Real getAverageFPS( void ) { return 0.0f; }
+	virtual Int getLastFrameDrawCalls( void ) { return 0; }
+};
+
 // the singleton
 extern Display *TheDisplay;
 
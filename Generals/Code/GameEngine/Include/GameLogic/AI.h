@@ -952,7 +952,9 @@ public:
 	///< get IDs for every object in this group
 	const VecObjectID& getAllIDs ( void ) const;
 
-	void recomputeGroupSpeed() { m_dirty = true; }
+	void recomputeGroupSpeed() { m_dirty = true; m_cachedCRC.invalidate(); }
+
+	CachedCRC *friend_getCachedCRC() { return &m_cachedCRC; }	///< for GameLogic's CRC check
 
 	void setMineClearingDetail( bool set );
 	bool setWeaponLockForGroup( WeaponSlotType weaponSlot, WeaponLockType lockType ); ///< Set the groups' weapon choice.  
@@ -986,6 +988,8 @@ private:
 	Path *m_groundPath;											///< Group ground path.
 	
 	mutable VecObjectID	m_lastRequestedIDList;			///< this is used so we can return by reference, saving a copy
+
+	CachedCRC m_cachedCRC;									///< our last crc(), invalidated whenever the members, m_speed or m_dirty change
 };
 
 
@@ -34,6 +34,7 @@
 #include "Common/GameType.h"
 #include "Common/GameMemory.h"
 #include "Common/Snapshot.h"
+#include "Common/STLTypedefs.h"
 //#include "GameLogic/Locomotor.h"	// no, do not include this, unless you like long recompiles
 #include "GameLogic/LocomotorSet.h"
 
@@ -213,18 +214,29 @@ public:
 	static PathfindCellInfo * getACellInfo(PathfindCell *cell, const ICoord2D &pos);
 	static void releaseACellInfo(PathfindCellInfo *theInfo);
 
+protected:
+	static bool isOpenHeapLess(const PathfindCellInfo *a, const PathfindCellInfo *b);
+	static void openHeapSiftUp(Int ndx);
+	static void openHeapSiftDown(Int ndx);
+
 protected:
 	static PathfindCellInfo *s_infoArray;
 	static PathfindCellInfo *s_firstFree;							///< 
 
+	static PathfindCellInfo **s_openHeap;							///< A* "open" list, as a binary heap ordered by total cost.
+	static Int s_openHeapCount;												///< Number of cells on the open list.
+	static UnsignedInt s_openSequence;								///< Insertion counter, so equal costs come off the open list first in, first out.
 
-	PathfindCellInfo *m_nextOpen, *m_prevOpen;						///< for A* "open" list, shared by closed list
+	PathfindCellInfo *m_nextOpen, *m_prevOpen;						///< for A* "closed" list
 
 	PathfindCellInfo *m_pathParent;												///< "parent" cell from pathfinder
 	PathfindCell *m_cell;															///< Cell this info belongs to currently.
 
 	UnsignedShort m_totalCost, m_costSoFar;	///< cost estimates for A* search
 
+	Int m_openHeapIndex;											///< Index in s_openHeap while on the open list.
+	UnsignedInt m_openSequence;								///< Value of s_openSequence when put on the open list.
+
 	/// have to include cell's coordinates, since cells are often accessed via pointer only
 	ICoord2D m_pos;
 	
@@ -302,6 +314,9 @@ public:
 	/// put self on "open" list in ascending cost order, return new list
 	PathfindCell *putOnSortedOpenList( PathfindCell *list );		
 
+	/// put self back on the "open" list with the sequence it had when its search was suspended.
+	PathfindCell *restoreOnOpenList( PathfindCell *list, UnsignedInt sequence );		
+
 	/// remove self from "open" list
 	PathfindCell *removeFromOpenList( PathfindCell *list );		
 
@@ -314,9 +329,18 @@ public:
 	/// remove all cells from closed list.
 	static Int releaseClosedList( PathfindCell *list );	
 
-	/// remove all cells from closed list.
+	/// remove all cells from open list.
 	static Int releaseOpenList( PathfindCell *list );	
 
+	/// number of cells on the open list, and access to them in no particular order.  For debugging.
+	static Int getOpenListCount( void );
+	static PathfindCell *getOpenListCell( Int ndx );
+
+	/// open list insertion counter, saved & restored with a suspended search.
+	static UnsignedInt getOpenListSequence( void );
+	static void setOpenListSequence( UnsignedInt sequence );
+	inline UnsignedInt getOpenSequence(void) const {return m_info->m_openSequence;}
+
 	inline PathfindCell *getNextOpen(void) {return m_info->m_nextOpen?m_info->m_nextOpen->m_cell:NULL;}
 
 	inline UnsignedShort getXIndex(void) const {return m_info->m_pos.x;}
@@ -404,6 +428,7 @@ public:
 	void applyZone(void); // Propagates m_zone to all cells.
 	void getStartCellIndex(ICoord2D *start) {*start = m_startCell;}
 	void getEndCellIndex(ICoord2D *end) {*end = m_endCell;}
+	void getGroundCellBounds(IRegion2D *bounds); ///< Ground cells covered by this layer, inclusive.
 
 	ObjectID getBridgeID(void);
 	bool connectsZones(PathfindZoneManager *zm, const LocomotorSet& locomotorSet,Int zone1, Int zone2);
@@ -442,6 +467,33 @@ enum { PATHFIND_QUEUE_LEN=512};
 
 struct TCheckMovementInfo;
 
+/** 
+ * A cached connection between two zones that touch along a cell edge, or between a zone and a 
+ * bridge layer.  Zones are stored relative to their block's first zone, so the link stays valid 
+ * when the blocks are renumbered.
+ */
+struct ZoneBlockLink
+{
+	UnsignedShort m_zone;				///< Zone in the owning block, relative to its first zone.
+	UnsignedShort m_otherZone;	///< Zone in the other block relative to its first zone, or the layer.
+	UnsignedShort m_other;			///< ZoneBlock::LINK_xxx.
+	UnsignedShort m_tables;			///< Mask of ZoneBlock::TABLE_xxx equivalency tables that join the zones.
+};
+
+/** 
+ * A cell on the edge of a zone block, paired with the cell across the edge.  The hierarchical 
+ * pathfind steps between blocks at these cells, so their ground block zones are cached when 
+ * the zones are calculated instead of being looked up on every search.  Zones are relative to 
+ * the first zone of the block each cell is in, so they stay valid when blocks are renumbered.
+ */
+struct ZoneBlockPortal
+{
+	zoneStorageType m_blockZone[2];		///< Ground block zone of the edge cell, [0] normal, [1] crusher.
+	zoneStorageType m_otherZone[2];		///< Ground block zone of the cell across the edge, [0] normal, [1] crusher.
+	bool m_onMap;											///< The edge cell is on the map.
+	bool m_otherOnMap;								///< The cell across the edge is on the map.
+};
+
 /** 
  * This class is a helper class for zone manager.  It maintains information regarding the 
  * LocomotorSurfaceTypeMask equivalencies within a ZONE_BLOCK_SIZE x ZONE_BLOCK_SIZE area of 
@@ -454,19 +506,45 @@ public:
 	ZoneBlock();
 	~ZoneBlock();  // not virtual, please don't override without making virtual.  jba.
 
+	enum {LINK_SAME_BLOCK, LINK_LEFT_BLOCK, LINK_LOWER_BLOCK, LINK_LAYER};
+	enum {TABLE_HIERARCHICAL=0x01, TABLE_GROUND_WATER=0x02, TABLE_GROUND_RUBBLE=0x04, 
+				TABLE_GROUND_CLIFF=0x08, TABLE_TERRAIN=0x10, TABLE_CRUSHER=0x20};
+	enum {SIDE_LEFT, SIDE_RIGHT, SIDE_TOP, SIDE_BOTTOM, SIDE_COUNT};
+
+	UnsignedShort blockAssignZones(PathfindCell **map, const IRegion2D &bounds, zoneStorageType firstZone); ///< Numbers the cell zones, returns zone count.
 	void blockCalculateZones(	PathfindCell **map, PathfindLayer layers[], const IRegion2D &bounds);	///< Does zone calculations.  
+	void blockCalculateLinks(PathfindCell **map, const IRegion2D &bounds, const IRegion2D &globalBounds,
+		const ZoneBlock *leftBlock, const ZoneBlock *lowerBlock); ///< Caches the zone links of this block.
+	void blockCalculatePortals(const PathfindZoneManager *zm, PathfindCell **map, const IRegion2D &globalBounds,
+		Int xBlock, Int yBlock); ///< Caches the zones of the cells on the block edges.
+	void shiftZones(PathfindCell **map, const IRegion2D &bounds, zoneStorageType firstZone); ///< Renumbers an unchanged block.
 	zoneStorageType getEffectiveZone(LocomotorSurfaceTypeMask acceptableSurfaces, bool crusher, zoneStorageType zone) const;
 
+	zoneStorageType getFirstZone(void) const {return m_firstZone;}
+	UnsignedShort getNumZones(void) const {return m_numZones;}
+	Int getNumLinks(void) const {return m_numLinks;}
+	const ZoneBlockLink &getLink(Int ndx) const {return m_links[ndx];}
+	const ZoneBlockPortal *getPortals(Int side) const; ///< Edge cells of side, in hierarchical search order.
+
+	bool isZonesDirty(void) const {return m_zonesDirty;}
+	void setZonesDirty(bool dirty) {m_zonesDirty = dirty;}
+	bool isLinksDirty(void) const {return m_linksDirty;}
+	void setLinksDirty(bool dirty) {m_linksDirty = dirty;}
+	bool isPortalsDirty(void) const {return m_portalsDirty;}
+	void setPortalsDirty(bool dirty) {m_portalsDirty = dirty;}
+
 	void clearMarkedPassable(void) {m_markedPassable = false;}
 	bool isPassable(void) {return m_markedPassable;}
 	void setPassable(bool pass) {m_markedPassable = pass;}
 
 	bool getInteractsWithBridge(void) const {return m_interactsWithBridge;}
 	void setInteractsWithBridge(bool interacts) {m_interactsWithBridge = interacts;}
+	bool getCellsConnectToLayer(void) const {return m_cellsConnectToLayer;}
 
 protected:
 	void allocateZones(void);
 	void freeZones(void);
+	void addLink(UnsignedShort zone, UnsignedShort otherZone, UnsignedShort other, UnsignedShort tables);
 
 protected:
 	ICoord2D		m_cellOrigin;
@@ -480,8 +558,16 @@ protected:
 	zoneStorageType *m_groundWaterZones;
 	zoneStorageType *m_groundRubbleZones;
 	zoneStorageType *m_crusherZones;
+	ZoneBlockLink *m_links;		 // Links to zones in this & the left and lower blocks.
+	Int						m_numLinks;
+	Int						m_linksAllocated;
+	ZoneBlockPortal *m_portals; // Edge cells, ZONE_BLOCK_SIZE per side.
 	bool					m_interactsWithBridge;
+	bool					m_cellsConnectToLayer; // True if any cell in the block connects to a bridge layer.
 	bool					m_markedPassable;
+	bool					m_zonesDirty;	 // True if the cells changed since the zones were numbered.
+	bool					m_linksDirty;	 // True if this or the left or lower block was renumbered.
+	bool					m_portalsDirty; // True if this or a neighboring block was renumbered.
 };
 typedef ZoneBlock *ZoneBlockP;
 
@@ -505,13 +591,19 @@ public:
 	void reset(void);
 
 	bool needToCalculateZones(void) const {return m_needToCalculateZones;} ///< Returns true if the zones need to be recalculated.
-	void markZonesDirty(void) ; ///< Called when the zones need to be recalculated.
+	void markZonesDirty(void) ; ///< Called when all the zones need to be recalculated.
+	void markZonesDirty(const IRegion2D &cellBounds) ; ///< Called when the cells in cellBounds changed.
+	void markBlocksDirty(const IRegion2D &cellBounds) ; ///< Flags the blocks in cellBounds without requesting a recalculation.
 	void calculateZones(	PathfindCell **map, PathfindLayer layers[], const IRegion2D &bounds);	///< Does zone calculations.  
 	zoneStorageType getEffectiveZone(LocomotorSurfaceTypeMask acceptableSurfaces, bool crusher, zoneStorageType zone) const;
 	zoneStorageType getEffectiveTerrainZone(zoneStorageType zone) const;
 
 	void getExtent(ICoord2D &extent) const {extent = m_zoneBlockExtent;}
 
+	const ZoneBlock *getBlock(Int blockX, Int blockY) const {return &m_zoneBlocks[blockX][blockY];}
+	const ZoneBlock *getCellBlock(Int cellX, Int cellY) const; ///< Block the cell is in, or NULL.
+	static void getPortalCell(Int blockX, Int blockY, Int side, Int ndx, ICoord2D &cell, ICoord2D &delta); ///< Edge cell ndx of a block side, and the step across the edge.
+
 	/// return zone relative the the block zone that this cell resides in.
 	zoneStorageType getBlockZone(LocomotorSurfaceTypeMask acceptableSurfaces, bool crusher, Int cellX, Int cellY, PathfindCell **map) const;
 	void allocateBlocks(const IRegion2D &globalBounds);
@@ -530,6 +622,7 @@ protected:
 	void allocateZones(void);
 	void freeZones(void);
 	void freeBlocks(void);
+	bool getBlockBounds(Int xBlock, Int yBlock, const IRegion2D &globalBounds, IRegion2D &bounds) const;
 
 protected:
 	ZoneBlock			*m_blockOfZoneBlocks;			///< Zone blocks - Info for hierarchical pathfinding at a "blocky" level.
@@ -547,6 +640,170 @@ protected:
 	zoneStorageType *m_hierarchicalZones;
 };
 
+/**
+ * Everything about a findPath request that affects the path found.  Positions are 
+ * quantized to pathfind cells.
+ */
+struct PathfindCacheKey
+{
+	ICoord2D									m_startCell;
+	ICoord2D									m_goalCell;
+	PathfindLayerEnum					m_startLayer;
+	PathfindLayerEnum					m_goalLayer;
+	LocomotorSurfaceTypeMask	m_surfaces;
+	Int												m_radius;					///< Path radius in cells, from getRadiusAndCenter.
+	Int												m_playerIndex;		///< Controlling player, as other units block by relationship.
+	ObjectID									m_ignoreObstacleID;
+	bool											m_centerInCell;
+	bool											m_crusher;
+
+	bool isSameKey(const PathfindCacheKey &other) const;
+};
+
+struct PathfindCacheStats
+{
+	Int m_lookups;		///< Number of findPath calls that checked the cache.
+	Int m_hits;				///< Number of lookups answered from the cache.
+	Int m_stale;			///< Number of entries dropped because their cells changed, or they expired.
+};
+
+/**
+ * This class caches recent findPath results, so units ordered together from the same cell to 
+ * the same cell share one A* search.  An entry is dropped when cells change in the zone blocks 
+ * around its path, and after a short lifetime, since the units that block paths move.
+ */
+class PathfindCache
+{
+public:
+	enum {CACHE_SIZE = 64};
+	enum {CACHE_LIFETIME = LOGICFRAMES_PER_SECOND};	///< Frames an entry stays valid.
+
+	PathfindCache();
+	~PathfindCache();
+
+	void reset(void);
+	void allocateRegions(const IRegion2D &globalBounds);	///< Called on a new map.
+
+	Path *findPath(const PathfindCacheKey &key, UnsignedInt frame);	///< Returns a copy of the cached path, or NULL.
+	void addPath(const PathfindCacheKey &key, const Coord3D *from, Path *path, UnsignedInt frame);
+
+	void invalidateRegion(const IRegion2D &cellBounds);	///< Called when the cells in cellBounds change.
+	void invalidateAll(void);
+
+	void xfer(Xfer *xfer);	///< Save or load the entries, for save games.
+
+	void getStats(PathfindCacheStats &stats) const {stats = m_stats;}
+
+protected:
+	struct Entry
+	{
+		PathfindCacheKey	m_key;
+		Path							*m_path;						///< Path nodes, without the start position node.
+		IRegion2D					m_regionBounds;		///< Regions the path crosses, padded by one region.
+		UnsignedInt				m_epoch;					///< Entry is stale if any region changed after this epoch.
+		UnsignedInt				m_frame;					///< Frame the path was found.
+	};
+
+	void freeEntry(Entry &entry);
+	bool isEntryValid(const Entry &entry, UnsignedInt frame) const;
+
+protected:
+	Entry					m_entries[CACHE_SIZE];
+	Int						m_nextEntry;				///< Next entry to replace, round robin.
+	UnsignedInt		*m_regionEpochs;		///< Epoch each region last changed, ZONE_BLOCK_SIZE cells on a side.
+	ICoord2D			m_regionExtent;
+	UnsignedInt		m_epoch;
+	PathfindCacheStats m_stats;
+};
+
+/**
+ * An internalFindPath search that used up its cell budget for the frame.  The open & closed 
+ * lists are saved by cell position rather than by cell info, so no cell infos are held across 
+ * frames, and the search picks up next frame where it left off.
+ */
+struct PathfindSearchState
+{
+	struct SavedCell
+	{
+		ICoord2D					m_pos;
+		ICoord2D					m_parentPos;
+		UnsignedInt				m_costSoFar;
+		UnsignedInt				m_totalCost;
+		UnsignedInt				m_openSequence;		///< Keeps ties coming off the open list in the original order.
+		PathfindLayerEnum	m_layer;
+		PathfindLayerEnum	m_parentLayer;
+		bool							m_hasParent;
+		bool							m_open;						///< On the open list, else on the closed list.
+		bool							m_blockedByAlly;
+	};
+	typedef std::vector<SavedCell> SavedCellVector;
+
+	ObjectID					m_objID;						///< INVALID_ID if there is no suspended search.
+	PathfindCacheKey	m_key;							///< The request the search is for.
+	UnsignedInt				m_openSequence;			///< Open list insertion counter when suspended.
+	bool							m_isTunneling;
+	SavedCellVector		m_cells;						///< Closed list in list order, then the open list.
+	Int								m_numClosed;
+
+	void clear(void) {m_objID = INVALID_ID; m_cells.clear(); m_numClosed = 0;}
+	void xfer(Xfer *xfer);	///< Save or load the search, for save games.
+};
+
+/**
+ * A flow field for a large group ordered to the same place.  It is a Dijkstra search outward
+ * from the goal over the ground layer, so each cell in the field's bounds knows its cost to the
+ * goal, and which neighbor to step to.  The members of the group trace the field rather than
+ * each doing an A* search.  Other units are ignored, as the field is shared by the whole group,
+ * so the paths differ from what findPath would find.  Flow fields are only used in games that
+ * share paths (see GameInfo::getSharedPaths).
+ */
+struct PathfindFlowField
+{
+	enum {FLOW_FIELD_LIFETIME = 3*LOGICFRAMES_PER_SECOND};	///< Frames a field stays valid.
+	enum {GOAL_DIRECTION = 8, NO_DIRECTION = 0xff};	///< Directions 0-7 are neighbors.
+	enum {FLOW_FIELD_MARGIN = 32};		///< Cells the field extends past the group & goal.
+	enum {FLOW_FIELD_MAX_CELLS = 256*256};
+	enum {FLOW_FIELD_GOAL_RADIUS = 16};	///< Cells a unit's own goal may be from the field goal.
+
+	ICoord2D									m_goalCell;
+	IRegion2D									m_bounds;						///< Cells covered by the field.
+	LocomotorSurfaceTypeMask	m_surfaces;
+	Int												m_radius;						///< Path radius in cells, from getRadiusAndCenter.
+	bool											m_centerInCell;
+	bool											m_crusher;
+	UnsignedInt								m_frame;						///< Frame the field was built.
+	UnsignedInt								*m_costs;						///< Cost to the goal, per cell.
+	UnsignedByte							*m_directions;			///< Neighbor to step to, or NO_DIRECTION if the goal wasn't reached.
+	Int												m_numCells;					///< Size of the arrays.
+
+	struct OpenCell
+	{
+		UnsignedInt m_cost;
+		Int					m_index;
+
+		// The stl heap keeps the largest on top, so this is reversed.  Ties go to the lowest index,
+		// so the field is the same on every machine.
+		bool operator<(const OpenCell &other) const
+		{
+			if (m_cost != other.m_cost) return m_cost > other.m_cost;
+			return m_index > other.m_index;
+		}
+	};
+
+	PathfindFlowField() : m_costs(NULL), m_directions(NULL), m_numCells(0) {clear();}
+	~PathfindFlowField() {freeArrays();}
+
+	void clear(void) {m_frame = 0; m_bounds.lo.x = m_bounds.lo.y = 0; m_bounds.hi.x = m_bounds.hi.y = -1;}
+	void freeArrays(void);
+	void allocate(const IRegion2D &bounds);
+	void xfer(Xfer *xfer);	///< Save or load the field, for save games.
+
+	bool isValid(UnsignedInt frame) const {return m_bounds.hi.x >= m_bounds.lo.x && frame <= m_frame + FLOW_FIELD_LIFETIME;}
+	bool contains(Int x, Int y) const {return x >= m_bounds.lo.x && x <= m_bounds.hi.x && y >= m_bounds.lo.y && y <= m_bounds.hi.y;}
+	Int getIndex(Int x, Int y) const {return (y - m_bounds.lo.y)*(m_bounds.hi.x - m_bounds.lo.x + 1) + (x - m_bounds.lo.x);}
+	bool isReached(Int x, Int y) const {return contains(x, y) && m_directions[getIndex(x, y)] != NO_DIRECTION;}
+};
+
 /** 
  * The pathfinding services interface provides access to the 3 expensive path find calls:
  * findPath, findClosestPath, and findAttackPath.
@@ -630,6 +887,10 @@ public:
 	Path *findGroundPath( const Coord3D *from, const Coord3D *to, Int pathRadius,
 		bool crusher);	///< Find a short, valid path of the desired width on the ground.
 
+	enum {FLOW_FIELD_MIN_GROUP = 8};	///< Fewest units in a group move that builds a flow field.
+	void buildFlowField( const Object *obj, const LocomotorSet& locomotorSet, const Coord3D *goal,
+		const Coord2D *groupMin, const Coord2D *groupMax );	///< Build a flow field to goal for units like obj, unless there is one.
+
 	void addObjectToPathfindMap( class Object *obj );				///< Classify the given object's cells in the map
 	void removeObjectFromPathfindMap( class Object *obj );	///< De-classify the given object's cells in the map
 
@@ -685,6 +946,10 @@ public:
 	bool isGroundPathPassable( bool isCrusher, const Coord3D& startWorld, PathfindLayerEnum startLayer, 
 		const Coord3D& endWorld, Int pathDiameter);	///< Return true if the straight line between the given points is passable
 
+	void getPathCacheStats(PathfindCacheStats &stats) const {m_pathCache.getStats(stats);} ///< Hit rate of the findPath cache.
+	bool isSearchSuspended(void) const {return m_searchSuspended;} ///< True if the last findPath ran out of cells for this frame, and will resume next frame.
+	bool isSlicingSearches(void) const; ///< True if long searches are spread over several frames in this game (see GameInfo::getSlicedPathSearches).
+
 	// for debugging
 	const Coord3D *getDebugPathPosition( void );
 	void setDebugPathPosition( const Coord3D *pos );
@@ -724,11 +989,12 @@ public:
 	Int clearCellForDiameter( bool crusher, Int cellX, Int cellY, PathfindLayerEnum layer, Int pathDiameter );		///< Return true if given position is a valid movement location
 
 protected:
-	virtual Path *internalFindPath( Object *obj, const LocomotorSet& locomotorSet, const Coord3D *from, const Coord3D *to);	///< Find a short, valid path between given locations
+	virtual Path *internalFindPath( Object *obj, const LocomotorSet& locomotorSet, const Coord3D *from, const Coord3D *to,
+		const PathfindCacheKey &key);	///< Find a short, valid path between given locations.  key is from makePathCacheKey.
 	Path *findHierarchicalPath( bool isHuman, const LocomotorSet& locomotorSet, const Coord3D *from, const Coord3D *to, bool crusher);	
 	Path *findClosestHierarchicalPath( bool isHuman, const LocomotorSet& locomotorSet, const Coord3D *from, const Coord3D *to, bool crusher);	
 	Path *internal_findHierarchicalPath( bool isHuman, const LocomotorSurfaceTypeMask locomotorSurface, const Coord3D *from, const Coord3D *to, bool crusher, bool closestOK);	
-	void processHierarchicalCell( const ICoord2D &scanCell, const ICoord2D &deltaPathfindCell,
+	void processHierarchicalCell( const ZoneBlockPortal &portal, const ICoord2D &scanCell, const ICoord2D &deltaPathfindCell,
 																PathfindCell *parentCell, 
 																PathfindCell *goalCell, zoneStorageType parentZone, 
 																zoneStorageType *examinedZones, Int &numExZones,
@@ -819,6 +1085,21 @@ protected:
 
 	void checkChangeLayers(PathfindCell *parentCell);
 
+	void makePathCacheKey(const Object *obj, const LocomotorSet& locomotorSet, const Coord3D *from, 
+		const Coord3D *to, PathfindCacheKey &key);
+
+	Path *findFlowFieldPath(const Object *obj, const LocomotorSet& locomotorSet, const Coord3D *from, 
+		const PathfindCacheKey &key);	///< Trace a path through a flow field, or NULL if there isn't a usable one.
+	bool isFlowFieldCellClear(const bool *validCells, const IRegion2D &validBounds, Int cellX, Int cellY, 
+		Int radius, bool centerInCell) const;
+	bool *growFlowFieldScratch(bool *&cells, Int &cellsSize, Int size);
+	void invalidateFlowFields(const IRegion2D &cellBounds);	///< Drop the flow fields that overlap cellBounds.
+	void resetFlowFields(void);
+
+	void suspendSearch(const Object *obj, const PathfindCacheKey &key);	///< Save the open & closed lists, and release them.
+	bool resumeSearch(const Object *obj, const PathfindCacheKey &key);	///< Restore the open & closed lists, if the suspended search matches.
+	void saveSearchCell(PathfindCell *cell, PathfindSearchState::SavedCell &saved);
+
 #if defined RTS_DEBUG || defined RTS_INTERNAL
 	void doDebugIcons(void) ;
 #endif
@@ -844,6 +1125,20 @@ private:
 	ObjectID m_ignoreObstacleID;									///< Ignore the given obstacle
 
 	PathfindZoneManager m_zoneManager;						///< Handles the pathfind zones.
+	PathfindCache m_pathCache;										///< Recent findPath results.
+
+	PathfindSearchState m_suspendedSearch;				///< Search that ran out of cells last frame.
+	Int m_searchCellBudget;												///< Cells internalFindPath may examine before suspending, 0 for no limit.
+	bool m_searchSuspended;												///< True if the last internalFindPath suspended.
+
+	enum {MAX_FLOW_FIELDS = 4};
+	PathfindFlowField m_flowFields[MAX_FLOW_FIELDS];	///< Recent group move flow fields.
+	Int m_nextFlowField;													///< Next field to replace, round robin.
+	bool *m_flowFieldValidCells;									///< Scratch for buildFlowField.
+	Int m_flowFieldValidSize;
+	bool *m_flowFieldClearCells;									///< Scratch for buildFlowField.
+	Int m_flowFieldClearSize;
+	std::vector<PathfindFlowField::OpenCell> m_flowFieldOpenCells;	///< Scratch for buildFlowField.
 
 	PathfindLayer m_layers[LAYER_LAST+1];
 
@@ -973,5 +1268,13 @@ inline bool PathfindCell::isObstaclePresent( ObjectID objID ) const
 	return false;
 }
 
+#if defined RTS_DEBUG || defined RTS_INTERNAL
+/**
+	Run numPaths A* searches between fixed points of a synthetic obstacle grid, using the same
+	cell infos & open list as the pathfinder, and log the cells examined per second.  Has to run 
+	before TheAI exists, since it borrows the cell info pool.
+*/
+extern void benchmarkPathfinding(Int numPaths);
+#endif
 
 #endif // _PATHFIND_H_
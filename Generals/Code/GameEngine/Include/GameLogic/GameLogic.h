@@ -66,6 +66,7 @@ class WindowLayout;
 class TerrainLogic;
 class GhostObjectManager;
 class CommandButton;
+class AssetPrefetcher;
 enum BuildableStatus : Int;
 
 typedef const CommandButton* ConstCommandButtonPtr;
@@ -88,6 +89,19 @@ enum
 	CRC_RECALC
 };
 
+/// The MARKER: sections of GameLogic::getCRC(), in the order they go into the CRC
+enum CRCSectionType
+{
+	CRC_SECTION_OBJECTS,					///< MARKER:Objects, and the logic random seed
+	CRC_SECTION_PARTITION,				///< MARKER:ThePartitionManager
+	CRC_SECTION_PLAYERS,					///< MARKER:ThePlayerList
+	CRC_SECTION_AI,								///< MARKER:TheAI
+
+	CRC_SECTION_COUNT
+};
+
+extern const char *TheCRCSectionNames[];
+
 /// Function pointers for use by GameLogic callback functions.
 typedef void (*GameLogicFuncPtr)( Object *obj, void *userData ); 
 typedef std::hash_map<ObjectID, Object *, rts::hash<ObjectID>, rts::equal_to<ObjectID> > ObjectPtrHash;
@@ -132,6 +146,7 @@ public:
 	bool isInGameLogicUpdate( void ) const { return m_isInUpdate; }
 	UnsignedInt getFrame( void );										///< Returns the current simulation frame number
 	UnsignedInt getCRC( Int mode = CRC_CACHED, AsciiString deepCRCFileName = AsciiString::TheEmptyString );		///< Returns the CRC
+	UnsignedInt getCRCSection( CRCSectionType section ) const { return m_crcSections[section]; }	///< Returns the running CRC after a section of the last recalculated CRC
 
 	void setObjectIDCounter( ObjectID nextObjID ) { m_nextObjID = nextObjID; }
 	ObjectID getObjectIDCounter( void ) { return m_nextObjID; }
@@ -274,8 +289,10 @@ private:
 	
 	// CRC cache system -----------------------------------------------------------------------------
 	UnsignedInt	m_CRC;																			///< Cache of previous CRC value
+	UnsignedInt m_crcSections[CRC_SECTION_COUNT];						///< Running CRC after each section of the last recalculated CRC
 	std::map<Int, UnsignedInt> m_cachedCRCs;								///< CRCs we've seen this frame
 	bool m_shouldValidateCRCs;															///< Should we validate CRCs this frame?
+	bool m_noCachedCRCs;																		///< getCRC recomputes every CachedCRC instead of using it
 	//-----------------------------------------------------------------------------------------------
 
 	//Added By Sadullah Nader
@@ -318,12 +335,17 @@ private:
 
 	void setDefaults( bool saveGame );											///< Set default values of class object
 	void processDestroyList( void );												///< Destroy all pending objects on the destroy list
+	void verifyCachedCRCs( UnsignedInt crc );								///< check a CRC made from CachedCRCs against a full recompute
 
 	void destroyAllObjectsImmediate();											///< destroy, and process destroy list immediately
 
 	/// factory for TheTerrainLogic, called from init()
 	virtual TerrainLogic *createTerrainLogic( void );
 	virtual GhostObjectManager *createGhostObjectManager(void);
+	/// factory for TheAssetPrefetcher, called from startPrefetchingMapAssets()
+	virtual AssetPrefetcher *createAssetPrefetcher( void );
+
+	void startPrefetchingMapAssets( void );									///< start reading the files the map's objects will load
 
 	Int m_gameMode;
 	Int m_rankLevelLimit;
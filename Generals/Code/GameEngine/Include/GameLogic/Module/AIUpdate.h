@@ -439,6 +439,7 @@ public:
 	// Pathfinding ---------------------------------------------------------------------------------------
 private:
 	bool computePath( PathfindServicesInterface *pathfinder, Coord3D *destination );	///< computes path to destination, returns false if no path
+	bool computePathNow( PathfindServicesInterface *pathfinder, Coord3D *destination );	///< computePath, without keeping the current path through a time sliced search
 	bool computeAttackPath(PathfindServicesInterface *pathfinder,  const Object *victim, const Coord3D* victimPos );	///< computes path to attack the current target, returns false if no path
 #ifdef ALLOW_SURRENDER
 	void doSurrenderUpdateStuff();
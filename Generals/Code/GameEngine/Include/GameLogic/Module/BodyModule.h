@@ -261,7 +261,7 @@ public:
 	virtual bool isIndestructible( void ) const { return TRUE; }
 
 	//Allows outside systems to apply defensive bonuses or penalties (they all stack as a multiplier!)
-	virtual void applyDamageScalar( Real scalar ) { m_damageScalar *= scalar; }
+	virtual void applyDamageScalar( Real scalar );
 	virtual Real getDamageScalar() const { return m_damageScalar; }
 
 	/**
@@ -387,6 +387,10 @@ public:
 
 	// this is intended for use ONLY by GameLogic.
 	void friend_deleteInstance() { deleteInstance(); }
+	CachedCRC *friend_getCachedCRC() { return &m_cachedCRC; }
+
+	/// anything that changes what Object::crc reads must call this, or the game CRC goes stale
+	void invalidateCRC() { m_cachedCRC.invalidate(); }
 
 	/// cache the partition module (should be called only by PartitionData)
 	void friend_setPartitionData(PartitionData *pd) { m_partitionData = pd; }
@@ -521,8 +525,8 @@ public:
 	// @todo: inline
 	bool hasSpecialPower( SpecialPowerType type ) const;
 
-	void setWeaponBonusCondition(WeaponBonusConditionType wst) { m_weaponBonusCondition |= (1 << wst); }
-	void clearWeaponBonusCondition(WeaponBonusConditionType wst) { m_weaponBonusCondition &= ~(1 << wst); }
+	void setWeaponBonusCondition(WeaponBonusConditionType wst) { m_weaponBonusCondition |= (1 << wst); invalidateCRC(); }
+	void clearWeaponBonusCondition(WeaponBonusConditionType wst) { m_weaponBonusCondition &= ~(1 << wst); invalidateCRC(); }
   // note, the !=0 at the end is important, to convert this into a boolean type! (srj)
 	bool testWeaponBonusCondition(WeaponBonusConditionType wst) const { return (m_weaponBonusCondition & (1 << wst)) != 0; }
 	inline WeaponBonusConditionFlags getWeaponBonusCondition() const { return m_weaponBonusCondition; }
@@ -751,6 +755,8 @@ private:
 	
 	UnsignedInt										m_safeOcclusionFrame;	///<flag used by occlusion renderer so it knows when objects have exited their production building.
 
+	CachedCRC											m_cachedCRC;					///< see invalidateCRC
+
 	// --------- BYTE-SIZED THINGS GO HERE
 	bool													m_isSelectable;
 	bool													m_modulesReady;
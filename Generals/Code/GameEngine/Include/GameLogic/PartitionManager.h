@@ -97,6 +97,7 @@ class GhostObject;
 class CommandButton;
 
 enum CommandSourceType : Int;
+enum CRCKernel : Int;
 
 // ----------------------------------------------------------------------------------------------
 enum ValueOrThreat : Int
@@ -307,6 +308,23 @@ private:
 	Short													m_cellX;						///< x-coord of this cell within the Partition Mgr coords (NOT in world coords)
 	Short													m_cellY;						///< y-coord of this cell within the Partition Mgr coords (NOT in world coords)
 
+	/*
+		The range index: the position & bounding radius of each COI's module, in parallel arrays
+		in the order the COIs were added (so the list order is the reverse), so range queries can 
+		reject most modules without touching them.
+	*/
+	Short													m_rangeIndexSize;		///< number of entries allocated in the range index.
+	PartitionData**								m_rangeModule;			///< module for each entry.
+	Real*													m_rangeX;						///< module position when its cells were last updated.
+	Real*													m_rangeY;
+	Real*													m_rangeRadius;			///< module bounding radius, or HUGE_DIST if the module moved since.
+	UnsignedInt										m_rangeIndexStamp;	///< the range index clock when the range index last changed.
+
+	void addToRangeIndex(PartitionData *module);
+	void removeFromRangeIndex(PartitionData *module);
+
+	inline void invalidateCRC();				///< call whenever something crc() looks at changes
+
 public:
 
 	// Note, we allocate these in arrays, thus we must have a default ctor (and NOT descend from MPO)
@@ -353,6 +371,18 @@ public:
 
 	inline CellAndObjectIntersection *getFirstCoiInCell() { return m_firstCoiInCell; }
 
+	/**
+		return a mask of the range index entries in [first, first+32) that may be within dist 
+		of (x, y), bit n for entry first+n. dist should include the querying object's radius.
+	*/
+	UnsignedInt getRangeIndexMask(Int first, Real x, Real y, Real dist) const;
+	inline PartitionData *getRangeIndexModule(Int i) const { return m_rangeModule[i]; }
+	inline UnsignedInt getRangeIndexStamp() const { return m_rangeIndexStamp; }
+	inline void friend_clearRangeIndexStamp() { m_rangeIndexStamp = 0; }	///< for PartitionManager only
+
+	// intended only for PartitionData, when it moves.
+	void friend_invalidateRangeIndex(PartitionData *module);
+
 	#ifdef RTS_DEBUG
 	void validateCoiList();
 	#endif
@@ -399,6 +429,8 @@ private:
 	ObjectShroudStatus					m_shroudednessPrevious[MAX_PLAYER_COUNT];	///<previous frames value of m_shroudedness						
 	bool												m_everSeenByPlayer[MAX_PLAYER_COUNT];		///<whether this object has ever been seen by a given player.
 	const PartitionCell					*m_lastCell;							///< The last cell I thought my center was in.
+	Coord2D											m_rangePos;								///< position recorded in the cells' range index.
+	Real												m_rangeRadius;						///< bounding radius recorded in the cells' range index.
 	
 	/**
 		Given a shape's geometry and size parameters, calculate the maximum number of COIs
@@ -546,6 +578,8 @@ public:
 	void friend_removeAllTouchedCells() { removeAllTouchedCells(); }	///< this is only for use by PartitionManager
 	void friend_updateCellsTouched()	{ updateCellsTouched(); } ///< this is only for use by PartitionManager
 	Int friend_getCoiInUseCount() { return m_coiInUseCount; } ///< this is only for use by PartitionManager
+	const Coord2D *friend_getRangePos() const { return &m_rangePos; }	///< this is only for use by PartitionCell
+	Real friend_getRangeRadius() const { return m_rangeRadius; }	///< this is only for use by PartitionCell
 	bool friend_collidesWith(const PartitionData *that, CollideLocAndNormal *cinfo) const { return collidesWith(that, cinfo); }	///< this is only for use by PartitionContactList
 
 	// these are only for use by getClosestObjects.
@@ -1192,11 +1226,53 @@ protected:
 	system. It maintains the set of PartitionCells that correspond to the world system,
 	and updates the PartitionDatas as needed during update phase.
 */
+//=====================================
 class PartitionManager : public SubsystemInterface, public Snapshot
 {
 
 private:
 
+	struct RangeScan
+	{
+		ObjectID								m_clientID;				///< the object that will do the scan
+		Real										m_maxDist;
+		DistanceCalculationType	m_dc;
+		UnsignedInt							m_frame;					///< the frame the scan is due on
+		Int											m_phase;					///< the update phase the scan is done in
+		bool										m_swept;					///< true once sweepRangeScans has got to it
+		bool										m_valid;					///< false if the client was gone when it was swept
+		Coord3D									m_pos;						///< where the client was when it was swept
+		Real										m_queryRadius;
+		UnsignedInt							m_sweptClock;			///< the range index clock when it was swept
+		Int											m_firstCandidate;	///< index into m_rangeScanCandidates
+		Int											m_numCandidates;
+	};
+	typedef std::vector<RangeScan> RangeScanVec;
+
+	struct RangeScanCandidate
+	{
+		PartitionData*					m_module;
+		Int											m_radius;					///< the shell of cells it was found in
+	};
+	typedef std::vector<RangeScanCandidate> RangeScanCandidateVec;
+
+	struct RangeScanVisit
+	{
+		Int											m_cellIndex;
+		Int											m_scan;						///< index into m_dueRangeScans
+		Int											m_order;					///< the order the scan walks its cells in
+		Int											m_radius;
+	};
+	typedef std::vector<RangeScanVisit> RangeScanVisitVec;
+
+	struct RangeScanHit
+	{
+		Int											m_scan;
+		Int											m_order;
+		RangeScanCandidate			m_candidate;
+	};
+	typedef std::vector<RangeScanHit> RangeScanHitVec;
+
 #ifdef FASTER_GCO
 	typedef std::vector<ICoord2D>		OffsetVec;
 	typedef std::vector<OffsetVec>	RadiusVec;
@@ -1216,6 +1292,15 @@ private:
 
 	std::queue<SightingInfo *> m_pendingUndoShroudReveals;	///< Anything can queue up an Undo to happen later. This is a queue, because "later" is a constant
 
+	RangeScanVec					m_rangeScans;						///< scans queued for a later frame
+	RangeScanVec					m_dueRangeScans;				///< scans due this frame, sorted by client, dist & calc
+	RangeScanCandidateVec	m_rangeScanCandidates;	///< every due scan's candidates, in the order getClosestObjects would see them
+	RangeScanVisitVec			m_rangeScanVisits;			///< scratch for sweepRangeScans
+	RangeScanHitVec				m_rangeScanHits;				///< scratch for sweepRangeScans
+
+	std::vector<UnsignedInt>	m_rowCRC;				///< light CRC of each row of cells, unless m_rowCRCDirty
+	std::vector<bool>					m_rowCRCDirty;	///< true if a cell in the row changed since its m_rowCRC
+
 #ifdef FASTER_GCO
 	Int							m_maxGcoRadius;
 	RadiusVec				m_radiusVec;
@@ -1223,6 +1308,8 @@ private:
 
 protected:
 
+	UnsignedInt calcRowCRC(Int y, CRCKernel kernel);	///< light CRC of cell row y, from scratch
+
 	/**
 		This is an internal function that is used to implement the public 
 		getClosestObject and iterateObjects calls. 
@@ -1256,6 +1343,17 @@ protected:
 #ifdef FASTER_GCO
 	Int calcMinRadius(const ICoord2D& cur);
 	void calcRadiusVec();
+	Int getGcoRadiusLimit(Real maxDist);
+
+	RangeScan *findDueRangeScan(const Object *obj, Real maxDist, DistanceCalculationType dc);
+	void sweepRangeScans(Int phase);
+	bool isRangeScanCurrent(const RangeScan *scan, const Object *obj, Int cellCenterX, Int cellCenterY, Real queryRadius);
+	static bool rangeScanKeyLess(const RangeScan& a, const RangeScan& b);
+	static bool rangeScanVisitLess(const RangeScanVisit& a, const RangeScanVisit& b);
+	static bool rangeScanHitLess(const RangeScanHit& a, const RangeScanHit& b);
+#if defined(RTS_DEBUG) || defined(RTS_INTERNAL)
+	Int benchmarkScanCellLists(const Object *obj, Real maxDist, DistanceCalculationType dc);
+#endif
 #endif
 
 	// These are all friend functions now. They will continue to function as before, but can be passed into 
@@ -1298,6 +1396,25 @@ public:
 
 	void processEntirePendingUndoShroudRevealQueue(); ///< process every pending one regardless of timestamp
 
+	/**
+		obj will call getClosestObject() or iterateObjectsInRange() on itself with this maxDist & dc
+		(and any filters) in the given update phase of the given frame. the cells are then walked
+		once for all the scans due in that phase, and the call answers from that walk if nothing in
+		its cells has changed since, so the result is always exactly what the call would return anyway.
+	*/
+	void queueRangeScan(const Object *obj, Real maxDist, DistanceCalculationType dc, UnsignedInt frame, Int phase);
+
+	/// collect the range scans due this frame. (called by GameLogic before the object updates)
+	void prepareRangeScans();
+
+#if (defined(RTS_DEBUG) || defined(RTS_INTERNAL)) && defined(FASTER_GCO)
+	/// log how long range scans among numObjects infantry take on the current map, several ways.
+	void benchmarkRangeScans(Int numObjects);
+#endif
+
+	/// the cached CRC of cell row y is stale. (for PartitionCell only)
+	void friend_invalidateRowCRC(Int y) { m_rowCRCDirty[y] = TRUE; }
+
 	/// return the number of PartitionCells in the x-dimension.
 	Int getCellCountX() { DEBUG_ASSERTCRASH(m_cellCountX != 0, ("partition not inited")); return m_cellCountX; }
 
@@ -630,8 +630,8 @@ public:
 	Real getPercentReadyToFire() const;
 
 	// do not ever use this unless you are weaponset.cpp
-	void setPossibleNextShotFrame( UnsignedInt frameNum ) { m_whenWeCanFireAgain = frameNum; }
-	void setPreAttackFinishedFrame( UnsignedInt frameNum ) { m_whenPreAttackFinished = frameNum; }
+	void setPossibleNextShotFrame( UnsignedInt frameNum ) { m_whenWeCanFireAgain = frameNum; invalidateCRC(); }
+	void setPreAttackFinishedFrame( UnsignedInt frameNum ) { m_whenPreAttackFinished = frameNum; invalidateCRC(); }
 
 	// we must pass the source object for these (and for ANY FUTURE ADDITIONS)
 	// so that we can take the source's weapon bonuses, if any, into account.
@@ -689,10 +689,10 @@ public:
 	//weapon template has the LeechRangeWeapon set, it means that once the unit has closed to standard weapon range
 	//it fires the weapon, and will be able to hit the target even if it moves out of range! The unit will simply
 	//stand there. This functionality is used by hack attacks.
-	void setLeechRangeActive( bool active ) { m_leechWeaponRangeActive = active; }
+	void setLeechRangeActive( bool active ) { m_leechWeaponRangeActive = active; invalidateCRC(); }
 	bool hasLeechRange() const { return m_leechWeaponRangeActive; }
 
-	void setMaxShotCount(Int maxShots) { m_maxShotCount = maxShots; }
+	void setMaxShotCount(Int maxShots) { m_maxShotCount = maxShots; invalidateCRC(); }
 	Int getMaxShotCount() const { return m_maxShotCount; }
 
 	bool isClearFiringLineOfSightTerrain(const Object* source, const Object* victim) const;
@@ -724,6 +724,9 @@ public:
 	void setClipPercentFull(Real percent, bool allowReduction);
 	UnsignedInt getSuspendFXFrame( void ) const { return m_suspendFXFrame; }
 
+	/// the CRC our state goes into, if we belong to an object's WeaponSet
+	void friend_setOwnerCRC( CachedCRC *ownerCRC ) { m_ownerCRC = ownerCRC; }
+
 protected:
 
 	Weapon(const WeaponTemplate* tmpl, WeaponSlotType wslot);
@@ -749,6 +752,8 @@ protected:
 
 	void rebuildScatterTargets();
 
+	void invalidateCRC() { if (m_ownerCRC) m_ownerCRC->invalidate(); }	///< call whenever something crc() reads changes
+
 
 private:
 	const WeaponTemplate*			m_template;									///< the kind of weapon this is
@@ -767,6 +772,7 @@ private:
 	std::vector<Int>					m_scatterTargetsUnused;			///< A running memory of which targets I've used, so I can shoot them all at random
 	bool											m_pitchLimited;
 	bool											m_leechWeaponRangeActive;		///< This weapon has unlimited range until attack state is aborted!
+	CachedCRC*								m_ownerCRC;									///< the owning object's CRC (see friend_setOwnerCRC)
 
 	// setter function for status that should not be used outside this class
 	void setStatus( WeaponStatus status) { m_status = status; }
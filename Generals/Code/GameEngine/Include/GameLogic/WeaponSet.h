@@ -187,6 +187,7 @@ private:
 	UnsignedInt								m_totalDamageTypeMask;			///< damagetype mask of all current weapons
 	bool											m_hasPitchLimit;
 	bool											m_hasDamageWeapon;
+	CachedCRC*								m_ownerCRC;									///< the owning object's CRC, which has our weapons in it
 
 	bool isAnyWithinTargetPitch(const Object* obj, const Object* victim) const;
 
@@ -201,6 +202,7 @@ public:
 	WeaponSet();
 	~WeaponSet();
 
+	void friend_setOwnerCRC( CachedCRC *ownerCRC ) { m_ownerCRC = ownerCRC; }	///< for use only by Object
 	void updateWeaponSet(const Object* obj);
 	void reloadAllAmmo(const Object *obj, bool now);
 	bool isOutOfAmmo() const;
@@ -35,6 +35,8 @@
 #include "GameNetwork/NetworkDefs.h"
 #include "GameNetwork/FirewallHelper.h"
 
+enum CRCKernel : Int;
+
 enum SlotState : Int
 {
 	SLOT_OPEN,
@@ -52,6 +54,21 @@ enum
 	PLAYERTEMPLATE_MIN = PLAYERTEMPLATE_OBSERVER
 };
 
+/**
+	* What a player's build can do, beyond what every build can.  Each human slot advertises
+	* these to the host, and a game only uses one when every human slot advertised it, so
+	* older builds (which advertise nothing) can always join and watch the replay.
+	*/
+enum GameCapability
+{
+	GAME_CAPABILITY_CRC_KERNEL_LANES	= 0x0001,	///< can checksum with CRC_KERNEL_LANES
+	GAME_CAPABILITY_SHARED_PATHS			= 0x0002,	///< can share cached paths (SP=1)
+	GAME_CAPABILITY_SLICED_PATH_SEARCHES	= 0x0004,	///< can slice path searches across frames (SS=1)
+	GAME_CAPABILITY_FLOW_FIELDS				= 0x0008,	///< can trace group moves through flow fields when paths are shared
+};
+
+UnsignedInt GetLocalGameCapabilities( void );	///< the GameCapability bits this build advertises
+
 /**
   * GameSlot class - maintains information about the contents of a
 	* game slot.  This persists throughout the game.
@@ -127,6 +144,9 @@ public:
 
 	void mute( bool isMuted ) { m_isMuted = isMuted; }
 	bool isMuted( void ) const { return m_isMuted; }
+
+	void setCapabilities( UnsignedInt capabilities ) { m_capabilities = capabilities; }
+	UnsignedInt getCapabilities( void ) const { return m_capabilities; }	///< GameCapability bits this player advertised
 protected:
 	SlotState m_state;
 	bool m_isAccepted;
@@ -145,6 +165,7 @@ protected:
 	FirewallHelperClass::FirewallBehaviorType m_NATBehavior;	///< The NAT behavior for this slot's player.
 	UnsignedInt m_lastFrameInGame;	// only valid for human players
 	bool m_disconnected;						// only valid for human players
+	UnsignedInt m_capabilities;			///< GameCapability bits, only valid for human players
 };
 
 /**
@@ -211,6 +232,13 @@ public:
 	// CRC checking hack
 	void setCRCInterval( Int val ) { m_crcInterval = (val<100)?val:100; }
 	inline Int getCRCInterval( void ) const { return m_crcInterval; }
+	bool doAllPlayersHaveCapability( UnsignedInt capability ) const;	///< did every human slot advertise this GameCapability?
+	CRCKernel getCRCKernel( void ) const;							///< the checksum everyone in this game uses
+	void setSharedPaths( bool val ) { m_sharedPaths = val; }
+	bool getSharedPaths( void ) const;								///< units moving together share paths (see PathfindCache)
+	bool getFlowFields( void ) const;									///< large group moves share a flow field (see PathfindFlowField)
+	void setSlicedPathSearches( bool val ) { m_slicedPathSearches = val; }
+	bool getSlicedPathSearches( void ) const;					///< long path searches finish over several frames (see PathfindSearchState)
 	
 	bool haveWeSurrendered(void) { return m_surrendered; }
 	void markAsSurrendered(void) { m_surrendered = TRUE; }
@@ -225,6 +253,8 @@ public:
 protected:
 	Int m_preorderMask;
 	Int m_crcInterval;
+	bool m_sharedPaths;
+	bool m_slicedPathSearches;
 	bool m_inGame;
 	bool m_inProgress;
 	bool m_surrendered;
@@ -50,6 +50,8 @@ static const Int g_lanMaxChatLength = 100;
 static const Int m_lanMaxOptionsLength = MAX_PACKET_SIZE - ( 8 + (g_lanGameNameLength+1)*2 + 4 + (g_lanPlayerNameLength+1)*2
 																														+ (g_lanLoginNameLength+1) + (g_lanHostNameLength+1) );
 static const Int g_maxSerialLength = 23; // including the trailing '\0'
+static const UnsignedInt g_lanCapabilitiesTag = 0xCA500000; // marks GameToJoin.capabilities as filled in
+static const UnsignedInt g_lanCapabilitiesTagMask = 0xFFF00000;
 
 struct LANMessage;
 
@@ -366,6 +368,7 @@ struct LANMessage
 			UnsignedInt exeCRC;
 			UnsignedInt iniCRC;
 			char serial[g_maxSerialLength];
+			UnsignedInt capabilities;	///< GameCapability bits | g_lanCapabilitiesTag; older versions leave this uninitialized
 		} GameToJoin;
 
 		// GameJoined is sent with JOIN_ACCEPT
@@ -378,6 +378,37 @@ AsciiString AudioEventRTS::getFilename( void )
 	return m_filenameToLoad;
 }
 
+//-------------------------------------------------------------------------------------------------
+void AudioEventRTS::getAllFilenames( FilenameList &filenames ) const
+{
+	if (!m_eventInfo) {
+		TheAudio->getInfoForAudioEvent(this);
+		if (!m_eventInfo) {
+			return;
+		}
+	}
+
+	AsciiString filename;
+	if (m_eventInfo->m_soundType == AT_Music || m_eventInfo->m_soundType == AT_Streaming) {
+		filename = generateFilenamePrefix(m_eventInfo->m_soundType, false);
+		filename.concat(m_eventInfo->m_filename);
+		adjustForLocalization(filename);
+		filenames.insert(filename);
+		return;
+	}
+
+	const std::vector<AsciiString> *soundLists[] = { &m_eventInfo->m_attackSounds, &m_eventInfo->m_sounds, &m_eventInfo->m_decaySounds };
+	for (Int i = 0; i < (Int)(sizeof(soundLists) / sizeof(soundLists[0])); ++i) {
+		for (std::vector<AsciiString>::const_iterator it = soundLists[i]->begin(); it != soundLists[i]->end(); ++it) {
+			filename = generateFilenamePrefix(m_eventInfo->m_soundType, false);
+			filename.concat(*it);
+			filename.concat(generateFilenameExtension(m_eventInfo->m_soundType));
+			adjustForLocalization(filename);
+			filenames.insert(filename);
+		}
+	}
+}
+
 //-------------------------------------------------------------------------------------------------
 void AudioEventRTS::generatePlayInfo( void )
 {
@@ -767,7 +798,7 @@ const Coord3D *AudioEventRTS::getCurrentPosition( void )
 }
 
 //-------------------------------------------------------------------------------------------------
-AsciiString AudioEventRTS::generateFilenamePrefix( AudioType audioTypeToPlay, bool localized )
+AsciiString AudioEventRTS::generateFilenamePrefix( AudioType audioTypeToPlay, bool localized ) const
 {
 	AsciiString retStr;
 	retStr = TheAudio->getAudioSettings()->m_audioRoot;
@@ -790,7 +821,7 @@ AsciiString AudioEventRTS::generateFilenamePrefix( AudioType audioTypeToPlay, bo
 }
 
 //-------------------------------------------------------------------------------------------------
-AsciiString AudioEventRTS::generateFilenameExtension( AudioType audioTypeToPlay )
+AsciiString AudioEventRTS::generateFilenameExtension( AudioType audioTypeToPlay ) const
 {
 	AsciiString retStr = AsciiString::TheEmptyString;
 	if (audioTypeToPlay != AT_Music) {
@@ -802,7 +833,7 @@ AsciiString AudioEventRTS::generateFilenameExtension( AudioType audioTypeToPlay
 }
 
 //-------------------------------------------------------------------------------------------------
-void AudioEventRTS::adjustForLocalization(AsciiString &strToAdjust)
+void AudioEventRTS::adjustForLocalization(AsciiString &strToAdjust) const
 {
 	if (TheFileSystem->doesFileExist(strToAdjust.str()))
 	{
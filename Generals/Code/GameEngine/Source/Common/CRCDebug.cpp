@@ -29,6 +29,7 @@
 #include "Common/Debug.h"
 #include "Common/PerfTimer.h"
 #include "Common/LocalFileSystem.h"
+#include "Common/XferCRC.h"
 #include "GameClient/InGameUI.h"
 #include "GameNetwork/IPEnumeration.h"
 #include <cstdarg>
@@ -324,4 +325,67 @@ void dumpReal(Real r, AsciiString name, AsciiString fname, Int line)
 		fname.str(), line, name.str(), AS_INT(r), r);
 }
 
+/**
+	Time every CRCKernel over a deep CRC dump (see -KeepCRCSaves or -ClientDeepCRC), both as 
+	4-byte xfers (which is what most of a real CRC looks like) and as a single big xfer.
+*/
+void benchmarkCRCKernels(const char *fileName)
+{
+	FILE *fp = fopen(fileName, "rb");
+	if (!fp)
+	{
+		DEBUG_CRASH(("benchmarkCRCKernels - can't open %s\n", fileName));
+		return;
+	}
+	fseek(fp, 0, SEEK_END);
+	Int size = ftell(fp) & ~3;
+	fseek(fp, 0, SEEK_SET);
+	if (size <= 0)
+	{
+		fclose(fp);
+		return;
+	}
+	UnsignedByte *data = NEW UnsignedByte[size];
+	size = fread(data, 1, size, fp) & ~3;
+	fclose(fp);
+
+	const Int PASSES = 20;
+	Int64 freq, start, end;
+	QueryPerformanceFrequency((LARGE_INTEGER *)&freq);
+
+	for (Int kernel = 0; kernel < CRC_KERNEL_COUNT; ++kernel)
+	{
+		UnsignedInt crc = 0;
+
+		QueryPerformanceCounter((LARGE_INTEGER *)&start);
+		for (Int pass = 0; pass < PASSES; ++pass)
+		{
+			XferCRC xferCRC((CRCKernel)kernel);
+			xferCRC.open("benchmark");
+			for (Int i = 0; i < size; i += 4)
+				xferCRC.xferUser(data + i, 4);
+			xferCRC.close();
+			crc = xferCRC.getCRC();
+		}
+		QueryPerformanceCounter((LARGE_INTEGER *)&end);
+		double smallMBPerSec = (double)size * PASSES / (1024.0 * 1024.0) / ((double)(end - start) / (double)freq);
+
+		QueryPerformanceCounter((LARGE_INTEGER *)&start);
+		for (Int pass = 0; pass < PASSES; ++pass)
+		{
+			XferCRC xferCRC((CRCKernel)kernel);
+			xferCRC.open("benchmark");
+			xferCRC.xferUser(data, size);
+			xferCRC.close();
+		}
+		QueryPerformanceCounter((LARGE_INTEGER *)&end);
+		double bigMBPerSec = (double)size * PASSES / (1024.0 * 1024.0) / ((double)(end - start) / (double)freq);
+
+		DEBUG_LOG(("CRC kernel %d over %d bytes of %s: %.1f MB/s as 4-byte xfers, %.1f MB/s as one xfer (CRC 0x%8.8X)\n",
+			kernel, size, fileName, smallMBPerSec, bigMBPerSec, crc));
+	}
+
+	delete [] data;
+}
+
 #endif // DEBUG_CRC
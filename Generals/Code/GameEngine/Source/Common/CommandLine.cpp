@@ -27,11 +27,13 @@
 
 #include "Common/ArchiveFileSystem.h"
 #include "Common/CommandLine.h"
+#include "Common/CompressionBenchmark.h"
 #include "Common/CRCDebug.h"
 #include "Common/LocalFileSystem.h"
 #include "Common/version.h"
 #include "GameClient/TerrainVisual.h" // for TERRAIN_LOD_MIN definition
 #include "GameClient/GameText.h"
+#include "GameLogic/AIPathfind.h"
 #include "GameNetwork/NetworkDefs.h"
 
 #ifdef RTS_INTERNAL
@@ -56,6 +58,7 @@ bool g_crcModuleDataFromClient = FALSE;
 bool g_verifyClientCRC = FALSE; // verify that GameLogic CRC doesn't change from client
 bool g_clientDeepCRC = FALSE;
 bool g_logObjectCRCs = FALSE;
+bool g_verifyIncrementalCRC = FALSE;
 #endif
 
 #if defined(RTS_DEBUG) || defined(RTS_INTERNAL)
@@ -309,6 +312,29 @@ Int parseLogObjectCRCs(char *args[], int argc)
 	return 1;
 }
 
+//=============================================================================
+//=============================================================================
+Int parseBenchmarkCRC(char *args[], int argc)
+{
+#ifdef DEBUG_CRC
+	if (argc > 1)
+	{
+		benchmarkCRCKernels(args[1]);
+	}
+#endif
+	return 2;
+}
+
+//=============================================================================
+//=============================================================================
+Int parseVerifyIncrementalCRC(char *args[], int argc)
+{
+#ifdef DEBUG_CRC
+	g_verifyIncrementalCRC = TRUE;
+#endif
+	return 1;
+}
+
 //=============================================================================
 //=============================================================================
 Int parseNetCRCInterval(char *args[], int argc)
@@ -880,6 +906,60 @@ Int parseExtraLogging( char *args[], int num )
 	}
 	return 1;
 }
+
+Int parseRecordPoolProfile( char *args[], int num )
+{
+	if (num > 1)
+	{
+		recordMemoryPoolProfile(args[1]);
+	}
+	return 2;
+}
+
+Int parseBenchmarkMemoryPools( char *args[], int num )
+{
+	if (num > 1)
+	{
+		benchmarkMemoryPools(atoi(args[1]));
+	}
+	return 2;
+}
+
+Int parseBenchmarkPathfinding( char *args[], int num )
+{
+	if (num > 1)
+	{
+		benchmarkPathfinding(atoi(args[1]));
+	}
+	return 2;
+}
+
+Int parseBenchmarkRangeScans( char *args[], int num )
+{
+	if (TheWritableGlobalData && num > 1)
+	{
+		TheWritableGlobalData->m_benchmarkRangeScans = atoi(args[1]);
+	}
+	return 2;
+}
+
+Int parseBenchmarkSleepyUpdates( char *args[], int num )
+{
+	if (TheWritableGlobalData && num > 1)
+	{
+		TheWritableGlobalData->m_benchmarkSleepyUpdates = atoi(args[1]);
+	}
+	return 2;
+}
+
+Int parseBenchmarkCompression( char *args[], int num )
+{
+	if (num > 1)
+	{
+		benchmarkCompression(args[1]);
+	}
+	return 2;
+}
 #endif
 
 //-allAdvice feature
@@ -1098,6 +1178,134 @@ Int parseJumpToFrame(char *args[], int num)
 	return 1;
 }
 
+Int parseReplayKeyframes(char *args[], int num)
+{
+	if (TheWritableGlobalData && num > 1)
+	{
+		TheWritableGlobalData->m_replayKeyframeInterval = atoi(args[1]);
+		return 2;
+	}
+	return 1;
+}
+
+Int parseSeekToFrame(char *args[], int num)
+{
+	if (TheWritableGlobalData && num > 1)
+	{
+		// fast forward without drawing from the restored keyframe to the frame asked for
+		parseJumpToFrame(args, num);
+		TheWritableGlobalData->m_replaySeekFrame = atoi(args[1]);
+		return 2;
+	}
+	return 1;
+}
+
+Int parseBenchmarkSeek(char *args[], int num)
+{
+	if (TheWritableGlobalData && num > 1)
+	{
+		TheWritableGlobalData->m_replaySeekBenchmark = TRUE;
+		return parseSeekToFrame(args, num);
+	}
+	return 1;
+}
+
+Int parseHeadless(char *args[], int num)
+{
+	if (TheWritableGlobalData)
+	{
+		TheWritableGlobalData->m_headless = TRUE;
+		TheWritableGlobalData->m_windowed = TRUE;
+		TheWritableGlobalData->m_playIntro = FALSE;
+		TheWritableGlobalData->m_afterIntro = TRUE;
+		TheWritableGlobalData->m_playSizzle = FALSE;
+		TheWritableGlobalData->m_videoOn = FALSE;
+	}
+	parseNoAudio(args, num);
+	parseNoFPSLimit(args, num);
+	parseNoShellMap(args, num);
+	return 1;
+}
+
+Int parseReplay(char *args[], int num)
+{
+	if (TheWritableGlobalData && num > 1)
+	{
+		TheWritableGlobalData->m_simulateReplays.push_back(AsciiString(args[1]));
+		return 2;
+	}
+	return 1;
+}
+
+Int parseReplayReport(char *args[], int num)
+{
+	if (TheWritableGlobalData && num > 1)
+	{
+		TheWritableGlobalData->m_replayReportFile = args[1];
+		return 2;
+	}
+	return 1;
+}
+
+Int parseReplayReference(char *args[], int num)
+{
+	if (TheWritableGlobalData && num > 1)
+	{
+		TheWritableGlobalData->m_replayReferenceFile = args[1];
+		return 2;
+	}
+	return 1;
+}
+
+Int parseJobs(char *args[], int num)
+{
+	if (TheWritableGlobalData && num > 1)
+	{
+		Int jobs = atoi(args[1]);
+		TheWritableGlobalData->m_replayJobs = (jobs > 0) ? jobs : 0;
+		return 2;
+	}
+	return 1;
+}
+
+Int parseReplayChild(char *args[], int)
+{
+	if (TheWritableGlobalData)
+	{
+		TheWritableGlobalData->m_replayChildProcess = TRUE;
+	}
+	return 1;
+}
+
+Int parseMappedBIGFileMB(char *args[], int num)
+{
+	if (TheWritableGlobalData && num > 1)
+	{
+		Int megabytes = atoi(args[1]);
+		TheWritableGlobalData->m_maxMappedBIGFileMB = (megabytes > 0) ? megabytes : 0;
+		return 2;
+	}
+	return 1;
+}
+
+Int parseSharedPaths(char *args[], int)
+{
+	if (TheWritableGlobalData)
+	{
+		TheWritableGlobalData->m_sharedPaths = TRUE;
+	}
+	return 1;
+}
+
+Int parseSlicedPathSearches(char *args[], int)
+{
+	if (TheWritableGlobalData)
+	{
+		TheWritableGlobalData->m_slicedPathSearches = TRUE;
+	}
+	return 1;
+}
+
 Int parseUpdateImages(char *args[], int num)
 {
 	if (TheWritableGlobalData)
@@ -1204,6 +1412,18 @@ static CommandLineParam params[] =
 	{ "-mod", parseMod },
 	{ "-noshaders", parseNoShaders },
 	{ "-quickstart", parseQuickStart },
+	{ "-headless", parseHeadless },
+	{ "-replay", parseReplay },
+	{ "-replayReport", parseReplayReport },
+	{ "-replayReference", parseReplayReference },
+	{ "-jobs", parseJobs },
+	{ "-replayChild", parseReplayChild },
+	{ "-mappedBIGFileMB", parseMappedBIGFileMB },
+	// games we host let units moving together share paths. everyone in the game does, so
+	// it's sent with the game options and recorded in replays.
+	{ "-sharedPaths", parseSharedPaths },
+	// likewise for spreading long path searches over several frames.
+	{ "-slicedPathSearches", parseSlicedPathSearches },
 
 #if (defined(RTS_DEBUG) || defined(RTS_INTERNAL))
 	{ "-noaudio", parseNoAudio },
@@ -1263,6 +1483,14 @@ static CommandLineParam params[] =
 	// Log CRC of Objects and Weapons (See Object::crc and Weapon::crc)
 	{ "-LogObjectCRCs", parseLogObjectCRCs },
 
+	// Recompute every CRC without the cached sub-CRCs (see CachedCRC in Snapshot.h) and crash if
+	// the cached values are stale, writing a deep CRC of the frame on a mismatch (see
+	// GameLogic::verifyCachedCRCs). Run it on a replay to check the cache invalidation.
+	{ "-VerifyIncrementalCRC", parseVerifyIncrementalCRC },
+
+	// Log the throughput of each CRC kernel (see XferCRC.h) over the deep CRC dump file given.
+	{ "-BenchmarkCRC", parseBenchmarkCRC },
+
 	// Number of frames between each CRC check between all players in multiplayer games
 	// (if not all crcs are equal, mismatch occurs).
 	{ "-NetCRCInterval", parseNetCRCInterval },
@@ -1325,10 +1553,42 @@ static CommandLineParam params[] =
 	{ "-noFPSLimit", parseNoFPSLimit },
 	{ "-dumpAssetUsage", parseDumpAssetUsage },
 	{ "-jumpToFrame", parseJumpToFrame },
+
+	// Write a keyframe index (<replay>.rpx) while playing back a replay, one keyframe every N frames.
+	{ "-replayKeyframes", parseReplayKeyframes },
+
+	// Seek the replay given with -file to frame N from its nearest keyframe, then fast forward to N.
+	// -benchmarkSeek does the same, logs how long it took to reach frame N and quits.
+	{ "-seekToFrame", parseSeekToFrame },
+	{ "-benchmarkSeek", parseBenchmarkSeek },
 	{ "-updateImages", parseUpdateImages },
 	{ "-showTeamDot", parseShowTeamDot },
 	{ "-extraLogging", parseExtraLogging },
 
+	// Write the peak usage of every memory pool to the given file on exit, in the format of
+	// Data\INI\MemoryPoolProfile.ini (see MemoryInit.cpp), and log whenever a pool has to grow.
+	{ "-recordPoolProfile", parseRecordPoolProfile },
+
+	// Log memory pool allocate/free throughput with and without the per-thread magazines
+	// (see GameMemory.h), from one thread and from the given number of threads at once.
+	{ "-benchmarkMemoryPools", parseBenchmarkMemoryPools },
+
+	// Log the cells per second of the given number of A* searches on a synthetic grid (see AIPathfind.h).
+	{ "-benchmarkPathfinding", parseBenchmarkPathfinding },
+
+	// Scatter the given number of infantry over the first map loaded (the shell map, unless -file
+	// gives one), log how long range scans among them take with and without the range index and
+	// the shared sweep (see PartitionManager.h), and quit.
+	{ "-benchmarkRangeScans", parseBenchmarkRangeScans },
+
+	// Log how long keeping the sleepy updates in their heap takes per frame, against the whole
+	// sleepy update loop, over the given number of logic frames of the first map loaded, and quit.
+	{ "-benchmarkSleepyUpdates", parseBenchmarkSleepyUpdates },
+
+	// Log the ratio and throughput of every compression type (see Compression.h) over the files
+	// matching the given mask, egs. Maps\*.map, and check that they all decompress unchanged.
+	{ "-benchmarkCompression", parseBenchmarkCompression },
+
 #endif
 
 #ifdef DEBUG_LOGGING
@@ -29,6 +29,7 @@
 #include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
 
 #include "Common/ActionManager.h"
+#include "Common/ArchiveIndexCache.h"
 #include "Common/AudioAffect.h"
 #include "Common/BuildAssistant.h"
 #include "Common/CRCDebug.h"
@@ -219,6 +220,9 @@ GameEngine::~GameEngine()
 	delete TheCommandList;
 	TheCommandList = NULL;
 
+	delete TheGameMessageArena;
+	TheGameMessageArena = NULL;
+
 	delete TheNameKeyGenerator;
 	TheNameKeyGenerator = NULL;
 
@@ -288,6 +292,9 @@ void GameEngine::init( int argc, char *argv[] )
 		TheNameKeyGenerator = MSGNEW("GameEngineSubsystem") NameKeyGenerator;
 		TheNameKeyGenerator->init();
 
+		// not part of the subsystem list; it is rewound by the logic at the end of every frame
+		TheGameMessageArena = MSGNEW("GameEngineSubsystem") GameMessageArena;
+
 		// not part of the subsystem list, because it should normally never be reset!
 		TheCommandList = MSGNEW("GameEngineSubsystem") CommandList;
 		TheCommandList->init();
@@ -296,6 +303,12 @@ void GameEngine::init( int argc, char *argv[] )
 		xferCRC.open("lightCRC");
 
 		initSubsystem(TheLocalFileSystem, "TheLocalFileSystem", createLocalFileSystem(), NULL);
+
+		// the directory listings of the .big files can come from the last run. the user data directory
+		// isn't known until GameData.ini has been read out of them, so the cache lives next to them
+		TheArchiveIndexCache = MSGNEW("GameEngineSubsystem") ArchiveIndexCache;
+		TheArchiveIndexCache->load("ArchiveIndexCache.dat");
+
 		initSubsystem(TheArchiveFileSystem, "TheArchiveFileSystem", createArchiveFileSystem(), NULL); // this MUST come after TheLocalFileSystem creation
 		initSubsystem(TheWritableGlobalData, "TheWritableGlobalData", MSGNEW("GameEngineSubsystem") GlobalData(), &xferCRC, "Data\\INI\\Default\\GameData.ini", "Data\\INI\\GameData.ini");
 
@@ -307,6 +320,11 @@ void GameEngine::init( int argc, char *argv[] )
 		// special-case: parse command-line parameters after loading global data
 		parseCommandLine(argc, argv);
 
+		// the mods are loaded at the end of parseCommandLine(), and with that all of the .big files
+		TheArchiveIndexCache->save();
+		delete TheArchiveIndexCache;
+		TheArchiveIndexCache = NULL;
+
 		// doesn't require resets so just create a single instance here.
 		TheGameLODManager = MSGNEW("GameEngineSubsystem") GameLODManager;
 		TheGameLODManager->init();
@@ -570,6 +588,9 @@ void GameEngine::update( void )
 
 		if ((TheNetwork == NULL && !TheGameLogic->isGamePaused()) || (TheNetwork && TheNetwork->isFrameDataReady()))
 		{
+			// replay keyframes are saved and loaded between logic frames
+			TheRecorder->updateKeyframes();
+
 			TheGameLogic->UPDATE();
 		}
 
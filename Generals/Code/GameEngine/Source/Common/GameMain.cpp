@@ -29,23 +29,31 @@
 #include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
 
 #include "Common/GameEngine.h"
+#include "Common/GlobalData.h"
+#include "Common/ReplaySimulation.h"
 
 
 /**
- * This is the entry point for the game system.
+ * This is the entry point for the game system. Returns the exit code of the process.
  */
-void GameMain( int argc, char *argv[] )
+Int GameMain( int argc, char *argv[] )
 {
+	Int exitCode = 0;
+
 	// initialize the game engine using factory function
 	TheGameEngine = CreateGameEngine();
 	TheGameEngine->init(argc, argv);
 
-	// run it
-	TheGameEngine->execute();
+	// run it, or just simulate the replays asked for
+	if (!TheGlobalData->m_simulateReplays.empty())
+		exitCode = ReplaySimulation::simulateReplays(TheGlobalData->m_simulateReplays, argc, argv);
+	else
+		TheGameEngine->execute();
 
 	// since execute() returned, we are exiting the game
 	delete TheGameEngine;
 	TheGameEngine = NULL;
 
+	return exitCode;
 }
 
@@ -944,6 +944,21 @@ GlobalData::GlobalData()
 	m_buildMapCache = FALSE;
 	m_initialFile.clear();
 	m_pendingFile.clear();
+	m_replayKeyframeInterval = 0;
+	m_replaySeekFrame = 0;
+	m_replaySeekBenchmark = FALSE;
+	m_benchmarkRangeScans = 0;
+	m_benchmarkSleepyUpdates = 0;
+	m_headless = FALSE;
+	m_sharedPaths = FALSE;
+	m_slicedPathSearches = FALSE;
+	m_simulateReplays.clear();
+	m_replayReportFile.clear();
+	m_replayReferenceFile.clear();
+	m_replayJobs = 0;
+	m_replayChildProcess = FALSE;
+	// the game is a 32 bit process, and the address space is wanted for everything else too
+	m_maxMappedBIGFileMB = 256;
 
 	for (i = LEVEL_FIRST; i <= LEVEL_LAST; ++i)
 		m_healthBonus[i] = 1.0f;
@@ -180,6 +180,10 @@ INI::INI( void )
 {
 
 	m_file							= NULL;
+	m_fileData					= NULL;
+	m_readPos						= NULL;
+	m_readEnd						= NULL;
+	m_tokenPos					= NULL;
 	m_filename					= "None";
 	m_loadType					= INI_LOAD_INVALID;
 	m_lineNum						= 0;
@@ -259,7 +263,7 @@ void INI::loadDirectory( AsciiString dirName, bool subdirs, INILoadType loadType
 void INI::prepFile( AsciiString filename, INILoadType loadType )
 {
 	// if we have a file open already -- we can't do another one
-	if( m_file != NULL )
+	if( m_readPos != NULL )
 	{
 
 		DEBUG_CRASH(( "INI::load, cannot open file '%s', file already open\n", filename.str() ));
@@ -267,9 +271,15 @@ void INI::prepFile( AsciiString filename, INILoadType loadType )
 
 	}  // end if
 
+	// save our filename
+	m_filename = filename;
+
+	// save our load time
+	m_loadType = loadType;
+
 	// open the file
-	m_file = TheFileSystem->openFile(filename.str(), File::READ);
-	if( m_file == NULL )
+	File *file = TheFileSystem->openFile(filename.str(), File::READ);
+	if( file == NULL )
 	{
 
 		DEBUG_CRASH(( "INI::load, cannot open file '%s'\n", filename.str() ));
@@ -277,22 +287,40 @@ void INI::prepFile( AsciiString filename, INILoadType loadType )
 
 	}  // end if
 
-	m_file = m_file->convertToRAMFile();
-
-	// save our filename
-	m_filename = filename;
-
-	// save our load time
-	m_loadType = loadType;
+	// take the whole file in one go, readLine() then scans it straight out of memory. A file from
+	// a .big archive that is mapped is scanned right where it is, without copying it
+	file = file->convertToRAMFile();
+	Int fileSize = file->size();
+	const char *data = file->getData();
+	if( data )
+	{
+		m_file = file;
+	}
+	else
+	{
+		m_fileData = file->readEntireAndClose();
+		data = m_fileData;
+	}
+	m_readPos = data;
+	m_readEnd = data + fileSize;
+	m_tokenPos = NULL;
 }
 
 //-------------------------------------------------------------------------------------------------
 //-------------------------------------------------------------------------------------------------
 void INI::unPrepFile()
 {
-	// close the file
-	m_file->close();
-	m_file = NULL;
+	// release the file contents
+	if( m_file )
+	{
+		m_file->close();
+		m_file = NULL;
+	}
+	delete [] m_fileData;
+	m_fileData = NULL;
+	m_readPos = NULL;
+	m_readEnd = NULL;
+	m_tokenPos = NULL;
 	m_filename = "None";
 	m_loadType = INI_LOAD_INVALID;
 	m_lineNum = 0;
@@ -362,7 +390,7 @@ void INI::load( AsciiString filename, INILoadType loadType, Xfer *pXfer )
 			AsciiString currentLine = m_buffer;
 
 			// the first word is the type of data we're processing
-			const char *token = strtok( m_buffer, m_seps );
+			const char *token = nextToken( m_buffer, m_seps );
 			if( token )
 			{
 				INIBlockParse parse = findBlockParse(token);
@@ -414,10 +442,9 @@ void INI::load( AsciiString filename, INILoadType loadType, Xfer *pXfer )
 //-------------------------------------------------------------------------------------------------
 void INI::readLine( void )
 {
-	bool isComment = FALSE;
 
 	// sanity
-	DEBUG_ASSERTCRASH( m_file, ("readLine(), file pointer is NULL\n") );
+	DEBUG_ASSERTCRASH( m_readPos, ("readLine(), file data is NULL\n") );
 
 	// if we've reached end of file we'll just keep returning empty string in our buffer
 	if( m_endOfFile )
@@ -426,66 +453,50 @@ void INI::readLine( void )
 	}
 	else
 	{
-		// read up till the newline character or until out of space
-		Int i = 0;
-		bool done = FALSE;
-		while( !done )
+		//
+		// find the end of the line with memchr() rather than looking at a character at a time,
+		// the line then is the newline included, all of the rest of the file, or as much as
+		// fits in our buffer
+		//
+		const Int maxLen = INI_MAX_CHARS_PER_LINE - 1;
+		Int avail = m_readEnd - m_readPos;
+		const char *line = m_readPos;
+		const char *newLine = (const char *)memchr( line, '\n', avail < maxLen ? avail : maxLen );
+		Int len;
+		if( newLine )
 		{
+			len = newLine - line + 1;
+		}
+		else if( avail < maxLen )
+		{
+			len = avail;
+			m_endOfFile = TRUE;
+		}
+		else
+		{
+			len = maxLen;
+			DEBUG_ASSERTCRASH( 0, ("Buffer too small (%d) and was truncated, increase INI_MAX_CHARS_PER_LINE\n", 
+														 INI_MAX_CHARS_PER_LINE) );
+		}
+		m_readPos += len;
 
-			// read character
-			m_endOfFile = (m_file->read(m_buffer + i, 1) == 0);
-
-			// check for end of file
-			if( m_endOfFile )
-			{
-		
-				done = TRUE;
-				m_buffer[ i ] = '\0';
-
-			}  // end if
-
-			// check for new line
-			if( m_buffer[ i ] == '\n' )
-				done = TRUE;
-
-			DEBUG_ASSERTCRASH(m_buffer[ i ] != '\t', ("tab characters are not allowed in INI files (%s). please check your editor settings. Line Number %d\n",m_filename.str(), getLineNum()));
-
-			// make all whitespace characters actual spaces
-			if( isspace( m_buffer[ i ] ) )
-				m_buffer[ i ] = ' ';
-
-			// if this is a semicolon, that represents the start of a comment
-			if( m_buffer[ i ] == ';' )
-				isComment = TRUE;
-
-			// if we've set the comment flag, just insert terminators in the place of each character read
-			if( isComment == TRUE )
-				m_buffer[ i ] = '\0';
-
-			//
-			// when we've become done, as the last thing just set the current index position + 1
-			// to the string terminator
-			//
-			if( done == TRUE && i + 1 < INI_MAX_CHARS_PER_LINE )
-				m_buffer[ i + 1 ] = '\0';
+		DEBUG_ASSERTCRASH(memchr( line, '\t', len ) == NULL, ("tab characters are not allowed in INI files (%s). please check your editor settings. Line Number %d\n",m_filename.str(), getLineNum()));
 
-			// increase our buffer index, but watch out for the max
-			if( ++i == INI_MAX_CHARS_PER_LINE )
-				done = TRUE;
+		// a semicolon represents the start of a comment, which we ignore up to the end of the line
+		const char *comment = (const char *)memchr( line, ';', len );
+		if( comment )
+			len = comment - line;
 
-		}  // end while
+		// copy the line, making all whitespace characters actual spaces ('\t' through '\r')
+		for( Int i = 0; i < len; ++i )
+		{
+			char c = line[ i ];
+			m_buffer[ i ] = ((UnsignedByte)(c - '\t') < 5) ? ' ' : c;
+		}
+		m_buffer[ len ] = '\0';
 
 		// increase our line count
 		m_lineNum++;
-
-		// check for at the max
-		if( i == INI_MAX_CHARS_PER_LINE )
-		{
-
-			DEBUG_ASSERTCRASH( 0, ("Buffer too small (%d) and was truncated, increase INI_MAX_CHARS_PER_LINE\n", 
-														 INI_MAX_CHARS_PER_LINE) );
-
-		}  // end if
 	}
 
 	if (s_xfer)
@@ -1489,7 +1500,7 @@ void INI::initFromINIMulti( void *what, const MultiIniFieldParse& parseTableList
 		readLine();
 
 		// check for end token
-		const char* field = strtok( m_buffer, INI::getSeps() );
+		const char* field = nextToken( m_buffer, INI::getSeps() );
 		if( field )
 		{
 
@@ -1558,7 +1569,7 @@ void INI::initFromINIMulti( void *what, const MultiIniFieldParse& parseTableList
 /*static*/ const char* INI::getNextToken(const char* seps)
 {
 	if (!seps) seps = getSeps();
-	const char *token = ::strtok(NULL, seps);
+	const char *token = nextToken(NULL, seps);
 	if (!token) 
 		throw INI_INVALID_DATA;
 	return token;
@@ -1568,10 +1579,43 @@ void INI::initFromINIMulti( void *what, const MultiIniFieldParse& parseTableList
 /*static*/ const char* INI::getNextTokenOrNull(const char* seps)
 {
 	if (!seps) seps = getSeps();
-	const char *token = ::strtok(NULL, seps);
+	const char *token = nextToken(NULL, seps);
 	return token;
 }
 
+//-------------------------------------------------------------------------------------------------
+/** Works like strtok() over m_buffer, but keeps its place in the line itself rather than in
+	* the one strtok() state shared by everyone else in the process */
+//-------------------------------------------------------------------------------------------------
+char *INI::nextToken( char *str, const char *seps )
+{
+	if( str == NULL )
+		str = m_tokenPos;
+	if( str == NULL )
+		return NULL;
+
+	// skip leading separators
+	str += strspn( str, seps );
+	if( *str == '\0' )
+	{
+		m_tokenPos = NULL;
+		return NULL;
+	}
+
+	// find the end of the token, and terminate it in place
+	char *end = str + strcspn( str, seps );
+	if( *end == '\0' )
+	{
+		m_tokenPos = NULL;
+	}
+	else
+	{
+		*end = '\0';
+		m_tokenPos = end + 1;
+	}
+	return str;
+}
+
 //-------------------------------------------------------------------------------------------------
 /*static*/ ScienceType INI::scanScience(const char* token)
 {
@@ -28,6 +28,8 @@
 
 #include "PreRTS.h"	// This must go first in EVERY cpp file int the GameEngine
 
+#include <new>
+
 #include "Common/MessageStream.h"
 #include "Common/Player.h"
 #include "Common/PlayerList.h"
@@ -39,6 +41,109 @@
 /// The singleton message stream for messages going to TheGameLogic
 MessageStream *TheMessageStream = NULL;
 CommandList *TheCommandList = NULL;
+GameMessageArena *TheGameMessageArena = NULL;
+
+
+//------------------------------------------------------------------------------------------------
+// GameMessageArena
+//
+
+/**
+ * Constructor
+ */
+GameMessageArena::GameMessageArena( void )
+{
+	m_firstChunk = NULL;
+	m_curChunk = NULL;
+	m_curOffset = 0;
+	m_liveMessages = 0;
+	m_rewindPending = FALSE;
+}
+
+/**
+ * Destructor
+ */
+GameMessageArena::~GameMessageArena()
+{
+	DEBUG_ASSERTCRASH(m_liveMessages == 0, ("%d frame messages still alive at arena shutdown", m_liveMessages));
+
+	Chunk *chunk, *nextChunk;
+	for( chunk = m_firstChunk; chunk; chunk = nextChunk )
+	{
+		nextChunk = chunk->m_next;
+		delete chunk;
+	}
+}
+
+/**
+ * Carve numBytes out of the current chunk, moving on to the next one (and allocating it
+ * if we have never been this far before) when it is full.
+ */
+void *GameMessageArena::allocate( Int numBytes )
+{
+	numBytes = (numBytes + 7) & ~7;
+	DEBUG_ASSERTCRASH(numBytes <= CHUNK_SIZE, ("frame allocation of %d bytes is too large", numBytes));
+
+	if (m_curChunk == NULL || m_curOffset + numBytes > CHUNK_SIZE)
+	{
+		Chunk *next = m_curChunk ? m_curChunk->m_next : m_firstChunk;
+		if (next == NULL)
+		{
+			next = MSGNEW("GameMessageArena") Chunk;
+			next->m_next = NULL;
+			if (m_curChunk)
+				m_curChunk->m_next = next;
+			else
+				m_firstChunk = next;
+		}
+		m_curChunk = next;
+		m_curOffset = 0;
+	}
+
+	void *p = m_curChunk->m_data + m_curOffset;
+	m_curOffset += numBytes;
+	return p;
+}
+
+/**
+ * A frame message has been destroyed
+ */
+void GameMessageArena::releaseMessage( void )
+{
+	DEBUG_ASSERTCRASH(m_liveMessages > 0, ("frame message released twice"));
+	--m_liveMessages;
+
+	if (m_liveMessages == 0 && m_rewindPending)
+		rewind();
+}
+
+/**
+ * Rewind the arena so the next frame reuses the same chunks. If anything still holds a
+ * frame message we must not hand its memory out again. Rather than grow the arena for as
+ * long as it is held, new messages come from the pool until the last old one is destroyed,
+ * and the arena rewinds then. Only arguments added to the survivors can take more chunks.
+ */
+void GameMessageArena::reset( void )
+{
+	if (m_liveMessages != 0)
+	{
+		DEBUG_LOG(("GameMessageArena::reset - %d frame messages still alive, rewinding when they are gone\n", m_liveMessages));
+		m_rewindPending = TRUE;
+		return;
+	}
+
+	rewind();
+}
+
+/**
+ * Hand the chunks out again from the start
+ */
+void GameMessageArena::rewind( void )
+{
+	m_curChunk = m_firstChunk;
+	m_curOffset = 0;
+	m_rewindPending = FALSE;
+}
 
 
 //------------------------------------------------------------------------------------------------
@@ -56,6 +161,7 @@ GameMessage::GameMessage( GameMessage::Type type )
 	m_argTail = NULL;
 	m_argCount = 0; 
 	m_list = 0; 
+	m_inFrameArena = FALSE;
 }
 
 
@@ -67,15 +173,76 @@ GameMessage::~GameMessage( )
 	// free all arguments
 	GameMessageArgument *arg, *nextArg;
 
-	for( arg = m_argList; arg; arg=nextArg )
+	// (arguments in the frame arena have nothing to tear down, and are reclaimed with it)
+	if (!m_inFrameArena)
 	{
-		nextArg = arg->m_next;
-		arg->deleteInstance();
+		for( arg = m_argList; arg; arg=nextArg )
+		{
+			nextArg = arg->m_next;
+			arg->deleteInstance();
+		}
 	}
 
 	// detach message from list
 	if (m_list)
 		m_list->removeMessage( this );
+
+	// (which may let the arena rewind, so last)
+	if (m_inFrameArena)
+		TheGameMessageArena->releaseMessage();
+}
+
+/**
+ * Create a message that will live in TheGameMessageArena. If there is no arena
+ * (tools, or before the engine is up) this is just an ordinary pool message.
+ */
+GameMessage *GameMessage::newFrameMessage( GameMessage::Type type )
+{
+	if (TheGameMessageArena == NULL || !TheGameMessageArena->isTakingMessages())
+		return newInstance(GameMessage)( type );
+
+	void *mem = TheGameMessageArena->allocate( sizeof(GameMessage) );
+	GameMessage *msg = ::new (mem) GameMessage( type );
+	msg->m_inFrameArena = TRUE;
+	TheGameMessageArena->addMessage();
+
+	return msg;
+}
+
+/**
+ * Where deleteInstance() returns our memory. Frame messages only have their destructor
+ * run, since their memory goes back to the arena as a whole.
+ */
+MemoryPool *GameMessage::getInstanceMemoryPool( void )
+{
+	return m_inFrameArena ? NULL : getObjectMemoryPool();
+}
+
+/**
+ * Copy a frame message into pool memory so it may outlive the frame. The copy takes the
+ * original's place in its list and the original is destroyed. Returns the message to use.
+ */
+GameMessage *GameMessage::promote( void )
+{
+	if (!m_inFrameArena)
+		return this;
+
+	GameMessage *msg = newInstance(GameMessage)( m_type );
+	msg->m_playerIndex = m_playerIndex;
+
+	for( GameMessageArgument *a = m_argList; a; a = a->m_next )
+	{
+		GameMessageArgument *arg = msg->allocArg();
+		arg->m_data = a->m_data;
+		arg->m_type = a->m_type;
+	}
+
+	if (m_list)
+		m_list->insertMessage( msg, this );
+
+	deleteInstance();
+
+	return msg;
 }
 
 /**
@@ -120,7 +287,11 @@ GameMessageArgumentDataType GameMessage::getArgumentDataType( Int argIndex )
 GameMessageArgument *GameMessage::allocArg( void ) 
 { 
 	// allocate a new argument
-	GameMessageArgument *arg = newInstance(GameMessageArgument); 
+	GameMessageArgument *arg;
+	if (m_inFrameArena)
+		arg = ::new (TheGameMessageArena->allocate( sizeof(GameMessageArgument) )) GameMessageArgument;
+	else
+		arg = newInstance(GameMessageArgument); 
 
 	// add to end of argument list
 	if (m_argTail)
@@ -816,7 +987,7 @@ void MessageStream::update( void )
  */
 GameMessage *MessageStream::appendMessage( GameMessage::Type type )
 {
-	GameMessage *msg = newInstance(GameMessage)( type );
+	GameMessage *msg = GameMessage::newFrameMessage( type );
 
 	// add message to list
 	GameMessageList::appendMessage( msg );
@@ -830,7 +1001,7 @@ GameMessage *MessageStream::appendMessage( GameMessage::Type type )
  */
 GameMessage *MessageStream::insertMessage( GameMessage::Type type, GameMessage *messageToInsertAfter )
 {
-	GameMessage *msg = newInstance(GameMessage)(type);
+	GameMessage *msg = GameMessage::newFrameMessage( type );
 
 	GameMessageList::insertMessage(msg, messageToInsertAfter);
 
@@ -1069,6 +1240,22 @@ void MessageStream::propagateMessages( void )
 
 }
 
+/**
+ * Messages appended to the stream after it was propagated this frame (eg, by the logic)
+ * won't be seen until next frame, so they must not stay in the frame arena when it is
+ * rewound. Copy them out to pool memory.
+ */
+void MessageStream::promoteMessages( void )
+{
+	GameMessage *msg, *next;
+
+	for( msg=m_firstMessage; msg; msg=next )
+	{
+		next = msg->next();
+		msg->promote();
+	}
+}
+
 
 //------------------------------------------------------------------------------------------------
 // CommandList
@@ -203,6 +203,18 @@ void dumpBattlePlanBonuses(const BattlePlanBonuses *b, AsciiString name, const P
 #define CRCDUMPBATTLEPLANBONUSES(x,y,z) {}
 #endif // DEBUG_CRC
 
+// ------------------------------------------------------------------------------------------------
+/** Player::crc goes into the player list's cached CRC, so whatever changes what it reads
+	must call this */
+// ------------------------------------------------------------------------------------------------
+static void invalidatePlayerCRC( void )
+{
+
+	if( ThePlayerList )
+		ThePlayerList->invalidateCRC();
+
+}  // end invalidatePlayerCRC
+
 // ------------------------------------------------------------------------------------------------
 // ------------------------------------------------------------------------------------------------
 PlayerRelationMap::PlayerRelationMap( void )
@@ -378,6 +390,7 @@ void Player::init(const PlayerTemplate* pt)
 		m_battlePlanBonuses->deleteInstance();
 		m_battlePlanBonuses = NULL;
 	}
+	invalidatePlayerCRC();
 
 	deleteUpgradeList();
 
@@ -2076,6 +2089,7 @@ bool Player::addSkillPoints(Int delta)
 
 	bool levelGained = FALSE;
 	m_skillPoints = min( pointCap, (m_skillPoints + delta) );
+	invalidatePlayerCRC();
 	while( m_skillPoints >= m_levelUp )
 	{
 		// LevelUp gets increased as a side effect of setRankLevel, and this won't infinitely loop,
@@ -2189,6 +2203,7 @@ void Player::addSciencePurchasePoints(Int delta)
 	m_sciencePurchasePoints += delta;
 	if (m_sciencePurchasePoints < 0)
 		m_sciencePurchasePoints = 0;
+	invalidatePlayerCRC();
 
 	if (oldSPP != m_sciencePurchasePoints && TheControlBar != NULL)
 		TheControlBar->onPlayerSciencePurchasePointsChanged(this);
@@ -2267,6 +2282,7 @@ void Player::resetRank()
 	m_sciencePurchasePoints = getPlayerTemplate() ? getPlayerTemplate()->getIntrinsicSciencePurchasePoints() : 0;
 	const RankInfo* curRank = TheRankInfoStore->getRankInfo(m_rankLevel);
 	m_sciencePurchasePoints += curRank ? curRank->m_sciencePurchasePointsGranted : 0;
+	invalidatePlayerCRC();
 	m_generalName = TheGameText? TheGameText->fetch("SCIENCE:GeneralName"):UnicodeString::TheEmptyString;
 	resetSciences();
 }
@@ -2310,6 +2326,7 @@ bool Player::setRankLevel(Int newLevel)
 
 			if (m_skillPoints < rank->m_skillPointsNeeded)
 				m_skillPoints = rank->m_skillPointsNeeded;
+			invalidatePlayerCRC();
 
 			for (ScienceVec::const_iterator it = rank->m_sciencesGranted.begin(); it != rank->m_sciencesGranted.end(); ++it)
 			{
@@ -3131,6 +3148,7 @@ void Player::removeBattlePlanBonusesForObject( Object *obj ) const
 void Player::applyBattlePlanBonusesForPlayerObjects( const BattlePlanBonuses *bonus )
 {
 	DUMPBATTLEPLANBONUSES(bonus, this, NULL);
+	invalidatePlayerCRC();
 
 	//Only allocate the battle plan bonuses if we actually use it!
 	if( !m_battlePlanBonuses )
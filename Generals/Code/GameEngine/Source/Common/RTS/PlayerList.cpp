@@ -234,6 +234,8 @@ void PlayerList::newGame()
 		p->setDefaultTeam();
 	}
 
+	invalidateCRC();
+
 }
 
 //-----------------------------------------------------------------------------
@@ -248,6 +250,8 @@ void PlayerList::init()
 	// call setLocalPlayer so that becomingLocalPlayer() gets called appropriately
 	setLocalPlayer(m_players[0]);
 
+	invalidateCRC();
+
 }
 
 //-----------------------------------------------------------------------------
@@ -482,6 +486,9 @@ void PlayerList::xfer( Xfer *xfer )
 	for( Int i = 0; i < playerCount; ++i )
 		xfer->xferSnapshot( m_players[ i ] );
 
+	if( xfer->getXferMode() == XFER_LOAD )
+		invalidateCRC();
+
 }  // end xfer
 
 // ------------------------------------------------------------------------------------------------
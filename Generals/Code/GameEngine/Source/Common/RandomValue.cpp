@@ -153,6 +153,20 @@ UnsignedInt GetGameLogicRandomSeedCRC( void )
 	return c.get();
 }
 
+void GetGameLogicRandomState( UnsignedInt seed[6], UnsignedInt *baseSeed )
+{
+	for( Int i = 0; i < 6; ++i )
+		seed[i] = theGameLogicSeed[i];
+	*baseSeed = theGameLogicBaseSeed;
+}
+
+void SetGameLogicRandomState( const UnsignedInt seed[6], UnsignedInt baseSeed )
+{
+	for( Int i = 0; i < 6; ++i )
+		theGameLogicSeed[i] = seed[i];
+	theGameLogicBaseSeed = baseSeed;
+}
+
 void InitRandom( void )
 {
 #ifdef DETERMINISTIC
@@ -30,6 +30,7 @@
 #include "Common/Player.h"
 #include "Common/GlobalData.h"
 #include "Common/GameEngine.h"
+#include "Common/GameState.h"
 #include "GameClient/ClientInstance.h"
 #include "GameClient/GameWindow.h"
 #include "GameClient/GameWindowManager.h"
@@ -56,6 +57,18 @@ Int REPLAY_CRC_INTERVAL = 100;
 
 const char *replayExtention = ".rep";
 const char *lastReplayFileName = "00000000";	// a name the user is unlikely to ever type, but won't cause panic & confusion
+const char *replayIndexExtention = ".rpx";
+
+// The keyframe index (<replay>.rpx) is:
+//   "GENRPX", version, size of the replay it indexes, keyframe interval, table offset, keyframe count,
+//   the data of each keyframe, then the table of ReplayKeyframes.
+// The table offset stays 0 until the index is closed, so an index that was never finished is ignored.
+// The data of a keyframe is the logic random state, the replay CRC queue and a save game, because
+// neither of the first two is part of a save game. The table has the game logic CRC at each keyframe,
+// so a restored keyframe can be checked against the game it was taken from.
+static const UnsignedInt replayIndexVersion = 2;
+static const UnsignedInt replayIndexTableOffset = 6 + 3*sizeof(UnsignedInt);
+static const char *keyframeSaveFileName = "ReplayKeyframe.tmp";	// in the save directory, where GameState wants it
 
 // TheSuperHackers @tweak helmutbuhler 25/04/2025
 // The replay header contains two time fields; startTime and endTime of type time_t.
@@ -374,6 +387,15 @@ RecorderClass::RecorderClass()
 	m_nextFrame = 0;
 	m_wasDesync = FALSE;
 	//
+	m_crcInfo = NULL;
+	m_indexFile = NULL;
+	m_indexWriting = FALSE;
+	m_restoringKeyframe = FALSE;
+	m_seekFrame = 0;
+	m_seekPending = FALSE;
+	m_seekStartTime = 0;
+	m_lastCRCMatchFrame = 0;
+	m_crcMismatchFrame = 0;
 
 	init(); // just for the heck of it.
 }
@@ -406,12 +428,22 @@ void RecorderClass::init() {
 	m_gameInfo.setSeed(GetGameLogicRandomSeed());
 	m_wasDesync = FALSE;
 	m_doingAnalysis = FALSE;
+	m_indexFile = NULL;
+	m_indexWriting = FALSE;
+	m_keyframes.clear();
+	m_seekFrame = 0;
+	m_seekPending = FALSE;
 }
 
 /**
  * Reset the recorder to the "initialized state."
  */
 void RecorderClass::reset() {
+	// restoring a keyframe resets the whole engine underneath the playback; carry on regardless
+	if (m_restoringKeyframe)
+		return;
+
+	closeReplayIndex();
 	if (m_file != NULL) {
 		fclose(m_file);
 		m_file = NULL;
@@ -460,6 +492,7 @@ void RecorderClass::updatePlayback() {
  * reaching the end of the playback file.
  */
 void RecorderClass::stopPlayback() {
+	closeReplayIndex();
 	if (m_file != NULL) {
 		fclose(m_file);
 		m_file = NULL;
@@ -925,6 +958,14 @@ AsciiString RecorderClass::getCurrentReplayFilename( void )
 	return AsciiString::TheEmptyString;
 }
 
+/**
+ * Return true while a file is being played back and not all of its commands have been executed yet.
+ */
+bool RecorderClass::isPlaybackInProgress( void )
+{
+	return m_mode == RECORDERMODETYPE_PLAYBACK && m_nextFrame != -1;
+}
+
 // TheSuperHackers @info helmutbuhler 03/04/2025
 // Some info about CRC:
 // In each game, each peer periodically calculates a CRC from the local gamestate and sends that
@@ -954,6 +995,11 @@ public:
 	void setSawCRCMismatch(void) { m_sawCRCMismatch = TRUE; }
 	bool sawCRCMismatch(void) { return m_sawCRCMismatch; }
 
+	// for replay keyframes
+	void setSkippedOne(bool skippedOne) { m_skippedOne = skippedOne; }
+	bool skippedOne(void) const { return m_skippedOne; }
+	const std::list<UnsignedInt>& getQueue(void) const { return m_data; }
+
 protected:
 
 	bool m_sawCRCMismatch;
@@ -1000,6 +1046,14 @@ UnsignedInt CRCInfo::readCRC(void)
 	return val;
 }
 
+/**
+ * Return true if a CRC from the file being played back didn't match ours.
+ */
+bool RecorderClass::sawCRCMismatch( void )
+{
+	return m_crcInfo != NULL && m_crcInfo->sawCRCMismatch();
+}
+
 void RecorderClass::handleCRCMessage(UnsignedInt newCRC, Int playerIndex, bool fromPlayback)
 {
 	if (fromPlayback)
@@ -1021,9 +1075,22 @@ void RecorderClass::handleCRCMessage(UnsignedInt newCRC, Int playerIndex, bool f
 		UnsignedInt playbackCRC = m_crcInfo->readCRC();
 		//DEBUG_LOG(("RecorderClass::handleCRCMessage() - Comparing CRCs of InGame:%8.8X Replay:%8.8X Frame:%d from Player %d\n",
 		//	playbackCRC, newCRC, TheGameLogic->getFrame()-m_crcInfo->GetQueueSize()-1, playerIndex));
+		if (TheGameLogic->getFrame() > 0 && newCRC == playbackCRC && !m_crcInfo->sawCRCMismatch())
+		{
+			m_lastCRCMatchFrame = TheGameLogic->getFrame()-m_crcInfo->GetQueueSize()-1;
+		}
 		if (TheGameLogic->getFrame() > 0 && newCRC != playbackCRC && !m_crcInfo->sawCRCMismatch())
 		{
 			m_crcInfo->setSawCRCMismatch();
+			m_crcMismatchFrame = TheGameLogic->getFrame()-m_crcInfo->GetQueueSize()-1;
+
+			if (TheGlobalData->m_headless)
+			{
+				// nobody is watching a headless simulation, so don't stop it; the replay report says it desynced.
+				DEBUG_LOG(("Replay has gone out of sync!  InGame:%8.8X Replay:%8.8X Frame:%d\n",
+					playbackCRC, newCRC, TheGameLogic->getFrame()-m_crcInfo->GetQueueSize()-1));
+				return;
+			}
 
 			// Since we don't seem to have any *visible* desyncs when replaying games, but get this warning
 			// virtually every replay, the assumption is our CRC checking is faulty.  Since we're at the
@@ -1155,6 +1222,8 @@ bool RecorderClass::playbackFile(AsciiString filename)
 
 	bool isMultiplayer = m_gameInfo.getSlot(header.localPlayerIndex)->getIP() != 0;
 	m_crcInfo = NEW CRCInfo(header.localPlayerIndex, isMultiplayer);
+	m_lastCRCMatchFrame = 0;
+	m_crcMismatchFrame = 0;
 	REPLAY_CRC_INTERVAL = m_gameInfo.getCRCInterval();
 	DEBUG_LOG(("Player index is %d, replay CRC interval is %d\n", m_crcInfo->getLocalPlayer(), REPLAY_CRC_INTERVAL));
 
@@ -1176,6 +1245,8 @@ bool RecorderClass::playbackFile(AsciiString filename)
 	// Otherwise a crc message remains and messes up the crc calculation on the restarted replay.
 	TheCommandList->reset();
 
+	openReplayIndex(filename);
+
 	readNextFrame();
 
 	// send a message to the logic for a new game
@@ -1192,6 +1263,403 @@ bool RecorderClass::playbackFile(AsciiString filename)
 	}
 
 	m_currentReplayFilename = filename;
+
+	// the game has to be under way before a keyframe can be restored over it; see updateKeyframes()
+	if (!m_doingAnalysis && TheGlobalData->m_replaySeekFrame > 0)
+	{
+		m_seekFrame = TheGlobalData->m_replaySeekFrame;
+		m_seekPending = TRUE;
+		m_seekStartTime = timeGetTime();
+	}
+	return TRUE;
+}
+
+/**
+ * Return the path of the keyframe index for the given replay: the replay's path with a different extension.
+ */
+AsciiString RecorderClass::getReplayIndexPath(AsciiString filename)
+{
+	AsciiString path = getReplayDir();
+	path.concat(filename);
+	if (path.endsWithNoCase(replayExtention))
+	{
+		for (Int i = strlen(replayExtention); i > 0; --i)
+			path.removeLastChar();
+	}
+	path.concat(replayIndexExtention);
+	return path;
+}
+
+/**
+ * Open the keyframe index for the replay we are about to play back. With -replayKeyframes we (re)write it
+ * as we go, otherwise we read the keyframe table of an existing one, if it matches this replay.
+ */
+void RecorderClass::openReplayIndex(AsciiString filename)
+{
+	closeReplayIndex();
+	m_keyframes.clear();
+
+	if (m_doingAnalysis || m_file == NULL)
+		return;
+
+	// the index only goes with the replay it was made from
+	Int filePos = ftell(m_file);
+	fseek(m_file, 0, SEEK_END);
+	UnsignedInt replaySize = ftell(m_file);
+	fseek(m_file, filePos, SEEK_SET);
+
+	AsciiString indexPath = getReplayIndexPath(filename);
+	UnsignedInt interval = TheGlobalData->m_replayKeyframeInterval;
+	UnsignedInt tableOffset = 0;
+	UnsignedInt count = 0;
+
+	if (interval > 0)
+	{
+		m_indexFile = fopen(indexPath.str(), "wb");
+		if (m_indexFile == NULL)
+		{
+			DEBUG_LOG(("RecorderClass::openReplayIndex - could not create %s\n", indexPath.str()));
+			return;
+		}
+		m_indexWriting = TRUE;
+
+		fprintf(m_indexFile, "GENRPX");
+		fwrite(&replayIndexVersion, sizeof(UnsignedInt), 1, m_indexFile);
+		fwrite(&replaySize, sizeof(UnsignedInt), 1, m_indexFile);
+		fwrite(&interval, sizeof(UnsignedInt), 1, m_indexFile);
+		fwrite(&tableOffset, sizeof(UnsignedInt), 1, m_indexFile);	// filled in by closeReplayIndex()
+		fwrite(&count, sizeof(UnsignedInt), 1, m_indexFile);
+		DEBUG_LOG(("RecorderClass::openReplayIndex - writing a keyframe every %d frames to %s\n", interval, indexPath.str()));
+		return;
+	}
+
+	m_indexFile = fopen(indexPath.str(), "rb");
+	if (m_indexFile == NULL)
+		return;
+
+	char genrpx[7];
+	UnsignedInt version = 0;
+	UnsignedInt indexedSize = 0;
+	genrpx[6] = 0;
+	fread(genrpx, sizeof(char), 6, m_indexFile);
+	fread(&version, sizeof(UnsignedInt), 1, m_indexFile);
+	fread(&indexedSize, sizeof(UnsignedInt), 1, m_indexFile);
+	fread(&interval, sizeof(UnsignedInt), 1, m_indexFile);
+	fread(&tableOffset, sizeof(UnsignedInt), 1, m_indexFile);
+	fread(&count, sizeof(UnsignedInt), 1, m_indexFile);
+
+	if (strncmp(genrpx, "GENRPX", 6) || version != replayIndexVersion || indexedSize != replaySize || tableOffset == 0 ||
+			fseek(m_indexFile, tableOffset, SEEK_SET))
+	{
+		DEBUG_LOG(("RecorderClass::openReplayIndex - %s is unfinished or does not belong to this replay\n", indexPath.str()));
+		closeReplayIndex();
+		return;
+	}
+
+	m_keyframes.resize(count);
+	if (count > 0 && fread(&m_keyframes[0], sizeof(ReplayKeyframe), count, m_indexFile) != count)
+	{
+		DEBUG_LOG(("RecorderClass::openReplayIndex - %s is truncated\n", indexPath.str()));
+		m_keyframes.clear();
+		closeReplayIndex();
+		return;
+	}
+	DEBUG_LOG(("RecorderClass::openReplayIndex - %d keyframes in %s\n", count, indexPath.str()));
+}
+
+/**
+ * Close the keyframe index. If we were writing it, append the keyframe table and point the header at it;
+ * this also happens when playback is abandoned part way, which leaves a perfectly good (shorter) index.
+ */
+void RecorderClass::closeReplayIndex()
+{
+	if (m_indexFile == NULL)
+		return;
+
+	if (m_indexWriting)
+	{
+		UnsignedInt tableOffset = ftell(m_indexFile);
+		UnsignedInt count = m_keyframes.size();
+		if (count > 0)
+			fwrite(&m_keyframes[0], sizeof(ReplayKeyframe), count, m_indexFile);
+
+		fseek(m_indexFile, replayIndexTableOffset, SEEK_SET);
+		fwrite(&tableOffset, sizeof(UnsignedInt), 1, m_indexFile);
+		fwrite(&count, sizeof(UnsignedInt), 1, m_indexFile);
+		DEBUG_LOG(("RecorderClass::closeReplayIndex - wrote %d keyframes\n", count));
+	}
+
+	fclose(m_indexFile);
+	m_indexFile = NULL;
+	m_indexWriting = FALSE;
+}
+
+/**
+ * Called by the engine between logic frames, which is the only time the game can be saved or loaded.
+ */
+void RecorderClass::updateKeyframes()
+{
+	if (m_mode != RECORDERMODETYPE_PLAYBACK || m_file == NULL || !TheGameLogic->isInGame())
+		return;
+
+	// frame 0 is still setting the game up
+	UnsignedInt frame = TheGameLogic->getFrame();
+	if (frame == 0)
+		return;
+
+	if (m_seekPending)
+	{
+		m_seekPending = FALSE;
+		if (seekToFrame(m_seekFrame))
+			frame = TheGameLogic->getFrame();
+	}
+
+	if (m_seekFrame > 0 && frame >= m_seekFrame)
+	{
+		DEBUG_LOG(("RecorderClass::updateKeyframes - reached frame %d in %d ms\n", frame, timeGetTime() - m_seekStartTime));
+		m_seekFrame = 0;
+		if (TheGlobalData->m_replaySeekBenchmark)
+			TheGameEngine->setQuitting(TRUE);
+	}
+
+	// once the last command is read there is nothing left to resume
+	if (m_indexWriting && m_nextFrame != (UnsignedInt)-1 && (frame % TheGlobalData->m_replayKeyframeInterval) == 0 &&
+			(m_keyframes.empty() || m_keyframes.back().frame != frame))
+	{
+		writeKeyframe();
+	}
+}
+
+/**
+ * Snapshot the game into the keyframe index. The logic is between frames, so the recorder has already
+ * read the frame of the next command in the replay; the keyframe points at that command.
+ */
+void RecorderClass::writeKeyframe()
+{
+	ReplayKeyframe keyframe;
+	keyframe.frame = TheGameLogic->getFrame();
+	keyframe.replayOffset = ftell(m_file) - sizeof(m_nextFrame);
+	keyframe.dataOffset = ftell(m_indexFile);
+	keyframe.logicCRC = TheGameLogic->getCRC(CRC_RECALC);
+
+	// the logic random state is not part of a save game
+	UnsignedInt seed[6];
+	UnsignedInt baseSeed;
+	GetGameLogicRandomState(seed, &baseSeed);
+	fwrite(seed, sizeof(UnsignedInt), 6, m_indexFile);
+	fwrite(&baseSeed, sizeof(UnsignedInt), 1, m_indexFile);
+
+	// neither are the CRCs we computed but have not matched against the replay yet. That includes the
+	// ones the logic sent last frame which are still waiting on TheCommandList.
+	bool skippedOne = m_crcInfo->skippedOne();
+	bool sawMismatch = m_crcInfo->sawCRCMismatch();
+	fwrite(&skippedOne, sizeof(bool), 1, m_indexFile);
+	fwrite(&sawMismatch, sizeof(bool), 1, m_indexFile);
+
+	const std::list<UnsignedInt>& queue = m_crcInfo->getQueue();
+	UnsignedInt count = queue.size();
+	fwrite(&count, sizeof(UnsignedInt), 1, m_indexFile);
+	for (std::list<UnsignedInt>::const_iterator it = queue.begin(); it != queue.end(); ++it)
+	{
+		UnsignedInt crc = *it;
+		fwrite(&crc, sizeof(UnsignedInt), 1, m_indexFile);
+	}
+
+	std::vector<UnsignedInt> pending;
+	for (GameMessage *msg = TheCommandList->getFirstMessage(); msg; msg = msg->next())
+	{
+		if (msg->getType() == GameMessage::MSG_LOGIC_CRC && msg->getArgument(1)->boolean)
+			pending.push_back(msg->getArgument(0)->integer);
+	}
+	count = pending.size();
+	fwrite(&count, sizeof(UnsignedInt), 1, m_indexFile);
+	if (count > 0)
+		fwrite(&pending[0], sizeof(UnsignedInt), count, m_indexFile);
+
+	// and then the game itself
+	AsciiString savePath = TheGameState->getFilePathInSaveDirectory(keyframeSaveFileName);
+	UnsignedInt saveSize = 0;
+	FILE *fp = NULL;
+	if (TheGameState->saveGame(keyframeSaveFileName, UnicodeString::TheEmptyString, SAVE_FILE_TYPE_NORMAL, SNAPSHOT_SAVELOAD, TRUE) == SC_OK)
+		fp = fopen(savePath.str(), "rb");
+	if (fp)
+	{
+		fseek(fp, 0, SEEK_END);
+		saveSize = ftell(fp);
+		fseek(fp, 0, SEEK_SET);
+	}
+	fwrite(&saveSize, sizeof(UnsignedInt), 1, m_indexFile);
+	if (fp)
+	{
+		char buf[4096];
+		Int len;
+		while ( (len=fread(buf, 1, 4096, fp)) > 0 )
+		{
+			fwrite(buf, 1, len, m_indexFile);
+		}
+		fclose(fp);
+		fp = NULL;
+	}
+	DeleteFile(savePath.str());
+
+	keyframe.dataSize = ftell(m_indexFile) - keyframe.dataOffset;
+	if (saveSize == 0)
+	{
+		// leave the junk in the file, it's unreachable without a table entry
+		DEBUG_LOG(("RecorderClass::writeKeyframe - could not save frame %d\n", keyframe.frame));
+		return;
+	}
+	m_keyframes.push_back(keyframe);
+	fflush(m_indexFile);
+}
+
+/**
+ * Restore the latest keyframe at or before the given frame. When simulating forward from where we
+ * are is no more work than that, don't bother and return FALSE.
+ */
+bool RecorderClass::seekToFrame(UnsignedInt frame)
+{
+	if (m_mode != RECORDERMODETYPE_PLAYBACK || m_file == NULL || m_indexFile == NULL || m_indexWriting)
+		return FALSE;
+
+	const ReplayKeyframe *best = NULL;
+	for (ReplayKeyframeVec::const_iterator it = m_keyframes.begin(); it != m_keyframes.end(); ++it)
+	{
+		if (it->frame <= frame && (best == NULL || it->frame > best->frame))
+			best = &(*it);
+	}
+	if (best == NULL)
+	{
+		DEBUG_LOG(("RecorderClass::seekToFrame - no keyframe at or before frame %d\n", frame));
+		return FALSE;
+	}
+
+	UnsignedInt curFrame = TheGameLogic->getFrame();
+	if (curFrame <= frame && best->frame <= curFrame)
+		return FALSE;
+
+	ReplayKeyframe keyframe = *best;
+	return restoreKeyframe(keyframe);
+}
+
+/**
+ * Load the given keyframe and reposition the playback to match it.
+ */
+bool RecorderClass::restoreKeyframe(const ReplayKeyframe& keyframe)
+{
+	if (fseek(m_indexFile, keyframe.dataOffset, SEEK_SET))
+		return FALSE;
+
+	UnsignedInt seed[6];
+	UnsignedInt baseSeed = 0;
+	fread(seed, sizeof(UnsignedInt), 6, m_indexFile);
+	fread(&baseSeed, sizeof(UnsignedInt), 1, m_indexFile);
+
+	bool skippedOne = FALSE;
+	bool sawMismatch = FALSE;
+	fread(&skippedOne, sizeof(bool), 1, m_indexFile);
+	fread(&sawMismatch, sizeof(bool), 1, m_indexFile);
+
+	UnsignedInt count = 0;
+	fread(&count, sizeof(UnsignedInt), 1, m_indexFile);
+	std::vector<UnsignedInt> queue(count);
+	if (count > 0)
+		fread(&queue[0], sizeof(UnsignedInt), count, m_indexFile);
+
+	count = 0;
+	fread(&count, sizeof(UnsignedInt), 1, m_indexFile);
+	std::vector<UnsignedInt> pending(count);
+	if (count > 0)
+		fread(&pending[0], sizeof(UnsignedInt), count, m_indexFile);
+
+	// GameState loads from the save directory, so put the save back there
+	UnsignedInt saveSize = 0;
+	fread(&saveSize, sizeof(UnsignedInt), 1, m_indexFile);
+	AsciiString savePath = TheGameState->getFilePathInSaveDirectory(keyframeSaveFileName);
+	FILE *fp = saveSize ? fopen(savePath.str(), "wb") : NULL;
+	if (fp == NULL)
+	{
+		DEBUG_LOG(("RecorderClass::restoreKeyframe - could not extract the keyframe for frame %d\n", keyframe.frame));
+		return FALSE;
+	}
+	char buf[4096];
+	UnsignedInt left = saveSize;
+	while (left > 0)
+	{
+		Int len = fread(buf, 1, min(left, (UnsignedInt)sizeof(buf)), m_indexFile);
+		if (len <= 0)
+			break;
+		fwrite(buf, 1, len, fp);
+		left -= len;
+	}
+	fclose(fp);
+	fp = NULL;
+	if (left > 0)
+	{
+		DEBUG_LOG(("RecorderClass::restoreKeyframe - the keyframe for frame %d is truncated\n", keyframe.frame));
+		DeleteFile(savePath.str());
+		return FALSE;
+	}
+
+	AvailableGameInfo gameInfo;
+	gameInfo.filename = keyframeSaveFileName;
+	gameInfo.saveGameInfo.saveFileType = SAVE_FILE_TYPE_NORMAL;
+	gameInfo.next = NULL;
+	gameInfo.prev = NULL;
+
+	// nothing queued for the frame we are leaving may reach the frame we load
+	TheCommandList->reset();
+
+	m_restoringKeyframe = TRUE;
+	SaveCode code = TheGameState->loadGame(gameInfo);
+	m_restoringKeyframe = FALSE;
+	DeleteFile(savePath.str());
+
+	if (code != SC_OK)
+	{
+		DEBUG_LOG(("RecorderClass::restoreKeyframe - loading the keyframe for frame %d failed (%d)\n", keyframe.frame, code));
+		stopPlayback();
+		return FALSE;
+	}
+	DEBUG_ASSERTCRASH(TheGameLogic->getFrame() == keyframe.frame, ("Keyframe for frame %d loaded frame %d", keyframe.frame, TheGameLogic->getFrame()));
+
+	SetGameLogicRandomState(seed, baseSeed);
+
+	// the restored game has to be the one the keyframe was taken from, or the rest of the playback is
+	// not the replay anymore
+	UnsignedInt logicCRC = TheGameLogic->getCRC(CRC_RECALC);
+	if (logicCRC != keyframe.logicCRC)
+	{
+		if (TheGlobalData->m_headless)
+		{
+			DEBUG_LOG(("Keyframe for frame %d restored out of sync!  Restored:%8.8X Keyframe:%8.8X\n",
+				keyframe.frame, logicCRC, keyframe.logicCRC));
+		}
+		else
+		{
+			DEBUG_CRASH(("Keyframe for frame %d restored out of sync!  Restored:%8.8X Keyframe:%8.8X",
+				keyframe.frame, logicCRC, keyframe.logicCRC));
+		}
+		sawMismatch = TRUE;
+		if (m_crcMismatchFrame == 0)
+			m_crcMismatchFrame = keyframe.frame;
+	}
+
+	UnsignedInt localPlayer = m_crcInfo->getLocalPlayer();
+	delete m_crcInfo;
+	m_crcInfo = NEW CRCInfo(localPlayer, TRUE);
+	m_crcInfo->setSkippedOne(skippedOne);
+	if (sawMismatch)
+		m_crcInfo->setSawCRCMismatch();
+	for (std::vector<UnsignedInt>::const_iterator it = queue.begin(); it != queue.end(); ++it)
+		m_crcInfo->addCRC(*it);
+	for (std::vector<UnsignedInt>::const_iterator it = pending.begin(); it != pending.end(); ++it)
+		m_crcInfo->addCRC(*it);
+
+	fseek(m_file, keyframe.replayOffset, SEEK_SET);
+	readNextFrame();
+
+	DEBUG_LOG(("RecorderClass::restoreKeyframe - resumed playback at frame %d\n", keyframe.frame));
 	return TRUE;
 }
 
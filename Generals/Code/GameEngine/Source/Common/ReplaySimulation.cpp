@@ -0,0 +1,488 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "PreRTS.h"
+#include "Common/ReplaySimulation.h"
+
+#include "Common/FileSystem.h"
+#include "Common/GameEngine.h"
+#include "Common/GlobalData.h"
+#include "Common/Player.h"
+#include "Common/PlayerList.h"
+#include "Common/Recorder.h"
+#include "GameLogic/GameLogic.h"
+
+static const char *resultNames[] = { "ok", "mismatch", "failed" };
+
+// The CRCs of one logic frame, as written to the report.
+struct FrameCRC
+{
+	UnsignedInt frame;
+	UnsignedInt crc;
+	UnsignedInt sections[CRC_SECTION_COUNT];	///< running CRC after each MARKER: section
+};
+typedef std::vector<FrameCRC> FrameCRCVec;
+
+//-------------------------------------------------------------------------------------------------
+static void writeFrameCRC(FILE *report, const FrameCRC &crc)
+{
+	fprintf(report, "frame %d crc %8.8X", crc.frame, crc.crc);
+	for (Int i = 0; i < CRC_SECTION_COUNT; ++i)
+		fprintf(report, " %s %8.8X", TheCRCSectionNames[i], crc.sections[i]);
+	fprintf(report, "\n");
+}
+
+//-------------------------------------------------------------------------------------------------
+static bool parseFrameCRC(const char *line, FrameCRC &crc)
+{
+	Int used = 0;
+	if (sscanf(line, "frame %u crc %x%n", &crc.frame, &crc.crc, &used) != 2)
+		return FALSE;
+
+	for (Int i = 0; i < CRC_SECTION_COUNT; ++i)
+	{
+		line += used;
+		char name[64];
+		if (sscanf(line, " %63s %x%n", name, &crc.sections[i], &used) != 2)
+			return FALSE;
+		// a report from a build with different sections can't be compared section by section
+		if (strcmp(name, TheCRCSectionNames[i]) != 0)
+			return FALSE;
+	}
+	return TRUE;
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Read the frame CRCs recorded for one replay from the report of another run. */
+//-------------------------------------------------------------------------------------------------
+static bool readReferenceCRCs(const AsciiString &referencePath, const AsciiString &filename, FrameCRCVec &crcs)
+{
+	FILE *fp = fopen(referencePath.str(), "r");
+	if (fp == NULL)
+		return FALSE;
+
+	bool found = FALSE;
+	bool inReplay = FALSE;
+	char line[1024];
+	while (fgets(line, sizeof(line), fp))
+	{
+		if (strncmp(line, "replay ", 7) == 0)
+		{
+			// a report may hold the same replay more than once; use the first
+			if (found)
+				break;
+
+			AsciiString name = line + 7;
+			name.trim();
+			inReplay = (name.compareNoCase(filename) == 0);
+			found = inReplay;
+			continue;
+		}
+
+		FrameCRC crc;
+		if (inReplay && parseFrameCRC(line, crc))
+			crcs.push_back(crc);
+	}
+
+	fclose(fp);
+	return found && !crcs.empty();
+}
+
+//-------------------------------------------------------------------------------------------------
+static const FrameCRC *findFrameCRC(const FrameCRCVec &crcs, UnsignedInt frame)
+{
+	// frames are in increasing order
+	Int lo = 0;
+	Int hi = (Int)crcs.size() - 1;
+	while (lo <= hi)
+	{
+		Int mid = (lo + hi) / 2;
+		if (crcs[mid].frame == frame)
+			return &crcs[mid];
+		if (crcs[mid].frame < frame)
+			lo = mid + 1;
+		else
+			hi = mid - 1;
+	}
+	return NULL;
+}
+
+//-------------------------------------------------------------------------------------------------
+static bool hasDiverged(const FrameCRC &crc, const FrameCRCVec &reference)
+{
+	const FrameCRC *other = findFrameCRC(reference, crc.frame);
+	return other != NULL && other->crc != crc.crc;
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Bisect our frame CRCs against the reference ones for the first frame they differ in, and
+	report it along with the first section that differs. Once two simulations have diverged they
+	practically never come back together, so "diverged by frame N" is monotonic in N. */
+//-------------------------------------------------------------------------------------------------
+static void reportDivergence(FILE *report, const FrameCRCVec &crcs, const FrameCRCVec &reference)
+{
+	// only frames the reference got to can be compared
+	Int count = 0;
+	while (count < (Int)crcs.size() && crcs[count].frame <= reference.back().frame)
+		++count;
+
+	if (count == 0 || !hasDiverged(crcs[count - 1], reference))
+	{
+		fprintf(report, "divergence none\n");
+		return;
+	}
+
+	Int lo = 0;
+	Int hi = count - 1;
+	while (lo < hi)
+	{
+		Int mid = (lo + hi) / 2;
+		if (hasDiverged(crcs[mid], reference))
+			hi = mid;
+		else
+			lo = mid + 1;
+	}
+
+	const FrameCRC &ours = crcs[lo];
+	const FrameCRC *theirs = findFrameCRC(reference, ours.frame);
+	Int section = 0;
+	while (section < CRC_SECTION_COUNT - 1 && ours.sections[section] == theirs->sections[section])
+		++section;
+
+	fprintf(report, "divergence frame %d section MARKER:%s\n", ours.frame, TheCRCSectionNames[section]);
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Expand wildcards in the replay names against the replay directory. */
+//-------------------------------------------------------------------------------------------------
+static void expandReplayNames(const std::vector<AsciiString> &names, std::vector<AsciiString> &filenames)
+{
+	for (std::vector<AsciiString>::const_iterator it = names.begin(); it != names.end(); ++it)
+	{
+		if (strpbrk(it->str(), "*?") == NULL)
+		{
+			filenames.push_back(*it);
+			continue;
+		}
+
+		FilenameList found;
+		TheFileSystem->getFileListInDirectory(TheRecorder->getReplayDir(), *it, found, FALSE);
+		for (FilenameListIter f = found.begin(); f != found.end(); ++f)
+		{
+			// just want the filename
+			const char *name = f->reverseFind('\\');
+			filenames.push_back(AsciiString(name ? name + 1 : f->str()));
+		}
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+Int ReplaySimulation::simulateReplays(const std::vector<AsciiString> &names, int argc, char *argv[])
+{
+	AsciiString reportPath = TheGlobalData->m_replayReportFile;
+	if (reportPath.isEmpty())
+	{
+		reportPath = TheGlobalData->getPath_UserData();
+		reportPath.concat("ReplayReport.txt");
+	}
+
+	FILE *report = fopen(reportPath.str(), "w");
+	if (report == NULL)
+	{
+		DEBUG_LOG(("ReplaySimulation::simulateReplays - can't open the report %s\n", reportPath.str()));
+		return RESULT_FAILED;
+	}
+
+	std::vector<AsciiString> filenames;
+	expandReplayNames(names, filenames);
+
+	Int worst = RESULT_OK;
+	if (TheGlobalData->m_replayChildProcess)
+	{
+		// our report is one part of the parent's, which lists the desyncs and sums them up itself
+		TheGameEngine->update();
+		for (std::vector<AsciiString>::const_iterator it = filenames.begin(); it != filenames.end(); ++it)
+		{
+			if (TheGameEngine->getQuitting())
+				break;
+
+			Result result = simulateReplay(*it, report);
+			if (result > worst)
+				worst = result;
+		}
+	}
+	else if (filenames.size() > 1 && TheGlobalData->m_replayJobs != 1)
+	{
+		worst = simulateReplaysInChildProcesses(filenames, report, reportPath, argc, argv);
+	}
+	else
+	{
+		// let the shell come up first, as if the replays were picked from the replay menu
+		TheGameEngine->update();
+
+		Int counts[3] = { 0, 0, 0 };
+		for (std::vector<AsciiString>::const_iterator it = filenames.begin(); it != filenames.end(); ++it)
+		{
+			if (TheGameEngine->getQuitting())
+				break;
+
+			Result result = simulateReplay(*it, report);
+			++counts[result];
+			if (result != RESULT_OK)
+				fprintf(report, "%s %s\n", (result == RESULT_MISMATCH) ? "desync" : "failed", it->str());
+			if (result > worst)
+				worst = result;
+		}
+		fprintf(report, "summary ok %d mismatch %d failed %d\n", counts[RESULT_OK], counts[RESULT_MISMATCH], counts[RESULT_FAILED]);
+	}
+
+	fclose(report);
+	return worst;
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Simulate each replay in a child process running this same executable, -jobs at a time, then
+	gather their reports into ours. */
+//-------------------------------------------------------------------------------------------------
+Int ReplaySimulation::simulateReplaysInChildProcesses(const std::vector<AsciiString> &filenames, FILE *report,
+	const AsciiString &reportPath, int argc, char *argv[])
+{
+	Int jobs = TheGlobalData->m_replayJobs;
+	if (jobs <= 0)
+	{
+		SYSTEM_INFO info;
+		GetSystemInfo(&info);
+		jobs = info.dwNumberOfProcessors;
+	}
+	if (jobs > MAXIMUM_WAIT_OBJECTS)
+		jobs = MAXIMUM_WAIT_OBJECTS;
+
+	char exePath[_MAX_PATH];
+	GetModuleFileName(NULL, exePath, sizeof(exePath));
+
+	// the children get our arguments, less the ones saying which replays to simulate and how
+	AsciiString commonArgs;
+	commonArgs.format("\"%s\"", exePath);
+	for (Int i = 1; i < argc; ++i)
+	{
+		if ((stricmp(argv[i], "-replay") == 0 || stricmp(argv[i], "-replayReport") == 0 || stricmp(argv[i], "-jobs") == 0) && i + 1 < argc)
+		{
+			++i;
+			continue;
+		}
+		commonArgs.concat(" \"");
+		commonArgs.concat(argv[i]);
+		commonArgs.concat("\"");
+	}
+
+	const Int numReplays = filenames.size();
+	std::vector<AsciiString> partPaths(numReplays);
+	std::vector<Int> results(numReplays, RESULT_FAILED);
+	std::vector<HANDLE> running;
+	std::vector<Int> runningReplays;
+	Int next = 0;
+
+	while (next < numReplays || !running.empty())
+	{
+		while (next < numReplays && (Int)running.size() < jobs)
+		{
+			partPaths[next].format("%s.%d", reportPath.str(), next);
+
+			AsciiString commandLine;
+			commandLine.format("%s -replayChild -replay \"%s\" -replayReport \"%s\"", commonArgs.str(), filenames[next].str(), partPaths[next].str());
+
+			PROCESS_INFORMATION procInfo;
+			ZeroMemory(&procInfo, sizeof(procInfo));
+			STARTUPINFO startUp;
+			ZeroMemory(&startUp, sizeof(startUp));
+			startUp.cb = sizeof(startUp);
+
+			// CreateProcess may write to the command line
+			std::vector<char> buffer(commandLine.str(), commandLine.str() + commandLine.getLength() + 1);
+			if (CreateProcess(exePath, &buffer[0], NULL, NULL, FALSE, 0, NULL, NULL, &startUp, &procInfo))
+			{
+				CloseHandle(procInfo.hThread);
+				running.push_back(procInfo.hProcess);
+				runningReplays.push_back(next);
+			}
+			else
+			{
+				DEBUG_LOG(("ReplaySimulation::simulateReplaysInChildProcesses - can't start a process for %s (%d)\n",
+					filenames[next].str(), GetLastError()));
+			}
+			++next;
+		}
+
+		if (running.empty())
+			continue;
+
+		DWORD wait = WaitForMultipleObjects(running.size(), &running[0], FALSE, INFINITE);
+		Int index = wait - WAIT_OBJECT_0;
+		if (index < 0 || index >= (Int)running.size())
+		{
+			DEBUG_CRASH(("ReplaySimulation::simulateReplaysInChildProcesses - wait failed (%d)", GetLastError()));
+			break;
+		}
+
+		DWORD exitCode = RESULT_FAILED;
+		GetExitCodeProcess(running[index], &exitCode);
+		CloseHandle(running[index]);
+
+		// anything else means the child crashed
+		Int replay = runningReplays[index];
+		results[replay] = (exitCode <= RESULT_FAILED) ? (Int)exitCode : RESULT_FAILED;
+		DEBUG_LOG(("ReplaySimulation::simulateReplaysInChildProcesses - %s: %s\n", filenames[replay].str(), resultNames[results[replay]]));
+
+		running.erase(running.begin() + index);
+		runningReplays.erase(runningReplays.begin() + index);
+	}
+
+	// in case we gave up waiting
+	for (size_t i = 0; i < running.size(); ++i)
+	{
+		TerminateProcess(running[i], RESULT_FAILED);
+		CloseHandle(running[i]);
+	}
+
+	// gather the reports in replay order, so ours reads the same as if we had simulated them one by one
+	Int worst = RESULT_OK;
+	Int counts[3] = { 0, 0, 0 };
+	for (Int i = 0; i < numReplays; ++i)
+	{
+		FILE *part = fopen(partPaths[i].str(), "r");
+		if (part)
+		{
+			char line[1024];
+			while (fgets(line, sizeof(line), part))
+				fputs(line, report);
+			fclose(part);
+			DeleteFile(partPaths[i].str());
+		}
+		else
+		{
+			fprintf(report, "replay %s\nresult %s\n", filenames[i].str(), resultNames[RESULT_FAILED]);
+			results[i] = RESULT_FAILED;
+		}
+
+		++counts[results[i]];
+		if (results[i] > worst)
+			worst = results[i];
+	}
+
+	for (Int i = 0; i < numReplays; ++i)
+	{
+		if (results[i] != RESULT_OK)
+			fprintf(report, "%s %s\n", (results[i] == RESULT_MISMATCH) ? "desync" : "failed", filenames[i].str());
+	}
+	fprintf(report, "summary ok %d mismatch %d failed %d\n", counts[RESULT_OK], counts[RESULT_MISMATCH], counts[RESULT_FAILED]);
+
+	return worst;
+}
+
+//-------------------------------------------------------------------------------------------------
+ReplaySimulation::Result ReplaySimulation::simulateReplay(const AsciiString &filename, FILE *report)
+{
+	fprintf(report, "replay %s\n", filename.str());
+
+	if (!TheRecorder->playbackFile(filename))
+	{
+		DEBUG_LOG(("ReplaySimulation::simulateReplay - can't play back %s\n", filename.str()));
+		fprintf(report, "result %s\n", resultNames[RESULT_FAILED]);
+		fflush(report);
+		return RESULT_FAILED;
+	}
+
+	Int64 freq64, start64, end64, logicTicks = 0;
+	QueryPerformanceFrequency((LARGE_INTEGER *)&freq64);
+
+	FrameCRCVec crcs;
+	UnsignedInt lastFrame = 0;
+
+	while (TheRecorder->isPlaybackInProgress() && !TheGameEngine->getQuitting())
+	{
+		QueryPerformanceCounter((LARGE_INTEGER *)&start64);
+		TheGameEngine->update();
+		QueryPerformanceCounter((LARGE_INTEGER *)&end64);
+		logicTicks += end64 - start64;
+
+		if (!TheGameLogic->isInGame())
+			continue;
+
+		// the CRC of the state each logic frame left behind. Kept out of the timing, it costs more than the frame.
+		UnsignedInt frame = TheGameLogic->getFrame();
+		if (frame != lastFrame)
+		{
+			FrameCRC crc;
+			crc.frame = frame;
+			crc.crc = TheGameLogic->getCRC(CRC_RECALC);
+			for (Int i = 0; i < CRC_SECTION_COUNT; ++i)
+				crc.sections[i] = TheGameLogic->getCRCSection((CRCSectionType)i);
+			writeFrameCRC(report, crc);
+			crcs.push_back(crc);
+			lastFrame = frame;
+		}
+	}
+
+	Result result = TheRecorder->sawCRCMismatch() ? RESULT_MISMATCH : RESULT_OK;
+	if (TheGameEngine->getQuitting())
+		result = RESULT_FAILED;
+
+	// the replay only holds a CRC every so many frames, which is as close as it can place the desync
+	if (TheRecorder->sawCRCMismatch())
+		fprintf(report, "mismatch %d lastmatch %d\n", TheRecorder->getCRCMismatchFrame(), TheRecorder->getLastCRCMatchFrame());
+
+	if (TheGlobalData->m_replayReferenceFile.isNotEmpty())
+	{
+		FrameCRCVec reference;
+		if (readReferenceCRCs(TheGlobalData->m_replayReferenceFile, filename, reference))
+			reportDivergence(report, crcs, reference);
+		else
+			fprintf(report, "divergence noreference\n");
+	}
+
+	if (TheGameLogic->isInGame())
+	{
+		for (Int i = 0; i < ThePlayerList->getPlayerCount(); ++i)
+		{
+			Player *player = ThePlayerList->getNthPlayer(i);
+			if (!player->isPlayableSide())
+				continue;
+
+			ScoreKeeper *score = player->getScoreKeeper();
+			fprintf(report, "player %d \"%ls\" %s score %d unitsBuilt %d unitsLost %d buildingsBuilt %d buildingsLost %d moneyEarned %d\n",
+				i, player->getPlayerDisplayName().str(), player->getSide().str(), score->calculateScore(),
+				score->getTotalUnitsBuilt(), score->getTotalUnitsLost(), score->getTotalBuildingsBuilt(),
+				score->getTotalBuildingsLost(), score->getTotalMoneyEarned());
+		}
+	}
+
+	Real seconds = (Real)((double)logicTicks / (double)freq64);
+	Real fps = (seconds > 0.0f) ? lastFrame / seconds : 0.0f;
+	fprintf(report, "result %s frames %d seconds %.3f logicfps %.1f\n", resultNames[result], lastFrame, seconds, fps);
+	fflush(report);
+
+	DEBUG_LOG(("ReplaySimulation::simulateReplay - %s: %s after %d frames, %.1f logic frames per second\n",
+		filename.str(), resultNames[result], lastFrame, fps));
+
+	// let the end of the playback clear the game, so the next replay starts from the shell
+	while (TheGameLogic->isInGame() && !TheGameEngine->getQuitting())
+	{
+		TheGameEngine->update();
+	}
+
+	return result;
+}
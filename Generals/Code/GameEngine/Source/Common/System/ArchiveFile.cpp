@@ -81,109 +81,113 @@ static bool SearchStringMatches(AsciiString str, AsciiString searchString)
 	return FALSE;
 }
 
-ArchiveFile::~ArchiveFile() 
+SharedArchiveData::SharedArchiveData(const char *data, Int size) :
+	m_data(data),
+	m_size(size),
+	m_refCount(1)
 {
-	if (m_file != NULL) {
-		m_file->close();
-		m_file = NULL;
-	}
 }
 
-ArchiveFile::ArchiveFile() 
+SharedArchiveData::~SharedArchiveData()
 {
-	m_rootDirectory.clear();
 }
 
-void ArchiveFile::addFile(const AsciiString& path, const ArchivedFileInfo *fileInfo) 
+void SharedArchiveData::addRef()
 {
-	AsciiString temp;
-	temp = path;
-	temp.toLower();
-	AsciiString token;
-	AsciiString debugpath;
-
-	DetailedArchivedDirectoryInfo *dirInfo = &m_rootDirectory;
+	InterlockedIncrement(&m_refCount);
+}
 
-	temp.nextToken(&token, "\\/");
+void SharedArchiveData::release()
+{
+	if (InterlockedDecrement(&m_refCount) == 0) {
+		delete this;
+	}
+}
 
-	while (token.getLength() > 0) {
-		if (dirInfo->m_directories.find(token) == dirInfo->m_directories.end()) 
-		{
-			dirInfo->m_directories[token].clear();
-			dirInfo->m_directories[token].m_directoryName = token;
-		}
+ArchiveFile::~ArchiveFile() 
+{
+	if (m_file != NULL) {
+		m_file->close();
+		m_file = NULL;
+	}
 
-		debugpath.concat(token);
-		debugpath.concat('\\');
-		dirInfo = &(dirInfo->m_directories[token]);
-		temp.nextToken(&token, "\\/");
+	// files that are still open keep the data alive by themselves
+	if (m_sharedData != NULL) {
+		m_sharedData->release();
+		m_sharedData = NULL;
 	}
+}
 
-	dirInfo->m_files[fileInfo->m_filename] = *fileInfo;
-	//path.concat(fileInfo->m_filename);
+ArchiveFile::ArchiveFile() :
+	m_file(NULL),
+	m_sharedData(NULL),
+	m_data(NULL),
+	m_dataSize(0)
+{
 }
 
-void ArchiveFile::getFileListInDirectory(const AsciiString& currentDirectory, const AsciiString& originalDirectory, const AsciiString& searchName, FilenameList &filenameList, bool searchSubdirectories) const
+void ArchiveFile::reserveFiles(Int count)
 {
+	m_files.reserve(count);
+}
 
-	AsciiString searchDir;
-	const DetailedArchivedDirectoryInfo *dirInfo = &m_rootDirectory;
+void ArchiveFile::addFile(const char *path, const ArchivedFileInfo *fileInfo) 
+{
+	char normalized[_MAX_PATH];
+	if (!normalizeArchivePath(path, normalized, sizeof(normalized)) || normalized[0] == 0) {
+		DEBUG_CRASH(("ArchiveFile::addFile - bad path '%s'\n", path));
+		return;
+	}
 
-	searchDir = originalDirectory;
-	searchDir.toLower();
-	AsciiString token;
-	
-	searchDir.nextToken(&token, "\\/");
+	m_files.insert(AsciiString(normalized)) = *fileInfo;
+}
 
-	while (token.getLength() > 0) {
+void ArchiveFile::addNormalizedFile(const AsciiString& path, const ArchivedFileInfo *fileInfo) 
+{
+	m_files.insert(path) = *fileInfo;
+}
 
-		DetailedArchivedDirectoryInfoMap::const_iterator it = dirInfo->m_directories.find(token);
-		if (it != dirInfo->m_directories.end())
-		{
-			dirInfo = &it->second;
-		}
-		else
-		{
-			// if the directory doesn't exist, then there aren't any files to be had.
-			return;
-		}
+void ArchiveFile::getFileListInDirectory(const AsciiString& currentDirectory, const AsciiString& originalDirectory, const AsciiString& searchName, FilenameList &filenameList, bool searchSubdirectories) const
+{
+	char searchDir[_MAX_PATH];
+	if (!normalizeArchivePath(originalDirectory.str(), searchDir, sizeof(searchDir))) {
+		return;
+	}
+	Int searchDirLen = strlen(searchDir);
 
-		searchDir.nextToken(&token, "\\/");
+	AsciiString prefix;
+	prefix = originalDirectory;
+	if ((prefix.getLength() > 0) && (!prefix.endsWith("\\"))) {
+		prefix.concat('\\');
 	}
 
-	getFileListInDirectory(dirInfo, originalDirectory, searchName, filenameList, searchSubdirectories);
-}
+	// like the directory tree this replaced, subdirectories are always searched.
+	for (Int i = 0; i < m_files.getSlotCount(); ++i) {
+		const AsciiString& path = m_files.getSlot(i).m_path;
+		if (path.isEmpty()) {
+			continue;
+		}
 
-void ArchiveFile::getFileListInDirectory(const DetailedArchivedDirectoryInfo *dirInfo, const AsciiString& currentDirectory, const AsciiString& searchName, FilenameList &filenameList, bool searchSubdirectories) const
-{
-	DetailedArchivedDirectoryInfoMap::const_iterator diriter = dirInfo->m_directories.begin();
-	while (diriter != dirInfo->m_directories.end()) {
-		const DetailedArchivedDirectoryInfo *tempDirInfo = &(diriter->second);
-		AsciiString tempdirname;
-		tempdirname = currentDirectory;
-		if ((tempdirname.getLength() > 0) && (!tempdirname.endsWith("\\"))) {
-			tempdirname.concat('\\');
+		// the part of the path below the directory we're searching
+		const char *relativePath = path.str();
+		if (searchDirLen > 0) {
+			if (path.getLength() <= searchDirLen || memcmp(relativePath, searchDir, searchDirLen) != 0 || relativePath[searchDirLen] != '\\') {
+				continue;
+			}
+			relativePath += searchDirLen + 1;
 		}
-		tempdirname.concat(tempDirInfo->m_directoryName);
-		getFileListInDirectory(tempDirInfo, tempdirname, searchName, filenameList, searchSubdirectories);
-		diriter++;
-	}
 
-	ArchivedFileInfoMap::const_iterator fileiter = dirInfo->m_files.begin();
-	while (fileiter != dirInfo->m_files.end()) {
-		if (SearchStringMatches(fileiter->second.m_filename, searchName)) {
+		const char *filename = strrchr(relativePath, '\\');
+		filename = (filename != NULL) ? filename + 1 : relativePath;
+		if (SearchStringMatches(AsciiString(filename), searchName)) {
 			AsciiString tempfilename;
-			tempfilename = currentDirectory;
-			if ((tempfilename.getLength() > 0) && (!tempfilename.endsWith("\\"))) {
-				tempfilename.concat('\\');
-			}
-			tempfilename.concat(fileiter->second.m_filename);
+			tempfilename = prefix;
+			tempfilename.concat(relativePath);
 			if (filenameList.find(tempfilename) == filenameList.end()) {
 				// only insert into the list if its not already in there.
 				filenameList.insert(tempfilename);
 			}
 		}
-		fileiter++;
 	}
 }
 
@@ -196,40 +200,28 @@ void ArchiveFile::attachFile(File *file)
 	m_file = file;
 }
 
-const ArchivedFileInfo * ArchiveFile::getArchivedFileInfo(const AsciiString& filename) const
+void ArchiveFile::attachData(SharedArchiveData *data)
 {
-	AsciiString path;
-	path = filename;
-	path.toLower();
-	AsciiString token;
-
-	const DetailedArchivedDirectoryInfo *dirInfo = &m_rootDirectory;
-
-	path.nextToken(&token, "\\/");
-
-	while ((token.find('.') == NULL) || (path.find('.') != NULL)) {
-
-		DetailedArchivedDirectoryInfoMap::const_iterator it = dirInfo->m_directories.find(token);
-		if (it != dirInfo->m_directories.end())
-		{
-			dirInfo = &it->second; 
-		}
-		else
-		{
-			return NULL;
-		}
-
-		path.nextToken(&token, "\\/");
+	if (m_sharedData != NULL) {
+		m_sharedData->release();
 	}
+	m_sharedData = data;
+	m_data = data ? data->getData() : NULL;
+	m_dataSize = data ? data->getSize() : 0;
+}
 
-	ArchivedFileInfoMap::const_iterator it = dirInfo->m_files.find(token);
-	if (it != dirInfo->m_files.end())
-	{
-		return &it->second;
+const ArchivedFileInfo * ArchiveFile::getArchivedFileInfo(const AsciiString& filename) const
+{
+	return m_files.find(filename.str());
+}
+
+const char * ArchiveFile::getFileDataInMemory(const ArchivedFileInfo *fileInfo) const
+{
+	if (m_data == NULL || fileInfo == NULL) {
+		return NULL;
 	}
-	else
-	{
+	if (fileInfo->m_offset > (UnsignedInt)m_dataSize || fileInfo->m_size > (UnsignedInt)m_dataSize - fileInfo->m_offset) {
 		return NULL;
 	}
-
+	return m_data + fileInfo->m_offset;
 }
@@ -103,6 +103,31 @@ ArchiveFileSystem *TheArchiveFileSystem = NULL;
 //         Public Functions                                                
 //----------------------------------------------------------------------------
 
+bool normalizeArchivePath(const char *path, char *buffer, Int bufferSize)
+{
+	Int len = 0;
+	bool separator = FALSE;
+
+	for (const char *c = path; *c != 0; ++c) {
+		if (*c == '\\' || *c == '/') {
+			separator = (len > 0);
+			continue;
+		}
+
+		if (len + (separator ? 2 : 1) >= bufferSize) {
+			return FALSE;
+		}
+		if (separator) {
+			buffer[len++] = '\\';
+			separator = FALSE;
+		}
+		buffer[len++] = (char)tolower((UnsignedByte)*c);
+	}
+
+	buffer[len] = 0;
+	return TRUE;
+}
+
 //------------------------------------------------------
 // ArchivedFileInfo
 //------------------------------------------------------
@@ -123,51 +148,34 @@ ArchiveFileSystem::~ArchiveFileSystem()
 	}
 }
 
-void ArchiveFileSystem::loadIntoDirectoryTree(const ArchiveFile *archiveFile, const AsciiString& archiveFilename, bool overwrite)
+void ArchiveFileSystem::loadIntoDirectoryTree(ArchiveFile *archiveFile, const AsciiString& archiveFilename, bool overwrite)
 {
+	const ArchivedFileInfoTable& files = archiveFile->getArchivedFiles();
+	m_fileLocations.reserve(m_fileLocations.getCount() + files.getCount());
 
-	FilenameList filenameList;
-
-	archiveFile->getFileListInDirectory(AsciiString(""), AsciiString(""), AsciiString("*"), filenameList, TRUE);
-
-	FilenameListIter it = filenameList.begin();
-
-	while (it != filenameList.end()) {
-		// add this filename to the directory tree.
-		AsciiString path = *it;
-		path.toLower();
-		AsciiString token;
-		AsciiString debugpath;
-
-		ArchivedDirectoryInfo *dirInfo = &m_rootDirectory;
-
-		bool infoInPath;
-		infoInPath = path.nextToken(&token, "\\/");
-
-		while (infoInPath && (!token.find('.') || path.find('.'))) {
-			ArchivedDirectoryInfoMap::iterator tempiter = dirInfo->m_directories.find(token);
-			if (tempiter == dirInfo->m_directories.end()) 
-			{
-				dirInfo->m_directories[token].clear();
-				dirInfo->m_directories[token].m_directoryName = token;
-			}
-
-			dirInfo = &(dirInfo->m_directories[token]);
-			debugpath.concat(token);
-			debugpath.concat('\\');
-			infoInPath = path.nextToken(&token, "\\/");
+	for (Int i = 0; i < files.getSlotCount(); ++i) {
+		const AsciiString& path = files.getSlot(i).m_path;
+		if (path.isEmpty()) {
+			continue;
 		}
 
-		// token is the filename, and dirInfo is the directory that this file is in.
-		if (dirInfo->m_files.find(token) == dirInfo->m_files.end() || overwrite) {
-			AsciiString path2;
-			path2 = debugpath;
-			path2.concat(token);
-//			DEBUG_LOG(("ArchiveFileSystem::loadIntoDirectoryTree - adding file %s, archived in %s\n", path2.str(), archiveFilename.str()));
-			dirInfo->m_files[token] = archiveFilename;
+		// the paths are normalized already, so they go straight in.
+		ArchiveFile *&location = m_fileLocations.insert(path);
+		if (location == NULL || overwrite) {
+//			DEBUG_LOG(("ArchiveFileSystem::loadIntoDirectoryTree - adding file %s, archived in %s\n", path.str(), archiveFilename.str()));
+			location = archiveFile;
 		}
+	}
+}
 
-		it++;
+void ArchiveFileSystem::removeFromDirectoryTree(const ArchiveFile *archiveFile)
+{
+	// the paths stay, as if the files were never found. an archive loaded later can take them again.
+	for (Int i = 0; i < m_fileLocations.getSlotCount(); ++i) {
+		const ArchivedFileLocationTable::Slot& slot = m_fileLocations.getSlot(i);
+		if (slot.m_value == archiveFile) {
+			*m_fileLocations.find(slot.m_path.str()) = NULL;
+		}
 	}
 }
 
@@ -200,46 +208,18 @@ void ArchiveFileSystem::loadMods() {
 
 bool ArchiveFileSystem::doesFileExist(const Char *filename) const
 {
-	AsciiString path = filename;
-	path.toLower();
-	AsciiString token;
-
-	const ArchivedDirectoryInfo *dirInfo = &m_rootDirectory;
-
-	path.nextToken(&token, "\\/");
-
-	while (!token.find('.') || path.find('.')) 
-	{
-		ArchivedDirectoryInfoMap::const_iterator tempiter = dirInfo->m_directories.find(token);
-		if (tempiter != dirInfo->m_directories.end()) 
-		{
-			dirInfo = &tempiter->second;
-			path.nextToken(&token, "\\/");
-		}
-		else
-		{
-			// the directory doesn't exist, so return false
-			return FALSE;
-		}
-	}
-
-	// token is the filename, and dirInfo is the directory that this file is in.
-	if (dirInfo->m_files.find(token) == dirInfo->m_files.end()) {
-		return FALSE;
-	}
-	return TRUE;
+	ArchiveFile *const *location = m_fileLocations.find(filename);
+	return location != NULL && *location != NULL;
 }
 
 File * ArchiveFileSystem::openFile(const Char *filename, Int access /* = 0 */) 
 {
-	AsciiString archiveFilename;
-	archiveFilename = getArchiveFilenameForFile(AsciiString(filename));
-
-	if (archiveFilename.getLength() == 0) {
+	ArchiveFile *const *location = m_fileLocations.find(filename);
+	if (location == NULL || *location == NULL) {
 		return NULL;
 	}
 
-	return m_archiveFileMap[archiveFilename]->openFile(filename, access);
+	return (*location)->openFile(filename, access);
 }
 
 bool ArchiveFileSystem::getFileInfo(const AsciiString& filename, FileInfo *fileInfo) const
@@ -252,69 +232,32 @@ bool ArchiveFileSystem::getFileInfo(const AsciiString& filename, FileInfo *fileI
 		return FALSE;
 	}
 
-	AsciiString archiveFilename = getArchiveFilenameForFile(filename);
-	ArchiveFileMap::const_iterator it = m_archiveFileMap.find(archiveFilename);
-	if (it != m_archiveFileMap.end())
-	{
-		return it->second->getFileInfo(filename, fileInfo);
-	}
-	else
-	{
+	ArchiveFile *const *location = m_fileLocations.find(filename.str());
+	if (location == NULL || *location == NULL) {
 		return FALSE;
 	}
+
+	return (*location)->getFileInfo(filename, fileInfo);
 }
 
 AsciiString ArchiveFileSystem::getArchiveFilenameForFile(const AsciiString& filename) const
 {
-	AsciiString path;
-	path = filename;
-	path.toLower();
-	AsciiString token;
-	AsciiString debugpath;
-
-	const ArchivedDirectoryInfo *dirInfo = &m_rootDirectory;
-
-	path.nextToken(&token, "\\/");
-
-	while (!token.find('.') || path.find('.')) {
-
-		ArchivedDirectoryInfoMap::const_iterator it = dirInfo->m_directories.find(token);
-		if (it != dirInfo->m_directories.end())
-		{
-			dirInfo = &it->second;
-		}
-		else
-		{
-			// the directory doesn't exist, so return NULL
-
-			// dump the directories;
-			//DEBUG_LOG(("directory %s not found in %s in archive file system\n", token.str(), debugpath.str()));
-			//DEBUG_LOG(("directories in %s in archive file system are:\n", debugpath.str()));
-			//ArchivedDirectoryInfoMap::const_iterator it = dirInfo->m_directories.begin();
-			//while (it != dirInfo->m_directories.end()) {
-			//	DEBUG_LOG(("\t%s\n", it->second.m_directoryName.str()));
-			//	it++;
-			//}
-			//DEBUG_LOG(("end of directory list.\n"));
-			return AsciiString::TheEmptyString;
-		}
-
-		debugpath.concat(token);
-		debugpath.concat('\\');
-
-		path.nextToken(&token, "\\/");
+	ArchiveFile *const *location = m_fileLocations.find(filename.str());
+	if (location == NULL || *location == NULL) {
+		return AsciiString::TheEmptyString;
 	}
 
-	ArchivedFileLocationMap::const_iterator it = dirInfo->m_files.find(token);
-	if (it != dirInfo->m_files.end())
-	{
-		return it->second;
-	}
-	else
-	{
-		return AsciiString::TheEmptyString;
+	return (*location)->getName();
+}
+
+ArchiveFile * ArchiveFileSystem::getArchiveFileForFile(const AsciiString& filename) const
+{
+	ArchiveFile *const *location = m_fileLocations.find(filename.str());
+	if (location == NULL) {
+		return NULL;
 	}
 
+	return *location;
 }
 
 void ArchiveFileSystem::getFileListInDirectory(const AsciiString& currentDirectory, const AsciiString& originalDirectory, const AsciiString& searchName, FilenameList &filenameList, bool searchSubdirectories) const
@@ -0,0 +1,129 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "PreRTS.h"	// This must go first in EVERY cpp file int the GameEngine
+#include "Common/ArchiveIndexCache.h"
+
+#include "Common/ArchiveFile.h"
+#include "Common/crc.h"
+#include "Common/LocalFileSystem.h"
+
+// The check of an entry is the CRC of the archive's header, and its data is, for each file:
+// UnsignedInt offset, UnsignedInt size, normalized path, '\0'.
+static const UnsignedInt ARCHIVE_INDEX_CACHE_MAGIC = 0x43474942;	// "BIGC"
+static const UnsignedInt ARCHIVE_INDEX_CACHE_VERSION = 2;
+
+ArchiveIndexCache *TheArchiveIndexCache = NULL;
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+ArchiveIndexCache::ArchiveIndexCache() :
+	CacheFile(ARCHIVE_INDEX_CACHE_MAGIC, ARCHIVE_INDEX_CACHE_VERSION, HEADER_SIZE)
+{
+}
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+UnsignedInt ArchiveIndexCache::getHeaderCRC(const char *header)
+{
+	CRC crc;
+	crc.computeCRC(header, HEADER_SIZE);
+	return crc.get();
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Every file has to be there in full, with a path that isn't empty and fits the archive tables, so
+	* a damaged cache can't make find() run off the end */
+//-------------------------------------------------------------------------------------------------
+bool ArchiveIndexCache::isValidEntry(const char *files, Int size, Int numFiles) const
+{
+	const char *end = files + size;
+	if (size < 0 || numFiles < 0)
+		return FALSE;
+
+	for (Int i = 0; i < numFiles; ++i)
+	{
+		if (end - files <= (Int)(2 * sizeof(UnsignedInt)) + 1)
+			return FALSE;
+		files += 2 * sizeof(UnsignedInt);
+
+		Int maxLen = end - files;
+		if (maxLen > _MAX_PATH)
+			maxLen = _MAX_PATH;
+		const char *terminator = (const char *)memchr(files, '\0', maxLen);
+		if (terminator == NULL || terminator == files)
+			return FALSE;
+		files = terminator + 1;
+	}
+	return files == end;
+}
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+bool ArchiveIndexCache::find(const AsciiString &archiveFilename, const char *header, ArchiveFile *archiveFile)
+{
+	FileInfo info;
+	if (!TheLocalFileSystem->getFileInfo(archiveFilename, &info))
+		return FALSE;
+
+	const Entry *entry = findEntry(archiveFilename, info, getHeaderCRC(header));
+	if (entry == NULL)
+		return FALSE;
+
+	archiveFile->reserveFiles(entry->count);
+
+	ArchivedFileInfo fileInfo;
+	const char *pos = entry->data;
+	for (Int i = 0; i < entry->count; ++i)
+	{
+		memcpy(&fileInfo.m_offset, pos, sizeof(UnsignedInt));
+		memcpy(&fileInfo.m_size, pos + sizeof(UnsignedInt), sizeof(UnsignedInt));
+		pos += 2 * sizeof(UnsignedInt);
+
+		Int len = strlen(pos);
+		archiveFile->addNormalizedFile(AsciiString(pos), &fileInfo);
+		pos += len + 1;
+	}
+
+	return TRUE;
+}
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+void ArchiveIndexCache::add(const AsciiString &archiveFilename, const char *header, const ArchiveFile *archiveFile)
+{
+	FileInfo info;
+	if (!TheLocalFileSystem->getFileInfo(archiveFilename, &info))
+		return;
+
+	std::vector<char> files;
+	const ArchivedFileInfoTable &table = archiveFile->getArchivedFiles();
+	for (Int i = 0; i < table.getSlotCount(); ++i)
+	{
+		const ArchivedFileInfoTable::Slot &slot = table.getSlot(i);
+		if (slot.m_path.isEmpty())
+			continue;
+
+		const char *offset = (const char *)&slot.m_value.m_offset;
+		const char *size = (const char *)&slot.m_value.m_size;
+		files.insert(files.end(), offset, offset + sizeof(UnsignedInt));
+		files.insert(files.end(), size, size + sizeof(UnsignedInt));
+		files.insert(files.end(), slot.m_path.str(), slot.m_path.str() + slot.m_path.getLength() + 1);
+	}
+
+	addEntry(archiveFilename, info, getHeaderCRC(header), table.getCount(), files.empty() ? NULL : &files[0], files.size());
+}
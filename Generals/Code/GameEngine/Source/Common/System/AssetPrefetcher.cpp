@@ -0,0 +1,452 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "PreRTS.h"	// This must go first in EVERY cpp file int the GameEngine
+#include "Common/AssetPrefetcher.h"
+
+#include "Common/ArchiveFile.h"
+#include "Common/LocalFileSystem.h"
+
+// The workers stop reading ahead while this much of what they read hasn't been taken yet, so a
+// big map can't make them pull all of its files into memory at once.
+static const Int MAX_PREFETCHED_BYTES = 128 * 1024 * 1024;
+
+// Reading the files is mostly waiting on the disk, a few threads are enough to keep it busy.
+static const Int MAX_PREFETCH_THREADS = 4;
+
+// A mapped file is brought in by reading a byte of each page. A smaller page than the real one
+// only touches some pages twice.
+static const Int PREFETCH_PAGE_SIZE = 4096;
+
+// Room for the files found in the files read ahead. The entries can't grow while the workers read them,
+// so anything found past this is left for whoever loads it.
+static const Int MAX_FOUND_FILES = 4096;
+
+AssetPrefetcher *TheAssetPrefetcher = NULL;
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+AssetPrefetcher::AssetPrefetcher() :
+	m_numFiles(0),
+	m_numEntries(0),
+	m_nextEntry(0),
+	m_nextBackgroundEntry(0),
+	m_numDone(0),
+	m_bytesHeld(0),
+	m_stopping(0),
+	m_hasFoundNames(0)
+{
+}
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+AssetPrefetcher::~AssetPrefetcher()
+{
+	stop();
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Find where filename is archived, for an entry that reads it. Returns FALSE if it isn't in a BIG
+	* file, is overridden by a file on disk, or is empty. */
+//-------------------------------------------------------------------------------------------------
+bool AssetPrefetcher::locateFile(const AsciiString &filename, char *normalized, Int normalizedSize, Entry &entry) const
+{
+	if (!normalizeArchivePath(filename.str(), normalized, normalizedSize))
+		return FALSE;
+
+	if (TheLocalFileSystem->doesFileExist(filename.str()))
+		return FALSE;
+
+	ArchiveFile *archive = TheArchiveFileSystem->getArchiveFileForFile(filename);
+	const ArchivedFileInfo *info = archive ? archive->getArchivedFileInfo(filename) : NULL;
+	if (info == NULL || info->m_size == 0)
+		return FALSE;
+
+	entry.archive = archive;
+	entry.info = *info;
+	entry.mappedData = (archive->mapData() != NULL) ? archive->getFileDataInMemory(info) : NULL;
+	entry.data = NULL;
+	entry.state = ENTRY_QUEUED;
+	entry.warmOnly = FALSE;
+	entry.scanned = FALSE;
+	return TRUE;
+}
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+void AssetPrefetcher::start(const FilenameList &filenames, const FilenameList &backgroundFilenames)
+{
+	stop();
+
+	if (TheArchiveFileSystem == NULL)
+		return;
+
+	// find where every file is on the main thread, the workers only read. The entries are all made up
+	// front, so the ones found later can be filled in without moving those being read.
+	m_entries.resize(filenames.size() + MAX_FOUND_FILES);
+	m_index.reserve((Int)filenames.size());
+	for (FilenameList::const_iterator it = filenames.begin(); it != filenames.end(); ++it)
+	{
+		char normalized[_MAX_PATH];
+		Entry &entry = m_entries[m_numEntries];
+		if (!locateFile(*it, normalized, sizeof(normalized), entry))
+			continue;
+
+		bool isNew;
+		Int &index = m_index.insert(AsciiString(normalized), &isNew);
+		if (!isNew)
+			continue;
+		index = m_numEntries++;
+		entry.scanned = isScannedFile(normalized);
+	}
+	m_numFiles = m_numEntries;
+
+	for (FilenameList::const_iterator it = backgroundFilenames.begin(); it != backgroundFilenames.end(); ++it)
+	{
+		char normalized[_MAX_PATH];
+		Entry entry;
+		if (!locateFile(*it, normalized, sizeof(normalized), entry) || m_index.find(normalized) != NULL)
+			continue;
+
+		bool isNew;
+		m_warmIndex.insert(AsciiString(normalized), &isNew);
+		if (!isNew)
+			continue;
+		entry.warmOnly = TRUE;
+		m_backgroundEntries.push_back(entry);
+	}
+
+	Int numFiles = m_numEntries + (Int)m_backgroundEntries.size();
+	if (numFiles == 0)
+		return;
+
+	SYSTEM_INFO systemInfo;
+	GetSystemInfo(&systemInfo);
+	Int numThreads = (Int)systemInfo.dwNumberOfProcessors - 1;	// leave one for the main thread
+	numThreads = max(1, min(MAX_PREFETCH_THREADS, min(numThreads, numFiles)));
+
+	for (Int i = 0; i < numThreads; ++i)
+	{
+		DWORD threadID;
+		HANDLE thread = ::CreateThread(NULL, 0, workerThread, this, 0, &threadID);
+		if (thread == NULL)
+		{
+			DEBUG_CRASH(("AssetPrefetcher::start - could not create thread %d\n", i));
+			break;
+		}
+		m_threads.push_back(thread);
+	}
+
+	DEBUG_LOG(("AssetPrefetcher::start - reading %d files, then %d in the background, on %d threads\n", m_numFiles, m_backgroundEntries.size(), m_threads.size()));
+}
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+void AssetPrefetcher::stop()
+{
+	InterlockedExchange(&m_stopping, 1);
+
+	if (!m_threads.empty())
+	{
+		::WaitForMultipleObjects((DWORD)m_threads.size(), &m_threads[0], TRUE, INFINITE);
+		for (size_t i = 0; i < m_threads.size(); ++i)
+			::CloseHandle(m_threads[i]);
+		m_threads.clear();
+	}
+
+	Int numUnused = 0;
+	for (Int i = 0; i < m_numEntries; ++i)
+	{
+		if (m_entries[i].data != NULL)
+		{
+			delete [] m_entries[i].data;
+			++numUnused;
+		}
+	}
+	if (m_numFiles > 0)
+		DEBUG_LOG(("AssetPrefetcher::stop - %d of %d files were read ahead and never used, %d more were found and read through\n",
+			numUnused, m_numFiles, m_numEntries - m_numFiles));
+
+	m_entries.clear();
+	m_backgroundEntries.clear();
+	m_index.clear();
+	m_warmIndex.clear();
+	m_foundNames.clear();
+	m_numFiles = 0;
+	m_numEntries = 0;
+	m_nextEntry = 0;
+	m_nextBackgroundEntry = 0;
+	m_numDone = 0;
+	m_bytesHeld = 0;
+	m_hasFoundNames = 0;
+	m_stopping = 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+void AssetPrefetcher::update()
+{
+	if (!m_hasFoundNames)
+		return;
+
+	std::vector<char> names;
+	{
+		ScopedCriticalSection lock(&m_foundNamesLock);
+		names.swap(m_foundNames);
+		m_hasFoundNames = 0;
+	}
+
+	for (size_t i = 0; i < names.size(); i += strlen(&names[i]) + 1)
+		queueFoundFile(&names[i]);
+}
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+void AssetPrefetcher::foundFile(const char *name, Int length)
+{
+	ScopedCriticalSection lock(&m_foundNamesLock);
+	m_foundNames.insert(m_foundNames.end(), name, name + length);
+	m_foundNames.push_back(0);
+	m_hasFoundNames = 1;
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Queue filename to be read through, unless it's already queued. Returns FALSE if it isn't
+	* archived, so the caller can try another name for it, or if there's no room left. */
+//-------------------------------------------------------------------------------------------------
+bool AssetPrefetcher::warmFile(const AsciiString &filename)
+{
+	if (m_numEntries >= (Int)m_entries.size())
+		return FALSE;
+
+	char normalized[_MAX_PATH];
+	Entry &entry = m_entries[m_numEntries];
+	if (!locateFile(filename, normalized, sizeof(normalized), entry))
+		return FALSE;
+
+	if (m_index.find(normalized) == NULL)
+	{
+		bool isNew;
+		m_warmIndex.insert(AsciiString(normalized), &isNew);
+		if (isNew)
+		{
+			// fill the entry in before the workers can see it
+			entry.warmOnly = TRUE;
+			InterlockedIncrement(&m_numEntries);
+		}
+	}
+	return TRUE;
+}
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+bool AssetPrefetcher::takeFile(const Char *filename, char **data, Int *size)
+{
+	if (m_numFiles == 0)
+		return FALSE;
+
+	const Int *index = m_index.find(filename);
+	if (index == NULL)
+		return FALSE;
+
+	Entry &entry = m_entries[*index];
+	for (;;)
+	{
+		switch (entry.state)
+		{
+			case ENTRY_QUEUED:
+				// the caller reads it now anyway, so the workers don't need to
+				if (InterlockedCompareExchange(&entry.state, ENTRY_TAKEN, ENTRY_QUEUED) == ENTRY_QUEUED)
+				{
+					InterlockedIncrement(&m_numDone);
+					return FALSE;
+				}
+				break;
+
+			case ENTRY_LOADING:
+				Sleep(0);	// it is on its way, which is sooner than reading it again
+				break;
+
+			case ENTRY_DONE:
+				InterlockedExchange(&entry.state, ENTRY_TAKEN);
+				InterlockedExchangeAdd(&m_bytesHeld, -(LONG)entry.info.m_size);
+				*data = entry.data;
+				*size = (Int)entry.info.m_size;
+				entry.data = NULL;
+				return TRUE;
+
+			default:
+				return FALSE;
+		}
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+DWORD WINAPI AssetPrefetcher::workerThread(LPVOID param)
+{
+	ScopedMemoryPoolThreadCache threadCache;	// hand our cached pool blocks back on the way out
+	((AssetPrefetcher *)param)->work();
+	return 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Wait until size more bytes fit under MAX_PREFETCHED_BYTES. A file bigger than that is read anyway
+	* once nothing else is held. Returns FALSE if the prefetcher is being stopped. */
+//-------------------------------------------------------------------------------------------------
+bool AssetPrefetcher::waitForBudget(Int size)
+{
+	while (!m_stopping)
+	{
+		LONG held = m_bytesHeld;
+		if (held == 0 || held + size <= MAX_PREFETCHED_BYTES)
+		{
+			if (InterlockedCompareExchange(&m_bytesHeld, held + size, held) == held)
+				return TRUE;
+		}
+		else
+		{
+			Sleep(1);
+		}
+	}
+	return FALSE;
+}
+
+//-------------------------------------------------------------------------------------------------
+/** The next entry for this worker to read, the files to read now and those found in them first,
+	* or NULL if there is none right now. */
+//-------------------------------------------------------------------------------------------------
+AssetPrefetcher::Entry *AssetPrefetcher::claimEntry()
+{
+	for (;;)
+	{
+		LONG next = m_nextEntry;
+		if (next >= m_numEntries)
+			break;
+		if (InterlockedCompareExchange(&m_nextEntry, next + 1, next) == next)
+			return &m_entries[next];
+	}
+
+	if (m_nextBackgroundEntry < (LONG)m_backgroundEntries.size())
+	{
+		LONG next = InterlockedIncrement(&m_nextBackgroundEntry) - 1;
+		if (next < (LONG)m_backgroundEntries.size())
+			return &m_backgroundEntries[next];
+	}
+	return NULL;
+}
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+void AssetPrefetcher::work()
+{
+	char *scratch = NULL;	// where the files that are only read through go
+	Int scratchSize = 0;
+
+	while (!m_stopping)
+	{
+		Entry *entry = claimEntry();
+		if (entry == NULL)
+			Sleep(1);	// the main thread may still queue files found in the ones being read
+		else if (entry->warmOnly)
+			warmEntry(*entry, scratch, scratchSize);
+		else
+			readEntry(*entry);
+	}
+
+	delete [] scratch;
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Read a file the main thread is going to take. */
+//-------------------------------------------------------------------------------------------------
+void AssetPrefetcher::readEntry(Entry &entry)
+{
+	// get the budget before claiming the entry, the main thread may be waiting for it once it's claimed
+	Int size = (Int)entry.info.m_size;
+	if (entry.state != ENTRY_QUEUED)
+		return;	// already taken
+
+	// a mapped file is never copied, there is nothing to hand over
+	if (entry.mappedData != NULL)
+	{
+		if (InterlockedCompareExchange(&entry.state, ENTRY_TAKEN, ENTRY_QUEUED) == ENTRY_QUEUED)
+		{
+			touchPages(entry.mappedData, size);
+			if (entry.scanned)
+				scanFile(entry.mappedData, size);
+			InterlockedIncrement(&m_numDone);
+		}
+		return;
+	}
+	if (!waitForBudget(size))
+		return;
+	if (InterlockedCompareExchange(&entry.state, ENTRY_LOADING, ENTRY_QUEUED) != ENTRY_QUEUED)
+	{
+		InterlockedExchangeAdd(&m_bytesHeld, -size);
+		return;
+	}
+
+	char *data = MSGNEW("AssetPrefetcher") char[size];
+	if (entry.archive->readFileData(&entry.info, data))
+	{
+		// scan it first, the main thread may take the data away as soon as it's done
+		if (entry.scanned)
+			scanFile(data, size);
+		entry.data = data;
+		InterlockedExchange(&entry.state, ENTRY_DONE);
+	}
+	else
+	{
+		delete [] data;
+		InterlockedExchangeAdd(&m_bytesHeld, -size);
+		InterlockedExchange(&entry.state, ENTRY_FAILED);
+	}
+	InterlockedIncrement(&m_numDone);
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Read a file through so the system caches it, into scratch, which grows to fit. */
+//-------------------------------------------------------------------------------------------------
+void AssetPrefetcher::warmEntry(Entry &entry, char *&scratch, Int &scratchSize)
+{
+	Int size = (Int)entry.info.m_size;
+	if (entry.mappedData != NULL)
+	{
+		touchPages(entry.mappedData, size);
+		return;
+	}
+
+	if (size > scratchSize)
+	{
+		delete [] scratch;
+		scratch = MSGNEW("AssetPrefetcher") char[size];
+		scratchSize = size;
+	}
+	entry.archive->readFileData(&entry.info, scratch);
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Read a byte of every page of data, so the system pages the mapped file in now, on this thread. */
+//-------------------------------------------------------------------------------------------------
+void AssetPrefetcher::touchPages(const char *data, Int size)
+{
+	volatile char sink = 0;
+	for (Int offset = 0; offset < size && !m_stopping; offset += PREFETCH_PAGE_SIZE)
+		sink = data[offset];
+	sink = data[size - 1];
+}
@@ -0,0 +1,250 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "PreRTS.h"	// This must go first in EVERY cpp file int the GameEngine
+#include "Common/CacheFile.h"
+
+#include "Common/file.h"
+#include "Common/LocalFileSystem.h"
+
+// A cache file is a header followed by the entries:
+//   UnsignedInt magic, version, format, number of entries
+//   for each entry: Int name length, name, FileInfo, UnsignedInt check, Int count, Int size, data
+// Everything is in the byte order of the machine that wrote it; it never leaves that machine.
+
+//-------------------------------------------------------------------------------------------------
+static bool readBytes(const char *&pos, const char *end, void *dest, Int size)
+{
+	if (size < 0 || end - pos < size)
+		return FALSE;
+	memcpy(dest, pos, size);
+	pos += size;
+	return TRUE;
+}
+
+//-------------------------------------------------------------------------------------------------
+static bool writeBytes(File *file, const void *src, Int size)
+{
+	return size == 0 || file->write(src, size) == size;
+}
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+CacheFile::CacheFile(UnsignedInt magic, UnsignedInt version, UnsignedInt format) :
+	m_magic(magic),
+	m_version(version),
+	m_format(format),
+	m_cacheData(NULL),
+	m_dirty(FALSE)
+{
+}
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+CacheFile::~CacheFile()
+{
+	clear();
+}
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+void CacheFile::clear()
+{
+	for (EntryMap::iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+	{
+		if (it->second.owned)
+			delete [] (char *)it->second.data;
+	}
+	m_entries.clear();
+
+	delete [] m_cacheData;
+	m_cacheData = NULL;
+}
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+AsciiString CacheFile::makeKey(const AsciiString &filename)
+{
+	AsciiString key = filename;
+	key.toLower();
+	return key;
+}
+
+//-------------------------------------------------------------------------------------------------
+/** The whole cache is read in one go, and entries point straight into it */
+//-------------------------------------------------------------------------------------------------
+void CacheFile::load(const AsciiString &cacheFile)
+{
+	clear();
+	m_cacheFile = cacheFile;
+	m_dirty = FALSE;
+
+	File *file = TheLocalFileSystem->openFile(cacheFile.str(), File::READ | File::BINARY);
+	if (file == NULL)
+	{
+		m_dirty = TRUE;	// there is none yet, so write one
+		return;
+	}
+
+	Int fileSize = file->size();
+	m_cacheData = file->readEntireAndClose();
+
+	const char *pos = m_cacheData;
+	const char *end = m_cacheData + fileSize;
+
+	UnsignedInt header[4];
+	if (!readBytes(pos, end, header, sizeof(header)) || header[0] != m_magic
+		|| header[1] != m_version || header[2] != m_format)
+	{
+		DEBUG_LOG(("CacheFile::load - '%s' is out of date, ignoring it\n", cacheFile.str()));
+		clear();
+		m_dirty = TRUE;
+		return;
+	}
+
+	for (UnsignedInt i = 0; i < header[3]; ++i)
+	{
+		Int nameLen = 0;
+		char name[_MAX_PATH];
+		Entry entry;
+		entry.owned = FALSE;
+		entry.used = FALSE;
+		if (!readBytes(pos, end, &nameLen, sizeof(nameLen)) || nameLen >= _MAX_PATH
+			|| !readBytes(pos, end, name, nameLen)
+			|| !readBytes(pos, end, &entry.info, sizeof(entry.info))
+			|| !readBytes(pos, end, &entry.check, sizeof(entry.check))
+			|| !readBytes(pos, end, &entry.count, sizeof(entry.count))
+			|| !readBytes(pos, end, &entry.size, sizeof(entry.size))
+			|| entry.size < 0 || entry.size > end - pos || !isValidEntry(pos, entry.size, entry.count))
+		{
+			DEBUG_LOG(("CacheFile::load - '%s' is damaged, ignoring it\n", cacheFile.str()));
+			clear();
+			m_dirty = TRUE;
+			return;
+		}
+		name[nameLen] = '\0';
+		entry.data = pos;
+		pos += entry.size;
+
+		m_entries[AsciiString(name)] = entry;
+	}
+
+	DEBUG_LOG(("CacheFile::load - %d entries in '%s'\n", m_entries.size(), cacheFile.str()));
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Entries that weren't used during this run are left out, so the files that are gone, or that
+	* are now found elsewhere, don't pile up */
+//-------------------------------------------------------------------------------------------------
+void CacheFile::save()
+{
+	if (m_cacheFile.isEmpty())
+		return;
+
+	UnsignedInt numUsed = 0;
+	EntryMap::const_iterator it;
+	for (it = m_entries.begin(); it != m_entries.end(); ++it)
+	{
+		if (it->second.used)
+			++numUsed;
+	}
+
+	if (!m_dirty && numUsed == m_entries.size())
+		return;
+
+	File *file = TheLocalFileSystem->openFile(m_cacheFile.str(), File::WRITE | File::CREATE | File::TRUNCATE | File::BINARY);
+	if (file == NULL)
+	{
+		DEBUG_LOG(("CacheFile::save - cannot write '%s'\n", m_cacheFile.str()));
+		return;
+	}
+
+	UnsignedInt header[4] = { m_magic, m_version, m_format, numUsed };
+	bool ok = writeBytes(file, header, sizeof(header));
+	for (it = m_entries.begin(); ok && it != m_entries.end(); ++it)
+	{
+		const Entry &entry = it->second;
+		if (!entry.used)
+			continue;
+
+		Int nameLen = it->first.getLength();
+		ok = writeBytes(file, &nameLen, sizeof(nameLen))
+			&& writeBytes(file, it->first.str(), nameLen)
+			&& writeBytes(file, &entry.info, sizeof(entry.info))
+			&& writeBytes(file, &entry.check, sizeof(entry.check))
+			&& writeBytes(file, &entry.count, sizeof(entry.count))
+			&& writeBytes(file, &entry.size, sizeof(entry.size))
+			&& writeBytes(file, entry.data, entry.size);
+	}
+	file->close();
+
+	if (!ok)
+	{
+		// a partly written cache would only be thrown away by load(), so get rid of it now
+		DEBUG_LOG(("CacheFile::save - failed writing '%s'\n", m_cacheFile.str()));
+		DeleteFile(m_cacheFile.str());
+		return;
+	}
+
+	m_dirty = FALSE;
+	DEBUG_LOG(("CacheFile::save - %d entries in '%s'\n", numUsed, m_cacheFile.str()));
+}
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+CacheFile::Entry *CacheFile::findEntry(const AsciiString &filename, const FileInfo &info, UnsignedInt check)
+{
+	EntryMap::iterator it = m_entries.find(makeKey(filename));
+	if (it == m_entries.end())
+		return NULL;
+
+	Entry &entry = it->second;
+	if (memcmp(&info, &entry.info, sizeof(info)) != 0 || entry.check != check)
+		return NULL;
+
+	entry.used = TRUE;
+	return &entry;
+}
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+void CacheFile::addEntry(const AsciiString &filename, const FileInfo &info, UnsignedInt check, Int count, const char *data, Int size)
+{
+	if (filename.getLength() >= _MAX_PATH)
+		return;
+
+	AsciiString key = makeKey(filename);
+	EntryMap::iterator it = m_entries.find(key);
+	if (it != m_entries.end() && it->second.owned)
+		delete [] (char *)it->second.data;
+
+	char *copy = NEW char[size + 1];	// never zero sized, an entry may be empty
+	if (size > 0)
+		memcpy(copy, data, size);
+
+	Entry entry;
+	entry.info = info;
+	entry.check = check;
+	entry.count = count;
+	entry.data = copy;
+	entry.size = size;
+	entry.owned = TRUE;
+	entry.used = TRUE;
+
+	m_entries[key] = entry;
+	m_dirty = TRUE;
+}
@@ -0,0 +1,190 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "PreRTS.h"	// This must go first in EVERY cpp file int the GameEngine
+#include "Common/CompressionBenchmark.h"
+
+#if defined(RTS_DEBUG) || defined(RTS_INTERNAL)
+
+#include "Compression.h"
+#include "Common/file.h"
+#include "Common/FileSystem.h"
+
+#include <vector>
+
+static const Int BENCHMARK_PASSES = 3;
+
+struct BenchmarkFile
+{
+	char *data;
+	Int size;
+};
+
+//-------------------------------------------------------------------------------------------------
+/** read every file matching fileMask, decompressing the ones that are stored compressed */
+//-------------------------------------------------------------------------------------------------
+static void readBenchmarkFiles(const char *fileMask, std::vector<BenchmarkFile> &files)
+{
+	char directory[_MAX_PATH];
+	strncpy(directory, fileMask, sizeof(directory) - 1);
+	directory[sizeof(directory) - 1] = '\0';
+	const char *searchName = fileMask;
+	char *slash = strrchr(directory, '\\');
+	char *forwardSlash = strrchr(directory, '/');
+	if (slash == NULL || (forwardSlash != NULL && forwardSlash > slash))
+		slash = forwardSlash;
+	if (slash != NULL)
+	{
+		searchName += slash - directory + 1;
+		slash[1] = '\0';
+	}
+	else
+	{
+		directory[0] = '\0';
+	}
+
+	FilenameList filenames;
+	TheFileSystem->getFileListInDirectory(directory, searchName, filenames, TRUE);
+
+	for (FilenameList::const_iterator it = filenames.begin(); it != filenames.end(); ++it)
+	{
+		File *file = TheFileSystem->openFile(it->str(), File::READ | File::BINARY);
+		if (file == NULL)
+			continue;
+
+		BenchmarkFile benchmarkFile;
+		benchmarkFile.size = file->size();
+		benchmarkFile.data = file->readEntireAndClose();
+		if (benchmarkFile.size <= 0)
+		{
+			delete [] benchmarkFile.data;
+			continue;
+		}
+
+		if (CompressionManager::isDataCompressed(benchmarkFile.data, benchmarkFile.size))
+		{
+			Int size = CompressionManager::getUncompressedSize(benchmarkFile.data, benchmarkFile.size);
+			char *data = NEW char[size];
+			size = CompressionManager::decompressData(benchmarkFile.data, benchmarkFile.size, data, size);
+			delete [] benchmarkFile.data;
+			if (size <= 0)
+			{
+				delete [] data;
+				continue;
+			}
+			benchmarkFile.data = data;
+			benchmarkFile.size = size;
+		}
+
+		files.push_back(benchmarkFile);
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+void benchmarkCompression(const char *fileMask)
+{
+	if (TheFileSystem == NULL)
+		return;
+
+	std::vector<BenchmarkFile> files;
+	readBenchmarkFiles(fileMask, files);
+	if (files.empty())
+	{
+		DEBUG_LOG(("benchmarkCompression - no files match %s\n", fileMask));
+		return;
+	}
+
+	Int totalSize = 0;
+	Int maxSize = 0;
+	size_t i;
+	for (i = 0; i < files.size(); ++i)
+	{
+		totalSize += files[i].size;
+		maxSize = max(maxSize, files[i].size);
+	}
+
+	Int64 freq;
+	QueryPerformanceFrequency((LARGE_INTEGER *)&freq);
+
+	DEBUG_LOG(("benchmarkCompression - %d files matching %s, %d bytes\n", files.size(), fileMask, totalSize));
+
+	for (Int type = COMPRESSION_REFPACK; type <= COMPRESSION_MAX; ++type)
+	{
+		CompressionType compType = (CompressionType)type;
+		if (compType == COMPRESSION_NOXLZH)
+			continue;	// it only writes a header
+
+		// the EAC codecs aren't told how big dest is, and their max size is only a guess, so leave them room
+		Int destLen = CompressionManager::getMaxCompressedSize(maxSize, compType) + maxSize / 8 + 64;
+		UnsignedByte *compressed = NEW UnsignedByte[destLen];
+		UnsignedByte *decompressed = NEW UnsignedByte[maxSize];
+
+		Int64 compressTicks = 0;
+		Int64 decompressTicks = 0;
+		Int compressedSize = 0;
+		Int numFailed = 0;
+
+		for (i = 0; i < files.size(); ++i)
+		{
+			const BenchmarkFile &file = files[i];
+			Int64 start, end;
+			Int size = 0;
+
+			QueryPerformanceCounter((LARGE_INTEGER *)&start);
+			for (Int pass = 0; pass < BENCHMARK_PASSES; ++pass)
+				size = CompressionManager::compressData(compType, file.data, file.size, compressed, destLen);
+			QueryPerformanceCounter((LARGE_INTEGER *)&end);
+			compressTicks += end - start;
+
+			if (size == 0)
+			{
+				++numFailed;
+				continue;
+			}
+			compressedSize += size;
+
+			Int decompressedSize = 0;
+			QueryPerformanceCounter((LARGE_INTEGER *)&start);
+			for (Int pass = 0; pass < BENCHMARK_PASSES; ++pass)
+				decompressedSize = CompressionManager::decompressData(compressed, size, decompressed, file.size);
+			QueryPerformanceCounter((LARGE_INTEGER *)&end);
+			decompressTicks += end - start;
+
+			if (decompressedSize != file.size || memcmp(decompressed, file.data, file.size) != 0)
+				++numFailed;
+		}
+
+		delete [] compressed;
+		delete [] decompressed;
+
+		double megabytes = (double)totalSize * BENCHMARK_PASSES / (1024.0 * 1024.0);
+		DEBUG_LOG(("benchmarkCompression - %-16s %5.1f%% of the size, compress %7.1f MB/s, decompress %7.1f MB/s, %d failed\n",
+			CompressionManager::getCompressionNameByType(compType),
+			100.0 * (double)compressedSize / (double)totalSize,
+			megabytes / ((double)compressTicks / (double)freq),
+			decompressTicks ? megabytes / ((double)decompressTicks / (double)freq) : 0.0,
+			numFailed));
+		DEBUG_ASSERTCRASH(numFailed == 0, ("benchmarkCompression - %s failed on %d files\n",
+			CompressionManager::getCompressionNameByType(compType), numFailed));
+	}
+
+	for (i = 0; i < files.size(); ++i)
+		delete [] files[i].data;
+}
+
+#endif // RTS_DEBUG || RTS_INTERNAL
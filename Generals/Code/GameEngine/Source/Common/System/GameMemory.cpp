@@ -197,6 +197,53 @@ DECLARE_PERF_TIMER(MemoryPoolInitFilling)
 
 static bool thePreMainInitFlag = false;
 static bool theMainInitFlag = false;
+static char theProfileFileName[_MAX_PATH] = "";	///< set by recordMemoryPoolProfile
+
+#ifdef MEMORYPOOL_MAGAZINES
+
+	#ifdef _MSC_VER
+		#define MEMORYPOOL_THREAD_LOCAL __declspec(thread)
+	#else
+		#define MEMORYPOOL_THREAD_LOCAL __thread
+	#endif
+
+	enum
+	{
+		MAX_MAGAZINE_POOLS	= 1024,	///< pools created after this many just don't get magazines
+		MAGAZINE_CAPACITY		= 32,		///< max blocks cached per thread per pool
+		MAGAZINE_BATCH			= 16		///< blocks moved between a magazine and its pool per lock
+	};
+
+	/**
+		a thread's private stack of free blocks for one pool. the blocks are still taken
+		from the blobs as far as m_usedBlocksInPool is concerned (getCachedBlockCount tells
+		them apart); they go back to the blobs when the magazine overflows or is flushed.
+	*/
+	struct MemoryPoolMagazine
+	{
+		UnsignedInt							m_generation;								///< matches theMagazineGenerations[slot] while the blocks are valid
+		Int											m_count;										///< number of blocks in m_blocks
+		MemoryPoolSingleBlock		*m_blocks[MAGAZINE_CAPACITY];	///< most recently freed block is on top
+	};
+
+	/// all of a thread's magazines, indexed by MemoryPool::m_magazineSlot. (allocated on first use)
+	struct MemoryPoolThreadCache
+	{
+		MemoryPoolThreadCache		*m_next;										///< linked list of every thread's cache, so they can be counted
+		MemoryPoolThreadCache		*m_prev;
+		MemoryPoolMagazine			*m_magazines[MAX_MAGAZINE_POOLS];
+	};
+
+	static MEMORYPOOL_THREAD_LOCAL MemoryPoolThreadCache *theThreadCache = NULL;
+
+	// these are only written under TheMemoryPoolCriticalSection.
+	static MemoryPoolThreadCache *theFirstThreadCache = NULL;						///< caches stay on this list until flushed
+	static MemoryPool *theMagazinePools[MAX_MAGAZINE_POOLS];						///< the pool using each slot, or null once destroyed
+	static UnsignedInt theMagazineGenerations[MAX_MAGAZINE_POOLS];			///< bumped whenever a pool's blobs are thrown away
+	static Int theNextMagazineSlot = 0;
+	static bool theMagazinesEnabled = true;															///< only turned off by benchmarkMemoryPools
+
+#endif
 
 // ----------------------------------------------------------------------------
 // PRIVATE PROTOTYPES 
@@ -1525,9 +1572,13 @@ MemoryPool::MemoryPool() :
 	m_usedBlocksInPool(0),
 	m_totalBlocksInPool(0),
 	m_peakUsedBlocksInPool(0),
+	m_blobGrowthCount(0),
 	m_firstBlob(NULL),
 	m_lastBlob(NULL),
 	m_firstBlobWithFreeBlocks(NULL)
+#ifdef MEMORYPOOL_MAGAZINES
+	, m_magazineSlot(-1)
+#endif
 {
 }
 
@@ -1546,10 +1597,24 @@ void MemoryPool::init(MemoryPoolFactory *factory, const char *poolName, Int allo
 	m_usedBlocksInPool = 0;
 	m_totalBlocksInPool = 0;
 	m_peakUsedBlocksInPool = 0;
+	m_blobGrowthCount = 0;
 	m_firstBlob = NULL;
 	m_lastBlob = NULL;
 	m_firstBlobWithFreeBlocks = NULL;
 
+#ifdef MEMORYPOOL_MAGAZINES
+	// reset() calls us again, but the pool keeps its slot.
+	if (m_magazineSlot < 0)
+	{
+		ScopedCriticalSection scopedCriticalSection(TheMemoryPoolCriticalSection);
+		if (theNextMagazineSlot < MAX_MAGAZINE_POOLS)
+		{
+			m_magazineSlot = theNextMagazineSlot++;
+			theMagazinePools[m_magazineSlot] = this;
+		}
+	}
+#endif
+
 	// go ahead and init the initial block here (will throw on failure)
 	createBlob(m_initialAllocationCount);
 }
@@ -1560,6 +1625,16 @@ void MemoryPool::init(MemoryPoolFactory *factory, const char *poolName, Int allo
 */
 MemoryPool::~MemoryPool()
 {   
+#ifdef MEMORYPOOL_MAGAZINES
+	if (m_magazineSlot >= 0)
+	{
+		// any blocks still sitting in magazines are about to vanish with the blobs.
+		ScopedCriticalSection scopedCriticalSection(TheMemoryPoolCriticalSection);
+		++theMagazineGenerations[m_magazineSlot];
+		theMagazinePools[m_magazineSlot] = NULL;
+	}
+#endif
+
 	// toss everything. we could do this slightly more efficiently,
 	// but not really worth the extra code to do so.
 	while (m_firstBlob) 
@@ -1648,8 +1723,29 @@ Int MemoryPool::freeBlob(MemoryPoolBlob* blob)
 */
 void* MemoryPool::allocateBlockDoNotZeroImplementation(DECLARE_LITERALSTRING_ARG1)
 {
+#ifdef MEMORYPOOL_MAGAZINES
+	MemoryPoolMagazine *magazine = getThreadMagazine();
+	if (magazine)
+	{
+		if (magazine->m_count == 0)
+			refillMagazine(magazine);	// throws on failure
+		return magazine->m_blocks[--magazine->m_count]->getUserData();
+	}
+#endif
+
 	ScopedCriticalSection scopedCriticalSection(TheMemoryPoolCriticalSection);
 
+	return allocateBlockFromBlobs(PASS_LITERALSTRING_ARG1)->getUserData();
+}
+
+//-----------------------------------------------------------------------------
+/**
+	take a block from the first blob that has one, growing the pool if need be.
+	the caller must hold TheMemoryPoolCriticalSection. if unable to allocate, 
+	throw ERROR_OUT_OF_MEMORY. this function will never return null.
+*/
+MemoryPoolSingleBlock *MemoryPool::allocateBlockFromBlobs(DECLARE_LITERALSTRING_ARG1)
+{
 	if (m_firstBlobWithFreeBlocks != NULL && !m_firstBlobWithFreeBlocks->hasAnyFreeBlocks()) 
 	{
 		// hmm... the current 'free' blob has nothing available. look and see if there
@@ -1677,6 +1773,11 @@ void* MemoryPool::allocateBlockDoNotZeroImplementation(DECLARE_LITERALSTRING_ARG
 		else 
 		{
 			createBlob(m_overflowAllocationCount); // throws on failure
+			++m_blobGrowthCount;
+			if (theProfileFileName[0])
+			{
+				DEBUG_LOG(("Pool %s grew to %d blocks (%d used, %d cached)\n", m_poolName, m_totalBlocksInPool, getUsedBlockCount(), getCachedBlockCount()));
+			}
 		}
 	}
 	
@@ -1708,7 +1809,7 @@ void* MemoryPool::allocateBlockDoNotZeroImplementation(DECLARE_LITERALSTRING_ARG
 	#endif
 #endif
 
-	return block->getUserData();
+	return block;
 }
 
 //-----------------------------------------------------------------------------
@@ -1733,9 +1834,32 @@ void MemoryPool::freeBlock(void* pBlockPtr)
 	if (!pBlockPtr)
 		return;	// my, that was easy
 
+	MemoryPoolSingleBlock *block = MemoryPoolSingleBlock::recoverBlockFromUserData(pBlockPtr);
+
+#ifdef MEMORYPOOL_MAGAZINES
+	MemoryPoolMagazine *magazine = getThreadMagazine();
+	if (magazine)
+	{
+		DEBUG_ASSERTCRASH(block->getOwningBlob() && block->getOwningBlob()->getOwningPool() == this, ("block does not belong to this pool"));
+		if (magazine->m_count == MAGAZINE_CAPACITY)
+			flushMagazine(magazine, MAGAZINE_BATCH);
+		magazine->m_blocks[magazine->m_count++] = block;
+		return;
+	}
+#endif
+
 	ScopedCriticalSection scopedCriticalSection(TheMemoryPoolCriticalSection);
 
-	MemoryPoolSingleBlock *block = MemoryPoolSingleBlock::recoverBlockFromUserData(pBlockPtr);
+	freeBlockToBlobs(block);
+}
+
+//-----------------------------------------------------------------------------
+/**
+	give a block back to the blob it came from. the caller must hold 
+	TheMemoryPoolCriticalSection.
+*/
+void MemoryPool::freeBlockToBlobs(MemoryPoolSingleBlock *block)
+{
 	MemoryPoolBlob *blob = block->getOwningBlob();
 #ifdef MEMORYPOOL_DEBUG
 	const char* tagString = block->debugGetLiteralTagString();
@@ -1772,6 +1896,113 @@ void MemoryPool::freeBlock(void* pBlockPtr)
 #endif
 }
 
+#ifdef MEMORYPOOL_MAGAZINES
+//-----------------------------------------------------------------------------
+/**
+	return the calling thread's magazine for this pool, creating it if necessary.
+	a magazine left over from before the pool was reset comes back empty. returns
+	null if this pool doesn't use magazines.
+*/
+MemoryPoolMagazine *MemoryPool::getThreadMagazine()
+{
+	if (m_magazineSlot < 0 || !theMagazinesEnabled)
+		return NULL;
+
+	MemoryPoolThreadCache *cache = theThreadCache;
+	if (cache == NULL)
+	{
+		cache = (MemoryPoolThreadCache *)::sysAllocate(sizeof(MemoryPoolThreadCache));	// will throw on failure
+		theThreadCache = cache;
+
+		ScopedCriticalSection scopedCriticalSection(TheMemoryPoolCriticalSection);
+		cache->m_next = theFirstThreadCache;
+		if (theFirstThreadCache)
+			theFirstThreadCache->m_prev = cache;
+		theFirstThreadCache = cache;
+	}
+
+	MemoryPoolMagazine *magazine = cache->m_magazines[m_magazineSlot];
+	if (magazine == NULL)
+	{
+		magazine = (MemoryPoolMagazine *)::sysAllocate(sizeof(MemoryPoolMagazine));	// will throw on failure
+		magazine->m_generation = theMagazineGenerations[m_magazineSlot];
+		cache->m_magazines[m_magazineSlot] = magazine;
+	}
+	else if (magazine->m_generation != theMagazineGenerations[m_magazineSlot])
+	{
+		// the blobs these came from are gone; just forget them.
+		magazine->m_generation = theMagazineGenerations[m_magazineSlot];
+		magazine->m_count = 0;
+	}
+
+	return magazine;
+}
+
+//-----------------------------------------------------------------------------
+/**
+	return how many of our blocks sit in threads' magazines. the owning threads don't
+	lock to take or put a block, so this is a snapshot; it's meant for reports.
+*/
+Int MemoryPool::getCachedBlockCount()
+{
+	if (m_magazineSlot < 0)
+		return 0;
+
+	ScopedCriticalSection scopedCriticalSection(TheMemoryPoolCriticalSection);
+
+	Int cached = 0;
+	for (MemoryPoolThreadCache *cache = theFirstThreadCache; cache; cache = cache->m_next)
+	{
+		const MemoryPoolMagazine *magazine = cache->m_magazines[m_magazineSlot];
+		if (magazine && magazine->m_generation == theMagazineGenerations[m_magazineSlot])
+			cached += magazine->m_count;
+	}
+	return cached;
+}
+
+//-----------------------------------------------------------------------------
+/**
+	fill an empty magazine with up to MAGAZINE_BATCH blocks under a single lock. we
+	only grow the pool for the first one; the rest must already be free, so that
+	caching never makes a pool allocate more blobs than it otherwise would.
+*/
+void MemoryPool::refillMagazine(MemoryPoolMagazine *magazine)
+{
+	DEBUG_ASSERTCRASH(magazine->m_count == 0, ("refilling a nonempty magazine"));
+
+	ScopedCriticalSection scopedCriticalSection(TheMemoryPoolCriticalSection);
+
+	magazine->m_blocks[magazine->m_count++] = allocateBlockFromBlobs();	// throws on failure
+	while (magazine->m_count < MAGAZINE_BATCH && m_usedBlocksInPool < m_totalBlocksInPool)
+	{
+		magazine->m_blocks[magazine->m_count++] = allocateBlockFromBlobs();
+	}
+}
+
+//-----------------------------------------------------------------------------
+/**
+	return the oldest 'count' blocks in the magazine to the blobs under a single
+	lock, keeping the most recently freed (and so most likely cached) blocks.
+*/
+void MemoryPool::flushMagazine(MemoryPoolMagazine *magazine, Int count)
+{
+	DEBUG_ASSERTCRASH(count >= 0 && count <= magazine->m_count, ("bad flush count %d",count));
+	if (count <= 0)
+		return;
+
+	{
+		ScopedCriticalSection scopedCriticalSection(TheMemoryPoolCriticalSection);
+		for (Int i = 0; i < count; ++i)
+		{
+			freeBlockToBlobs(magazine->m_blocks[i]);
+		}
+	}
+
+	magazine->m_count -= count;
+	memmove(&magazine->m_blocks[0], &magazine->m_blocks[count], magazine->m_count * sizeof(magazine->m_blocks[0]));
+}
+#endif
+
 //-----------------------------------------------------------------------------
 Int MemoryPool::countBlobsInPool()
 {
@@ -1792,6 +2023,13 @@ Int MemoryPool::countBlobsInPool()
 */
 Int MemoryPool::releaseEmpties()
 {
+#ifdef MEMORYPOOL_MAGAZINES
+	// our own cached blocks would keep their blobs alive. (other threads' can't be helped.)
+	MemoryPoolMagazine *magazine = getThreadMagazine();
+	if (magazine)
+		flushMagazine(magazine, magazine->m_count);
+#endif
+
 	ScopedCriticalSection scopedCriticalSection(TheMemoryPoolCriticalSection);
 
 	Int released = 0;
@@ -1815,6 +2053,12 @@ void MemoryPool::reset()
 {
 	ScopedCriticalSection scopedCriticalSection(TheMemoryPoolCriticalSection);
 
+#ifdef MEMORYPOOL_MAGAZINES
+	// every thread's cached blocks for this pool are about to go away with the blobs.
+	if (m_magazineSlot >= 0)
+		++theMagazineGenerations[m_magazineSlot];
+#endif
+
 	// toss everything. we could do this slightly more efficiently,
 	// but not really worth the extra code to do so.
 	while (m_firstBlob) 
@@ -3070,6 +3314,49 @@ void MemoryPoolFactory::memoryPoolUsageReport( const char* filename, FILE *appen
 #endif
 }
 
+//-----------------------------------------------------------------------------
+/**
+	write a profile of every pool that was used this run, in the same "name initial overflow"
+	format as MemoryPools.ini, suitable for use as MemoryPoolProfile.ini. the initial count is
+	the peak number of live blocks plus some headroom, so that a similar run should never need
+	an overflow blob; the overflow count is left alone. unused pools are left out, so they keep
+	whatever size they would have had.
+*/
+void MemoryPoolFactory::memoryPoolProfileReport( const char* filename )
+{
+	const Int PROFILE_HEADROOM_DIVISOR = 8;	// 1/8 more than the peak
+
+	FILE* fp = fopen(filename, "w");
+	if (fp == NULL)
+	{
+		DEBUG_CRASH(("could not open/create pool profile %s",filename));
+		return;
+	}
+
+	fprintf(fp, "; MemoryPoolProfile.ini -- written by -recordPoolProfile\n");
+	fprintf(fp, "; pool, initial count, overflow count ; peak blocks used or cached, overflow blobs created, blocks used and cached now\n");
+
+	for (MemoryPool *pool = m_firstPoolInFactory; pool; pool = pool->getNextPoolInList())
+	{
+		// cached blocks were taken from the blobs too, so the pool must have room for them
+		Int peak = pool->getPeakBlockCount();
+		if (peak <= 0)
+			continue;
+
+		Int initial = ::roundUpMemBound(peak + peak / PROFILE_HEADROOM_DIVISOR);
+		fprintf(fp, "%s %d %d ; peak %d, grew %d, used %d, cached %d\n", pool->getPoolName(), initial, pool->getOverflowBlockCount(), 
+			peak, pool->getBlobGrowthCount(), pool->getUsedBlockCount(), pool->getCachedBlockCount());
+
+		if (pool->getBlobGrowthCount() > 0)
+		{
+			DEBUG_LOG(("Pool %s grew %d times (initial %d, peak %d)\n", pool->getPoolName(), 
+				pool->getBlobGrowthCount(), pool->getInitialBlockCount(), peak));
+		}
+	}
+
+	fclose(fp);
+}
+
 //-----------------------------------------------------------------------------
 #ifdef MEMORYPOOL_DEBUG
 /**
@@ -3524,6 +3811,8 @@ void shutdownMemoryManager()
 	}
 	else
 	{
+		flushMemoryPoolThreadCache();
+
 		if (TheDynamicMemoryAllocator)
 		{
 			DEBUG_ASSERTCRASH(TheMemoryPoolFactory, ("hmm, no factory"));
@@ -3552,6 +3841,216 @@ void shutdownMemoryManager()
 	theMainInitFlag = false;
 }
 
+//-----------------------------------------------------------------------------
+/**
+	remember where to write the pool profile, and start logging pool growth.
+*/
+void recordMemoryPoolProfile(const char *fileName)
+{
+	strncpy(theProfileFileName, fileName, sizeof(theProfileFileName) - 1);
+	theProfileFileName[sizeof(theProfileFileName) - 1] = 0;
+}
+
+//-----------------------------------------------------------------------------
+/**
+	write the pool profile if one was asked for. call this at the end of the run,
+	while TheMemoryPoolFactory still exists.
+*/
+void writeMemoryPoolProfile()
+{
+	if (theProfileFileName[0] && TheMemoryPoolFactory)
+		TheMemoryPoolFactory->memoryPoolProfileReport(theProfileFileName);
+}
+
+//-----------------------------------------------------------------------------
+/**
+	give everything the calling thread has cached back to the pools, and throw
+	away its magazines. magazines for pools that have since been reset or
+	destroyed are just discarded.
+*/
+void flushMemoryPoolThreadCache()
+{
+#ifdef MEMORYPOOL_MAGAZINES
+	MemoryPoolThreadCache *cache = theThreadCache;
+	if (cache == NULL)
+		return;
+
+	theThreadCache = NULL;
+
+	{
+		// once off the list, nobody else looks at our magazines
+		ScopedCriticalSection scopedCriticalSection(TheMemoryPoolCriticalSection);
+		if (cache->m_prev)
+			cache->m_prev->m_next = cache->m_next;
+		else
+			theFirstThreadCache = cache->m_next;
+		if (cache->m_next)
+			cache->m_next->m_prev = cache->m_prev;
+	}
+
+	for (Int slot = 0; slot < MAX_MAGAZINE_POOLS; ++slot)
+	{
+		MemoryPoolMagazine *magazine = cache->m_magazines[slot];
+		if (magazine == NULL)
+			continue;
+
+		{
+			ScopedCriticalSection scopedCriticalSection(TheMemoryPoolCriticalSection);
+			MemoryPool *pool = theMagazinePools[slot];
+			if (pool && magazine->m_generation == theMagazineGenerations[slot])
+				pool->flushMagazine(magazine, magazine->m_count);
+		}
+
+		::sysFree((void *)magazine);
+	}
+
+	::sysFree((void *)cache);
+#endif
+}
+
+//-----------------------------------------------------------------------------
+#if defined(RTS_DEBUG) || defined(RTS_INTERNAL)
+
+enum
+{
+	BENCHMARK_POOL_COUNT		= 3,
+	BENCHMARK_LIVE_BLOCKS		= 256,	///< blocks each thread holds per pool at the peak of a round
+	BENCHMARK_ROUNDS				= 2000,
+	MAX_BENCHMARK_THREADS		= 16
+};
+
+static MemoryPool *theBenchmarkPools[BENCHMARK_POOL_COUNT];
+
+//-----------------------------------------------------------------------------
+/**
+	allocate a batch from every pool, interleaved the way the game does it, then
+	free it again in a different order so the blocks don't come back in LIFO order.
+*/
+static DWORD WINAPI benchmarkMemoryPoolsThread(LPVOID)
+{
+	void *live[BENCHMARK_POOL_COUNT][BENCHMARK_LIVE_BLOCKS];
+
+	for (Int round = 0; round < BENCHMARK_ROUNDS; ++round)
+	{
+		Int i, p;
+		for (i = 0; i < BENCHMARK_LIVE_BLOCKS; ++i)
+		{
+			for (p = 0; p < BENCHMARK_POOL_COUNT; ++p)
+				live[p][i] = theBenchmarkPools[p]->allocateBlockDoNotZero("benchmarkMemoryPools");
+		}
+		for (i = 0; i < BENCHMARK_LIVE_BLOCKS; ++i)
+		{
+			Int j = (i * 7) % BENCHMARK_LIVE_BLOCKS;	// 7 is coprime with the block count, so this hits each once
+			for (p = 0; p < BENCHMARK_POOL_COUNT; ++p)
+				theBenchmarkPools[p]->freeBlock(live[p][j]);
+		}
+	}
+
+	flushMemoryPoolThreadCache();
+	return 0;
+}
+
+//-----------------------------------------------------------------------------
+/** run benchmarkMemoryPoolsThread on numThreads threads at once and return the elapsed seconds. */
+static double timeBenchmarkMemoryPools(Int numThreads)
+{
+	HANDLE threads[MAX_BENCHMARK_THREADS];
+	__int64 freq, start, end;
+
+	QueryPerformanceFrequency((LARGE_INTEGER *)&freq);
+	QueryPerformanceCounter((LARGE_INTEGER *)&start);
+
+	Int created = 0;
+	for (; created < numThreads; ++created)
+	{
+		DWORD threadID;
+		threads[created] = ::CreateThread(NULL, 0, benchmarkMemoryPoolsThread, NULL, 0, &threadID);
+		if (threads[created] == NULL)
+		{
+			DEBUG_CRASH(("benchmarkMemoryPools: could not create thread %d", created));
+			break;
+		}
+	}
+	if (created > 0)
+		::WaitForMultipleObjects(created, threads, TRUE, INFINITE);
+
+	QueryPerformanceCounter((LARGE_INTEGER *)&end);
+
+	for (Int i = 0; i < created; ++i)
+		::CloseHandle(threads[i]);
+
+	return (double)(end - start) / (double)freq;
+}
+
+//-----------------------------------------------------------------------------
+void benchmarkMemoryPools(Int numThreads)
+{
+	if (!TheMemoryPoolFactory)
+		return;
+
+	numThreads = max(1, min((Int)MAX_BENCHMARK_THREADS, numThreads));
+
+	// take the real block sizes if those pools exist yet. PathfindCellInfo has its own
+	// pool outside the factory, so PathNodePool stands in for the pathfinder.
+	static const PoolInitRec lookalikes[BENCHMARK_POOL_COUNT] = 
+	{
+		{ "GameMessage",		48,		BENCHMARK_LIVE_BLOCKS, BENCHMARK_LIVE_BLOCKS },
+		{ "PathNodePool",		64,		BENCHMARK_LIVE_BLOCKS, BENCHMARK_LIVE_BLOCKS },
+		{ "ParticlePool",		224,	BENCHMARK_LIVE_BLOCKS, BENCHMARK_LIVE_BLOCKS },
+	};
+	static const char *benchmarkPoolNames[BENCHMARK_POOL_COUNT] = 
+	{
+		"BenchmarkGameMessagePool",
+		"BenchmarkPathfindPool",
+		"BenchmarkParticlePool",
+	};
+
+	Int p;
+	for (p = 0; p < BENCHMARK_POOL_COUNT; ++p)
+	{
+		MemoryPool *real = TheMemoryPoolFactory->findMemoryPool(lookalikes[p].poolName);
+		Int size = real ? real->getAllocationSize() : lookalikes[p].allocationSize;
+		theBenchmarkPools[p] = TheMemoryPoolFactory->createMemoryPool(benchmarkPoolNames[p], size, 
+			lookalikes[p].initialAllocationCount, lookalikes[p].overflowAllocationCount);
+	}
+
+#ifdef MEMORYPOOL_MAGAZINES
+	bool wasEnabled = theMagazinesEnabled;
+#endif
+
+	const Int ops = BENCHMARK_ROUNDS * BENCHMARK_LIVE_BLOCKS * BENCHMARK_POOL_COUNT * 2;
+	for (Int pass = 0; pass < 2; ++pass)
+	{
+		bool useMagazines = (pass == 1);
+#ifdef MEMORYPOOL_MAGAZINES
+		flushMemoryPoolThreadCache();
+		theMagazinesEnabled = useMagazines;
+#else
+		if (useMagazines)
+		{
+			DEBUG_LOG(("benchmarkMemoryPools: magazines are not compiled into this build\n"));
+			break;
+		}
+#endif
+		double single = timeBenchmarkMemoryPools(1);
+		double multi = timeBenchmarkMemoryPools(numThreads);
+		DEBUG_LOG(("benchmarkMemoryPools: magazines %s: 1 thread %.1f Mops/s, %d threads %.1f Mops/s\n",
+			useMagazines ? "on" : "off", ops / single / 1.0e6, numThreads, ops * numThreads / multi / 1.0e6));
+	}
+
+#ifdef MEMORYPOOL_MAGAZINES
+	theMagazinesEnabled = wasEnabled;
+#endif
+
+	for (p = 0; p < BENCHMARK_POOL_COUNT; ++p)
+	{
+		TheMemoryPoolFactory->destroyMemoryPool(theBenchmarkPools[p]);
+		theBenchmarkPools[p] = NULL;
+	}
+}
+
+#endif
+
 //-----------------------------------------------------------------------------
 void* createW3DMemPool(const char *poolName, int allocationSize)
 {
@@ -3584,3 +4083,9 @@ void freeFromW3DMemPool(void* pool, void* p)
 	DEBUG_ASSERTCRASH(pool, ("pool is null\n"));
 	((MemoryPool*)pool)->freeBlock(p);
 }
+
+//-----------------------------------------------------------------------------
+void flushW3DMemPoolThreadCache()
+{
+	flushMemoryPoolThreadCache();
+}
@@ -150,6 +150,30 @@ void shutdownMemoryManager()
 	theMainInitFlag = false;
 }
 
+//-----------------------------------------------------------------------------
+void flushMemoryPoolThreadCache()
+{
+}
+
+//-----------------------------------------------------------------------------
+void recordMemoryPoolProfile(const char *fileName)
+{
+	DEBUG_LOG(("recordMemoryPoolProfile: game memory is disabled in this build, no profile will be written\n"));
+}
+
+//-----------------------------------------------------------------------------
+void writeMemoryPoolProfile()
+{
+}
+
+//-----------------------------------------------------------------------------
+#if defined(RTS_DEBUG) || defined(RTS_INTERNAL)
+void benchmarkMemoryPools(Int numThreads)
+{
+	DEBUG_LOG(("benchmarkMemoryPools: game memory is disabled in this build, nothing to measure\n"));
+}
+#endif
+
 
 #ifndef DISABLE_GAMEMEMORY_NEW_OPERATORS
 
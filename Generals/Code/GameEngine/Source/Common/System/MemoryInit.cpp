@@ -671,9 +671,35 @@ static PoolSizeRec sizes[] =
 	{ 0, 0, 0 }
 };
 
+//-----------------------------------------------------------------------------
+// Sizes recorded by -recordPoolProfile (see GameMemory.h) and loaded from MemoryPoolProfile.ini.
+// These win over everything else, including sizes passed explicitly to createMemoryPool.
+// We're set up before the memory manager, so this can't be allocated dynamically.
+enum { MAX_PROFILED_POOLS = 1024, MAX_PROFILED_POOL_NAME = 64 };
+
+struct PoolProfileRec
+{
+	char name[MAX_PROFILED_POOL_NAME];
+	Int initial;
+	Int overflow;
+};
+
+static PoolProfileRec profile[MAX_PROFILED_POOLS];
+static Int profileCount = 0;
+
 //-----------------------------------------------------------------------------
 void userMemoryAdjustPoolSize(const char *poolName, Int& initialAllocationCount, Int& overflowAllocationCount)
 {
+	for (Int i = 0; i < profileCount; ++i)
+	{
+		if (stricmp(profile[i].name, poolName) == 0)
+		{
+			initialAllocationCount = profile[i].initial;
+			overflowAllocationCount = profile[i].overflow;
+			return;
+		}
+	}
+
 	if (initialAllocationCount > 0)
 		return;
 
@@ -702,17 +728,14 @@ static Int roundUpMemBound(Int i)
 }
 
 //-----------------------------------------------------------------------------
-void userMemoryManagerInitPools()
+/**
+	put the full path of the given file in our Data\INI dir into buf (which must be _MAX_PATH long).
+	since we're called prior to main, the cur dir might not be what
+	we expect. so do it the hard way.
+*/
+static void getIniPath(char *buf, const char *fileName)
 {
-	// note that we MUST use stdio stuff here, and not the normal game file system
-	// (with bigfile support, etc), because that relies on memory pools, which
-	// aren't yet initialized properly! so rely ONLY on straight stdio stuff here.
-	// (not even AsciiString. thanks.)
-	
-	// since we're called prior to main, the cur dir might not be what
-	// we expect. so do it the hard way.
-	char buf[_MAX_PATH];
-	::GetModuleFileName(NULL, buf, sizeof(buf));
+	::GetModuleFileName(NULL, buf, _MAX_PATH);
 	char* pEnd = buf + strlen(buf);
 	while (pEnd != buf) 
 	{
@@ -723,7 +746,20 @@ void userMemoryManagerInitPools()
 		}
 		--pEnd;
 	}
-	strcat(buf, "\\Data\\INI\\MemoryPools.ini");
+	strcat(buf, "\\Data\\INI\\");
+	strcat(buf, fileName);
+}
+
+//-----------------------------------------------------------------------------
+void userMemoryManagerInitPools()
+{
+	// note that we MUST use stdio stuff here, and not the normal game file system
+	// (with bigfile support, etc), because that relies on memory pools, which
+	// aren't yet initialized properly! so rely ONLY on straight stdio stuff here.
+	// (not even AsciiString. thanks.)
+	
+	char buf[_MAX_PATH];
+	getIniPath(buf, "MemoryPools.ini");
 
 	FILE* fp = fopen(buf, "r");
 	if (fp)
@@ -750,5 +786,33 @@ void userMemoryManagerInitPools()
 		}
 		fclose(fp);
 	}
+
+	// same format, but for any pool at all; see -recordPoolProfile.
+	getIniPath(buf, "MemoryPoolProfile.ini");
+	fp = fopen(buf, "r");
+	if (fp)
+	{
+		char poolName[256];
+		int initial, overflow;
+		profileCount = 0;
+		while (fgets(buf, _MAX_PATH, fp))
+		{
+			if (buf[0] == ';')
+				continue;
+			if (sscanf(buf, "%255s %d %d", poolName, &initial, &overflow ) != 3 || initial <= 0 || overflow < 0)
+				continue;
+			if (strlen(poolName) >= MAX_PROFILED_POOL_NAME || profileCount >= MAX_PROFILED_POOLS)
+			{
+				DEBUG_CRASH(("MemoryPoolProfile.ini: no room for pool %s\n", poolName));
+				continue;
+			}
+			PoolProfileRec& rec = profile[profileCount++];
+			strcpy(rec.name, poolName);
+			// currently, these must be multiples of 4. so round up. (but a pool that may not grow stays that way)
+			rec.initial = roundUpMemBound(initial);
+			rec.overflow = overflow > 0 ? roundUpMemBound(overflow) : 0;
+		}
+		fclose(fp);
+	}
 }
 
@@ -53,6 +53,7 @@
 #include <string.h>
 #include <sys/stat.h>
 
+#include "Common/ArchiveFile.h"
 #include "Common/AsciiString.h"
 #include "Common/FileSystem.h"
 #include "Common/RAMFile.h"
@@ -108,8 +109,9 @@ RAMFile::RAMFile()
 	m_data(NULL),
 //Added By Sadullah Nader
 //Initializtion(s) inserted
-	m_pos(0)
+	m_pos(0),
 //
+	m_sharedData(NULL)
 {
 
 }
@@ -126,9 +128,7 @@ RAMFile::RAMFile()
 
 RAMFile::~RAMFile()
 {
-	if (m_data != NULL) {
-		delete [] m_data;
-	}
+	releaseData();
 
 	File::close();
 
@@ -194,8 +194,7 @@ bool RAMFile::open( File *file )
 
 	if ( m_size < 0 )
 	{
-		delete [] m_data;
-		m_data = NULL;
+		releaseData();
 		return FALSE;
 	}
 
@@ -218,10 +217,7 @@ bool RAMFile::openFromArchive(File *archiveFile, const AsciiString& filename, In
 		return FALSE;
 	}
 
-	if (m_data != NULL) {
-		delete[] m_data;
-		m_data = NULL;
-	}
+	releaseData();
 	m_data = MSGNEW("RAMFILE") Char [size];	// pool[]ify
 	m_size = size;
 
@@ -236,6 +232,55 @@ bool RAMFile::openFromArchive(File *archiveFile, const AsciiString& filename, In
 	return TRUE;
 }
 
+//============================================================================
+// RAMFile::openFromSharedData
+//============================================================================
+/**
+	* The file data stays where it is in the archive's memory, and we hold a reference to it until
+	* we are closed, so the archive can be closed before we are.
+	*/
+bool RAMFile::openFromSharedData(SharedArchiveData *data, const AsciiString& filename, Int offset, Int size) 
+{
+	if (data == NULL || offset < 0 || size < 0 || offset > data->getSize() - size) {
+		return FALSE;
+	}
+
+	if (File::open(filename.str(), File::READ | File::BINARY) == FALSE) {
+		return FALSE;
+	}
+
+	releaseData();
+	data->addRef();
+	m_sharedData = data;
+	m_data = (Char *)data->getData() + offset;	// we never write to it
+	m_size = size;
+	m_nameStr = filename;
+
+	return TRUE;
+}
+
+//============================================================================
+// RAMFile::openFromBuffer
+//============================================================================
+bool RAMFile::openFromBuffer(char *data, const AsciiString& filename, Int size) 
+{
+	if (data == NULL) {
+		return FALSE;
+	}
+
+	if (File::open(filename.str(), File::READ | File::BINARY) == FALSE) {
+		delete[] data;
+		return FALSE;
+	}
+
+	releaseData();
+	m_data = data;
+	m_size = size;
+	m_nameStr = filename;
+
+	return TRUE;
+}
+
 //=================================================================
 // RAMFile::close 	
 //=================================================================
@@ -247,13 +292,27 @@ bool RAMFile::openFromArchive(File *archiveFile, const AsciiString& filename, In
 
 void RAMFile::close( void )
 {
-	if ( m_data )
+	releaseData();
+
+	File::close();
+}
+
+//=================================================================
+// RAMFile::releaseData 	
+//=================================================================
+
+void RAMFile::releaseData( void )
+{
+	if ( m_sharedData )
+	{
+		m_sharedData->release();
+		m_sharedData = NULL;
+	}
+	else if ( m_data )
 	{
 		delete [] m_data;
-		m_data = NULL;
 	}
-
-	File::close();
+	m_data = NULL;
 }
 
 //=================================================================
@@ -499,6 +558,15 @@ char* RAMFile::readEntireAndClose()
 		return NEW char[1];	// just to avoid crashing...
 	}
 
+	if (m_sharedData != NULL)
+	{
+		// the data isn't ours to give away; callers that can do without a copy use getData() instead
+		char* copy = MSGNEW("RAMFILE") char[m_size];
+		memcpy(copy, m_data, m_size);
+		close();
+		return copy;
+	}
+
 	char* tmp = m_data;
 	m_data = NULL;	// will belong to our caller!
 
@@ -540,7 +540,7 @@ AsciiString GameState::findNextSaveFilename( UnicodeString desc )
 	* NOTE: filename is a *filename only* */
 // ------------------------------------------------------------------------------------------------
 SaveCode GameState::saveGame( AsciiString filename, UnicodeString desc, 
-															SaveFileType saveType, SnapshotType which )
+															SaveFileType saveType, SnapshotType which, bool silent )
 {
 
 	// if there is no filename, this is a new file being created, find an appropriate filename
@@ -617,8 +617,11 @@ SaveCode GameState::saveGame( AsciiString filename, UnicodeString desc,
 	xferSave.close();
 
 	// print message to the user for game successfully saved
-	UnicodeString msg = TheGameText->fetch( "GUI:GameSaveComplete" );
-	TheInGameUI->message( msg );
+	if( silent == FALSE )
+	{
+		UnicodeString msg = TheGameText->fetch( "GUI:GameSaveComplete" );
+		TheInGameUI->message( msg );
+	}
 
 	return SC_OK;
 
@@ -828,6 +828,16 @@ void Xfer::xferUpgradeMask( UpgradeMaskType *upgradeMaskData )
 	
 }  // end xferUpgradeMask
 
+// ------------------------------------------------------------------------------------------------
+/** Only an XferCRC makes use of the cached CRC */
+// ------------------------------------------------------------------------------------------------
+void Xfer::xferCachedSnapshot( Snapshot *snapshot, CachedCRC *cachedCRC )
+{
+
+	xferSnapshot( snapshot );
+
+}  // end xferCachedSnapshot
+
 // ------------------------------------------------------------------------------------------------
 // ------------------------------------------------------------------------------------------------
 void Xfer::xferUser( void *data, Int dataSize )
@@ -38,13 +38,15 @@
 
 //-------------------------------------------------------------------------------------------------
 //-------------------------------------------------------------------------------------------------
-XferCRC::XferCRC( void )
+XferCRC::XferCRC( CRCKernel kernel )
 {
 
 	m_xferMode = XFER_CRC;
+	DEBUG_ASSERTCRASH( kernel >= 0 && kernel < CRC_KERNEL_COUNT, ("Unknown CRC kernel %d\n", kernel) );
+	m_kernel = kernel;
 	//Added By Sadullah Nader
 	//Initialization(s) inserted
-	m_crc = 0;
+	resetCRC();
 	//
 }  // end XferCRC
 
@@ -65,7 +67,7 @@ void XferCRC::open( AsciiString identifier )
 	Xfer::open( identifier );
 
 	// initialize CRC to brand new one at zero
-	m_crc = 0;
+	resetCRC();
 
 }  // end open
 
@@ -93,6 +95,19 @@ void XferCRC::endBlock( void )
 
 }  // end endBlock
 
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+void XferCRC::resetCRC( void )
+{
+
+	m_crc = 0;
+	for( Int i = 0; i < NUM_LANES; ++i )
+		m_lanes[ i ] = 0;
+	m_laneBytes = 0;
+	m_laneBufferUsed = 0;
+
+}  // end resetCRC
+
 //-------------------------------------------------------------------------------------------------
 //-------------------------------------------------------------------------------------------------
 void XferCRC::addCRC( UnsignedInt val )
@@ -134,6 +149,105 @@ void XferCRC::xferSnapshot( Snapshot *snapshot )
 
 }  // end xferSnapshot
 
+// ------------------------------------------------------------------------------------------------
+/** Entry point for xfering a snapshot that keeps a CachedCRC. With a newer kernel the stream gets
+	the snapshot's own CRC instead of its data, and that is only recomputed once the snapshot
+	has changed. Deep CRCs are meant for diffing and legacy CRCs must never change, so they get
+	the snapshot's data just like xferSnapshot */
+// ------------------------------------------------------------------------------------------------
+void XferCRC::xferCachedSnapshot( Snapshot *snapshot, CachedCRC *cachedCRC )
+{
+
+	if( snapshot == NULL )
+	{
+
+		return;
+
+	}  // end if
+
+	if( m_xferMode != XFER_CRC || m_kernel == CRC_KERNEL_LEGACY )
+	{
+
+		xferSnapshot( snapshot );
+		return;
+
+	}  // end if
+
+	UnsignedInt crc;
+	if( BitIsSet( m_options, XO_NO_CACHED_CRCS ) )
+	{
+
+		// a full recompute, for checking the cache against
+		crc = calcSnapshotCRC( snapshot );
+		DEBUG_ASSERTCRASH( cachedCRC->m_dirty || cachedCRC->m_crc == crc,
+			("Cached CRC is stale (0x%8.8X, should be 0x%8.8X)\n", cachedCRC->m_crc, crc) );
+
+	}  // end if
+	else
+	{
+
+		if( cachedCRC->m_dirty )
+		{
+
+			cachedCRC->m_crc = calcSnapshotCRC( snapshot );
+			cachedCRC->m_dirty = FALSE;
+
+		}  // end if
+		crc = cachedCRC->m_crc;
+
+	}  // end else
+
+	xferUnsignedInt( &crc );
+
+}  // end xferCachedSnapshot
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+UnsignedInt XferCRC::calcSnapshotCRC( Snapshot *snapshot )
+{
+
+	// a new XferCRC starts out at zero, and open() would only cost us a string copy per snapshot
+	XferCRC xferCRC( m_kernel );
+	xferCRC.setOptions( m_options );
+	xferCRC.xferSnapshot( snapshot );
+	return xferCRC.getCRC();
+
+}  // end calcSnapshotCRC
+
+//-------------------------------------------------------------------------------------------------
+/** CRC_KERNEL_LANES: word i of the stream (in native, ie little-endian, order) goes into lane
+	i % NUM_LANES, the same way addCRC does it. The lanes don't depend on each other, so unlike
+	the legacy kernel this isn't one long chain of dependent adds. */
+//-------------------------------------------------------------------------------------------------
+#define ROTL1(x) (((x) << 1) | ((x) >> 31))
+
+void XferCRC::addLaneWords( const UnsignedByte *data, Int numWords )
+{
+
+	DEBUG_ASSERTCRASH( (m_laneBytes & (NUM_LANES * 4 - 1)) == 0 && (numWords & (NUM_LANES - 1)) == 0, 
+		("CRC lanes out of step\n") );
+
+	UnsignedInt l0 = m_lanes[ 0 ];
+	UnsignedInt l1 = m_lanes[ 1 ];
+	UnsignedInt l2 = m_lanes[ 2 ];
+	UnsignedInt l3 = m_lanes[ 3 ];
+	for (Int i = 0; i < numWords; i += NUM_LANES, data += NUM_LANES * 4)
+	{
+		UnsignedInt w[ NUM_LANES ];
+		memcpy(w, data, sizeof(w));
+		l0 = ROTL1(l0) + w[ 0 ];
+		l1 = ROTL1(l1) + w[ 1 ];
+		l2 = ROTL1(l2) + w[ 2 ];
+		l3 = ROTL1(l3) + w[ 3 ];
+	}
+	m_lanes[ 0 ] = l0;
+	m_lanes[ 1 ] = l1;
+	m_lanes[ 2 ] = l2;
+	m_lanes[ 3 ] = l3;
+	m_laneBytes += numWords * 4;
+
+}  // end addLaneWords
+
 //-------------------------------------------------------------------------------------------------
 /** Perform a single CRC operation on the data passed in */
 //-------------------------------------------------------------------------------------------------
@@ -145,6 +259,35 @@ void XferCRC::xferImplementation( void *data, Int dataSize )
 		return;
 	}
 
+	if (m_kernel == CRC_KERNEL_LANES)
+	{
+		const UnsignedByte *src = (const UnsignedByte *)data;
+		while (dataSize > 0)
+		{
+			// whole lane groups can skip the buffer, if nothing is waiting in it
+			if (m_laneBufferUsed == 0 && dataSize >= NUM_LANES * 4)
+			{
+				Int n = dataSize & ~(NUM_LANES * 4 - 1);
+				addLaneWords(src, n / 4);
+				src += n;
+				dataSize -= n;
+				continue;
+			}
+
+			Int n = min(dataSize, (Int)LANE_BUFFER_SIZE - m_laneBufferUsed);
+			memcpy(m_laneBuffer + m_laneBufferUsed, src, n);
+			m_laneBufferUsed += n;
+			src += n;
+			dataSize -= n;
+			if (m_laneBufferUsed == LANE_BUFFER_SIZE)
+			{
+				addLaneWords(m_laneBuffer, LANE_BUFFER_SIZE / 4);
+				m_laneBufferUsed = 0;
+			}
+		}
+		return;
+	}
+
 	const UnsignedInt *uintPtr = (const UnsignedInt *) (data);
 
 	for (Int i=0 ; i<dataSize/4 ; i++)
@@ -179,14 +322,44 @@ void XferCRC::skip( Int dataSize )
 UnsignedInt XferCRC::getCRC( void )
 {
 
-	return htonl(m_crc);
+	if (m_kernel != CRC_KERNEL_LANES)
+		return htonl(m_crc);
+
+	// finish off copies of the lanes with whatever is still buffered, so we can keep going afterwards.
+	// (the buffer always starts on lane 0.)
+	UnsignedInt lanes[ NUM_LANES ];
+	memcpy(lanes, m_lanes, sizeof(lanes));
+
+	Int numWords = m_laneBufferUsed / 4;
+	for (Int i = 0; i < numWords; ++i)
+	{
+		UnsignedInt w;
+		memcpy(&w, m_laneBuffer + i * 4, sizeof(w));
+		lanes[i & (NUM_LANES - 1)] = ROTL1(lanes[i & (NUM_LANES - 1)]) + w;
+	}
+	Int leftover = m_laneBufferUsed & 3;
+	if (leftover)
+	{
+		UnsignedInt w = 0;
+		memcpy(&w, m_laneBuffer + numWords * 4, leftover);
+		lanes[numWords & (NUM_LANES - 1)] = ROTL1(lanes[numWords & (NUM_LANES - 1)]) + w;
+	}
+
+	UnsignedInt crc = 0;
+	for (Int i = 0; i < NUM_LANES; ++i)
+	{
+		crc = ((crc << 7) | (crc >> 25)) ^ lanes[i];
+	}
+	crc += m_laneBytes + m_laneBufferUsed;		// so trailing zeros count
+
+	return htonl(crc);
 
 }  // end skip
 
 
 //-------------------------------------------------------------------------------------------------
 //-------------------------------------------------------------------------------------------------
-XferDeepCRC::XferDeepCRC( void )
+XferDeepCRC::XferDeepCRC( CRCKernel kernel ) : XferCRC( kernel )
 {
 
 	m_xferMode = XFER_SAVE;
@@ -242,7 +415,7 @@ void XferDeepCRC::open( AsciiString identifier )
 	}  // end if
 
 	// initialize CRC to brand new one at zero
-	m_crc = 0;
+	resetCRC();
 
 }  // end open
 
@@ -1306,6 +1306,19 @@ const AudioEventRTS *ThingTemplate::getPerUnitSound(const AsciiString& soundName
 	return &(it->second);
 }
 
+//-------------------------------------------------------------------------------------------------
+void ThingTemplate::getAudioFilenames(FilenameList &filenames) const
+{
+	for (Int i = 0; i < TTAUDIO_COUNT; ++i)
+	{
+		if (m_audioarray.m_audio[i])
+			m_audioarray.m_audio[i]->m_event.getAllFilenames(filenames);
+	}
+
+	for (PerUnitSoundMap::const_iterator it = m_perUnitSounds.begin(); it != m_perUnitSounds.end(); ++it)
+		it->second.getAllFilenames(filenames);
+}
+
 //-------------------------------------------------------------------------------------------------
 bool ThingTemplate::isEquivalentTo(const ThingTemplate* tt) const
 {
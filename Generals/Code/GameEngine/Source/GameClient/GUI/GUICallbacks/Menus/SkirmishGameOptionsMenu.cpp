@@ -1220,6 +1220,7 @@ void SkirmishGameOptionsMenuInit( WindowLayout *layout, void *userData )
   gSlot.setState( SLOT_PLAYER, prefs.getUserName() );
   gSlot.setColor(prefs.getPreferredColor());
   gSlot.setPlayerTemplate(prefs.getPreferredFaction());
+  gSlot.setCapabilities(GetLocalGameCapabilities());
   TheSkirmishGameInfo->setSlot(0,gSlot);
 
 	SkirmishBattleHonors honors;
@@ -1285,6 +1285,9 @@ void WOLGameSetupMenuInit( WindowLayout *layout, void *userData )
 		options.format("Ping=%s", TheGameSpyInfo->getPingString().str());
 		req.options = options.str();
 		TheGameSpyPeerMessageQueue->addRequest(req);
+		options.format("Caps=%X", GetLocalGameCapabilities());
+		req.options = options.str();
+		TheGameSpyPeerMessageQueue->addRequest(req);
 
 		game->setMapCRC( game->getMapCRC() );		// force a recheck
 		game->setMapSize( game->getMapSize() ); // of if we have the map
@@ -2222,6 +2225,17 @@ void WOLGameSetupMenuUpdate( WindowLayout * layout, void *userData)
 									TheGameSpyInfo->setGameOptions();
 									DEBUG_LOG(("Setting ping string to %s for player %d\n", options.str()+1, slotNum));
 								}
+								else if (key == "Caps")
+								{
+									UnsignedInt capabilities = 0;
+									sscanf(options.str()+1, "%X", &capabilities);
+									if (capabilities != slot->getCapabilities())
+									{
+										slot->setCapabilities(capabilities);
+										DEBUG_LOG(("Setting capabilities to %X for player %d\n", capabilities, slotNum));
+										change = true;
+									}
+								}
 
 								if (change)
 								{
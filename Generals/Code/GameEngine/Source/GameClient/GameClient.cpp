@@ -685,6 +685,12 @@ void GameClient::update( void )
 		}
 	}
 
+	// nothing is ever drawn when running headless
+	if (TheGlobalData->m_headless)
+	{
+		return;
+	}
+
 #if defined(RTS_INTERNAL) || defined(RTS_DEBUG)
 	// need to draw the first frame, then don't draw again until TheGlobalData->m_noDraw
 	if (TheGlobalData->m_noDraw > TheGameLogic->getFrame() && TheGameLogic->getFrame() > 0) 
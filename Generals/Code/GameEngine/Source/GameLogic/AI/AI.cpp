@@ -994,6 +994,8 @@ void TAiData::loadPostProcess( void )
 void AI::crc( Xfer *xfer )
 {
 
+	// the pathfinder and the AI data are small and their state moves nearly every frame, so
+	// only the groups keep a cached CRC
 	xfer->xferSnapshot( m_pathfinder );
 	CRCGEN_LOG(("CRC after AI pathfinder for frame %d is 0x%8.8X\n", TheGameLogic->getFrame(), ((XferCRC *)xfer)->getCRC()));
 
@@ -1013,7 +1015,7 @@ void AI::crc( Xfer *xfer )
 		{
 			marker = "MARKER:AIGroup";
 			xfer->xferAsciiString(&marker);
-			xfer->xferSnapshot( (*groupIt) );
+			xfer->xferCachedSnapshot( (*groupIt), (*groupIt)->friend_getCachedCRC() );
 		}
 	}
 
@@ -198,6 +198,7 @@ void AIGroup::add( Object *obj )
 
 	// list has changed, properties need recomputation
 	m_dirty = true;
+	m_cachedCRC.invalidate();
 }
 
 /**
@@ -222,6 +223,7 @@ bool AIGroup::remove( Object *obj )
 
 	// list has changed, properties need recomputation
 	m_dirty = true;
+	m_cachedCRC.invalidate();
 
 	// if the group is empty, no-one is using it any longer, so destroy it
 	if (isEmpty()) {
@@ -455,6 +457,7 @@ void AIGroup::recompute( void )
 	}
 	// clear "dirty bit" - data is up-to-date
 	m_dirty = false;
+	m_cachedCRC.invalidate();
 }
 
 /**
@@ -1542,6 +1545,8 @@ void AIGroup::groupMoveToPosition( const Coord3D *pos, bool addWaypoint, Command
 	MemoryPoolObjectHolder iterHolder;
 	SimpleObjectIterator *iter = newInstance(SimpleObjectIterator);
 	iterHolder.hold(iter);
+	Coord2D moverMin;
+	Coord2D moverMax;
 	for( i = m_memberList.begin(); i != m_memberList.end(); ++i )	
 	{
 		Real dx, dy;
@@ -1568,6 +1573,15 @@ void AIGroup::groupMoveToPosition( const Coord3D *pos, bool addWaypoint, Command
 		}
 		Coord3D unitPos = *((*i)->getPosition());
 		TheAI->pathfinder()->removeGoal(*i);
+		if (iter->getCount()==0) {
+			moverMin.x = moverMax.x = unitPos.x;
+			moverMin.y = moverMax.y = unitPos.y;
+		}	else {
+			if (unitPos.x < moverMin.x) moverMin.x = unitPos.x;
+			if (unitPos.y < moverMin.y) moverMin.y = unitPos.y;
+			if (unitPos.x > moverMax.x) moverMax.x = unitPos.x;
+			if (unitPos.y > moverMax.y) moverMax.y = unitPos.y;
+		}
 		dx = unitPos.x - pos->x;
 		dy = unitPos.y - pos->y;
 		// adjust so units are sorted first by move priority.
@@ -1588,10 +1602,22 @@ void AIGroup::groupMoveToPosition( const Coord3D *pos, bool addWaypoint, Command
 	}
 
 	Coord3D goalPos = *pos;
+	Object *theUnit;
 	iter->sort(ITER_SORTED_NEAR_TO_FAR);
+
+	// A large group shares one flow field per locomotor class, rather than each unit searching.
+	if (!addWaypoint && iter->getCount() >= Pathfinder::FLOW_FIELD_MIN_GROUP) {
+		for (theUnit = iter->first(); theUnit; theUnit = iter->next())
+		{
+			AIUpdateInterface *ai = theUnit->getAIUpdateInterface();
+			if (ai && ai->isDoingGroundMovement()) {
+				TheAI->pathfinder()->buildFlowField(theUnit, ai->getLocomotorSet(), pos, &moverMin, &moverMax);
+			}
+		}
+	}
+
 	// Works better if you let the near units get the first paths... jba.
 	// Move the ones nearest the goal first.  Reduces collision problems later.
-	Object *theUnit;
 	bool firstUnit = true;
 	for (theUnit = iter->first(); theUnit; theUnit = iter->next())
 	{
@@ -49,6 +49,7 @@
 #include "GameLogic/PartitionManager.h"
 #include "GameLogic/TerrainLogic.h"
 #include "GameLogic/Weapon.h"
+#include "GameNetwork/GameInfo.h"
 
 #include "Common/UnitTimings.h" //Contains the DO_UNIT_TIMINGS define jba.	
 
@@ -1084,9 +1085,13 @@ Real Path::computeFlightDistToGoal( const Coord3D *pos, Coord3D& goalPos )
 //-----------------------------------------------------------------------------------
 
 enum { PATHFIND_CELLS_PER_FRAME=5000}; // Number of cells we will search pathfinding per frame.
+enum { PATHFIND_MIN_SEARCH_SLICE=1000}; // Fewest cells a search gets before suspending, so long searches make progress.
 enum {CELL_INFOS_TO_ALLOCATE = 30000};
 PathfindCellInfo *PathfindCellInfo::s_infoArray = NULL;
 PathfindCellInfo *PathfindCellInfo::s_firstFree = NULL;						
+PathfindCellInfo **PathfindCellInfo::s_openHeap = NULL;
+Int PathfindCellInfo::s_openHeapCount = 0;
+UnsignedInt PathfindCellInfo::s_openSequence = 0;
 /**
  * Allocates a pool of pathfind cell infos.
  */
@@ -1094,6 +1099,10 @@ void PathfindCellInfo::allocateCellInfos(void)
 {
 	releaseCellInfos();
 	s_infoArray = MSGNEW("PathfindCellInfo") PathfindCellInfo[CELL_INFOS_TO_ALLOCATE];	// pool[]ify
+	// The open list can never hold more cells than there are infos.
+	s_openHeap = MSGNEW("PathfindCellInfo") PathfindCellInfo*[CELL_INFOS_TO_ALLOCATE];
+	s_openHeapCount = 0;
+	s_openSequence = 0;
 	s_infoArray[CELL_INFOS_TO_ALLOCATE-1].m_pathParent = NULL;
 	s_infoArray[CELL_INFOS_TO_ALLOCATE-1].m_isFree = true;
 	s_firstFree = s_infoArray;
@@ -1118,9 +1127,70 @@ void PathfindCellInfo::releaseCellInfos(void)
 		s_firstFree = s_firstFree->m_pathParent;
 	}
 	DEBUG_ASSERTCRASH(count==CELL_INFOS_TO_ALLOCATE, ("Error - Allocated cellinfos."));
+	DEBUG_ASSERTCRASH(s_openHeapCount==0, ("Error - Cells left on open list."));
 	delete[] s_infoArray;
 	s_infoArray = NULL;
 	s_firstFree = NULL;
+	delete[] s_openHeap;
+	s_openHeap = NULL;
+	s_openHeapCount = 0;
+}
+
+/**
+ * Open list ordering.  Lower total cost comes first, and cells of equal cost come off 
+ * in the order they were put on, which is what the old sorted linked list did.  The
+ * search order has to stay exactly the same or paths, and hence the game crc, change.
+ */
+inline bool PathfindCellInfo::isOpenHeapLess(const PathfindCellInfo *a, const PathfindCellInfo *b) 
+{
+	if (a->m_totalCost != b->m_totalCost) {
+		return a->m_totalCost < b->m_totalCost;
+	}
+	return a->m_openSequence < b->m_openSequence;
+}
+
+/**
+ * Moves the open list entry at ndx towards the top of the heap.
+ */
+void PathfindCellInfo::openHeapSiftUp(Int ndx) 
+{
+	PathfindCellInfo *info = s_openHeap[ndx];
+	while (ndx > 0) {
+		Int parent = (ndx-1)>>1;
+		if (!isOpenHeapLess(info, s_openHeap[parent])) {
+			break;
+		}
+		s_openHeap[ndx] = s_openHeap[parent];
+		s_openHeap[ndx]->m_openHeapIndex = ndx;
+		ndx = parent;
+	}
+	s_openHeap[ndx] = info;
+	info->m_openHeapIndex = ndx;
+}
+
+/**
+ * Moves the open list entry at ndx towards the bottom of the heap.
+ */
+void PathfindCellInfo::openHeapSiftDown(Int ndx) 
+{
+	PathfindCellInfo *info = s_openHeap[ndx];
+	for (;;) {
+		Int child = 2*ndx+1;
+		if (child >= s_openHeapCount) {
+			break;
+		}
+		if (child+1 < s_openHeapCount && isOpenHeapLess(s_openHeap[child+1], s_openHeap[child])) {
+			child++;
+		}
+		if (!isOpenHeapLess(s_openHeap[child], info)) {
+			break;
+		}
+		s_openHeap[ndx] = s_openHeap[child];
+		s_openHeap[ndx]->m_openHeapIndex = ndx;
+		ndx = child;
+	}
+	s_openHeap[ndx] = info;
+	info->m_openHeapIndex = ndx;
 }
 
 /**
@@ -1141,6 +1211,8 @@ PathfindCellInfo *PathfindCellInfo::getACellInfo(PathfindCell *cell,const ICoord
 		info->m_pathParent = NULL;
 		info->m_costSoFar = 0;		
 		info->m_totalCost = 0;
+		info->m_openHeapIndex = -1;
+		info->m_openSequence = 0;
 		info->m_open = 0;
 		info->m_closed = 0;
 		info->m_obstacleID = INVALID_ID;
@@ -1225,7 +1297,8 @@ bool PathfindCell::startPathfind( PathfindCell *goalCell  )
 	if (goalCell) {
 		m_info->m_totalCost = costToGoal( goalCell );
 	}
-	m_info->m_open = TRUE;
+	// Caller puts the start cell on the open list.
+	m_info->m_open = FALSE;
 	m_info->m_closed = FALSE;
 	return true;
 }
@@ -1493,52 +1566,45 @@ PathfindCell *PathfindCell::putOnSortedOpenList( PathfindCell *list )
 {
 	DEBUG_ASSERTCRASH(m_info, ("Has to have info."));
 	DEBUG_ASSERTCRASH(m_info->m_closed==FALSE && m_info->m_open==FALSE, ("Serious error - Invalid flags. jba"));
-	if (list == NULL)
-	{
-		list = this;
-		m_info->m_prevOpen = NULL;
-		m_info->m_nextOpen = NULL;
+	DEBUG_ASSERTCRASH(list == getOpenListCell(0), ("Open list out of sync."));
+	if (PathfindCellInfo::s_openHeapCount == 0) {
+		PathfindCellInfo::s_openSequence = 0;
 	}
-	else
-	{
-		// insertion sort
-		PathfindCell *c, *lastCell = NULL;
-		for( c = list; c; c = c->getNextOpen() )
-		{
-			if (c->m_info->m_totalCost > m_info->m_totalCost)
-				break;
 
-			lastCell = c;
-		}
+	// binary heap insert, O(log n) instead of the old O(n) insertion sort.
+	m_info->m_prevOpen = NULL;
+	m_info->m_nextOpen = NULL;
+	m_info->m_openSequence = PathfindCellInfo::s_openSequence++;
+	PathfindCellInfo::s_openHeap[PathfindCellInfo::s_openHeapCount] = m_info;
+	PathfindCellInfo::s_openHeapCount++;
+	PathfindCellInfo::openHeapSiftUp(PathfindCellInfo::s_openHeapCount-1);
 
-		if (c)
-		{
-			// insert just before "c"
-			if (c->m_info->m_prevOpen)
-				c->m_info->m_prevOpen->m_nextOpen = this->m_info;
-			else
-				list = this;
+	// mark newCell as being on open list
+	m_info->m_open = true;
+	m_info->m_closed = false;
 
-			m_info->m_prevOpen = c->m_info->m_prevOpen;
-			c->m_info->m_prevOpen = this->m_info;
-				
-			m_info->m_nextOpen = c->m_info;
+	// head of the list is the top of the heap.
+	return getOpenListCell(0);
+}
 
-		}
-		else
-		{
-			// append after "lastCell" - end of list
-			lastCell->m_info->m_nextOpen = this->m_info;
-			m_info->m_prevOpen = lastCell->m_info;
-			m_info->m_nextOpen = NULL;
-		}
-	}
+/// put self back on the "open" list with the sequence it had when its search was suspended.
+PathfindCell *PathfindCell::restoreOnOpenList( PathfindCell *list, UnsignedInt sequence )
+{
+	DEBUG_ASSERTCRASH(m_info, ("Has to have info."));
+	DEBUG_ASSERTCRASH(m_info->m_closed==FALSE && m_info->m_open==FALSE, ("Serious error - Invalid flags. jba"));
+	DEBUG_ASSERTCRASH(list == getOpenListCell(0), ("Open list out of sync."));
+
+	m_info->m_prevOpen = NULL;
+	m_info->m_nextOpen = NULL;
+	m_info->m_openSequence = sequence;
+	PathfindCellInfo::s_openHeap[PathfindCellInfo::s_openHeapCount] = m_info;
+	PathfindCellInfo::s_openHeapCount++;
+	PathfindCellInfo::openHeapSiftUp(PathfindCellInfo::s_openHeapCount-1);
 
-	// mark newCell as being on open list
 	m_info->m_open = true;
 	m_info->m_closed = false;
 
-	return list;
+	return getOpenListCell(0);
 }
 
 /// remove self from "open" list
@@ -1546,45 +1612,79 @@ PathfindCell *PathfindCell::removeFromOpenList( PathfindCell *list )
 {
 	DEBUG_ASSERTCRASH(m_info, ("Has to have info."));
 	DEBUG_ASSERTCRASH(m_info->m_closed==FALSE && m_info->m_open==TRUE, ("Serious error - Invalid flags. jba"));
-	if (m_info->m_nextOpen)
-		m_info->m_nextOpen->m_prevOpen = m_info->m_prevOpen;
-	
-	if (m_info->m_prevOpen)
-		m_info->m_prevOpen->m_nextOpen = m_info->m_nextOpen;
-	else
-		list = getNextOpen();
+	DEBUG_ASSERTCRASH(list == getOpenListCell(0), ("Open list out of sync."));
+	Int ndx = m_info->m_openHeapIndex;
+	DEBUG_ASSERTCRASH(ndx>=0 && ndx<PathfindCellInfo::s_openHeapCount && PathfindCellInfo::s_openHeap[ndx]==m_info, ("Bad open list index."));
+
+	PathfindCellInfo::s_openHeapCount--;
+	Int last = PathfindCellInfo::s_openHeapCount;
+	if (ndx != last) {
+		// Fill the hole with the last entry, and let it find its place.
+		PathfindCellInfo *moved = PathfindCellInfo::s_openHeap[last];
+		PathfindCellInfo::s_openHeap[ndx] = moved;
+		moved->m_openHeapIndex = ndx;
+		PathfindCellInfo::openHeapSiftDown(ndx);
+		PathfindCellInfo::openHeapSiftUp(moved->m_openHeapIndex);
+	}
+	PathfindCellInfo::s_openHeap[last] = NULL;
 
 	m_info->m_open = false;
+	m_info->m_openHeapIndex = -1;
 	m_info->m_nextOpen = NULL;
 	m_info->m_prevOpen = NULL;
 
-	return list;
+	return getOpenListCell(0);
 }
 
 /// remove all cells from "open" list
 Int PathfindCell::releaseOpenList( PathfindCell *list )
 {
+	DEBUG_ASSERTCRASH(list == getOpenListCell(0), ("Open list out of sync."));
 	Int count = 0;
-	while (list) {
+	while (PathfindCellInfo::s_openHeapCount > 0) {
 		count++;
-		DEBUG_ASSERTCRASH(list->m_info, ("Has to have info."));
-		DEBUG_ASSERTCRASH(list->m_info->m_closed==FALSE && list->m_info->m_open==TRUE, ("Serious error - Invalid flags. jba"));
-		PathfindCell *cur = list;
-		PathfindCellInfo *curInfo = list->m_info;
-		if (curInfo->m_nextOpen) {
-			list = curInfo->m_nextOpen->m_cell;
-		}	else {
-			list = NULL;
-		}
-		DEBUG_ASSERTCRASH(cur == curInfo->m_cell, ("Bad backpointer in PathfindCellInfo"));
+		PathfindCellInfo::s_openHeapCount--;
+		PathfindCellInfo *curInfo = PathfindCellInfo::s_openHeap[PathfindCellInfo::s_openHeapCount];
+		PathfindCellInfo::s_openHeap[PathfindCellInfo::s_openHeapCount] = NULL;
+		PathfindCell *cur = curInfo->m_cell;
+		DEBUG_ASSERTCRASH(cur->m_info == curInfo, ("Bad backpointer in PathfindCellInfo"));
+		DEBUG_ASSERTCRASH(curInfo->m_closed==FALSE && curInfo->m_open==TRUE, ("Serious error - Invalid flags. jba"));
 		curInfo->m_nextOpen = NULL;
 		curInfo->m_prevOpen = NULL;
+		curInfo->m_openHeapIndex = -1;
 		curInfo->m_open = FALSE;
 		cur->releaseInfo();
 	}
 	return count;
 }
 
+/// number of cells on the "open" list
+Int PathfindCell::getOpenListCount( void )
+{
+	return PathfindCellInfo::s_openHeapCount;
+}
+
+/// open list insertion counter.
+UnsignedInt PathfindCell::getOpenListSequence( void )
+{
+	return PathfindCellInfo::s_openSequence;
+}
+
+/// set the open list insertion counter, when resuming a suspended search.
+void PathfindCell::setOpenListSequence( UnsignedInt sequence )
+{
+	PathfindCellInfo::s_openSequence = sequence;
+}
+
+/// cell on the "open" list, in heap order.  Index 0 is the lowest cost cell.
+PathfindCell *PathfindCell::getOpenListCell( Int ndx )
+{
+	if (ndx<0 || ndx>=PathfindCellInfo::s_openHeapCount) {
+		return NULL;
+	}
+	return PathfindCellInfo::s_openHeap[ndx]->m_cell;
+}
+
 /// remove all cells from "closed" list
 Int PathfindCell::releaseClosedList( PathfindCell *list )
 {
@@ -1870,6 +1970,36 @@ static void __fastcall resolveZones(Int srcZone, Int targetZone, zoneStorageType
 	}
 }
 
+/* Join the sets containing zone1 & zone2, keeping the lower zone as the root, so each entry 
+stays <= its index.  Call resolveJoinedZones to point every entry at its root. */
+static void joinZones(Int zone1, Int zone2, zoneStorageType *zoneEquivalency)
+{
+	DEBUG_ASSERTCRASH(zone1!=0 && zone2!=0,  ("Bad resolve zones	."));
+	while (zoneEquivalency[zone1] != zone1) {
+		zoneEquivalency[zone1] = zoneEquivalency[zoneEquivalency[zone1]];
+		zone1 = zoneEquivalency[zone1];
+	}
+	while (zoneEquivalency[zone2] != zone2) {
+		zoneEquivalency[zone2] = zoneEquivalency[zoneEquivalency[zone2]];
+		zone2 = zoneEquivalency[zone2];
+	}
+	if (zone1<zone2) {
+		zoneEquivalency[zone2] = zone1;
+	} else if (zone2<zone1) {
+		zoneEquivalency[zone1] = zone2;
+	}
+}
+
+/* Point every zone at the lowest zone it was joined to.  Same result as calling resolveZones 
+for each pair. */
+static void resolveJoinedZones(zoneStorageType *zoneEquivalency, Int sizeOfZE)
+{
+	Int i;
+	for (i=1; i<sizeOfZE; i++) {
+		zoneEquivalency[i] = zoneEquivalency[zoneEquivalency[i]];
+	}
+}
+
 static void flattenZones(zoneStorageType *zoneArray, zoneStorageType *zoneHierarchical, Int sizeOfZones)
 {
 	Int i;
@@ -1931,8 +2061,16 @@ m_groundCliffZones(NULL),
 m_groundWaterZones(NULL), 
 m_groundRubbleZones(NULL), 
 m_crusherZones(NULL), 
+m_links(NULL),
+m_numLinks(0),
+m_linksAllocated(0),
+m_portals(NULL),
 m_zonesAllocated(0),
-m_interactsWithBridge(FALSE)
+m_interactsWithBridge(FALSE),
+m_cellsConnectToLayer(FALSE),
+m_zonesDirty(TRUE),
+m_linksDirty(TRUE),
+m_portalsDirty(TRUE)
 {		
 	m_cellOrigin.x = 0;
 	m_cellOrigin.y = 0;
@@ -1946,6 +2084,14 @@ m_interactsWithBridge(FALSE)
 ZoneBlock::~ZoneBlock()  
 {
 	freeZones();
+	if (m_links) {
+		delete [] m_links;
+		m_links = NULL;
+	}
+	if (m_portals) {
+		delete [] m_portals;
+		m_portals = NULL;
+	}
 }
 
 void ZoneBlock::freeZones(void) 
@@ -1968,6 +2114,232 @@ void ZoneBlock::freeZones(void)
 	}
 }
 
+/* Number the zones of the cells in this block, starting at firstZone.  Cells of the same type that 
+touch are in the same zone.  The numbering only depends on the cells in this block, so an unchanged 
+block can keep its zones and just be shifted with shiftZones.  Returns the number of zones used. */
+UnsignedShort ZoneBlock::blockAssignZones(PathfindCell **map, const IRegion2D &bounds, zoneStorageType firstZone)
+{
+	enum {MAX_BLOCK_ZONES = PathfindZoneManager::ZONE_BLOCK_SIZE*PathfindZoneManager::ZONE_BLOCK_SIZE+1};
+	zoneStorageType zoneEquivalency[MAX_BLOCK_ZONES];
+	Int i, j;
+	for (i=0; i<MAX_BLOCK_ZONES; i++) {
+		zoneEquivalency[i] = i;
+	}
+	Int numZones = 1;	// we start using zone 0 as a flag.
+	m_cellsConnectToLayer = false;
+	for( j=bounds.lo.y; j<=bounds.hi.y; j++ )	{
+		for( i=bounds.lo.x; i<=bounds.hi.x; i++ )	{
+			PathfindCell *cell = &map[i][j];
+			cell->setZone(0);
+
+			if (i>bounds.lo.x) {
+				if (map[i][j].getType() == map[i-1][j].getType()) {
+					applyZone(map[i][j], map[i-1][j], zoneEquivalency, numZones);
+				}
+			}
+			if (j>bounds.lo.y) {
+				if (map[i][j].getType() == map[i][j-1].getType()) {
+					applyZone(map[i][j], map[i][j-1], zoneEquivalency, numZones);
+				}
+			}
+			if (cell->getZone()==0) {
+				cell->setZone(numZones);
+				numZones++;
+			}
+			if (cell->getConnectLayer() > LAYER_GROUND) {
+				m_cellsConnectToLayer = true;
+			}
+		}
+	}
+
+	// Collapse the zones into a firstZone, firstZone+1... sequence, removing collapsed zones.
+	zoneStorageType collapsedZones[MAX_BLOCK_ZONES];
+	Int count = 0;
+	collapsedZones[0] = 0;
+	for (i=1; i<numZones; i++) {
+		Int zone = zoneEquivalency[i];
+		if (zone == i) {
+			collapsedZones[i] = firstZone + count;
+			++count;
+		}	else {
+			collapsedZones[i] = collapsedZones[zone];
+		}
+	}
+	for( j=bounds.lo.y; j<=bounds.hi.y; j++ )	{
+		for( i=bounds.lo.x; i<=bounds.hi.x; i++ )	{
+			map[i][j].setZone(collapsedZones[map[i][j].getZone()]);
+			if (map[i][j].getZone()==0) {
+				DEBUG_CRASH(("Zone not set cell %d, %d", i, j));
+			}
+		}
+	}
+	return count;
+}
+
+/* Move the zones of a block whose cells haven't changed so they start at firstZone. */
+void ZoneBlock::shiftZones(PathfindCell **map, const IRegion2D &bounds, zoneStorageType firstZone)
+{
+	Int delta = firstZone - m_firstZone;
+	if (delta == 0) {
+		return;
+	}
+	Int i, j;
+	for( j=bounds.lo.y; j<=bounds.hi.y; j++ )	{
+		for( i=bounds.lo.x; i<=bounds.hi.x; i++ )	{
+			map[i][j].setZone(map[i][j].getZone() + delta);
+		}
+	}
+	m_firstZone = firstZone;
+	if (m_numZones<2) {
+		return; // no zone equivalency tables.
+	}
+	for (i=0; i<m_zonesAllocated; i++) {
+		m_groundCliffZones[i] += delta;
+		m_groundWaterZones[i] += delta;
+		m_groundRubbleZones[i] += delta;
+		m_crusherZones[i] += delta;
+	}
+}
+
+/* Add a link, merging it with an existing link between the same zones. */
+void ZoneBlock::addLink(UnsignedShort zone, UnsignedShort otherZone, UnsignedShort other, UnsignedShort tables)
+{
+	Int i;
+	for (i=0; i<m_numLinks; i++) {
+		ZoneBlockLink &link = m_links[i];
+		if (link.m_zone==zone && link.m_otherZone==otherZone && link.m_other==other) {
+			link.m_tables |= tables;
+			return;
+		}
+	}
+	if (m_numLinks >= m_linksAllocated) {
+		Int newSize = m_linksAllocated ? 2*m_linksAllocated : 16;
+		ZoneBlockLink *newLinks = MSGNEW("PathfindZoneInfo") ZoneBlockLink[newSize];
+		for (i=0; i<m_numLinks; i++) {
+			newLinks[i] = m_links[i];
+		}
+		if (m_links) {
+			delete [] m_links;
+		}
+		m_links = newLinks;
+		m_linksAllocated = newSize;
+	}
+	ZoneBlockLink &link = m_links[m_numLinks++];
+	link.m_zone = zone;
+	link.m_otherZone = otherZone;
+	link.m_other = other;
+	link.m_tables = tables;
+}
+
+/* Cache the links between zones that touch inside this block, or across the left and lower edges
+of this block, and between zones and the bridge layers.  The zone manager replays the links 
+to build its equivalency tables, so unchanged blocks don't have to rescan their cells. */
+void ZoneBlock::blockCalculateLinks(PathfindCell **map, const IRegion2D &bounds, const IRegion2D &globalBounds,
+																		const ZoneBlock *leftBlock, const ZoneBlock *lowerBlock)
+{
+	m_numLinks = 0;
+	m_linksDirty = false;
+	Int i, j;
+	for( j=bounds.lo.y; j<=bounds.hi.y; j++ )	{
+		for( i=bounds.lo.x; i<=bounds.hi.x; i++ )	{
+			UnsignedShort zone = map[i][j].getZone() - m_firstZone;
+			if ( (map[i][j].getConnectLayer() > LAYER_GROUND) && 
+				(map[i][j].getType() == PathfindCell::CELL_CLEAR) ) {
+				addLink(zone, map[i][j].getConnectLayer(), LINK_LAYER, TABLE_HIERARCHICAL);
+			}
+			Int k;
+			for (k=0; k<2; k++) {
+				Int otherX = i;
+				Int otherY = j;
+				const ZoneBlock *otherBlock = this;
+				UnsignedShort other = LINK_SAME_BLOCK;
+				if (k==0) {
+					if (i<=globalBounds.lo.x) continue;
+					otherX = i-1;
+					if (i==bounds.lo.x) {
+						otherBlock = leftBlock;
+						other = LINK_LEFT_BLOCK;
+					}
+				}	else {
+					if (j<=globalBounds.lo.y) continue;
+					otherY = j-1;
+					if (j==bounds.lo.y) {
+						otherBlock = lowerBlock;
+						other = LINK_LOWER_BLOCK;
+					}
+				}
+				const PathfindCell &cell = map[i][j];
+				const PathfindCell &otherCell = map[otherX][otherY];
+				if (cell.getZone() == otherCell.getZone()) continue;
+				if (otherBlock == NULL) {
+					DEBUG_CRASH(("Missing neighbor block. jba."));
+					continue;
+				}
+				UnsignedShort tables = 0;
+				if (typesMatch(cell, otherCell)) tables |= TABLE_HIERARCHICAL;
+				if (waterGround(cell, otherCell)) tables |= TABLE_GROUND_WATER;
+				if (groundRubble(cell, otherCell)) tables |= TABLE_GROUND_RUBBLE;
+				if (groundCliff(cell, otherCell)) tables |= TABLE_GROUND_CLIFF;
+				if (terrain(cell, otherCell)) tables |= TABLE_TERRAIN;
+				if (crusherGround(cell, otherCell)) tables |= TABLE_CRUSHER;
+				if (tables) {
+					addLink(zone, otherCell.getZone() - otherBlock->getFirstZone(), other, tables);
+				}
+			}
+		}
+	}
+}
+
+/* Cache the ground block zones of the cells on the edges of this block, and of the cells across 
+each edge, for the hierarchical pathfind.  Needs to be redone when this block or a neighbor is
+renumbered, since edge cells can be in the next block over. */
+void ZoneBlock::blockCalculatePortals(const PathfindZoneManager *zm, PathfindCell **map, 
+																			const IRegion2D &globalBounds, Int xBlock, Int yBlock)
+{
+	if (m_portals == NULL) {
+		m_portals = MSGNEW("PathfindZoneInfo") ZoneBlockPortal[SIDE_COUNT*PathfindZoneManager::ZONE_BLOCK_SIZE];
+	}
+	m_portalsDirty = false;
+	Int side, ndx, k;
+	for (side=0; side<SIDE_COUNT; side++) {
+		for (ndx=0; ndx<PathfindZoneManager::ZONE_BLOCK_SIZE; ndx++) {
+			ZoneBlockPortal &portal = m_portals[side*PathfindZoneManager::ZONE_BLOCK_SIZE + ndx];
+			ICoord2D cell, delta;
+			PathfindZoneManager::getPortalCell(xBlock, yBlock, side, ndx, cell, delta);
+			ICoord2D other;
+			other.x = cell.x + delta.x;
+			other.y = cell.y + delta.y;
+			portal.m_onMap = (cell.x>=globalBounds.lo.x && cell.x<=globalBounds.hi.x &&
+				cell.y>=globalBounds.lo.y && cell.y<=globalBounds.hi.y);
+			portal.m_otherOnMap = (other.x>=globalBounds.lo.x && other.x<=globalBounds.hi.x &&
+				other.y>=globalBounds.lo.y && other.y<=globalBounds.hi.y);
+			for (k=0; k<2; k++) {
+				portal.m_blockZone[k] = 0;
+				portal.m_otherZone[k] = 0;
+			}
+			const ZoneBlock *cellBlock = portal.m_onMap ? zm->getCellBlock(cell.x, cell.y) : NULL;
+			const ZoneBlock *otherBlock = portal.m_otherOnMap ? zm->getCellBlock(other.x, other.y) : NULL;
+			for (k=0; k<2; k++) {
+				if (cellBlock) {
+					portal.m_blockZone[k] = cellBlock->getEffectiveZone(LOCOMOTORSURFACE_GROUND, k==1, 
+						map[cell.x][cell.y].getZone()) - cellBlock->getFirstZone();
+				}
+				if (otherBlock) {
+					portal.m_otherZone[k] = otherBlock->getEffectiveZone(LOCOMOTORSURFACE_GROUND, k==1, 
+						map[other.x][other.y].getZone()) - otherBlock->getFirstZone();
+				}
+			}
+		}
+	}
+}
+
+/* Edge cells of one side of this block. */
+const ZoneBlockPortal *ZoneBlock::getPortals(Int side) const
+{
+	DEBUG_ASSERTCRASH(m_portals && !m_portalsDirty, ("Zone block portals not calculated. jba."));
+	return m_portals + side*PathfindZoneManager::ZONE_BLOCK_SIZE;
+}
+
 /* Allocate zone equivalency arrays large enough to hold required entries.  If the arrays are already
 large enough, reuse.  Then calculate terrain equivalencies. */
 void ZoneBlock::blockCalculateZones(PathfindCell **map, PathfindLayer layers[], const IRegion2D &bounds) 
@@ -2233,11 +2605,65 @@ void PathfindZoneManager::allocateBlocks(const IRegion2D &globalBounds)
 	}
 }
 
-void PathfindZoneManager::markZonesDirty(void)  ///< Called when the zones need to be recalculated.
+void PathfindZoneManager::markZonesDirty(void)  ///< Called when all the zones need to be recalculated.
+{
+	m_needToCalculateZones = true;
+	Int blockX, blockY;
+	for (blockX = 0; blockX<m_zoneBlockExtent.x; blockX++) {
+		for (blockY = 0; blockY<m_zoneBlockExtent.y; blockY++) {
+			m_zoneBlocks[blockX][blockY].setZonesDirty(true);
+		}
+	}
+} 
+
+void PathfindZoneManager::markZonesDirty(const IRegion2D &cellBounds)  ///< Called when the cells in cellBounds changed.
 {
 	m_needToCalculateZones = true;
+	markBlocksDirty(cellBounds);
 } 
 
+/* Flag the zone blocks overlapping cellBounds so the next calculateZones renumbers them. */
+void PathfindZoneManager::markBlocksDirty(const IRegion2D &cellBounds) 
+{
+	if (cellBounds.hi.x<0 || cellBounds.hi.y<0 || cellBounds.lo.x>cellBounds.hi.x || cellBounds.lo.y>cellBounds.hi.y) {
+		return;
+	}
+	Int loX = cellBounds.lo.x/ZONE_BLOCK_SIZE;
+	Int loY = cellBounds.lo.y/ZONE_BLOCK_SIZE;
+	Int hiX = cellBounds.hi.x/ZONE_BLOCK_SIZE;
+	Int hiY = cellBounds.hi.y/ZONE_BLOCK_SIZE;
+	if (loX<0) loX = 0;
+	if (loY<0) loY = 0;
+	if (hiX>=m_zoneBlockExtent.x) hiX = m_zoneBlockExtent.x-1;
+	if (hiY>=m_zoneBlockExtent.y) hiY = m_zoneBlockExtent.y-1;
+	Int blockX, blockY;
+	for (blockX = loX; blockX<=hiX; blockX++) {
+		for (blockY = loY; blockY<=hiY; blockY++) {
+			m_zoneBlocks[blockX][blockY].setZonesDirty(true);
+		}
+	}
+} 
+
+/* Get the cell bounds of a zone block, inclusive. */
+bool PathfindZoneManager::getBlockBounds(Int xBlock, Int yBlock, const IRegion2D &globalBounds, IRegion2D &bounds) const
+{
+	bounds.lo.x = globalBounds.lo.x + xBlock*ZONE_BLOCK_SIZE;
+	bounds.lo.y = globalBounds.lo.y + yBlock*ZONE_BLOCK_SIZE;
+	bounds.hi.x = bounds.lo.x + ZONE_BLOCK_SIZE - 1; // bounds are inclusive.
+	bounds.hi.y = bounds.lo.y + ZONE_BLOCK_SIZE - 1; // bounds are inclusive.
+	if (bounds.hi.x > globalBounds.hi.x) {
+		bounds.hi.x = globalBounds.hi.x;
+	}
+	if (bounds.hi.y > globalBounds.hi.y) {
+		bounds.hi.y = globalBounds.hi.y;
+	}
+	if (bounds.lo.x>bounds.hi.x || bounds.lo.y>bounds.hi.y) {
+		DEBUG_CRASH(("Incorrect bounds calculation. Logic error, fix me. jba."));
+		return false;
+	}
+	return true;
+}
+
 void PathfindZoneManager::reset(void)  ///< Called when the map is reset.
 {
 	freeZones();
@@ -2250,6 +2676,7 @@ void PathfindZoneManager::reset(void)  ///< Called when the map is reset.
  * you can successfully pathfind.
  * If you are a multiple terrain vehicle, like amphibious transport, the lookup is a little more
  * complicated.
+ * Only the zone blocks flagged by markZonesDirty are rescanned, the rest reuse their zones.
  */
 void PathfindZoneManager::calculateZones( PathfindCell **map, PathfindLayer layers[], const IRegion2D &globalBounds )
 {
@@ -2266,88 +2693,57 @@ void PathfindZoneManager::calculateZones( PathfindCell **map, PathfindLayer laye
 
 	m_maxZone = 1;	// we start using zone 0 as a flag.
 	const Int maxZones=24000;
-	zoneStorageType zoneEquivalency[maxZones];
-	Int i, j;
-	for (i=0; i<maxZones; i++) {
-		zoneEquivalency[i] = i;
-	}
-	for (i=0; i<=LAYER_LAST; i++) {
-		layers[i].setZone(0);
-	}
+	Int i;
 
 	Int xCount = (globalBounds.hi.x-globalBounds.lo.x+1+ZONE_BLOCK_SIZE-1)/ZONE_BLOCK_SIZE;
 	Int yCount = (globalBounds.hi.y-globalBounds.lo.y+1+ZONE_BLOCK_SIZE-1)/ZONE_BLOCK_SIZE;
+	DEBUG_ASSERTCRASH(xCount==m_zoneBlockExtent.x && yCount==m_zoneBlockExtent.y, ("Inconsistent allocation - SERIOUS ERROR. jba"));
 
+	// Number the zones block by block.  A block's zones only depend on its own cells, so only the
+	// blocks whose cells changed are renumbered.  The others keep their zones, shifted to follow on
+	// from the previous block.  This gives the same zones as numbering the whole map.
 	Int xBlock, yBlock;
 	for (xBlock = 0; xBlock<xCount; xBlock++) {
 		for (yBlock=0; yBlock<yCount; yBlock++) {
 			IRegion2D bounds;
-			bounds.lo.x = globalBounds.lo.x + xBlock*ZONE_BLOCK_SIZE;
-			bounds.lo.y = globalBounds.lo.y + yBlock*ZONE_BLOCK_SIZE;
-			bounds.hi.x = bounds.lo.x + ZONE_BLOCK_SIZE - 1; // bounds are inclusive.
-			bounds.hi.y = bounds.lo.y + ZONE_BLOCK_SIZE - 1; // bounds are inclusive.
-			if (bounds.hi.x > globalBounds.hi.x) {
-				bounds.hi.x = globalBounds.hi.x;
-			}
-			if (bounds.hi.y > globalBounds.hi.y) {
-				bounds.hi.y = globalBounds.hi.y;
-			}
-			if (bounds.lo.x>bounds.hi.x || bounds.lo.y>bounds.hi.y) {
-				DEBUG_CRASH(("Incorrect bounds calculation. Logic error, fix me. jba."));
+			if (!getBlockBounds(xBlock, yBlock, globalBounds, bounds)) {
 				continue;
 			}
-			m_zoneBlocks[xBlock][yBlock].setInteractsWithBridge(false);
-			for( j=bounds.lo.y; j<=bounds.hi.y; j++ )	{
-				for( i=bounds.lo.x; i<=bounds.hi.x; i++ )	{
-					PathfindCell *cell = &map[i][j];
-					cell->setZone(0);
-
-					if (i>bounds.lo.x) {
-						if (map[i][j].getType() == map[i-1][j].getType()) {
-							applyZone(map[i][j], map[i-1][j], zoneEquivalency, m_maxZone);
-						}
-					}
-					if (j>bounds.lo.y) {
-						if (map[i][j].getType() == map[i][j-1].getType()) {
-							applyZone(map[i][j], map[i][j-1], zoneEquivalency, m_maxZone);
-						}
-					}
-					if (cell->getZone()==0) {
-						cell->setZone(m_maxZone);
-						m_maxZone++;
-						if (m_maxZone>= maxZones) {
-							DEBUG_CRASH(("Ran out of pathfind zones.  SERIOUS ERROR! jba."));
-							break;
+			ZoneBlock &block = m_zoneBlocks[xBlock][yBlock];
+			if (block.isZonesDirty()) {
+				block.blockAssignZones(map, bounds, m_maxZone);
+				block.blockCalculateZones(map, layers, bounds);
+				block.setZonesDirty(false);
+				// The links of this block, and the blocks that link back to it, use the old zones.
+				block.setLinksDirty(true);
+				if (xBlock+1<xCount) {
+					m_zoneBlocks[xBlock+1][yBlock].setLinksDirty(true);
+				}
+				if (yBlock+1<yCount) {
+					m_zoneBlocks[xBlock][yBlock+1].setLinksDirty(true);
+				}
+				// So do the portals of this block and the blocks around it.
+				Int portalX, portalY;
+				for (portalX = xBlock-1; portalX<=xBlock+1; portalX++) {
+					for (portalY = yBlock-1; portalY<=yBlock+1; portalY++) {
+						if (portalX>=0 && portalX<xCount && portalY>=0 && portalY<yCount) {
+							m_zoneBlocks[portalX][portalY].setPortalsDirty(true);
 						}
 					}
-					if (cell->getConnectLayer() > LAYER_GROUND) {
- 						m_zoneBlocks[xBlock][yBlock].setInteractsWithBridge(true);
-					}
-					
 				}
+			}	else {
+				block.shiftZones(map, bounds, m_maxZone);
+			}
+			block.setInteractsWithBridge(block.getCellsConnectToLayer());
+			m_maxZone += block.getNumZones();
+			if (m_maxZone>= maxZones) {
+				DEBUG_CRASH(("Ran out of pathfind zones.  SERIOUS ERROR! jba."));
 			}
-			//DEBUG_LOG(("Collapsed zones %d\n", m_maxZone));
  		}
 	}
-
-	Int totalZones = m_maxZone;
-	if (totalZones>maxZones/2) {
+	if (m_maxZone>maxZones/2) {
 		DEBUG_LOG(("Max zones %d\n", m_maxZone));
 	}
-
-	// Collapse the zones into a 1,2,3... sequence, removing collapsed zones.
-	m_maxZone = 1;
-	Int collapsedZones[maxZones];
-	collapsedZones[0] = 0;
-	for (i=1; i<totalZones; i++) {
-		Int zone = zoneEquivalency[i];
-		if (zone == i) {
-			collapsedZones[i] = m_maxZone;
-			++m_maxZone;
-		}	else {
-			collapsedZones[i] = collapsedZones[zone];
-		}
-	}
 #ifdef DEBUG_QPF
 #if defined(DEBUG_LOGGING)
 	QueryPerformanceCounter((LARGE_INTEGER *)&endTime64);
@@ -2355,25 +2751,9 @@ void PathfindZoneManager::calculateZones( PathfindCell **map, PathfindLayer laye
 	DEBUG_LOG(("Time to calculate first %f\n", timeToUpdate));
 #endif
 #endif
-	// Now map the zones in the map back into the collapsed zones.
-	for( j=globalBounds.lo.y; j<=globalBounds.hi.y; j++ )	{
-		for( i=globalBounds.lo.x; i<=globalBounds.hi.x; i++ )	{
-			map[i][j].setZone(collapsedZones[map[i][j].getZone()]);
-			if (map[i][j].getZone()==0) {
-				DEBUG_CRASH(("Zone not set cell %d, %d", i, j));
-			}
-		}
-	}
 	for (i=0; i<=LAYER_LAST; i++) {
-		Int zone = collapsedZones[layers[i].getZone()];
-		if (zone == 0) {
-			zone = m_maxZone;
-			m_maxZone++;
-		}
-		layers[i].setZone( zone );
-		if (!layers[i].isUnused() && !layers[i].isDestroyed() && layers[i].getZone()==0) {
-			DEBUG_CRASH(("Zone not set Layer %d", i));
-		}
+		layers[i].setZone( m_maxZone );
+		m_maxZone++;
 		layers[i].applyZone();
 		if (!layers[i].isUnused() && !layers[i].isDestroyed()) {
 			ICoord2D ndx;
@@ -2385,25 +2765,31 @@ void PathfindZoneManager::calculateZones( PathfindCell **map, PathfindLayer laye
 	}
 
 	allocateZones();
-	DEBUG_ASSERTCRASH(xBlock==m_zoneBlockExtent.x && yBlock==m_zoneBlockExtent.y, ("Inconsistent allocation - SERIOUS ERROR. jba"));
+
+	// Refresh the cached links of blocks that were renumbered, or that touch a renumbered block.
 	for (xBlock=0; xBlock<xCount; xBlock++) {
 		for (yBlock=0; yBlock<yCount; yBlock++) {
+			ZoneBlock &block = m_zoneBlocks[xBlock][yBlock];
+			if (!block.isLinksDirty()) {
+				continue;
+			}
 			IRegion2D bounds;
-			bounds.lo.x = globalBounds.lo.x + xBlock*ZONE_BLOCK_SIZE;
-			bounds.lo.y = globalBounds.lo.y + yBlock*ZONE_BLOCK_SIZE;
-			bounds.hi.x = bounds.lo.x + ZONE_BLOCK_SIZE - 1; // bounds are inclusive.
-			bounds.hi.y = bounds.lo.y + ZONE_BLOCK_SIZE - 1; // bounds are inclusive.
-			if (bounds.hi.x > globalBounds.hi.x) {
-				bounds.hi.x = globalBounds.hi.x;
-			}
-			if (bounds.hi.y > globalBounds.hi.y) {
-				bounds.hi.y = globalBounds.hi.y;
-			}
-			if (bounds.lo.x>bounds.hi.x || bounds.lo.y>bounds.hi.y) {
-				DEBUG_CRASH(("Incorrect bounds calculation. Logic error, fix me. jba."));
+			if (!getBlockBounds(xBlock, yBlock, globalBounds, bounds)) {
 				continue;
 			}
-			m_zoneBlocks[xBlock][yBlock].blockCalculateZones(map, layers, bounds);
+			const ZoneBlock *leftBlock = xBlock>0 ? &m_zoneBlocks[xBlock-1][yBlock] : NULL;
+			const ZoneBlock *lowerBlock = yBlock>0 ? &m_zoneBlocks[xBlock][yBlock-1] : NULL;
+			block.blockCalculateLinks(map, bounds, globalBounds, leftBlock, lowerBlock);
+		}
+	}
+
+	// Refresh the cached portals the hierarchical pathfind uses to step between blocks.
+	for (xBlock=0; xBlock<xCount; xBlock++) {
+		for (yBlock=0; yBlock<yCount; yBlock++) {
+			ZoneBlock &block = m_zoneBlocks[xBlock][yBlock];
+			if (block.isPortalsDirty()) {
+				block.blockCalculatePortals(this, map, globalBounds, xBlock, yBlock);
+			}
 		}
 	}
 
@@ -2425,79 +2811,47 @@ void PathfindZoneManager::calculateZones( PathfindCell **map, PathfindLayer laye
 		m_hierarchicalZones[i] = i;
 	}
 
-	for( j=globalBounds.lo.y; j<=globalBounds.hi.y; j++ )	{
-		for( i=globalBounds.lo.x; i<=globalBounds.hi.x; i++ )	{
-			if ( (map[i][j].getConnectLayer() > LAYER_GROUND) && 
-				(map[i][j].getType() == PathfindCell::CELL_CLEAR) ) {
-				PathfindLayer *layer = layers + map[i][j].getConnectLayer();
-				resolveZones(map[i][j].getZone(), layer->getZone(), m_hierarchicalZones, m_maxZone);
-			}
-			if (i>globalBounds.lo.x && map[i][j].getZone()!=map[i-1][j].getZone()) {
-				if (map[i][j].getType() == map[i-1][j].getType()) {
-					applyZone(map[i][j], map[i-1][j], m_hierarchicalZones, m_maxZone);
-				}
-				if (waterGround(map[i][j], map[i-1][j])) {
-					applyZone(map[i][j], map[i-1][j], m_groundWaterZones, m_maxZone);
-				}
-				if (groundRubble(map[i][j], map[i-1][j])) {
-					Int zone1 = map[i][j].getZone();
-					Int zone2 = map[i-1][j].getZone();
-					if (m_terrainZones[zone1] != m_terrainZones[zone2]) {
-						//DEBUG_LOG(("Matching terrain zone %d to %d.\n", zone1, zone2));
-					}
-					applyZone(map[i][j], map[i-1][j], m_groundRubbleZones, m_maxZone);
-				}
-				if (groundCliff(map[i][j], map[i-1][j])) {
-					applyZone(map[i][j], map[i-1][j], m_groundCliffZones, m_maxZone);
-				}
-				if (terrain(map[i][j], map[i-1][j])) {
-					applyZone(map[i][j], map[i-1][j], m_terrainZones, m_maxZone);
-				}
-				if (crusherGround(map[i][j], map[i-1][j])) {
-					applyZone(map[i][j], map[i-1][j], m_crusherZones, m_maxZone);
-				}
-			}
-			if (j>globalBounds.lo.y && map[i][j].getZone()!=map[i][j-1].getZone()) {
-				if (map[i][j].getType() == map[i][j-1].getType()) {
-					applyZone(map[i][j], map[i][j-1], m_hierarchicalZones, m_maxZone);
+	for (xBlock=0; xBlock<xCount; xBlock++) {
+		for (yBlock=0; yBlock<yCount; yBlock++) {
+			const ZoneBlock &block = m_zoneBlocks[xBlock][yBlock];
+			Int k;
+			for (k=0; k<block.getNumLinks(); k++) {
+				const ZoneBlockLink &link = block.getLink(k);
+				Int zone = block.getFirstZone() + link.m_zone;
+				Int otherZone;
+				switch (link.m_other) {
+					case ZoneBlock::LINK_LEFT_BLOCK:	otherZone = m_zoneBlocks[xBlock-1][yBlock].getFirstZone() + link.m_otherZone; break;
+					case ZoneBlock::LINK_LOWER_BLOCK: otherZone = m_zoneBlocks[xBlock][yBlock-1].getFirstZone() + link.m_otherZone; break;
+					case ZoneBlock::LINK_LAYER:				otherZone = layers[link.m_otherZone].getZone(); break;
+					default:													otherZone = block.getFirstZone() + link.m_otherZone; break;
 				}
-				if (waterGround(map[i][j],map[i][j-1])) {
-					applyZone(map[i][j], map[i][j-1], m_groundWaterZones, m_maxZone);
+				if (link.m_tables & ZoneBlock::TABLE_HIERARCHICAL) {
+					joinZones(zone, otherZone, m_hierarchicalZones);
 				}
-				if (groundRubble(map[i][j], map[i][j-1])) {
-					Int zone1 = map[i][j].getZone();
-					Int zone2 = map[i][j-1].getZone();
-					if (m_terrainZones[zone1] != m_terrainZones[zone2]) {
-						//DEBUG_LOG(("Matching terrain zone %d to %d.\n", zone1, zone2));
-					}
-					applyZone(map[i][j], map[i][j-1], m_groundRubbleZones, m_maxZone);
+				if (link.m_tables & ZoneBlock::TABLE_GROUND_WATER) {
+					joinZones(zone, otherZone, m_groundWaterZones);
 				}
-				if (groundCliff(map[i][j],map[i][j-1])) {
-					applyZone(map[i][j], map[i][j-1], m_groundCliffZones, m_maxZone);
+				if (link.m_tables & ZoneBlock::TABLE_GROUND_RUBBLE) {
+					joinZones(zone, otherZone, m_groundRubbleZones);
 				}
-				if (terrain(map[i][j], map[i][j-1])) {
-					applyZone(map[i][j], map[i][j-1], m_terrainZones, m_maxZone);
+				if (link.m_tables & ZoneBlock::TABLE_GROUND_CLIFF) {
+					joinZones(zone, otherZone, m_groundCliffZones);
 				}
-				if (crusherGround(map[i][j], map[i][j-1])) {
-					applyZone(map[i][j], map[i][j-1], m_crusherZones, m_maxZone);
+				if (link.m_tables & ZoneBlock::TABLE_TERRAIN) {
+					joinZones(zone, otherZone, m_terrainZones);
 				}
-/* No diagonals.  jba.
-				if (i>globalBounds.lo.x) {
-					if (waterGround(map[i][j],map[i-1][j-1])) {
-						applyZone(map[i][j], map[i-1][j-1], m_groundWaterZones, m_maxZone);
-					}
-					if (groundCliff(map[i][j],map[i-1][j-1])) {
-						applyZone(map[i][j], map[i-1][j-1], m_groundCliffZones, m_maxZone);
-					}
-					if (terrain(map[i][j],map[i-1][j-1])) {
-						applyZone(map[i][j], map[i-1][j-1], m_terrainZones, m_maxZone);
-					}
+				if (link.m_tables & ZoneBlock::TABLE_CRUSHER) {
+					joinZones(zone, otherZone, m_crusherZones);
 				}
-*/
 			}
-			DEBUG_ASSERTCRASH(map[i][j].getZone() != 0, ("Cleared the zone."));
 		}
 	}
+	resolveJoinedZones(m_hierarchicalZones, m_maxZone);
+	resolveJoinedZones(m_groundWaterZones, m_maxZone);
+	resolveJoinedZones(m_groundRubbleZones, m_maxZone);
+	resolveJoinedZones(m_groundCliffZones, m_maxZone);
+	resolveJoinedZones(m_terrainZones, m_maxZone);
+	resolveJoinedZones(m_crusherZones, m_maxZone);
 
 	if (m_maxZone >= m_zonesAllocated) {
 		RELEASE_CRASH("Pathfind allocation error - fatal. see jba.");
@@ -2524,6 +2878,7 @@ void PathfindZoneManager::calculateZones( PathfindCell **map, PathfindLayer laye
 #if defined RTS_DEBUG || defined RTS_INTERNAL
 	if (TheGlobalData->m_debugAI && false) 
 	{
+		Int j;
 		extern void addIcon(const Coord3D *pos, Real width, Int numFramesDuration, RGBColor color);
 		RGBColor color;
 		memset(&color, 0, sizeof(Color));
@@ -2672,6 +3027,53 @@ bool PathfindZoneManager::interactsWithBridge(Int cellX, Int cellY) const
 }
 
 
+//
+// Return the block containing this cell.
+//
+const ZoneBlock *PathfindZoneManager::getCellBlock(Int cellX, Int cellY) const
+{
+	Int blockX = cellX/ZONE_BLOCK_SIZE;
+	Int blockY = cellY/ZONE_BLOCK_SIZE;
+	if (blockX<0 || blockX>=m_zoneBlockExtent.x || blockY<0 || blockY>=m_zoneBlockExtent.y) {
+		return NULL;
+	}
+	return &m_zoneBlocks[blockX][blockY];
+}
+
+//
+// Return edge cell ndx of one side of a block, and the step to the cell across the edge.  Cells 
+// are in the order the hierarchical pathfind scans them, from the middle of the side outwards.
+//
+void PathfindZoneManager::getPortalCell(Int blockX, Int blockY, Int side, Int ndx, ICoord2D &cell, ICoord2D &delta)
+{
+	Int offset = (ndx+1)>>1;
+	if ((ndx+1)&1) offset = -offset;
+	delta.x = 0;
+	delta.y = 0;
+	switch (side) {
+		case ZoneBlock::SIDE_LEFT:
+			cell.x = blockX*ZONE_BLOCK_SIZE;
+			cell.y = blockY*ZONE_BLOCK_SIZE + ZONE_BLOCK_SIZE/2 + offset;
+			delta.x = -1; // left side moves -1.
+			break;
+		case ZoneBlock::SIDE_RIGHT:
+			cell.x = blockX*ZONE_BLOCK_SIZE + ZONE_BLOCK_SIZE-1;
+			cell.y = blockY*ZONE_BLOCK_SIZE + ZONE_BLOCK_SIZE/2 + offset;
+			delta.x = 1; // right side moves +1.
+			break;
+		case ZoneBlock::SIDE_TOP:
+			cell.y = blockY*ZONE_BLOCK_SIZE;
+			cell.x = blockX*ZONE_BLOCK_SIZE + ZONE_BLOCK_SIZE/2 + offset;
+			delta.y = -1;	// Top side moves -1.
+			break;
+		default:
+			cell.y = blockY*ZONE_BLOCK_SIZE + ZONE_BLOCK_SIZE-1;
+			cell.x = blockX*ZONE_BLOCK_SIZE + ZONE_BLOCK_SIZE/2 + offset;
+			delta.y = 1; // Bottom side moves +1.
+			break;
+	}
+}
+
 //
 // Return the zone at this location.
 //
@@ -2747,22 +3149,399 @@ zoneStorageType PathfindZoneManager::getEffectiveZone( LocomotorSurfaceTypeMask
 		return zone; 
 	}
 
-	if ( (acceptableSurfaces&LOCOMOTORSURFACE_GROUND) &&
-			(acceptableSurfaces&LOCOMOTORSURFACE_RUBBLE)) {
-		// Locomotors can go on ground & rubble, so use the ground rubble combiner.
-		zone = m_groundRubbleZones[zone];
-		return zone; 
+	if ( (acceptableSurfaces&LOCOMOTORSURFACE_GROUND) &&
+			(acceptableSurfaces&LOCOMOTORSURFACE_RUBBLE)) {
+		// Locomotors can go on ground & rubble, so use the ground rubble combiner.
+		zone = m_groundRubbleZones[zone];
+		return zone; 
+	}
+
+	if ( (acceptableSurfaces&LOCOMOTORSURFACE_CLIFF) &&
+			(acceptableSurfaces&LOCOMOTORSURFACE_WATER)) {
+		// Locomotors can go on ground & cliff, so use the ground cliff combiner.
+		DEBUG_CRASH(("Cliff water only locomotor sets not supported yet.")); 
+	}
+	zone = m_hierarchicalZones[zone];
+
+	return zone;
+}
+//-------------------- PathfindCache ----------------------------------------
+/* Paths are only shared between units (the cache & flow fields) if everyone in the game agreed
+to it, as the units don't go quite where their own searches would take them.  Campaign games
+have no game info, and never share them. */
+static bool arePathsShared(void)
+{
+	return TheGameInfo && TheGameInfo->getSharedPaths();
+}
+
+/* Flow fields also need everyone to have them. */
+static bool areFlowFieldsShared(void)
+{
+	return TheGameInfo && TheGameInfo->getFlowFields();
+}
+
+/* Likewise for time slicing, since a unit gets its path on a later frame than it would have. */
+bool Pathfinder::isSlicingSearches(void) const
+{
+	return TheGameInfo && TheGameInfo->getSlicedPathSearches();
+}
+
+bool PathfindCacheKey::isSameKey(const PathfindCacheKey &other) const
+{
+	return m_startCell.x == other.m_startCell.x && m_startCell.y == other.m_startCell.y &&
+		m_goalCell.x == other.m_goalCell.x && m_goalCell.y == other.m_goalCell.y &&
+		m_startLayer == other.m_startLayer && m_goalLayer == other.m_goalLayer &&
+		m_surfaces == other.m_surfaces && m_radius == other.m_radius &&
+		m_playerIndex == other.m_playerIndex && m_ignoreObstacleID == other.m_ignoreObstacleID &&
+		m_centerInCell == other.m_centerInCell && m_crusher == other.m_crusher;
+}
+
+PathfindCache::PathfindCache() : m_nextEntry(0),
+m_regionEpochs(NULL),
+m_epoch(0)
+{
+	Int i;
+	for (i=0; i<CACHE_SIZE; i++) {
+		m_entries[i].m_path = NULL;
+	}
+	m_regionExtent.x = 0;
+	m_regionExtent.y = 0;
+	memset(&m_stats, 0, sizeof(m_stats));
+}
+
+PathfindCache::~PathfindCache()
+{
+	reset();
+}
+
+void PathfindCache::reset(void)
+{
+	invalidateAll();
+	if (m_regionEpochs) {
+		delete [] m_regionEpochs;
+		m_regionEpochs = NULL;
+	}
+	m_regionExtent.x = 0;
+	m_regionExtent.y = 0;
+	m_nextEntry = 0;
+	m_epoch = 0;
+	memset(&m_stats, 0, sizeof(m_stats));
+}
+
+/* Allocate the region epochs.  Regions match the zone blocks. */
+void PathfindCache::allocateRegions(const IRegion2D &globalBounds)
+{
+	reset();
+	const Int regionSize = PathfindZoneManager::ZONE_BLOCK_SIZE;
+	m_regionExtent.x = (globalBounds.hi.x+1+regionSize-1)/regionSize;
+	m_regionExtent.y = (globalBounds.hi.y+1+regionSize-1)/regionSize;
+	m_regionEpochs = MSGNEW("PathfindCache") UnsignedInt[m_regionExtent.x*m_regionExtent.y];
+	memset(m_regionEpochs, 0, m_regionExtent.x*m_regionExtent.y*sizeof(UnsignedInt));
+}
+
+void PathfindCache::freeEntry(Entry &entry)
+{
+	if (entry.m_path) {
+		entry.m_path->deleteInstance();
+		entry.m_path = NULL;
+	}
+}
+
+void PathfindCache::invalidateAll(void)
+{
+	Int i;
+	for (i=0; i<CACHE_SIZE; i++) {
+		freeEntry(m_entries[i]);
+	}
+}
+
+/* Bump the epoch of the regions overlapping cellBounds, so paths that cross them are dropped. */
+void PathfindCache::invalidateRegion(const IRegion2D &cellBounds)
+{
+	if (m_regionEpochs == NULL) {
+		return;
+	}
+	if (cellBounds.hi.x<0 || cellBounds.hi.y<0 || cellBounds.lo.x>cellBounds.hi.x || cellBounds.lo.y>cellBounds.hi.y) {
+		return;
+	}
+	const Int regionSize = PathfindZoneManager::ZONE_BLOCK_SIZE;
+	Int loX = cellBounds.lo.x/regionSize;
+	Int loY = cellBounds.lo.y/regionSize;
+	Int hiX = cellBounds.hi.x/regionSize;
+	Int hiY = cellBounds.hi.y/regionSize;
+	if (loX<0) loX = 0;
+	if (loY<0) loY = 0;
+	if (hiX>=m_regionExtent.x) hiX = m_regionExtent.x-1;
+	if (hiY>=m_regionExtent.y) hiY = m_regionExtent.y-1;
+	m_epoch++;
+	Int i, j;
+	for (i=loX; i<=hiX; i++) {
+		for (j=loY; j<=hiY; j++) {
+			m_regionEpochs[i*m_regionExtent.y + j] = m_epoch;
+		}
+	}
+}
+
+bool PathfindCache::isEntryValid(const Entry &entry, UnsignedInt frame) const
+{
+	if (frame > entry.m_frame + CACHE_LIFETIME) {
+		return false;
+	}
+	Int i, j;
+	for (i=entry.m_regionBounds.lo.x; i<=entry.m_regionBounds.hi.x; i++) {
+		for (j=entry.m_regionBounds.lo.y; j<=entry.m_regionBounds.hi.y; j++) {
+			if (m_regionEpochs[i*m_regionExtent.y + j] > entry.m_epoch) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+/* Return a copy of a cached path for key, or NULL.  The copy doesn't have the start 
+position node, and isn't optimized. */
+Path *PathfindCache::findPath(const PathfindCacheKey &key, UnsignedInt frame)
+{
+	if (m_regionEpochs == NULL) {
+		return NULL;
+	}
+	m_stats.m_lookups++;
+	Int i;
+	for (i=0; i<CACHE_SIZE; i++) {
+		Entry &entry = m_entries[i];
+		if (entry.m_path == NULL || !entry.m_key.isSameKey(key)) {
+			continue;
+		}
+		if (!isEntryValid(entry, frame)) {
+			freeEntry(entry);
+			m_stats.m_stale++;
+			return NULL;
+		}
+		m_stats.m_hits++;
+		Path *path = newInstance(Path);
+		for (PathNode *node = entry.m_path->getLastNode(); node; node = node->getPrevious()) {
+			path->prependNode(node->getPosition(), node->getLayer());
+			path->getFirstNode()->setCanOptimize(node->getCanOptimize());
+		}
+		path->setBlockedByAlly(entry.m_path->getBlockedByAlly());
+		return path;
+	}
+	return NULL;
+}
+
+/* Store a copy of path, as found by findPath from the position from. */
+void PathfindCache::addPath(const PathfindCacheKey &key, const Coord3D *from, Path *path, UnsignedInt frame)
+{
+	if (m_regionEpochs == NULL || path->getFirstNode() == NULL) {
+		return;
+	}
+	// Reuse the entry for this key, if there is one.
+	Int i;
+	Entry *entry = NULL;
+	for (i=0; i<CACHE_SIZE; i++) {
+		if (m_entries[i].m_path && m_entries[i].m_key.isSameKey(key)) {
+			entry = &m_entries[i];
+			break;
+		}
+	}
+	if (entry == NULL) {
+		entry = &m_entries[m_nextEntry];
+		m_nextEntry = (m_nextEntry+1) % CACHE_SIZE;
+	}
+	freeEntry(*entry);
+
+	// The first node is the unit's own position, which the next user replaces with theirs.
+	PathNode *firstNode = path->getFirstNode();
+	if (firstNode->getPosition()->x == from->x && firstNode->getPosition()->y == from->y) {
+		firstNode = firstNode->getNext();
+	}
+	if (firstNode == NULL) {
+		return;
+	}
+	const Int regionSize = PathfindZoneManager::ZONE_BLOCK_SIZE*PATHFIND_CELL_SIZE;
+	IRegion2D bounds;
+	bounds.lo.x = bounds.hi.x = REAL_TO_INT_FLOOR(from->x/regionSize);
+	bounds.lo.y = bounds.hi.y = REAL_TO_INT_FLOOR(from->y/regionSize);
+	Path *copy = newInstance(Path);
+	for (PathNode *node = path->getLastNode(); node; node = node->getPrevious()) {
+		copy->prependNode(node->getPosition(), node->getLayer());
+		copy->getFirstNode()->setCanOptimize(node->getCanOptimize());
+		Int x = REAL_TO_INT_FLOOR(node->getPosition()->x/regionSize);
+		Int y = REAL_TO_INT_FLOOR(node->getPosition()->y/regionSize);
+		if (x<bounds.lo.x) bounds.lo.x = x;
+		if (y<bounds.lo.y) bounds.lo.y = y;
+		if (x>bounds.hi.x) bounds.hi.x = x;
+		if (y>bounds.hi.y) bounds.hi.y = y;
+		if (node == firstNode) {
+			break;
+		}
+	}
+	copy->setBlockedByAlly(path->getBlockedByAlly());
+
+	// Pad a region, so a shortcut opening up or closing next to the path drops it too.
+	bounds.lo.x--;
+	bounds.lo.y--;
+	bounds.hi.x++;
+	bounds.hi.y++;
+	if (bounds.lo.x<0) bounds.lo.x = 0;
+	if (bounds.lo.y<0) bounds.lo.y = 0;
+	if (bounds.hi.x>=m_regionExtent.x) bounds.hi.x = m_regionExtent.x-1;
+	if (bounds.hi.y>=m_regionExtent.y) bounds.hi.y = m_regionExtent.y-1;
+
+	entry->m_key = key;
+	entry->m_path = copy;
+	entry->m_regionBounds = bounds;
+	entry->m_epoch = m_epoch;
+	entry->m_frame = frame;
+}
+
+/* Save or load one key. */
+static void xferPathfindCacheKey(Xfer *xfer, PathfindCacheKey *key)
+{
+	xfer->xferICoord2D(&key->m_startCell);
+	xfer->xferICoord2D(&key->m_goalCell);
+	xfer->xferUser(&key->m_startLayer, sizeof(key->m_startLayer));
+	xfer->xferUser(&key->m_goalLayer, sizeof(key->m_goalLayer));
+	xfer->xferInt(&key->m_surfaces);
+	xfer->xferInt(&key->m_radius);
+	xfer->xferInt(&key->m_playerIndex);
+	xfer->xferObjectID(&key->m_ignoreObstacleID);
+	xfer->xferBool(&key->m_centerInCell);
+	xfer->xferBool(&key->m_crusher);
+}
+
+/* Save or load the entries & region epochs, so a loaded game gets the same cache hits.  
+allocateRegions has already been called for the map when loading. */
+void PathfindCache::xfer(Xfer *xfer)
+{
+	Int numRegions = m_regionExtent.x*m_regionExtent.y;
+	Int savedRegions = numRegions;
+	xfer->xferInt(&savedRegions);
+	if (savedRegions != numRegions) {
+		DEBUG_CRASH(("PathfindCache::xfer - region count mismatch."));
+		throw SC_INVALID_DATA;
+	}
+	if (numRegions > 0) {
+		xfer->xferUser(m_regionEpochs, numRegions*sizeof(UnsignedInt));
+	}
+	xfer->xferUnsignedInt(&m_epoch);
+	xfer->xferInt(&m_nextEntry);
+
+	Int i;
+	for (i=0; i<CACHE_SIZE; i++) {
+		Entry &entry = m_entries[i];
+		bool gotPath = (entry.m_path != NULL);
+		xfer->xferBool(&gotPath);
+		if (!gotPath) {
+			freeEntry(entry);
+			continue;
+		}
+		if (xfer->getXferMode() == XFER_LOAD) {
+			freeEntry(entry);
+			entry.m_path = newInstance(Path);
+		}
+		xferPathfindCacheKey(xfer, &entry.m_key);
+		xfer->xferSnapshot(entry.m_path);
+		xfer->xferIRegion2D(&entry.m_regionBounds);
+		xfer->xferUnsignedInt(&entry.m_epoch);
+		xfer->xferUnsignedInt(&entry.m_frame);
+	}
+}
+
+//-------------------- PathfindSearchState ----------------------------------------
+/* Save or load a suspended search, so a loaded game finishes it on the same frame. */
+void PathfindSearchState::xfer(Xfer *xfer)
+{
+	xfer->xferObjectID(&m_objID);
+	if (m_objID == INVALID_ID) {
+		clear();
+		return;
+	}
+	xferPathfindCacheKey(xfer, &m_key);
+	xfer->xferUnsignedInt(&m_openSequence);
+	xfer->xferBool(&m_isTunneling);
+	xfer->xferInt(&m_numClosed);
+	Int numCells = m_cells.size();
+	xfer->xferInt(&numCells);
+	if (xfer->getXferMode() == XFER_LOAD) {
+		m_cells.resize(numCells);
+	}
+	Int i;
+	for (i=0; i<numCells; i++) {
+		SavedCell &cell = m_cells[i];
+		xfer->xferICoord2D(&cell.m_pos);
+		xfer->xferICoord2D(&cell.m_parentPos);
+		xfer->xferUnsignedInt(&cell.m_costSoFar);
+		xfer->xferUnsignedInt(&cell.m_totalCost);
+		xfer->xferUnsignedInt(&cell.m_openSequence);
+		xfer->xferUser(&cell.m_layer, sizeof(cell.m_layer));
+		xfer->xferUser(&cell.m_parentLayer, sizeof(cell.m_parentLayer));
+		xfer->xferBool(&cell.m_hasParent);
+		xfer->xferBool(&cell.m_open);
+		xfer->xferBool(&cell.m_blockedByAlly);
+	}
+}
+
+//-------------------- PathfindFlowField ----------------------------------------
+void PathfindFlowField::freeArrays(void)
+{
+	if (m_costs) {
+		delete [] m_costs;
+		m_costs = NULL;
+	}
+	if (m_directions) {
+		delete [] m_directions;
+		m_directions = NULL;
+	}
+	m_numCells = 0;
+	clear();
+}
+
+/* Size the arrays for bounds, reusing them if they are big enough.  All cells start unreached. */
+void PathfindFlowField::allocate(const IRegion2D &bounds)
+{
+	Int numCells = (bounds.hi.x-bounds.lo.x+1)*(bounds.hi.y-bounds.lo.y+1);
+	if (numCells > m_numCells) {
+		freeArrays();
+		m_costs = MSGNEW("PathfindFlowField") UnsignedInt[numCells];
+		m_directions = MSGNEW("PathfindFlowField") UnsignedByte[numCells];
+		m_numCells = numCells;
 	}
+	m_bounds = bounds;
+	memset(m_directions, NO_DIRECTION, numCells*sizeof(UnsignedByte));
+}
 
-	if ( (acceptableSurfaces&LOCOMOTORSURFACE_CLIFF) &&
-			(acceptableSurfaces&LOCOMOTORSURFACE_WATER)) {
-		// Locomotors can go on ground & cliff, so use the ground cliff combiner.
-		DEBUG_CRASH(("Cliff water only locomotor sets not supported yet.")); 
+/* Save the field.  Only the cells in m_bounds are saved; an empty field saves no cells. */
+void PathfindFlowField::xfer(Xfer *xfer)
+{
+	xfer->xferICoord2D(&m_goalCell);
+	IRegion2D bounds = m_bounds;
+	xfer->xferIRegion2D(&bounds);
+	xfer->xferInt(&m_surfaces);
+	xfer->xferInt(&m_radius);
+	xfer->xferBool(&m_centerInCell);
+	xfer->xferBool(&m_crusher);
+	xfer->xferUnsignedInt(&m_frame);
+
+	if (bounds.hi.x < bounds.lo.x) {
+		if (xfer->getXferMode() == XFER_LOAD) {
+			m_bounds = bounds;
+		}
+		return;
 	}
-	zone = m_hierarchicalZones[zone];
 
-	return zone;
+	Int numCells = (bounds.hi.x-bounds.lo.x+1)*(bounds.hi.y-bounds.lo.y+1);
+	if (numCells <= 0 || numCells > FLOW_FIELD_MAX_CELLS) {
+		DEBUG_CRASH(("PathfindFlowField::xfer - bad bounds\n"));
+		throw SC_INVALID_DATA;
+	}
+	if (xfer->getXferMode() == XFER_LOAD) {
+		allocate(bounds);
+	}
+	xfer->xferUser(m_costs, numCells*sizeof(UnsignedInt));
+	xfer->xferUser(m_directions, numCells*sizeof(UnsignedByte));
 }
+
 //-------------------- PathfindLayer ----------------------------------------
 PathfindLayer::PathfindLayer() : m_blockOfMapCells(NULL), m_layerCells(NULL), m_bridge(NULL),
 // Added By Sadullah Nader
@@ -3052,6 +3831,17 @@ bool PathfindLayer::connectsZones(PathfindZoneManager *zm, const LocomotorSet& l
 	return found1 && found2;
 }
 
+/**
+ * Returns the ground cells under the layer.
+ */
+void PathfindLayer::getGroundCellBounds(IRegion2D *bounds)
+{
+	bounds->lo.x = m_xOrigin;
+	bounds->lo.y = m_yOrigin;
+	bounds->hi.x = m_xOrigin + m_width - 1;
+	bounds->hi.y = m_yOrigin + m_height - 1;
+}
+
 /**
  * Classifies the pathfind cells for the bridge layer.
  */
@@ -3384,7 +4174,11 @@ void PathfindLayer::classifyWallMapCell( Int i, Int j , PathfindCell *cell, Obje
 
 //----------------------- Pathfinder ---------------------------------------
 
-Pathfinder::Pathfinder( void ) :m_map(NULL)
+Pathfinder::Pathfinder( void ) :m_map(NULL),
+m_flowFieldValidCells(NULL),
+m_flowFieldValidSize(0),
+m_flowFieldClearCells(NULL),
+m_flowFieldClearSize(0)
 {
 	debugPath = NULL;
 	PathfindCellInfo::allocateCellInfos();
@@ -3394,6 +4188,14 @@ Pathfinder::Pathfinder( void ) :m_map(NULL)
 Pathfinder::~Pathfinder( void )
 {
 	PathfindCellInfo::releaseCellInfos();
+	if (m_flowFieldValidCells) {
+		delete [] m_flowFieldValidCells;
+		m_flowFieldValidCells = NULL;
+	}
+	if (m_flowFieldClearCells) {
+		delete [] m_flowFieldClearCells;
+		m_flowFieldClearCells = NULL;
+	}
 }
 
 void Pathfinder::reset( void )
@@ -3429,6 +4231,12 @@ void Pathfinder::reset( void )
 	// pathfind grid cells have not been classified yet
 	m_isMapReady = false;
 	m_cumulativeCellsAllocated = 0;
+	m_pathCache.reset();
+	resetFlowFields();
+	m_nextFlowField = 0;
+	m_suspendedSearch.clear();
+	m_searchCellBudget = 0;
+	m_searchSuspended = false;
 
 	debugPathPos.x = 0.0f;
 	debugPathPos.y = 0.0f;
@@ -3565,7 +4373,11 @@ void Pathfinder::updateLayer(Object *obj, PathfindLayerEnum layer)
  */
 void Pathfinder::classifyFence( Object *obj, bool insert )
 {
-	m_zoneManager.markZonesDirty();
+	IRegion2D cellBounds;
+	cellBounds.lo.x = m_extent.hi.x;
+	cellBounds.lo.y = m_extent.hi.y;
+	cellBounds.hi.x = -1;
+	cellBounds.hi.y = -1;
 	
 	const Coord3D *pos = obj->getPosition();
   Real angle = obj->getOrientation();
@@ -3607,10 +4419,17 @@ void Pathfinder::classifyFence( Object *obj, bool insert )
  				}
  				else
  					m_map[cx][cy].removeObstacle(obj);
+				if (cx < cellBounds.lo.x) cellBounds.lo.x = cx;
+				if (cy < cellBounds.lo.y) cellBounds.lo.y = cy;
+				if (cx > cellBounds.hi.x) cellBounds.hi.x = cx;
+				if (cy > cellBounds.hi.y) cellBounds.hi.y = cy;
  			}
  			
  		}
  	}
+	m_zoneManager.markZonesDirty(cellBounds);
+	m_pathCache.invalidateRegion(cellBounds);
+	invalidateFlowFields(cellBounds);
 
 #if 0 
 	// Perhaps it would make more sense to use the iteratecellsalongpath() provided in this class,
@@ -3713,6 +4532,11 @@ void Pathfinder::classifyObjectFootprint( Object *obj, bool insert )
 				}
 				// recalc the wall.
 				m_layers[LAYER_WALL].classifyWallCells(m_wallPieces, m_numWallPieces);
+				IRegion2D wallBounds;
+				m_layers[LAYER_WALL].getGroundCellBounds(&wallBounds);
+				m_zoneManager.markBlocksDirty(wallBounds);
+				m_pathCache.invalidateRegion(wallBounds);
+				invalidateFlowFields(wallBounds);
 			}
 		}
 	}
@@ -3739,7 +4563,6 @@ void Pathfinder::internal_classifyObjectFootprint( Object *obj, bool insert )
 	{
 		case GEOMETRY_BOX:
 		{
-			m_zoneManager.markZonesDirty();
 			const Coord3D *pos = obj->getPosition();
 			Real angle = obj->getOrientation();
 
@@ -3789,7 +4612,6 @@ void Pathfinder::internal_classifyObjectFootprint( Object *obj, bool insert )
 		case GEOMETRY_SPHERE:	// not quite right, but close enough
 		case GEOMETRY_CYLINDER:
 		{
-			m_zoneManager.markZonesDirty();
 			// fill in all cells that overlap as obstacle cells
 			/// @todo This is a very inefficient circle-rasterizer
 			ICoord2D topLeft, bottomRight;
@@ -3860,7 +4682,16 @@ void Pathfinder::internal_classifyObjectFootprint( Object *obj, bool insert )
 		cellBounds.hi.y = m_extent.hi.y;
 	}
 
-
+	// Only the zone blocks under the footprint need new zones.  Pad a little, as the 
+	// rasterizers above can step a cell past the geometry bounds.
+	IRegion2D dirtyBounds = cellBounds;
+	dirtyBounds.lo.x -= 2;
+	dirtyBounds.lo.y -= 2;
+	dirtyBounds.hi.x += 2;
+	dirtyBounds.hi.y += 2;
+	m_zoneManager.markZonesDirty(dirtyBounds);
+	m_pathCache.invalidateRegion(dirtyBounds);
+	invalidateFlowFields(dirtyBounds);
 
 	// Expand building bounds 1 cell.
 #define no_EXPAND_ONE_CELL
@@ -4084,6 +4915,8 @@ void Pathfinder::newMap( void )
 		m_extent = bounds;
 		DEBUG_ASSERTCRASH(m_map == NULL, ("Can't reallocate pathfind cells."));
  		m_zoneManager.allocateBlocks(m_extent);
+		m_pathCache.allocateRegions(m_extent);
+		resetFlowFields();
 		// Allocate cells.
 		m_blockOfMapCells = MSGNEW("PathfindMapCells") PathfindCell[(bounds.hi.x+1)*(bounds.hi.y+1)];
 		m_map = MSGNEW("PathfindMapCells") PathfindCellP[bounds.hi.x+1];
@@ -4189,7 +5022,11 @@ void Pathfinder::classifyMap(void)
 	if (!m_layers[LAYER_WALL].isUnused()) {
 		m_layers[LAYER_WALL].classifyWallCells(m_wallPieces, m_numWallPieces);
 	}
+	m_zoneManager.markZonesDirty();
 	m_zoneManager.calculateZones(m_map, m_layers, m_extent);
+	m_pathCache.invalidateAll();
+	resetFlowFields();
+	m_suspendedSearch.clear();
 }
 
 
@@ -4222,8 +5059,10 @@ void Pathfinder::debugShowSearch(  bool pathFound  )
 		addIcon(NULL, 0, 0, color);	 // erase.
 	}
 
-	for( s = m_openList; s; s=s->getNextOpen() )
+	Int i;
+	for( i = 0; i < PathfindCell::getOpenListCount(); i++ )
 	{
+		s = PathfindCell::getOpenListCell(i);
 		// create objects to show path - they decay
 		RGBColor color;
 		color.red = color.green = 0;
@@ -5398,6 +6237,8 @@ void Pathfinder::processPathfindQueue(void)
 
 	if (m_zoneManager.needToCalculateZones()) {
 		m_zoneManager.calculateZones(m_map, m_layers, m_extent);
+		// The map changed, so a suspended search starts over.
+		m_suspendedSearch.clear();
 		return;
 	}
 
@@ -5417,15 +6258,35 @@ void Pathfinder::processPathfindQueue(void)
 	Int pathsFound = 0;
 	while (m_cumulativeCellsAllocated < PATHFIND_CELLS_PER_FRAME && 
 		m_queuePRTail!=m_queuePRHead) {
-		Object *obj = TheGameLogic->findObjectByID(m_queuedPathfindRequests[m_queuePRHead]);
+		ObjectID id = m_queuedPathfindRequests[m_queuePRHead];
+		Object *obj = TheGameLogic->findObjectByID(id);
 		m_queuedPathfindRequests[m_queuePRHead] = INVALID_ID;
+		m_searchSuspended = false;
 		if (obj) {
 			AIUpdateInterface *ai = obj->getAIUpdateInterface();
 			if (ai) {
+				// Long searches get what is left of this frame's cells, and finish on later frames.
+				if (isSlicingSearches()) {
+					m_searchCellBudget = PATHFIND_CELLS_PER_FRAME - m_cumulativeCellsAllocated;
+					if (m_searchCellBudget < PATHFIND_MIN_SEARCH_SLICE) {
+						m_searchCellBudget = PATHFIND_MIN_SEARCH_SLICE;
+					}
+				}
 				ai->doPathfind(this);
+				m_searchCellBudget = 0;
 				pathsFound++;
 			}
 		}
+		if (m_searchSuspended) {
+			// Leave it at the head of the queue, and resume the search next frame.
+			m_searchSuspended = false;
+			m_queuedPathfindRequests[m_queuePRHead] = id;
+			break;
+		}
+		if (m_suspendedSearch.m_objID == id) {
+			// The unit didn't resume its search (new orders, or it died), so drop it.
+			m_suspendedSearch.clear();
+		}
 		m_queuePRHead = m_queuePRHead+1;
 		if (m_queuePRHead >= PATHFIND_QUEUE_LEN) {
 			m_queuePRHead = 0;
@@ -5440,6 +6301,12 @@ void Pathfinder::processPathfindQueue(void)
 		{
 			DEBUG_LOG(("%d Pathfind queue: %d paths, %d cells", TheGameLogic->getFrame(), pathsFound, m_cumulativeCellsAllocated));
 			DEBUG_LOG(("Time %f (%f)", timeToUpdate, (::GetTickCount()-startTimeMS)/1000.0f));
+			if (timeToUpdate > 0.0) {
+				DEBUG_LOG((", %d cells/sec", REAL_TO_INT(m_cumulativeCellsAllocated/timeToUpdate)));
+			}
+			PathfindCacheStats stats;
+			m_pathCache.getStats(stats);
+			DEBUG_LOG((", path cache %d/%d hits", stats.m_hits, stats.m_lookups));
 			DEBUG_LOG(("\n"));
 		}
 #endif
@@ -5845,107 +6712,618 @@ Int Pathfinder::examineNeighboringCells(PathfindCell *parentCell, PathfindCell *
 			if (m_isTunneling) {
 				costRemaining = 0; // find the closest valid cell.
 			}
-			newCell->setTotalCost(newCell->getCostSoFar() + costRemaining) ;
+			newCell->setTotalCost(newCell->getCostSoFar() + costRemaining) ;
+
+			//DEBUG_LOG(("Cell (%d,%d), Parent cost %d, newCostSoFar %d, cost rem %d, tot %d\n", 
+			//	newCell->getXIndex(), newCell->getYIndex(), 
+			//	newCell->costSoFar(parentCell), newCostSoFar, costRemaining, newCell->getCostSoFar() + costRemaining));
+
+			// if newCell was on closed list, remove it from the list
+			if (newCell->getClosed())
+				m_closedList = newCell->removeFromClosedList( m_closedList );
+
+			// if the newCell was already on the open list, remove it so it can be re-inserted in order
+			if (newCell->getOpen())
+				m_openList = newCell->removeFromOpenList( m_openList );
+
+			// insert newCell in open list such that open list is sorted, smallest total path cost first
+			m_openList = newCell->putOnSortedOpenList( m_openList );
+		}
+	return cellCount;
+}
+
+
+/**
+ * Find a short, valid path between given locations.
+ * Uses A* algorithm.
+ */
+Path *Pathfinder::findPath( Object *obj, const LocomotorSet& locomotorSet, const Coord3D *from, 
+													 const Coord3D *rawTo)
+{
+	if (!quickDoesPathExist(locomotorSet, from, rawTo)) {
+		return NULL;
+	}
+	bool isHuman = true;
+	if (obj && obj->getControllingPlayer() && (obj->getControllingPlayer()->getPlayerType()==PLAYER_COMPUTER)) {
+		isHuman = false; // computer gets to cheat.
+	}
+
+	// Units ordered together usually path from the same cell to the same cell, so check the cache.
+	// A cached path was found for another unit, which only matches this one's search as far as 
+	// the key goes (its own goal cell, for one, isn't in it), so this is a per game option.
+	bool sharedPaths = arePathsShared();
+	PathfindCacheKey key;
+	makePathCacheKey(obj, locomotorSet, from, rawTo, key);
+	Path *cachedPath = sharedPaths ? m_pathCache.findPath(key, TheGameLogic->getFrame()) : NULL;
+	if (cachedPath) {
+		if (!checkDestination(obj, key.m_goalCell.x, key.m_goalCell.y, key.m_goalLayer, key.m_radius, key.m_centerInCell)) {
+			cachedPath->deleteInstance();
+			return NULL;
+		}
+		// put actual start position as first node on the path, so it begins right at the unit's feet
+		if (from->x != cachedPath->getFirstNode()->getPosition()->x || from->y != cachedPath->getFirstNode()->getPosition()->y) {
+			cachedPath->prependNode( from, key.m_startLayer );
+		}
+		cachedPath->optimize(obj, locomotorSet.getValidSurfaces(), false);
+		return cachedPath;
+	}
+
+	// Large groups moved to the same place trace a shared flow field instead of searching.
+	Path *flowPath = findFlowFieldPath(obj, locomotorSet, from, key);
+	if (flowPath) {
+		return flowPath;
+	}
+
+	m_zoneManager.clearPassableFlags();
+	Path *hPat = findHierarchicalPath(isHuman, locomotorSet, from, rawTo, false);
+	if (hPat) {
+		hPat->deleteInstance();
+	}	else {
+		m_zoneManager.setAllPassable();
+	}
+
+	Path *pat = internalFindPath(obj, locomotorSet, from, rawTo, key);
+	if (pat!=NULL) {
+		if (sharedPaths) {
+			m_pathCache.addPath(key, from, pat, TheGameLogic->getFrame());
+		}
+		return pat;
+	}
+
+/* hierarchical build path code.
+	if (pat) {
+
+		Path *path = newInstance(Path);
+		PathNode *prior = NULL;
+		for (PathNode *node = pat->getLastNode(); node; node=node->getPrevious()) {
+			bool unobstructed = true;
+			if (prior!=NULL) {
+				unobstructed = isLinePassable( obj, locomotorSet.getValidSurfaces(), 
+				prior->getLayer(), *prior->getPosition(), *node->getPosition(), false, true);
+			}
+			if (unobstructed) {
+				path->prependNode( node->getPosition(), node->getLayer() );
+				path->getFirstNode()->setCanOptimize(node->getCanOptimize());	
+				path->getFirstNode()->setNextOptimized(path->getFirstNode()->getNext());
+			} else {
+				Path *linkPath = findClosestPath(obj, locomotorSet, node->getPosition(), 
+					prior->getPosition(), false, 0, true);
+				if (linkPath==NULL) {
+					DEBUG_LOG(("Couldn't find path - unexpected. jba.\n"));
+					continue;
+				}
+				PathNode *linkNode = linkPath->getLastNode();
+				if (linkNode==NULL) {
+					DEBUG_LOG(("Empty path - unexpected. jba.\n"));
+					continue;
+				}
+				for (linkNode=linkNode->getPrevious(); linkNode; linkNode=linkNode->getPrevious()) {
+					path->prependNode( linkNode->getPosition(), linkNode->getLayer() );
+					path->getFirstNode()->setCanOptimize(linkNode->getCanOptimize());
+					path->getFirstNode()->setNextOptimized(path->getFirstNode()->getNext());
+				}
+				linkPath->deleteInstance();
+			}
+			prior = node;
+		}
+		pat->deleteInstance();
+		path->optimize(obj, locomotorSet.getValidSurfaces(), false);
+		if (TheGlobalData->m_debugAI) {
+			setDebugPath(path);
+		}
+		return path;
+	}
+*/
+	return NULL; 
+}
+/**
+ * Fill in the path cache key for a findPath request.  Mirrors the start & goal cell
+ * calculations in internalFindPath.
+ */
+void Pathfinder::makePathCacheKey(const Object *obj, const LocomotorSet& locomotorSet, const Coord3D *from, 
+																	const Coord3D *rawTo, PathfindCacheKey &key)
+{
+	key.m_centerInCell = true;
+	key.m_radius = 0;
+	if (obj) {
+		getRadiusAndCenter(obj, key.m_radius, key.m_centerInCell);
+	}
+	Coord3D adjustTo = *rawTo;
+	Coord3D clipFrom = *from;
+	clip(&clipFrom, &adjustTo);
+	if (!key.m_centerInCell) {
+		adjustTo.x += PATHFIND_CELL_SIZE_F/2;
+		adjustTo.y += PATHFIND_CELL_SIZE_F/2;
+	}
+	worldToCell(&clipFrom, &key.m_startCell);
+	worldToCell(&adjustTo, &key.m_goalCell);
+	key.m_startLayer = obj ? obj->getLayer() : LAYER_GROUND;
+	key.m_goalLayer = TheTerrainLogic->getLayerForDestination(&adjustTo);
+	key.m_surfaces = locomotorSet.getValidSurfaces();
+	key.m_crusher = obj ? obj->getCrusherLevel() > 0 : false;
+	key.m_playerIndex = -1;
+	if (obj && obj->getControllingPlayer()) {
+		key.m_playerIndex = obj->getControllingPlayer()->getPlayerIndex();
+	}
+	key.m_ignoreObstacleID = m_ignoreObstacleID;
+}
+
+// Neighbor steps for the flow field directions.  Orthogonal first, as in examineNeighboringCells.
+static const ICoord2D s_flowFieldDelta[8] = 
+{ 
+	{ 1, 0 }, { 0, 1 }, { -1, 0 }, { 0, -1 }, 
+	{ 1, 1 }, { -1, 1 }, { -1, -1 }, { 1, -1 } 
+};
+static const Int s_flowFieldOpposite[8] = {2, 3, 0, 1, 6, 7, 4, 5};
+
+/* Return a scratch array of at least size bools, growing it if need be.  Kept between
+buildFlowField calls, so group moves don't allocate. */
+bool *Pathfinder::growFlowFieldScratch(bool *&cells, Int &cellsSize, Int size)
+{
+	if (size > cellsSize) {
+		if (cells) {
+			delete [] cells;
+		}
+		cells = MSGNEW("PathfindFlowField") bool[size];
+		cellsSize = size;
+	}
+	return cells;
+}
+
+/* True if a unit of radius centered on the cell only covers valid cells.  Matches the 
+footprint checkForMovement uses. */
+bool Pathfinder::isFlowFieldCellClear(const bool *validCells, const IRegion2D &validBounds, Int cellX, Int cellY, 
+																			Int radius, bool centerInCell) const
+{
+	Int numCellsAbove = radius;
+	if (centerInCell) numCellsAbove++;
+	Int width = validBounds.hi.x - validBounds.lo.x + 1;
+	Int i, j;
+	for (j=cellY-radius; j<cellY+numCellsAbove; j++) {
+		for (i=cellX-radius; i<cellX+numCellsAbove; i++) {
+			if (!validCells[(j-validBounds.lo.y)*width + (i-validBounds.lo.x)]) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+/**
+ * Build a flow field to goal for units that move like obj, covering the group's bounds.  Called 
+ * once per locomotor class when a large group is ordered to move, so the members' findPath calls 
+ * can trace the field instead of each doing an A* search.  Does nothing if a current field 
+ * already covers the group.
+ */
+void Pathfinder::buildFlowField( const Object *obj, const LocomotorSet& locomotorSet, const Coord3D *goal,
+																const Coord2D *groupMin, const Coord2D *groupMax )
+{
+	if (!m_isMapReady || obj == NULL || locomotorSet.isDownhillOnly() || !areFlowFieldsShared()) {
+		return;
+	}
+	Int radius;
+	bool centerInCell;
+	getRadiusAndCenter(obj, radius, centerInCell);
+	bool crusher = obj->getCrusherLevel() > 0;
+	LocomotorSurfaceTypeMask surfaces = locomotorSet.getValidSurfaces();
+
+	// Same goal cell as makePathCacheKey.
+	Coord3D adjustGoal = *goal;
+	if (!centerInCell) {
+		adjustGoal.x += PATHFIND_CELL_SIZE_F/2;
+		adjustGoal.y += PATHFIND_CELL_SIZE_F/2;
+	}
+	if (TheTerrainLogic->getLayerForDestination(&adjustGoal) != LAYER_GROUND) {
+		return;
+	}
+	ICoord2D goalCell;
+	worldToCell(&adjustGoal, &goalCell);
+
+	ICoord2D groupLo, groupHi;
+	groupLo.x = REAL_TO_INT_FLOOR(groupMin->x/PATHFIND_CELL_SIZE_F);
+	groupLo.y = REAL_TO_INT_FLOOR(groupMin->y/PATHFIND_CELL_SIZE_F);
+	groupHi.x = REAL_TO_INT_FLOOR(groupMax->x/PATHFIND_CELL_SIZE_F);
+	groupHi.y = REAL_TO_INT_FLOOR(groupMax->y/PATHFIND_CELL_SIZE_F);
+
+	UnsignedInt frame = TheGameLogic->getFrame();
+	Int i;
+	for (i=0; i<MAX_FLOW_FIELDS; i++) {
+		const PathfindFlowField &field = m_flowFields[i];
+		if (!field.isValid(frame)) continue;
+		if (field.m_goalCell.x != goalCell.x || field.m_goalCell.y != goalCell.y) continue;
+		if (field.m_surfaces != surfaces || field.m_crusher != crusher) continue;
+		if (field.m_radius != radius || field.m_centerInCell != centerInCell) continue;
+		if (field.contains(groupLo.x, groupLo.y) && field.contains(groupHi.x, groupHi.y)) {
+			return;
+		}
+	}
+
+	IRegion2D bounds;
+	bounds.lo.x = min(groupLo.x, goalCell.x) - PathfindFlowField::FLOW_FIELD_MARGIN;
+	bounds.lo.y = min(groupLo.y, goalCell.y) - PathfindFlowField::FLOW_FIELD_MARGIN;
+	bounds.hi.x = max(groupHi.x, goalCell.x) + PathfindFlowField::FLOW_FIELD_MARGIN;
+	bounds.hi.y = max(groupHi.y, goalCell.y) + PathfindFlowField::FLOW_FIELD_MARGIN;
+	// Stay on the logical map, so the paths are good for human players too.
+	if (bounds.lo.x < m_logicalExtent.lo.x) bounds.lo.x = m_logicalExtent.lo.x;
+	if (bounds.lo.y < m_logicalExtent.lo.y) bounds.lo.y = m_logicalExtent.lo.y;
+	if (bounds.hi.x > m_logicalExtent.hi.x) bounds.hi.x = m_logicalExtent.hi.x;
+	if (bounds.hi.y > m_logicalExtent.hi.y) bounds.hi.y = m_logicalExtent.hi.y;
+	if (bounds.lo.x > goalCell.x || bounds.lo.y > goalCell.y || bounds.hi.x < goalCell.x || bounds.hi.y < goalCell.y) {
+		return;
+	}
+	Int width = bounds.hi.x - bounds.lo.x + 1;
+	Int numCells = width*(bounds.hi.y - bounds.lo.y + 1);
+	if (numCells > PathfindFlowField::FLOW_FIELD_MAX_CELLS) {
+		return;
+	}
+
+	// Classify the cells once, then check the footprints against that.
+	IRegion2D validBounds = bounds;
+	validBounds.lo.x -= radius+1;
+	validBounds.lo.y -= radius+1;
+	validBounds.hi.x += radius+1;
+	validBounds.hi.y += radius+1;
+	Int validWidth = validBounds.hi.x - validBounds.lo.x + 1;
+	Int numValid = validWidth*(validBounds.hi.y - validBounds.lo.y + 1);
+	bool *validCells = growFlowFieldScratch(m_flowFieldValidCells, m_flowFieldValidSize, numValid);
+	ObjectID saveIgnoreObstacleID = m_ignoreObstacleID;
+	m_ignoreObstacleID = INVALID_ID;
+	Int x, y;
+	for (y=validBounds.lo.y; y<=validBounds.hi.y; y++) {
+		for (x=validBounds.lo.x; x<=validBounds.hi.x; x++) {
+			validCells[(y-validBounds.lo.y)*validWidth + (x-validBounds.lo.x)] = 
+				validMovementPosition(crusher, surfaces, getCell(LAYER_GROUND, x, y));
+		}
+	}
+	m_ignoreObstacleID = saveIgnoreObstacleID;
+
+	bool *clearCells = growFlowFieldScratch(m_flowFieldClearCells, m_flowFieldClearSize, numCells);
+	for (y=bounds.lo.y; y<=bounds.hi.y; y++) {
+		for (x=bounds.lo.x; x<=bounds.hi.x; x++) {
+			clearCells[(y-bounds.lo.y)*width + (x-bounds.lo.x)] = 
+				isFlowFieldCellClear(validCells, validBounds, x, y, radius, centerInCell);
+		}
+	}
+
+	Int goalNdx = (goalCell.y-bounds.lo.y)*width + (goalCell.x-bounds.lo.x);
+	if (!clearCells[goalNdx]) {
+		return;
+	}
+
+	PathfindFlowField &field = m_flowFields[m_nextFlowField];
+	m_nextFlowField = (m_nextFlowField+1) % MAX_FLOW_FIELDS;
+	field.allocate(bounds);
+	field.m_goalCell = goalCell;
+	field.m_surfaces = surfaces;
+	field.m_radius = radius;
+	field.m_centerInCell = centerInCell;
+	field.m_crusher = crusher;
+	field.m_frame = frame;
+
+	// Dijkstra outward from the goal.  Costs match PathfindCell::costSoFar, without the turn costs.
+	const Int firstDiagonal = 4;
+	const Int adjacent[5] = {0, 1, 2, 3, 0};
+	std::vector<PathfindFlowField::OpenCell> &openCells = m_flowFieldOpenCells;
+	openCells.clear();
+	PathfindFlowField::OpenCell openCell;
+	openCell.m_cost = 0;
+	openCell.m_index = goalNdx;
+	field.m_costs[goalNdx] = 0;
+	field.m_directions[goalNdx] = PathfindFlowField::GOAL_DIRECTION;
+	openCells.push_back(openCell);
+	while (!openCells.empty()) {
+		std::pop_heap(openCells.begin(), openCells.end());
+		PathfindFlowField::OpenCell cur = openCells.back();
+		openCells.pop_back();
+		if (cur.m_cost != field.m_costs[cur.m_index]) {
+			continue; // Already reached more cheaply.
+		}
+		x = bounds.lo.x + cur.m_index%width;
+		y = bounds.lo.y + cur.m_index/width;
+		UnsignedInt enterCost = 0;
+		PathfindCell *curCell = getCell(LAYER_GROUND, x, y);
+		if (curCell && curCell->getPinched()) {
+			enterCost = COST_DIAGONAL;
+		}
+		bool neighborFlags[4] = {false, false, false, false};
+		for (i=0; i<8; i++) {
+			Int newX = x + s_flowFieldDelta[i].x;
+			Int newY = y + s_flowFieldDelta[i].y;
+			if (!field.contains(newX, newY)) {
+				continue;
+			}
+			Int newNdx = field.getIndex(newX, newY);
+			if (!clearCells[newNdx]) {
+				continue;
+			}
+			if (i<firstDiagonal) {
+				neighborFlags[i] = true;
+			} else if (!neighborFlags[adjacent[i-4]] && !neighborFlags[adjacent[i-3]]) {
+				// make sure one of the adjacent sides is open.
+				continue;
+			}
+			UnsignedInt newCost = cur.m_cost + enterCost;
+			newCost += (i<firstDiagonal) ? COST_ORTHOGONAL : COST_DIAGONAL;
+			if (field.m_directions[newNdx] != PathfindFlowField::NO_DIRECTION && field.m_costs[newNdx] <= newCost) {
+				continue;
+			}
+			field.m_costs[newNdx] = newCost;
+			field.m_directions[newNdx] = s_flowFieldOpposite[i];
+			openCell.m_cost = newCost;
+			openCell.m_index = newNdx;
+			openCells.push_back(openCell);
+			std::push_heap(openCells.begin(), openCells.end());
+		}
+	}
+}
+
+/**
+ * Trace a path for the findPath request in key through a current flow field.  Both the start 
+ * and goal cells follow the field toward the field's goal until they meet, so units whose own 
+ * goal is near the group goal get a path too.  Returns NULL if no field fits, and findPath 
+ * does a normal search.
+ */
+Path *Pathfinder::findFlowFieldPath(const Object *obj, const LocomotorSet& locomotorSet, const Coord3D *from, 
+																		const PathfindCacheKey &key)
+{
+	if (obj == NULL || key.m_ignoreObstacleID != INVALID_ID || locomotorSet.isDownhillOnly() || !areFlowFieldsShared()) {
+		return NULL;
+	}
+	if (key.m_startLayer != LAYER_GROUND || key.m_goalLayer != LAYER_GROUND) {
+		return NULL;
+	}
+	if (key.m_startCell.x == key.m_goalCell.x && key.m_startCell.y == key.m_goalCell.y) {
+		return NULL;
+	}
+	UnsignedInt frame = TheGameLogic->getFrame();
+	const PathfindFlowField *field = NULL;
+	Int i;
+	for (i=0; i<MAX_FLOW_FIELDS; i++) {
+		const PathfindFlowField &curField = m_flowFields[i];
+		if (!curField.isValid(frame)) continue;
+		if (curField.m_surfaces != key.m_surfaces || curField.m_crusher != key.m_crusher) continue;
+		if (curField.m_radius != key.m_radius || curField.m_centerInCell != key.m_centerInCell) continue;
+		if (abs(curField.m_goalCell.x - key.m_goalCell.x) > PathfindFlowField::FLOW_FIELD_GOAL_RADIUS) continue;
+		if (abs(curField.m_goalCell.y - key.m_goalCell.y) > PathfindFlowField::FLOW_FIELD_GOAL_RADIUS) continue;
+		if (!curField.isReached(key.m_startCell.x, key.m_startCell.y)) continue;
+		if (!curField.isReached(key.m_goalCell.x, key.m_goalCell.y)) continue;
+		field = &curField;
+		break;
+	}
+	if (field == NULL) {
+		return NULL;
+	}
+	if (!checkDestination(obj, key.m_goalCell.x, key.m_goalCell.y, key.m_goalLayer, key.m_radius, key.m_centerInCell)) {
+		return NULL;
+	}
+
+	// Costs drop with every step, so stepping whichever end costs more finds where they meet.
+	std::vector<ICoord2D> startCells;
+	std::vector<ICoord2D> goalCells;
+	ICoord2D startCell = key.m_startCell;
+	ICoord2D goalCell = key.m_goalCell;
+	while (startCell.x != goalCell.x || startCell.y != goalCell.y) {
+		Int startNdx = field->getIndex(startCell.x, startCell.y);
+		Int goalNdx = field->getIndex(goalCell.x, goalCell.y);
+		if (field->m_costs[startNdx] >= field->m_costs[goalNdx] && 
+			field->m_directions[startNdx] != PathfindFlowField::GOAL_DIRECTION) {
+			startCells.push_back(startCell);
+			startCell.x += s_flowFieldDelta[field->m_directions[startNdx]].x;
+			startCell.y += s_flowFieldDelta[field->m_directions[startNdx]].y;
+		} else {
+			goalCells.push_back(goalCell);
+			goalCell.x += s_flowFieldDelta[field->m_directions[goalNdx]].x;
+			goalCell.y += s_flowFieldDelta[field->m_directions[goalNdx]].y;
+		}
+	}
+	startCells.push_back(startCell);
+	for (i=(Int)goalCells.size()-1; i>=0; i--) {
+		startCells.push_back(goalCells[i]);
+	}
+
+	// Build the path back from the goal, skipping the start cell, as prependCells does.
+	Path *path = newInstance(Path);
+	Coord3D pos;
+	PathfindCell *prevCell = NULL;
+	for (i=(Int)startCells.size()-1; i>=1; i--) {
+		PathfindCell *cell = getCell(LAYER_GROUND, startCells[i].x, startCells[i].y);
+		adjustCoordToCell(startCells[i].x, startCells[i].y, key.m_centerInCell, pos, LAYER_GROUND);
+		bool canOptimize = true;
+		if (cell->getType() == PathfindCell::CELL_CLIFF) {
+			if (prevCell && prevCell->getType() != PathfindCell::CELL_CLIFF) {
+				path->getFirstNode()->setCanOptimize(false);
+			}
+		}	else {
+			if (prevCell && prevCell->getType() == PathfindCell::CELL_CLIFF) {
+				canOptimize = false;
+			}
+		}
+		path->prependNode( &pos, LAYER_GROUND );
+		path->getFirstNode()->setCanOptimize(canOptimize);
+		prevCell = cell;
+	}
+	// put actual start position as first node on the path, so it begins right at the unit's feet
+	if (from->x != path->getFirstNode()->getPosition()->x || from->y != path->getFirstNode()->getPosition()->y) {
+		path->prependNode( from, LAYER_GROUND );
+	}
+	path->optimize(obj, key.m_surfaces, false);
+	return path;
+}
 
-			//DEBUG_LOG(("Cell (%d,%d), Parent cost %d, newCostSoFar %d, cost rem %d, tot %d\n", 
-			//	newCell->getXIndex(), newCell->getYIndex(), 
-			//	newCell->costSoFar(parentCell), newCostSoFar, costRemaining, newCell->getCostSoFar() + costRemaining));
+/* Drop the flow fields that overlap cellBounds, as their cells changed. */
+void Pathfinder::invalidateFlowFields(const IRegion2D &cellBounds)
+{
+	Int i;
+	for (i=0; i<MAX_FLOW_FIELDS; i++) {
+		PathfindFlowField &field = m_flowFields[i];
+		if (cellBounds.hi.x < field.m_bounds.lo.x || cellBounds.lo.x > field.m_bounds.hi.x) continue;
+		if (cellBounds.hi.y < field.m_bounds.lo.y || cellBounds.lo.y > field.m_bounds.hi.y) continue;
+		field.clear();
+	}
+}
 
-			// if newCell was on closed list, remove it from the list
-			if (newCell->getClosed())
-				m_closedList = newCell->removeFromClosedList( m_closedList );
+void Pathfinder::resetFlowFields(void)
+{
+	Int i;
+	for (i=0; i<MAX_FLOW_FIELDS; i++) {
+		m_flowFields[i].clear();
+	}
+}
 
-			// if the newCell was already on the open list, remove it so it can be re-inserted in order
-			if (newCell->getOpen())
-				m_openList = newCell->removeFromOpenList( m_openList );
+/**
+ * Save the open & closed lists of the current internalFindPath search, and release them.
+ * Cells are saved by position, since the infos go back to the pool until next frame.
+ */
+void Pathfinder::suspendSearch(const Object *obj, const PathfindCacheKey &key)
+{
+	m_suspendedSearch.clear();
+	m_suspendedSearch.m_objID = obj->getID();
+	m_suspendedSearch.m_key = key;
+	m_suspendedSearch.m_openSequence = PathfindCell::getOpenListSequence();
+	m_suspendedSearch.m_isTunneling = m_isTunneling;
 
-			// insert newCell in open list such that open list is sorted, smallest total path cost first
-			m_openList = newCell->putOnSortedOpenList( m_openList );
-		}
-	return cellCount;
+	PathfindCell *cell;
+	for (cell = m_closedList; cell; cell = cell->getNextOpen()) {
+		m_suspendedSearch.m_numClosed++;
+	}
+	m_suspendedSearch.m_cells.resize(m_suspendedSearch.m_numClosed + PathfindCell::getOpenListCount());
+
+	Int i = 0;
+	for (cell = m_closedList; cell; cell = cell->getNextOpen()) {
+		saveSearchCell(cell, m_suspendedSearch.m_cells[i++]);
+	}
+	Int j;
+	for (j=0; j<PathfindCell::getOpenListCount(); j++) {
+		saveSearchCell(PathfindCell::getOpenListCell(j), m_suspendedSearch.m_cells[i++]);
+	}
+
+	m_searchSuspended = true;
+	m_isTunneling = false;
+	cleanOpenAndClosedLists();
 }
 
+/**
+ * Record one cell of a suspended search.
+ */
+void Pathfinder::saveSearchCell(PathfindCell *cell, PathfindSearchState::SavedCell &saved)
+{
+	saved.m_pos.x = cell->getXIndex();
+	saved.m_pos.y = cell->getYIndex();
+	saved.m_layer = cell->getLayer();
+	saved.m_costSoFar = cell->getCostSoFar();
+	saved.m_totalCost = cell->getTotalCost();
+	saved.m_open = cell->getOpen();
+	saved.m_openSequence = saved.m_open ? cell->getOpenSequence() : 0;
+	saved.m_blockedByAlly = cell->isBlockedByAlly();
+	PathfindCell *parent = cell->getParentCell();
+	saved.m_hasParent = (parent != NULL);
+	saved.m_parentPos.x = saved.m_parentPos.y = 0;
+	saved.m_parentLayer = LAYER_GROUND;
+	if (parent) {
+		saved.m_parentPos.x = parent->getXIndex();
+		saved.m_parentPos.y = parent->getYIndex();
+		saved.m_parentLayer = parent->getLayer();
+	}
+}
 
 /**
- * Find a short, valid path between given locations.
- * Uses A* algorithm.
+ * If the suspended search is for this object & request, rebuild its open & closed lists
+ * and return true.  Returns false if there is nothing to resume, and the caller starts 
+ * a new search.
  */
-Path *Pathfinder::findPath( Object *obj, const LocomotorSet& locomotorSet, const Coord3D *from, 
-													 const Coord3D *rawTo)
+bool Pathfinder::resumeSearch(const Object *obj, const PathfindCacheKey &key)
 {
-	if (!quickDoesPathExist(locomotorSet, from, rawTo)) {
-		return NULL;
+	if (obj==NULL || m_suspendedSearch.m_objID != obj->getID()) {
+		return false;
 	}
-	bool isHuman = true;
-	if (obj && obj->getControllingPlayer() && (obj->getControllingPlayer()->getPlayerType()==PLAYER_COMPUTER)) {
-		isHuman = false; // computer gets to cheat.
+	if (!m_suspendedSearch.m_key.isSameKey(key)) {
+		// Same unit, different request.
+		m_suspendedSearch.clear();
+		return false;
 	}
+	DEBUG_ASSERTCRASH(m_openList==NULL && m_closedList == NULL, ("Dangling lists."));
 
-	m_zoneManager.clearPassableFlags();
-	Path *hPat = findHierarchicalPath(isHuman, locomotorSet, from, rawTo, false);
-	if (hPat) {
-		hPat->deleteInstance();
-	}	else {
-		m_zoneManager.setAllPassable();
+	bool restored = true;
+	Int numCells = m_suspendedSearch.m_cells.size();
+	Int i;
+	// Closed list was saved head first, so rebuild it from the tail.
+	for (i=numCells-1; i>=0 && restored; i--) {
+		const PathfindSearchState::SavedCell &saved = m_suspendedSearch.m_cells[i];
+		PathfindCell *cell = getCell(saved.m_layer, saved.m_pos.x, saved.m_pos.y);
+		if (cell==NULL || !cell->allocateInfo(saved.m_pos)) {
+			restored = false;
+			break;
+		}
+		cell->setCostSoFar(saved.m_costSoFar);
+		cell->setTotalCost(saved.m_totalCost);
+		cell->setBlockedByAlly(saved.m_blockedByAlly);
+		if (saved.m_open) {
+			m_openList = cell->restoreOnOpenList(m_openList, saved.m_openSequence);
+		} else {
+			m_closedList = cell->putOnClosedList(m_closedList);
+		}
 	}
 
-	Path *pat = internalFindPath(obj, locomotorSet, from, rawTo);
-	if (pat!=NULL) {
-		return pat;
+	// Parents are all on the lists now, so the links can be restored.
+	for (i=0; i<numCells && restored; i++) {
+		const PathfindSearchState::SavedCell &saved = m_suspendedSearch.m_cells[i];
+		PathfindCell *cell = getCell(saved.m_layer, saved.m_pos.x, saved.m_pos.y);
+		if (saved.m_hasParent) {
+			PathfindCell *parent = getCell(saved.m_parentLayer, saved.m_parentPos.x, saved.m_parentPos.y);
+			DEBUG_ASSERTCRASH(parent && parent->hasInfo(), ("Suspended search lost a parent cell. jba."));
+			cell->setParentCellHierarchical(parent);
+		} else {
+			cell->clearParentCell();
+		}
 	}
 
-/* hierarchical build path code.
-	if (pat) {
+	m_isTunneling = m_suspendedSearch.m_isTunneling;
+	PathfindCell::setOpenListSequence(m_suspendedSearch.m_openSequence);
+	m_suspendedSearch.clear();
 
-		Path *path = newInstance(Path);
-		PathNode *prior = NULL;
-		for (PathNode *node = pat->getLastNode(); node; node=node->getPrevious()) {
-			bool unobstructed = true;
-			if (prior!=NULL) {
-				unobstructed = isLinePassable( obj, locomotorSet.getValidSurfaces(), 
-				prior->getLayer(), *prior->getPosition(), *node->getPosition(), false, true);
-			}
-			if (unobstructed) {
-				path->prependNode( node->getPosition(), node->getLayer() );
-				path->getFirstNode()->setCanOptimize(node->getCanOptimize());	
-				path->getFirstNode()->setNextOptimized(path->getFirstNode()->getNext());
-			} else {
-				Path *linkPath = findClosestPath(obj, locomotorSet, node->getPosition(), 
-					prior->getPosition(), false, 0, true);
-				if (linkPath==NULL) {
-					DEBUG_LOG(("Couldn't find path - unexpected. jba.\n"));
-					continue;
-				}
-				PathNode *linkNode = linkPath->getLastNode();
-				if (linkNode==NULL) {
-					DEBUG_LOG(("Empty path - unexpected. jba.\n"));
-					continue;
-				}
-				for (linkNode=linkNode->getPrevious(); linkNode; linkNode=linkNode->getPrevious()) {
-					path->prependNode( linkNode->getPosition(), linkNode->getLayer() );
-					path->getFirstNode()->setCanOptimize(linkNode->getCanOptimize());
-					path->getFirstNode()->setNextOptimized(path->getFirstNode()->getNext());
-				}
-				linkPath->deleteInstance();
-			}
-			prior = node;
+	if (!restored) {
+		DEBUG_LOG(("Ran out of pathfind cells resuming a search, starting it over.\n"));
+		cleanOpenAndClosedLists();
+		// The start & goal cells may have gone back to the pool with the lists.
+		PathfindCell *goalCell = getCell(key.m_goalLayer, key.m_goalCell.x, key.m_goalCell.y);
+		if (goalCell) {
+			goalCell->allocateInfo(key.m_goalCell);
 		}
-		pat->deleteInstance();
-		path->optimize(obj, locomotorSet.getValidSurfaces(), false);
-		if (TheGlobalData->m_debugAI) {
-			setDebugPath(path);
+		PathfindCell *startCell = getCell(key.m_startLayer, key.m_startCell.x, key.m_startCell.y);
+		if (startCell) {
+			startCell->allocateInfo(key.m_startCell);
 		}
-		return path;
+		return false;
 	}
-*/
-	return NULL; 
+	return true;
 }
+
 /**
  * Find a short, valid path between given locations.
  * Uses A* algorithm.
  */
 Path *Pathfinder::internalFindPath( Object *obj, const LocomotorSet& locomotorSet, const Coord3D *from, 
-													 const Coord3D *rawTo)
+													 const Coord3D *rawTo, const PathfindCacheKey &key)
 {
 	//CRCDEBUG_LOG(("Pathfinder::findPath()\n"));
 #ifdef INTENSE_DEBUG
@@ -6081,14 +7459,21 @@ Path *Pathfinder::internalFindPath( Object *obj, const LocomotorSet& locomotorSe
 		m_isTunneling = true;
 	}
 
-	parentCell->startPathfind(goalCell);
-
-	// initialize "open" list to contain start cell
-	m_openList = parentCell;
-
 	// "closed" list is initially empty
 	m_closedList = NULL;
 
+	bool resumed = false;
+	if (m_suspendedSearch.m_objID != INVALID_ID) {
+		resumed = resumeSearch(obj, key);
+	}
+
+	if (!resumed) {
+		parentCell->startPathfind(goalCell);
+
+		// initialize "open" list to contain start cell
+		m_openList = parentCell->putOnSortedOpenList( m_openList );
+	}
+
 	Int cellCount = 0;
 
 	//
@@ -6097,6 +7482,13 @@ Path *Pathfinder::internalFindPath( Object *obj, const LocomotorSet& locomotorSe
 	//
 	while( m_openList != NULL )
 	{
+		if (m_searchCellBudget > 0 && cellCount >= m_searchCellBudget && obj) {
+			// Out of cells for this frame.  Save the search, and pick it up next frame.
+			suspendSearch(obj, key);
+			goalCell->releaseInfo();
+			return NULL;
+		}
+
 		// take head cell off of open list - it has lowest estimated total path cost
 		parentCell = m_openList;
 		m_openList = parentCell->removeFromOpenList(m_openList);
@@ -6581,7 +7973,7 @@ Path *Pathfinder::findGroundPath( const Coord3D *from,
 	parentCell->startPathfind(goalCell);
 
 	// initialize "open" list to contain start cell
-	m_openList = parentCell;
+	m_openList = parentCell->putOnSortedOpenList( m_openList );
 
 	// "closed" list is initially empty
 	m_closedList = NULL;
@@ -6811,17 +8203,17 @@ Path *Pathfinder::findGroundPath( const Coord3D *from,
  * Find a short, valid path between given locations.
  * Uses A* algorithm.
  */
-void Pathfinder::processHierarchicalCell( const ICoord2D &scanCell, const ICoord2D &delta, PathfindCell *parentCell, 
+void Pathfinder::processHierarchicalCell( const ZoneBlockPortal &portal, const ICoord2D &scanCell, const ICoord2D &delta, 
+																				 PathfindCell *parentCell, 
 																				 PathfindCell *goalCell, zoneStorageType parentZone, 
 																				 zoneStorageType *examinedZones, Int &numExZones,
 																				 bool crusher, Int &cellCount)
 {
-	if (scanCell.x<m_extent.lo.x || scanCell.x>m_extent.hi.x ||
-		scanCell.y<m_extent.lo.y || scanCell.y>m_extent.hi.y) {
+	if (!portal.m_onMap) {
 		return;
 	}
-	if (parentZone == m_zoneManager.getBlockZone(LOCOMOTORSURFACE_GROUND,
-		crusher, scanCell.x, scanCell.y, m_map)) { 
+	Int crusherNdx = crusher ? 1 : 0;
+	if (parentZone == m_zoneManager.getCellBlock(scanCell.x, scanCell.y)->getFirstZone() + portal.m_blockZone[crusherNdx]) { 
 		PathfindCell *newCell = getCell(LAYER_GROUND, scanCell.x, scanCell.y);
 		if (newCell->hasInfo() && (newCell->getOpen() || newCell->getClosed())) return; // already looked at this one.
 	  ICoord2D adjacentCell = scanCell;
@@ -6829,17 +8221,14 @@ void Pathfinder::processHierarchicalCell( const ICoord2D &scanCell, const ICoord
 		if (parentZone!=newCell->getZone()) return;
 		adjacentCell.x += delta.x;
 		adjacentCell.y += delta.y;
-		if (adjacentCell.x<m_extent.lo.x || adjacentCell.x>m_extent.hi.x ||
-			adjacentCell.y<m_extent.lo.y || adjacentCell.y>m_extent.hi.y) {
+		if (!portal.m_otherOnMap) {
 			return;
 		}
 		PathfindCell *adjNewCell = getCell(LAYER_GROUND, adjacentCell.x, adjacentCell.y); 
 		if (adjNewCell->hasInfo() && (adjNewCell->getOpen() || adjNewCell->getClosed())) return; // already looked at this one.
 		zoneStorageType parentGlobalZone = m_zoneManager.getEffectiveZone(LOCOMOTORSURFACE_GROUND, crusher, parentZone);
 
-		/// @todo - somehow out of bounds or bogus newZone.
-		zoneStorageType newZone = m_zoneManager.getBlockZone(LOCOMOTORSURFACE_GROUND,
-							crusher, adjacentCell.x, adjacentCell.y, m_map);
+		zoneStorageType newZone = m_zoneManager.getCellBlock(adjacentCell.x, adjacentCell.y)->getFirstZone() + portal.m_otherZone[crusherNdx];
 		zoneStorageType newGlobalZone = m_zoneManager.getEffectiveZone(LOCOMOTORSURFACE_GROUND, crusher, newZone);
 		if (newGlobalZone != parentGlobalZone) {
 			return; // can't step over. jba.
@@ -6996,9 +8385,9 @@ Path *Pathfinder::internal_findHierarchicalPath( bool isHuman, const LocomotorSu
 
 	if (parentCell->getLayer()==LAYER_GROUND) {
 		// initialize "open" list to contain start cell
-		m_openList = parentCell;
+		m_openList = parentCell->putOnSortedOpenList( m_openList );
 	}	else {
-		m_openList = parentCell;
+		m_openList = parentCell->putOnSortedOpenList( m_openList );
 		PathfindLayerEnum layer = parentCell->getLayer();
 		// We're starting on a bridge, so link to land at the bridge end points.
 		ICoord2D ndx;
@@ -7204,120 +8593,24 @@ Path *Pathfinder::internal_findHierarchicalPath( bool isHuman, const LocomotorSu
 		// put parent cell onto closed list - its evaluation is finished
 		m_closedList = parentCell->putOnClosedList( m_closedList );
 
-		Int i;
+		// Step into the neighboring blocks through the cached edge cells of this block.
+		Int i, side;
 		zoneStorageType examinedZones[PathfindZoneManager::ZONE_BLOCK_SIZE];
 		Int numExZones = 0;
-		// Left side.
-		if (blockX>0) {
-			for (i=1; i<=PathfindZoneManager::ZONE_BLOCK_SIZE; i++) {
-			ICoord2D scanCell;
-				scanCell.x = blockX*PathfindZoneManager::ZONE_BLOCK_SIZE;
-				scanCell.y = (blockY*PathfindZoneManager::ZONE_BLOCK_SIZE);
-				scanCell.y += PathfindZoneManager::ZONE_BLOCK_SIZE/2;
-				Int offset = i>>1;
-				if (i&1) offset = -offset;
-				scanCell.y += offset;	
-				ICoord2D delta;
-				delta.x = -1; // left side moves -1.
-				delta.y = 0;
-				PathfindCell *cell = getCell(LAYER_GROUND, scanCell.x, scanCell.y);
-				if (cell==NULL) continue;
-				if (cell->hasInfo() && (cell->getClosed() || cell->getOpen())) {
-					if (parentZone == m_zoneManager.getBlockZone(locomotorSurface,
-						crusher, scanCell.x, scanCell.y, m_map)) { 
-						break;
-					}
-				}
-				if (isHuman) {
-					if (scanCell.x < m_logicalExtent.lo.x || scanCell.x > m_logicalExtent.hi.x ||
-							scanCell.y < m_logicalExtent.lo.y || scanCell.y > m_logicalExtent.hi.y) {
-						continue;
-					}
-				}
-				processHierarchicalCell(scanCell, delta, parentCell, 
-					goalCell, parentZone, examinedZones, numExZones, crusher, cellCount);
-			}
-		}
-		// Right side.
-		if (blockX<zoneBlockExtent.x-1) {
-			numExZones = 0;
-			for (i=1; i<=PathfindZoneManager::ZONE_BLOCK_SIZE; i++) {
-			ICoord2D scanCell;
-				scanCell.x = blockX*PathfindZoneManager::ZONE_BLOCK_SIZE;
-				scanCell.x += PathfindZoneManager::ZONE_BLOCK_SIZE-1;
-				scanCell.y = (blockY*PathfindZoneManager::ZONE_BLOCK_SIZE);
-				scanCell.y += PathfindZoneManager::ZONE_BLOCK_SIZE/2;
-				Int offset = i>>1;
-				if (i&1) offset = -offset;
-				scanCell.y += offset;	
-				ICoord2D delta;
-				delta.x = 1; // right side moves +1.
-				delta.y = 0;
-				PathfindCell *cell = getCell(LAYER_GROUND, scanCell.x, scanCell.y);
-				if (cell==NULL) continue;
-				if (cell->hasInfo() && (cell->getClosed() || cell->getOpen())) {
-					if (parentZone == m_zoneManager.getBlockZone(locomotorSurface,
-						crusher, scanCell.x, scanCell.y, m_map)) { 
-						break;
-					}
-				}
-				if (isHuman) {
-					if (scanCell.x < m_logicalExtent.lo.x || scanCell.x > m_logicalExtent.hi.x ||
-							scanCell.y < m_logicalExtent.lo.y || scanCell.y > m_logicalExtent.hi.y) {
-						continue;
-					}
-				}
-				processHierarchicalCell(scanCell, delta, parentCell, 
-					goalCell, parentZone, examinedZones, numExZones, crusher, cellCount);
-			}
-		}
-		// Top side.
-		if (blockY>0) {
-			numExZones = 0;
-			for (i=1; i<=PathfindZoneManager::ZONE_BLOCK_SIZE; i++) {
-			ICoord2D scanCell;
-				scanCell.y = blockY*PathfindZoneManager::ZONE_BLOCK_SIZE;
-				scanCell.x = (blockX*PathfindZoneManager::ZONE_BLOCK_SIZE);
-				scanCell.x += PathfindZoneManager::ZONE_BLOCK_SIZE/2;
-				Int offset = i>>1;
-				if (i&1) offset = -offset;
-				scanCell.x += offset;	
-				ICoord2D delta;
-				delta.x = 0; 
-				delta.y = -1;	// Top side moves -1.
-				PathfindCell *cell = getCell(LAYER_GROUND, scanCell.x, scanCell.y);
-				if (cell==NULL) continue;
-				if (cell->hasInfo() && (cell->getClosed() || cell->getOpen())) {
-					if (parentZone == m_zoneManager.getBlockZone(locomotorSurface,
-						crusher, scanCell.x, scanCell.y, m_map)) { 
-						break;
-					}
-				}
-				if (isHuman) {
-					if (scanCell.x < m_logicalExtent.lo.x || scanCell.x > m_logicalExtent.hi.x ||
-							scanCell.y < m_logicalExtent.lo.y || scanCell.y > m_logicalExtent.hi.y) {
-						continue;
-					}
-				}
-				processHierarchicalCell(scanCell, delta, parentCell, 
-					goalCell, parentZone, examinedZones, numExZones, crusher, cellCount);
-			}
-		}
-		// Bottom side.
-		if (blockY<zoneBlockExtent.y-1) {
+		const ZoneBlock *block = m_zoneManager.getBlock(blockX, blockY);
+		for (side=0; side<ZoneBlock::SIDE_COUNT; side++) {
+			if (side==ZoneBlock::SIDE_LEFT && blockX<=0) continue;
+			if (side==ZoneBlock::SIDE_RIGHT && blockX>=zoneBlockExtent.x-1) continue;
+			if (side==ZoneBlock::SIDE_TOP && blockY<=0) continue;
+			if (side==ZoneBlock::SIDE_BOTTOM && blockY>=zoneBlockExtent.y-1) continue;
 			numExZones = 0;
-			for (i=1; i<=PathfindZoneManager::ZONE_BLOCK_SIZE; i++) {
-			ICoord2D scanCell;
-				scanCell.y = blockY*PathfindZoneManager::ZONE_BLOCK_SIZE;
-				scanCell.y += PathfindZoneManager::ZONE_BLOCK_SIZE-1;
-				scanCell.x = (blockX*PathfindZoneManager::ZONE_BLOCK_SIZE);
-				scanCell.x += PathfindZoneManager::ZONE_BLOCK_SIZE/2;
-				Int offset = i>>1;
-				if (i&1) offset = -offset;
-				scanCell.x += offset;	
+			const ZoneBlockPortal *portals = block->getPortals(side);
+			for (i=0; i<PathfindZoneManager::ZONE_BLOCK_SIZE; i++) {
+				const ZoneBlockPortal &portal = portals[i];
+				if (!portal.m_onMap) continue;
+				ICoord2D scanCell;
 				ICoord2D delta;
-				delta.x = 0; 
-				delta.y = 1; // Top side moves +1.
+				PathfindZoneManager::getPortalCell(blockX, blockY, side, i, scanCell, delta);
 				PathfindCell *cell = getCell(LAYER_GROUND, scanCell.x, scanCell.y);
 				if (cell==NULL) continue;
 				if (cell->hasInfo() && (cell->getClosed() || cell->getOpen())) {
@@ -7332,7 +8625,7 @@ Path *Pathfinder::internal_findHierarchicalPath( bool isHuman, const LocomotorSu
 						continue;
 					}
 				}
-				processHierarchicalCell(scanCell, delta, parentCell, 
+				processHierarchicalCell(portal, scanCell, delta, parentCell, 
 					goalCell, parentZone, examinedZones, numExZones, crusher, cellCount);
 			}
 		}
@@ -7537,7 +8830,11 @@ bool Pathfinder::slowDoesPathExist( Object *obj,
 	}
 	const LocomotorSet &locoSet = ai->getLocomotorSet();
 	m_ignoreObstacleID = ignoreObject;
+	// The caller needs the answer now, so don't time slice this search.
+	Int budget = m_searchCellBudget;
+	m_searchCellBudget = 0;
 	Path *path = findPath(obj, locoSet, from, to);
+	m_searchCellBudget = budget;
 	m_ignoreObstacleID = INVALID_ID;
 	bool found = (path!=NULL);
 	if (path) {
@@ -7640,7 +8937,7 @@ bool Pathfinder::pathDestination( 	Object *obj, const LocomotorSet& locomotorSet
 	parentCell->startPathfind(goalCell);
 
 	// initialize "open" list to contain start cell
-	m_openList = parentCell;
+	m_openList = parentCell->putOnSortedOpenList( m_openList );
 
 	// "closed" list is initially empty
 	m_closedList = NULL;
@@ -7904,7 +9201,7 @@ Int Pathfinder::checkPathCost(Object *obj, const LocomotorSet& locomotorSet, con
 	parentCell->startPathfind(goalCell);
 
 	// initialize "open" list to contain start cell
-	m_openList = parentCell;
+	m_openList = parentCell->putOnSortedOpenList( m_openList );
 
 	// "closed" list is initially empty
 	m_closedList = NULL;
@@ -8187,7 +9484,7 @@ Path *Pathfinder::findClosestPath( Object *obj, const LocomotorSet& locomotorSet
 	Real closestDistScreenSqr = FLT_MAX;
 
 	// initialize "open" list to contain start cell
-	m_openList = parentCell;
+	m_openList = parentCell->putOnSortedOpenList( m_openList );
 
 	// "closed" list is initially empty
 	m_closedList = NULL;
@@ -9080,7 +10377,12 @@ void Pathfinder::changeBridgeState( PathfindLayerEnum layer, bool repaired)
 {
 	if (m_layers[layer].isUnused()) return;	
 	if (m_layers[layer].setDestroyed(!repaired)) {
-		m_zoneManager.markZonesDirty();
+		// Only the ground cells under the bridge are reclassified.
+		IRegion2D cellBounds;
+		m_layers[layer].getGroundCellBounds(&cellBounds);
+		m_zoneManager.markZonesDirty(cellBounds);
+		m_pathCache.invalidateRegion(cellBounds);
+		invalidateFlowFields(cellBounds);
 	}
 }
 
@@ -9626,7 +10928,7 @@ Path *Pathfinder::getMoveAwayFromPath(Object* obj, Object *otherObj,
 	parentCell->startPathfind(NULL);
 
 	// initialize "open" list to contain start cell
-	m_openList = parentCell;
+	m_openList = parentCell->putOnSortedOpenList( m_openList );
 
 	// "closed" list is initially empty
 	m_closedList = NULL;
@@ -9787,7 +11089,7 @@ Path *Pathfinder::patchPath( const Object *obj, const LocomotorSet& locomotorSet
 	parentCell->startPathfind( NULL);
 
 	// initialize "open" list to contain start cell
-	m_openList = parentCell;
+	m_openList = parentCell->putOnSortedOpenList( m_openList );
 
 	// "closed" list is initially empty
 	m_closedList = NULL;
@@ -10067,7 +11369,7 @@ Path *Pathfinder::findAttackPath( const Object *obj, const LocomotorSet& locomot
 	}
 
 	// initialize "open" list to contain start cell
-	m_openList = parentCell;
+	m_openList = parentCell->putOnSortedOpenList( m_openList );
 
 	// "closed" list is initially empty
 	m_closedList = NULL;
@@ -10262,7 +11564,7 @@ Path *Pathfinder::findSafePath( const Object *obj, const LocomotorSet& locomotor
 	parentCell->startPathfind( NULL);
 
 	// initialize "open" list to contain start cell
-	m_openList = parentCell;
+	m_openList = parentCell->putOnSortedOpenList( m_openList );
 
 	// "closed" list is initially empty
 	m_closedList = NULL;
@@ -10421,15 +11723,56 @@ void Pathfinder::crc( Xfer *xfer )
 
 }  // end crc
 
+//-----------------------------------------------------------------------------
+/** Xfer method
+	* Version Info:
+	* 1: Initial version, nothing saved
+	* 2: The pathfind queue & path cache (GameLogic::xfer version 11 and later)
+	* 3: The suspended search
+	* 4: The flow fields
+	*/
 //-----------------------------------------------------------------------------
 void Pathfinder::xfer( Xfer *xfer )
 {
 
 	// version
-	XferVersion currentVersion = 1;
+	XferVersion currentVersion = 4;
 	XferVersion version = currentVersion;
 	xfer->xferVersion( &version, currentVersion );
 
+	if (version >= 2)
+	{
+		// units waiting for paths get them on the same frames they would have.
+		xfer->xferUser(m_queuedPathfindRequests, sizeof(ObjectID)*PATHFIND_QUEUE_LEN);
+		xfer->xferInt(&m_queuePRHead);
+		xfer->xferInt(&m_queuePRTail);
+
+		// a cache hit gives a different path than a search, so a loaded game needs the same hits.
+		m_pathCache.xfer(xfer);
+	}
+
+	if (version >= 3)
+	{
+		m_suspendedSearch.xfer(xfer);
+	}
+
+	if (version >= 4)
+	{
+		// group members that trace a field get different paths than a search, like the cache.
+		UnsignedByte numFields = MAX_FLOW_FIELDS;
+		xfer->xferUnsignedByte(&numFields);
+		if (numFields != MAX_FLOW_FIELDS)
+		{
+			DEBUG_CRASH(("Pathfinder::xfer - saved %d flow fields, expected %d\n", numFields, MAX_FLOW_FIELDS));
+			throw SC_INVALID_DATA;
+		}
+		xfer->xferInt(&m_nextFlowField);
+		for (Int i=0; i<MAX_FLOW_FIELDS; i++)
+		{
+			m_flowFields[i].xfer(xfer);
+		}
+	}
+
 }  // end xfer
 
 //-----------------------------------------------------------------------------
@@ -10437,3 +11780,154 @@ void Pathfinder::loadPostProcess( void )
 {
 
 }  // end loadPostProcess
+
+//-----------------------------------------------------------------------------
+#if defined RTS_DEBUG || defined RTS_INTERNAL
+
+enum { BENCHMARK_GRID_SIZE = 160 };	///< 160*160 cells is less than CELL_INFOS_TO_ALLOCATE, so no search runs out of infos.
+
+/**
+ * Fixed pseudo random numbers, so every run searches the same grid.
+ */
+static UnsignedInt benchmarkRandom(UnsignedInt &seed)
+{
+	seed = seed*1664525 + 1013904223;
+	return seed>>8;
+}
+
+/**
+ * Plain A* from start to goal over the benchmark grid.  Returns the number of cells examined,
+ * and the cost of the path in pathCost (0 if there is none).
+ */
+static Int benchmarkFindPath(PathfindCell *grid, PathfindCell *start, const ICoord2D &startPos, PathfindCell *goal, UnsignedInt *pathCost)
+{
+	static const Int dx[8] = { 1, 0, -1, 0, 1, -1, -1, 1 };
+	static const Int dy[8] = { 0, 1, 0, -1, 1, 1, -1, -1 };
+
+	*pathCost = 0;
+	start->allocateInfo(startPos);
+	start->startPathfind(goal);
+	PathfindCell *openList = start->putOnSortedOpenList(NULL);
+	PathfindCell *closedList = NULL;
+	Int cellCount = 1;
+
+	while (openList) {
+		PathfindCell *cell = openList;
+		openList = cell->removeFromOpenList(openList);
+		closedList = cell->putOnClosedList(closedList);
+		if (cell == goal) {
+			*pathCost = cell->getCostSoFar();
+			break;
+		}
+		for (Int i=0; i<8; i++) {
+			ICoord2D pos;
+			pos.x = cell->getXIndex() + dx[i];
+			pos.y = cell->getYIndex() + dy[i];
+			if (pos.x<0 || pos.y<0 || pos.x>=BENCHMARK_GRID_SIZE || pos.y>=BENCHMARK_GRID_SIZE) {
+				continue;
+			}
+			PathfindCell *newCell = &grid[pos.y*BENCHMARK_GRID_SIZE + pos.x];
+			if (newCell->getType() == PathfindCell::CELL_OBSTACLE) {
+				continue;
+			}
+			if (!newCell->allocateInfo(pos)) {
+				DEBUG_CRASH(("benchmarkPathfinding - ran out of cell infos"));
+				continue;
+			}
+			if (newCell->getClosed()) {
+				continue;
+			}
+			UnsignedInt costSoFar = newCell->costSoFar(cell);
+			if (newCell->getOpen()) {
+				if (costSoFar >= newCell->getCostSoFar()) {
+					continue;
+				}
+				openList = newCell->removeFromOpenList(openList);
+			} else {
+				cellCount++;
+			}
+			newCell->setParentCell(cell);
+			newCell->setCostSoFar(costSoFar);
+			newCell->setTotalCost(costSoFar + newCell->costToGoal(goal));
+			openList = newCell->putOnSortedOpenList(openList);
+		}
+	}
+
+	PathfindCell::releaseOpenList(openList);
+	PathfindCell::releaseClosedList(closedList);
+	return cellCount;
+}
+
+//-----------------------------------------------------------------------------
+void benchmarkPathfinding(Int numPaths)
+{
+	if (TheAI) {
+		DEBUG_CRASH(("benchmarkPathfinding - has to run before the pathfinder is created"));
+		return;
+	}
+	numPaths = max(1, numPaths);
+
+	// Walls with gaps in them, and scattered single obstacles, so searches have to work around things.
+	PathfindCell *grid = MSGNEW("PathfindMapCells") PathfindCell[BENCHMARK_GRID_SIZE*BENCHMARK_GRID_SIZE];
+	UnsignedInt seed = 12345;
+	Int i;
+	for (i=0; i<BENCHMARK_GRID_SIZE*BENCHMARK_GRID_SIZE/8; i++) {
+		grid[benchmarkRandom(seed) % (BENCHMARK_GRID_SIZE*BENCHMARK_GRID_SIZE)].setType(PathfindCell::CELL_OBSTACLE);
+	}
+	for (i=0; i<BENCHMARK_GRID_SIZE/4; i++) {
+		Int x = benchmarkRandom(seed) % BENCHMARK_GRID_SIZE;
+		Int y = benchmarkRandom(seed) % BENCHMARK_GRID_SIZE;
+		Int len = 10 + benchmarkRandom(seed) % (BENCHMARK_GRID_SIZE/2);
+		bool horizontal = (benchmarkRandom(seed) & 1) != 0;
+		for (Int j=0; j<len; j++) {
+			Int cx = horizontal ? x+j : x;
+			Int cy = horizontal ? y : y+j;
+			if (cx<BENCHMARK_GRID_SIZE && cy<BENCHMARK_GRID_SIZE && j%16 != 8) {
+				grid[cy*BENCHMARK_GRID_SIZE + cx].setType(PathfindCell::CELL_OBSTACLE);
+			}
+		}
+	}
+
+	PathfindCellInfo::allocateCellInfos();
+
+	Int64 freq, start, end;
+	QueryPerformanceFrequency((LARGE_INTEGER *)&freq);
+	QueryPerformanceCounter((LARGE_INTEGER *)&start);
+
+	Int totalCells = 0;
+	Int numFound = 0;
+	UnsignedInt costChecksum = 0;
+	seed = 54321;
+	for (i=0; i<numPaths; i++) {
+		ICoord2D from, to;
+		do {
+			from.x = benchmarkRandom(seed) % BENCHMARK_GRID_SIZE;
+			from.y = benchmarkRandom(seed) % BENCHMARK_GRID_SIZE;
+		} while (grid[from.y*BENCHMARK_GRID_SIZE + from.x].getType() == PathfindCell::CELL_OBSTACLE);
+		do {
+			to.x = benchmarkRandom(seed) % BENCHMARK_GRID_SIZE;
+			to.y = benchmarkRandom(seed) % BENCHMARK_GRID_SIZE;
+		} while (grid[to.y*BENCHMARK_GRID_SIZE + to.x].getType() == PathfindCell::CELL_OBSTACLE);
+
+		UnsignedInt pathCost;
+		totalCells += benchmarkFindPath(grid, &grid[from.y*BENCHMARK_GRID_SIZE + from.x], from, 
+			&grid[to.y*BENCHMARK_GRID_SIZE + to.x], &pathCost);
+		if (pathCost) {
+			numFound++;
+		}
+		costChecksum = costChecksum*31 + pathCost;
+	}
+
+	QueryPerformanceCounter((LARGE_INTEGER *)&end);
+	double seconds = (double)(end - start) / (double)freq;
+
+	PathfindCellInfo::releaseCellInfos();
+	delete [] grid;
+
+	// The checksum of the path costs has to stay the same from build to build, or the search order changed.
+	DEBUG_LOG(("benchmarkPathfinding - %d paths (%d found) on a %dx%d grid, %d cells in %f sec, %.0f cells/sec, cost checksum %8.8X\n",
+		numPaths, numFound, BENCHMARK_GRID_SIZE, BENCHMARK_GRID_SIZE, totalCells, seconds,
+		seconds > 0.0 ? totalCells/seconds : 0.0, costChecksum));
+}
+
+#endif // RTS_DEBUG || RTS_INTERNAL
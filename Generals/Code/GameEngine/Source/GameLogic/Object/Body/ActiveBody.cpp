@@ -980,6 +980,7 @@ void ActiveBody::internalChangeHealth( Real delta )
 	const Real lowEndCap = 0.0f;  // low end cap for health, don't go below this
 	if( m_currentHealth < lowEndCap )
 		m_currentHealth = lowEndCap;
+	getObject()->invalidateCRC();
 
 	// recalc the damage state
 	BodyDamageType oldState = m_curDamageState;
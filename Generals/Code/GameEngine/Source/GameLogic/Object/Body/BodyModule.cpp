@@ -31,6 +31,20 @@
 #include "PreRTS.h"
 #include "Common/Xfer.h"
 #include "GameLogic/Module/BodyModule.h"
+#include "GameLogic/Object.h"
+
+//-------------------------------------------------------------------------------------------------
+/** Allows outside systems to apply defensive bonuses or penalties (they all stack as a multiplier!) */
+//-------------------------------------------------------------------------------------------------
+void BodyModule::applyDamageScalar( Real scalar )
+{
+
+	m_damageScalar *= scalar;
+
+	// Object::crc has our damage scalar
+	getObject()->invalidateCRC();
+
+}  // end applyDamageScalar
 
 // ------------------------------------------------------------------------------------------------
 /** CRC */
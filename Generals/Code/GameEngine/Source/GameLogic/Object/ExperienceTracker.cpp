@@ -97,6 +97,7 @@ void ExperienceTracker::setMinVeterancyLevel( VeterancyLevel newLevel )
 		VeterancyLevel oldLevel = m_currentLevel;
 		m_currentLevel = newLevel;
 		m_currentExperience = m_parent->getTemplate()->getExperienceRequired(m_currentLevel); //Minimum for this level
+		m_parent->invalidateCRC();
 		if (m_parent)
 			m_parent->onVeterancyLevelChanged( oldLevel, newLevel );
 	}
@@ -113,6 +114,7 @@ void ExperienceTracker::setVeterancyLevel( VeterancyLevel newLevel )
 		VeterancyLevel oldLevel = m_currentLevel;
 		m_currentLevel = newLevel;
 		m_currentExperience = m_parent->getTemplate()->getExperienceRequired(m_currentLevel); //Minimum for this level
+		m_parent->invalidateCRC();
 		if (m_parent)
 			m_parent->onVeterancyLevelChanged( oldLevel, newLevel );
 	}
@@ -181,6 +183,7 @@ void ExperienceTracker::addExperiencePoints( Int experienceGain, bool canScaleFo
 	}
 
 	m_currentLevel = (VeterancyLevel)levelIndex;
+	m_parent->invalidateCRC();
 
 	if( oldLevel != m_currentLevel )
 	{
@@ -221,6 +224,7 @@ void ExperienceTracker::setExperienceAndLevel( Int experienceIn )
 	}
 
 	m_currentLevel = (VeterancyLevel)levelIndex;
+	m_parent->invalidateCRC();
 
 	if( oldLevel != m_currentLevel )
 	{
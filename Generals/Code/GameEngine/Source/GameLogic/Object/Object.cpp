@@ -404,6 +404,9 @@ Object::Object( const ThingTemplate *tt, const ObjectStatusMaskType &objectStatu
 	// allocate experience tracker
 	m_experienceTracker = newInstance(ExperienceTracker)(this);
 
+	// our weapons are part of our CRC
+	m_weaponSet.friend_setOwnerCRC( &m_cachedCRC );
+
 	// If a valid team has been assigned me, then I have a Player I can ask about my starting level
 	const Player* controller = getControllingPlayer();
 	m_experienceTracker->setVeterancyLevel( controller->getProductionVeterancyLevel( getTemplate()->getName() ) );
@@ -735,6 +738,7 @@ void Object::friend_setUndetectedDefector( bool status )
 		m_privateStatus |= UNDETECTED_DEFECTOR;
 	else
 		m_privateStatus &= ~UNDETECTED_DEFECTOR;
+	invalidateCRC();
 }
 
 //=============================================================================
@@ -1607,6 +1611,8 @@ void Object::reactToTurretChange( WhichTurretType turret, Real oldRotation, Real
 void Object::reactToTransformChange(const Matrix3D* oldMtx, const Coord3D* oldPos, Real oldAngle)
 {
 	//USE_PERF_TIMER(Object_reactToTransformChange)
+	invalidateCRC();
+
 	if(_isnan(getPosition()->x) || _isnan(getPosition()->y) || _isnan(getPosition()->z)) {
 		DEBUG_CRASH(("Object pos is nan."));
 		TheGameLogic->destroyObject(this);
@@ -1785,6 +1791,7 @@ void Object::setEffectivelyDead(bool dead)
 		BitSet(m_privateStatus, EFFECTIVELY_DEAD);
 	else
 		BitClear(m_privateStatus, EFFECTIVELY_DEAD);
+	invalidateCRC();
 
 	if (dead)
 	{
@@ -1803,6 +1810,7 @@ void Object::setCaptured(bool isCaptured)
 		DEBUG_LOG(("Clearing Captured Status. This should never happen. jkmcd"));
 		BitClear(m_privateStatus, CAPTURED);
 	}
+	invalidateCRC();
 
 	// No need to see if we should skip updates, this flag has no effect on skipping updates.
 }
@@ -2470,6 +2478,7 @@ void Object::setID( ObjectID id )
 
 	// assign new id
 	m_id = id;
+	invalidateCRC();
 
 	// add new id to lookup table
 	TheGameLogic->addObjectToLookupTable( this );
@@ -2539,6 +2548,7 @@ void Object::friend_notifyOfNewMapBoundary(void)
 		m_privateStatus &= ~OFF_MAP;
 	else
 		m_privateStatus |= OFF_MAP;
+	invalidateCRC();
 }
 
 
@@ -3948,6 +3958,7 @@ void Object::giveUpgrade( const UpgradeTemplate *upgradeT )
 	if (upgradeT)
 	{
 		m_objectUpgradesCompleted.set( upgradeT->getUpgradeMask() );
+		invalidateCRC();
 
 		//
 		// iterate through all the upgrade modules of this object and call the method to
@@ -3963,6 +3974,7 @@ void Object::giveUpgrade( const UpgradeTemplate *upgradeT )
 void Object::removeUpgrade( const UpgradeTemplate *upgradeT )
 {
 	m_objectUpgradesCompleted.clear( upgradeT->getUpgradeMask() );
+	invalidateCRC();
 	for (BehaviorModule** module = m_behaviors; *module; ++module)
 	{
 		UpgradeModuleInterface* upgrade = (*module)->getUpgrade();
@@ -62,6 +62,7 @@
 #include "Common/ThingFactory.h"	// for bullet type hack
 #include "Common/ThingTemplate.h"
 #include "Common/Xfer.h"
+#include "Common/XferCRC.h"
 
 #include "GameLogic/AIPathfind.h"
 #include "GameLogic/GameLogic.h"
@@ -186,6 +187,9 @@ typedef bool (*DistCalcProc)
 bool DoFilterProfiling = false;
 #endif
 
+// bumped whenever any cell's range index changes; each cell remembers the value it last changed at.
+static UnsignedInt theRangeIndexClock = 0;
+
 //DECLARE_PERF_TIMER(filtersAllow)
 inline bool filtersAllow(PartitionFilter **filters, Object *objOther)
 {
@@ -1198,11 +1202,13 @@ void CellAndObjectIntersection::addCoverage(PartitionCell *cell, PartitionData *
 		return;
 	}
 
-	if (m_cell == NULL)
-		cell->friend_addToCellList(this);
-
+	bool isNew = (m_cell == NULL);
 	m_cell = cell;
 	m_module = module;
+
+	// note that the cell reads our module for its range index, so this must come after.
+	if (isNew)
+		cell->friend_addToCellList(this);
 }
 
 //-----------------------------------------------------------------------------
@@ -1232,6 +1238,12 @@ PartitionCell::PartitionCell()
 	//
 	m_firstCoiInCell = NULL;
 	m_coiCount = 0;
+	m_rangeIndexSize = 0;
+	m_rangeModule = NULL;
+	m_rangeX = NULL;
+	m_rangeY = NULL;
+	m_rangeRadius = NULL;
+	m_rangeIndexStamp = 0;
 #ifdef PM_CACHE_TERRAIN_HEIGHT
 	m_loTerrainZ = HUGE_DIST;		// huge positive
 	m_hiTerrainZ = -HUGE_DIST;	// huge negative
@@ -1261,6 +1273,14 @@ PartitionCell::~PartitionCell()
 {
 	DEBUG_ASSERTCRASH(m_firstCoiInCell == NULL && m_coiCount == 0, ("destroying a nonempty PartitionCell"));
 	// but don't destroy the Cois; they don't belong to us
+	delete [] m_rangeModule;
+	delete [] m_rangeX;	// x, y & radius share one allocation.
+}
+
+//-----------------------------------------------------------------------------
+inline void PartitionCell::invalidateCRC()
+{
+	ThePartitionManager->friend_invalidateRowCRC(m_cellY);
 }
 
 //-----------------------------------------------------------------------------
@@ -1278,6 +1298,7 @@ void PartitionCell::addLooker(Int playerIndex)
 	CellShroudStatus oldShroud = getShroudStatusForPlayer( playerIndex );
 	// The decreasing Algorithm: A 1 will go straight to -1, otherwise it just gets decremented
 	m_shroudLevel[playerIndex].m_currentShroud = min( m_shroudLevel[playerIndex].m_currentShroud - 1, -1 );
+	invalidateCRC();
 
 	CellShroudStatus newShroud = getShroudStatusForPlayer( playerIndex );
 
@@ -1315,6 +1336,7 @@ void PartitionCell::removeLooker(Int playerIndex)
 		DEBUG_ASSERTCRASH( m_shroudLevel[playerIndex].m_currentShroud < 0, ("Someone is RemoveLooker-ing on a cell that is not looked at.  This will make a permanent shroud blob.") );
 		m_shroudLevel[playerIndex].m_currentShroud++;
 	}
+	invalidateCRC();
 	CellShroudStatus newShroud = getShroudStatusForPlayer( playerIndex );
 
 //	DEBUG_LOG(( "REMOVE %d, %d.  CS = %d, AS = %d for player %d.\n", 
@@ -1350,6 +1372,7 @@ void PartitionCell::addShrouder( Int playerIndex )
 	{
 		m_shroudLevel[playerIndex].m_currentShroud = 1;
 	}
+	invalidateCRC();
 	CellShroudStatus newShroud = getShroudStatusForPlayer( playerIndex );
 
 	if( oldShroud != newShroud )
@@ -1373,6 +1396,7 @@ void PartitionCell::removeShrouder( Int playerIndex )
 	// Either it was passive shroud and is now active, or it was being looked at and still is.
 	m_shroudLevel[playerIndex].m_activeShroudLevel--;
 	DEBUG_ASSERTCRASH( m_shroudLevel[playerIndex].m_activeShroudLevel >= 0, ("Shroud generation has gone negative.  This can't happen.") );
+	invalidateCRC();
 }
 
 //-----------------------------------------------------------------------------
@@ -1467,6 +1491,7 @@ void PartitionCell::friend_addToCellList(CellAndObjectIntersection *coi)
 	if (coi)
 	{
 		coi->friend_addToCellList(&m_firstCoiInCell);
+		addToRangeIndex(coi->getModule());
 		++m_coiCount;
 	}
 }
@@ -1477,10 +1502,101 @@ void PartitionCell::friend_removeFromCellList(CellAndObjectIntersection *coi)
 	if (coi)
 	{
 		coi->friend_removeFromCellList(&m_firstCoiInCell);
+		removeFromRangeIndex(coi->getModule());
 		--m_coiCount;
 	}
 }
 
+//-----------------------------------------------------------------------------
+void PartitionCell::addToRangeIndex(PartitionData *module)
+{
+	if (m_coiCount >= m_rangeIndexSize)
+	{
+		Int newSize = m_rangeIndexSize ? m_rangeIndexSize * 2 : 8;
+		PartitionData **newModule = MSGNEW("PartitionCell_RangeIndex") PartitionData*[newSize];
+		Real *newReals = MSGNEW("PartitionCell_RangeIndex") Real[newSize * 3];
+		if (m_coiCount > 0)
+		{
+			memcpy(newModule, m_rangeModule, m_coiCount * sizeof(PartitionData*));
+			memcpy(newReals, m_rangeX, m_coiCount * sizeof(Real));
+			memcpy(newReals + newSize, m_rangeY, m_coiCount * sizeof(Real));
+			memcpy(newReals + newSize * 2, m_rangeRadius, m_coiCount * sizeof(Real));
+		}
+		delete [] m_rangeModule;
+		delete [] m_rangeX;
+		m_rangeModule = newModule;
+		m_rangeX = newReals;
+		m_rangeY = newReals + newSize;
+		m_rangeRadius = newReals + newSize * 2;
+		m_rangeIndexSize = newSize;
+	}
+	m_rangeModule[m_coiCount] = module;
+	m_rangeX[m_coiCount] = module->friend_getRangePos()->x;
+	m_rangeY[m_coiCount] = module->friend_getRangePos()->y;
+	m_rangeRadius[m_coiCount] = module->friend_getRangeRadius();
+	m_rangeIndexStamp = ++theRangeIndexClock;
+}
+
+//-----------------------------------------------------------------------------
+void PartitionCell::removeFromRangeIndex(PartitionData *module)
+{
+	// keep the rest in order, so queries still see the COIs in list order.
+	for (Int i = m_coiCount - 1; i >= 0; --i)
+	{
+		if (m_rangeModule[i] != module)
+			continue;
+		Int numAfter = m_coiCount - 1 - i;
+		if (numAfter > 0)
+		{
+			memmove(&m_rangeModule[i], &m_rangeModule[i + 1], numAfter * sizeof(PartitionData*));
+			memmove(&m_rangeX[i], &m_rangeX[i + 1], numAfter * sizeof(Real));
+			memmove(&m_rangeY[i], &m_rangeY[i + 1], numAfter * sizeof(Real));
+			memmove(&m_rangeRadius[i], &m_rangeRadius[i + 1], numAfter * sizeof(Real));
+		}
+		m_rangeIndexStamp = ++theRangeIndexClock;
+		return;
+	}
+	DEBUG_CRASH(("module not in range index"));
+}
+
+//-----------------------------------------------------------------------------
+/* The module has moved, but its cells won't be updated until the next partition update, so
+	it has to pass every range check until then. */
+void PartitionCell::friend_invalidateRangeIndex(PartitionData *module)
+{
+	for (Int i = m_coiCount - 1; i >= 0; --i)
+	{
+		if (m_rangeModule[i] == module)
+		{
+			if (m_rangeRadius[i] != HUGE_DIST)
+			{
+				m_rangeRadius[i] = HUGE_DIST;
+				m_rangeIndexStamp = ++theRangeIndexClock;
+			}
+			return;
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+UnsignedInt PartitionCell::getRangeIndexMask(Int first, Real x, Real y, Real dist) const
+{
+	Int last = first + 32;
+	if (last > m_coiCount)
+		last = m_coiCount;
+
+	// no early outs, so this is a simple loop over the arrays.
+	UnsignedInt mask = 0;
+	for (Int i = first; i < last; ++i)
+	{
+		Real dx = m_rangeX[i] - x;
+		Real dy = m_rangeY[i] - y;
+		Real reach = dist + m_rangeRadius[i];
+		mask |= (UnsignedInt)(dx*dx + dy*dy <= reach*reach) << (i - first);
+	}
+	return mask;
+}
+
 //-----------------------------------------------------------------------------
 void PartitionCell::getCellCenterPos(Real& x, Real& y)
 {
@@ -1559,6 +1675,9 @@ PartitionData::PartitionData()
 	m_doneFlag = 0;
 	m_dirtyStatus = NOT_DIRTY;
 	m_lastCell = NULL;
+	m_rangePos.x = 0.0f;
+	m_rangePos.y = 0.0f;
+	m_rangeRadius = HUGE_DIST;
 	for (int i = 0; i < MAX_PLAYER_COUNT; ++i)
 	{
 		m_everSeenByPlayer[i] = false;
@@ -2062,6 +2181,17 @@ void PartitionData::updateCellsTouched()
 	}
 
 	removeAllTouchedCells();
+
+	// record where we are for the cells' range index. the range queries measure from
+	// the bounding circle (2d) or sphere (3d), so use the larger. ghosts always pass.
+	m_rangePos.x = pos.x;
+	m_rangePos.y = pos.y;
+	m_rangeRadius = HUGE_DIST;
+	if (obj)
+	{
+		const GeometryInfo& geomInfo = obj->getGeometryInfo();
+		m_rangeRadius = max(geomInfo.getBoundingCircleRadius(), geomInfo.getBoundingSphereRadius());
+	}
 	if (isSmall)
 	{
 		doSmallFill(pos.x, pos.y, majorRadius);
@@ -2196,6 +2326,16 @@ theObjName = obj->getTemplate()->getName();
 void PartitionData::makeDirty(bool needToUpdateCells)
 {
 	//DEBUG_LOG(("makeDirty for pd %08lx obj %08lx\n",this,m_object));
+	if (needToUpdateCells && m_dirtyStatus != NEED_CELL_UPDATE_AND_COLLISION_CHECK)
+	{
+		// our cells still have our old position, so make sure range queries don't skip us.
+		CellAndObjectIntersection *coi = m_coiArray;
+		for (Int i = m_coiArrayCount; i > 0; --i, ++coi)
+		{
+			if (coi->getModule())
+				coi->getCell()->friend_invalidateRangeIndex(this);
+		}
+	}
 	if (!ThePartitionManager->isInListDirtyModules(this))
 	{
 		if (needToUpdateCells)
@@ -2633,6 +2773,8 @@ void PartitionManager::init()
 #endif
 			}
 		}
+		m_rowCRC.assign(m_cellCountY, 0);
+		m_rowCRCDirty.assign(m_cellCountY, TRUE);
 
 #ifdef FASTER_GCO
 		calcRadiusVec();
@@ -2677,6 +2819,9 @@ void PartitionManager::reset()
 #endif
 
 	resetPendingUndoShroudRevealQueue();
+	m_rangeScans.clear();
+	m_dueRangeScans.clear();
+	m_rangeScanCandidates.clear();
 
 	shutdown();
 	//init();
@@ -2708,6 +2853,8 @@ void PartitionManager::shutdown()
 	
 	delete [] m_cells;
 	m_cells = NULL;
+	m_rowCRC.clear();
+	m_rowCRCDirty.clear();
 
 	m_cellSize = m_cellSizeInv = 0.0f;
 	m_cellCountX = 0;
@@ -3174,6 +3321,107 @@ void PartitionManager::calcRadiusVec()
 }
 #endif
 
+#ifdef FASTER_GCO
+//-----------------------------------------------------------------------------
+/// the last cell radius getClosestObjects needs to look at for maxDist.
+Int PartitionManager::getGcoRadiusLimit(Real maxDist)
+{
+	Int maxRadius = m_maxGcoRadius;
+	if (maxDist < HUGE_DIST)
+	{
+		// don't go outwards any farther than necessary.
+		maxRadius = minInt(m_maxGcoRadius, worldToCellDist(maxDist));
+	}
+#if defined(INTENSE_DEBUG)
+	/*
+		Note, if you ever enable this code, be forewarned that it can give
+		you "false positives" for objects that are located just off the map... (srj)
+	*/
+	Int maxRadiusLimit = maxRadius + 3;
+	if (maxRadiusLimit > m_maxGcoRadius) maxRadiusLimit = m_maxGcoRadius;
+#else
+	Int maxRadiusLimit = maxRadius;
+#endif
+	return maxRadiusLimit;
+}
+
+//-----------------------------------------------------------------------------
+/// how much farther than maxDist the range index has to look for objToUse (which may be null).
+static Real getRangeQueryRadius(const Object *objToUse, DistanceCalculationType dc)
+{
+	Real queryRadius = 1.0f;
+	if (objToUse && (dc == FROM_BOUNDINGSPHERE_2D || dc == FROM_BOUNDINGSPHERE_3D))
+	{
+		const GeometryInfo& geomInfo = objToUse->getGeometryInfo();
+		queryRadius += max(geomInfo.getBoundingCircleRadius(), geomInfo.getBoundingSphereRadius());
+	}
+	return queryRadius;
+}
+#endif
+
+#ifdef FASTER_GCO
+//-----------------------------------------------------------------------------
+/**
+	what getClosestObjects does with each module the range index lets through, whether it
+	came from walking the cells or from a range scan sweep.
+*/
+struct ClosestObjectsSearch
+{
+	const Object*						m_obj;
+	const Coord3D*					m_objPos;
+	const Object*						m_objToUse;
+	DistCalcProc						m_distProc;
+	PartitionFilter**				m_filters;
+	SimpleObjectIterator*		m_iter;						///< if nonnull, append ALL satisfactory objects
+	Int											m_iterFlag;
+	Object*									m_closestObj;
+	Real										m_closestDistSqr;
+	Coord3D									m_closestVec;
+	bool										m_foundAny;
+
+	/// returns true if this is the first object found when looking for the closest one.
+	inline bool consider(PartitionData *thisMod)
+	{
+		Object *thisObj = thisMod->getObject();
+
+		// never compare against ourself.
+		if (thisObj == m_obj || thisObj == NULL)
+			return false;
+
+		// since an object can exist in multiple COIs, we use this to avoid processing
+		// the same one more than once.
+		if (thisMod->friend_getDoneFlag() == m_iterFlag)
+			return false;
+		thisMod->friend_setDoneFlag(m_iterFlag);
+
+		Real thisDistSqr;
+		Coord3D distVec;
+		if (!(*m_distProc)(m_objPos, m_objToUse, thisObj->getPosition(), thisObj, thisDistSqr, distVec, m_closestDistSqr))
+			return false;
+
+		if (!filtersAllow(m_filters, thisObj))
+			return false;
+
+		// ok, this is within the range, and the filters allow it.
+		// add it to the iter, if we have one....
+		if (m_iter)
+		{
+			m_iter->insert(thisObj, thisDistSqr);
+			return false;
+		}
+
+		// hey, this is the new closest object! cool.
+		m_closestObj = thisObj;
+		m_closestDistSqr = thisDistSqr;
+		m_closestVec = distVec;
+
+		bool first = !m_foundAny;
+		m_foundAny = true;
+		return first;
+	}
+};
+#endif
+
 //-----------------------------------------------------------------------------
 //DECLARE_PERF_TIMER(getClosestObjects)
 Object *PartitionManager::getClosestObjects(
@@ -3234,92 +3482,102 @@ Object *PartitionManager::getClosestObjects(
 
 #ifdef FASTER_GCO
 
-	Int maxRadius = m_maxGcoRadius;
-	if (maxDist < HUGE_DIST)
-	{
-		// don't go outwards any farther than necessary.
-		maxRadius = minInt(m_maxGcoRadius, worldToCellDist(maxDist));
-	}
-#if defined(INTENSE_DEBUG)
-	/*
-		Note, if you ever enable this code, be forewarned that it can give
-		you "false positives" for objects that are located just off the map... (srj)
-	*/
-	Int maxRadiusLimit = maxRadius + 3;
-	if (maxRadiusLimit > m_maxGcoRadius) maxRadiusLimit = m_maxGcoRadius;
-#else
-	Int maxRadiusLimit = maxRadius;
-#endif
-
-	bool foundAny = false;
+	Int maxRadiusLimit = getGcoRadiusLimit(maxDist);
 
 	static Int theIterFlag = 1;	// nonzero, thanks
 	++theIterFlag;
 
-	/*
-		m_radiusVec[curRadius] contains a list of the cells (foo) that could
-		contain objects that are <= (curRadius * cellSize) distance away from cell (0,0).
-	*/
-  for (Int curRadius = 0; curRadius <= maxRadiusLimit; ++curRadius)
-  {
-    const OffsetVec& offsets = m_radiusVec[curRadius];
-		if (offsets.empty())
-			continue;
-    for (OffsetVec::const_iterator it = offsets.begin(); it != offsets.end(); ++it)
+	ClosestObjectsSearch search;
+	search.m_obj = obj;
+	search.m_objPos = objPos;
+	search.m_objToUse = objToUse;
+	search.m_distProc = distProc;
+	search.m_filters = filters;
+	search.m_iter = iterArg;
+	search.m_iterFlag = theIterFlag;
+	search.m_closestObj = NULL;
+	search.m_closestDistSqr = closestDistSqr;
+	search.m_foundAny = false;
+
+	// the range index only knows 2d positions and bounding radii, so it is checked against
+	// the most generous distance any of the dist calc procs could measure, plus a little slop.
+	Real queryRadius = getRangeQueryRadius(objToUse, dc);
+
+	// if this scan was queued and nothing it looks at has changed since the sweep, the sweep
+	// already found its candidates, in the order the cells would give them.
+	const RangeScan *scan = NULL;
+	if (objToUse && !m_dueRangeScans.empty())
+	{
+		RangeScan *dueScan = findDueRangeScan(objToUse, maxDist, dc);
+		if (dueScan && !dueScan->m_swept)
+			sweepRangeScans(dueScan->m_phase);
+		if (dueScan && isRangeScanCurrent(dueScan, objToUse, cellCenterX, cellCenterY, queryRadius))
+			scan = dueScan;
+	}
+
+	if (scan)
+	{
+		for (Int i = 0; i < scan->m_numCandidates; ++i)
 		{
-			PartitionCell* thisCell = getCellAt(cellCenterX + it->x, cellCenterY + it->y);
-			if (thisCell == NULL)
-				continue;
+			const RangeScanCandidate& cand = m_rangeScanCandidates[scan->m_firstCandidate + i];
+			if (cand.m_radius > maxRadiusLimit)
+				break;
 
-			for (CellAndObjectIntersection *thisCoi = thisCell->getFirstCoiInCell(); thisCoi; thisCoi = thisCoi->getNextCoi())
+			if (search.consider(cand.m_module))
 			{
-				PartitionData *thisMod = thisCoi->getModule();
-				Object *thisObj = thisMod->getObject();
-
-				// never compare against ourself.
-				if (thisObj == obj || thisObj == NULL) 
-					continue;
-
-				// since an object can exist in multiple COIs, we use this to avoid processing
-				// the same one more than once.
-				if (thisMod->friend_getDoneFlag() == theIterFlag)
-					continue;
-				thisMod->friend_setDoneFlag(theIterFlag);
-			
-				Real thisDistSqr;
-				Coord3D distVec;
-				if (!(*distProc)(objPos, objToUse, thisObj->getPosition(), thisObj, thisDistSqr, distVec, closestDistSqr))
+				// if not adding to iterArg, we want to stop once we have the closest object.
+				maxRadiusLimit = cand.m_radius;
+			}
+		}
+	}
+	else
+	{
+		/*
+			m_radiusVec[curRadius] contains a list of the cells (foo) that could
+			contain objects that are <= (curRadius * cellSize) distance away from cell (0,0).
+		*/
+		for (Int curRadius = 0; curRadius <= maxRadiusLimit; ++curRadius)
+		{
+			const OffsetVec& offsets = m_radiusVec[curRadius];
+			if (offsets.empty())
+				continue;
+			for (OffsetVec::const_iterator it = offsets.begin(); it != offsets.end(); ++it)
+			{
+				PartitionCell* thisCell = getCellAt(cellCenterX + it->x, cellCenterY + it->y);
+				if (thisCell == NULL)
 					continue;
 
-				if (!filtersAllow(filters, thisObj))
+				Int coiCount = thisCell->getCoiCount();
+				if (coiCount == 0)
 					continue;
 
-				// ok, this is within the range, and the filters allow it.
-				// add it to the iter, if we have one....
-				if (iterArg)
+				// walk the range index backwards, so we see the COIs in the same order as the cell's list.
+				Real reach = sqrtf(search.m_closestDistSqr) + queryRadius;
+				for (Int first = (coiCount - 1) & ~31; first >= 0; first -= 32)
 				{
-					iterArg->insert(thisObj, thisDistSqr);
-				}
-				else
-				{
-					// hey, this is the new closest object! cool.
-					// (note that we can't break out now 'cuz we have to finish examining the
-					// rest of curRadius)
-					closestObj = thisObj;
-					closestDistSqr = thisDistSqr;
-					closestVec = distVec;
-
-					if (!foundAny)
+					UnsignedInt nearMask = thisCell->getRangeIndexMask(first, objPos->x, objPos->y, reach);
+					for (Int bit = 31; nearMask != 0; --bit)
 					{
-						// if not adding to iterArg, we want to stop once we have the closest object. 
-						maxRadiusLimit = curRadius;
-					}
-					foundAny = true;
-				}
-
-			} // next coi
-		}	// next cell in this radius
-  } // next radius
+						if ((nearMask & (1U << bit)) == 0)
+							continue;
+						nearMask &= ~(1U << bit);
+
+						if (search.consider(thisCell->getRangeIndexModule(first + bit)))
+						{
+							// if not adding to iterArg, we want to stop once we have the closest object. 
+							// (note that we can't break out now 'cuz we have to finish examining the
+							// rest of curRadius)
+							maxRadiusLimit = curRadius;
+						}
+					} // next coi
+				} // next block of the range index
+			}	// next cell in this radius
+		} // next radius
+	}
+
+	closestObj = search.m_closestObj;
+	closestDistSqr = search.m_closestDistSqr;
+	closestVec = search.m_closestVec;
 
 #else // not FASTER_GCO
 
@@ -3608,6 +3866,424 @@ SimpleObjectIterator *PartitionManager::iterateObjectsInRange(
 	return iter;
 }
 
+//-----------------------------------------------------------------------------
+void PartitionManager::queueRangeScan(const Object *obj, Real maxDist, DistanceCalculationType dc, UnsignedInt frame, Int phase)
+{
+	DEBUG_ASSERTCRASH(obj, ("range scans need an object"));
+	RangeScan scan;
+	scan.m_clientID = obj->getID();
+	scan.m_maxDist = maxDist;
+	scan.m_dc = dc;
+	scan.m_frame = frame;
+	scan.m_phase = phase;
+	scan.m_swept = FALSE;
+	scan.m_valid = FALSE;
+	scan.m_pos.zero();
+	scan.m_queryRadius = 0.0f;
+	scan.m_sweptClock = 0;
+	scan.m_firstCandidate = 0;
+	scan.m_numCandidates = 0;
+	m_rangeScans.push_back(scan);
+}
+
+//-----------------------------------------------------------------------------
+void PartitionManager::prepareRangeScans()
+{
+	UnsignedInt now = TheGameLogic->getFrame();
+
+	m_dueRangeScans.clear();
+	m_rangeScanCandidates.clear();
+
+	// nothing is swept now, so this is the time to wrap the clock.
+	if (theRangeIndexClock > 0x7fffffff)
+	{
+		for (Int i = 0; i < m_totalCellCount; ++i)
+			m_cells[i].friend_clearRangeIndexStamp();
+		theRangeIndexClock = 0;
+	}
+
+	if (m_rangeScans.empty())
+		return;
+
+	// scans for past frames were never asked for, so just drop them.
+	RangeScanVec::iterator keep = m_rangeScans.begin();
+	for (RangeScanVec::iterator it = m_rangeScans.begin(); it != m_rangeScans.end(); ++it)
+	{
+		if (it->m_frame > now)
+			*keep++ = *it;
+		else if (it->m_frame == now)
+			m_dueRangeScans.push_back(*it);
+	}
+	m_rangeScans.erase(keep, m_rangeScans.end());
+
+	std::sort(m_dueRangeScans.begin(), m_dueRangeScans.end(), rangeScanKeyLess);
+	RangeScanVec::iterator last = m_dueRangeScans.begin();
+	for (RangeScanVec::iterator it = m_dueRangeScans.begin(); it != m_dueRangeScans.end(); ++it)
+	{
+		if (it == m_dueRangeScans.begin() || rangeScanKeyLess(*(last - 1), *it))
+			*last++ = *it;
+	}
+	m_dueRangeScans.erase(last, m_dueRangeScans.end());
+}
+
+//-----------------------------------------------------------------------------
+bool PartitionManager::rangeScanKeyLess(const RangeScan& a, const RangeScan& b)
+{
+	if (a.m_clientID != b.m_clientID)
+		return a.m_clientID < b.m_clientID;
+	if (a.m_maxDist != b.m_maxDist)
+		return a.m_maxDist < b.m_maxDist;
+	return a.m_dc < b.m_dc;
+}
+
+//-----------------------------------------------------------------------------
+bool PartitionManager::rangeScanVisitLess(const RangeScanVisit& a, const RangeScanVisit& b)
+{
+	if (a.m_cellIndex != b.m_cellIndex)
+		return a.m_cellIndex < b.m_cellIndex;
+	if (a.m_scan != b.m_scan)
+		return a.m_scan < b.m_scan;
+	return a.m_order < b.m_order;
+}
+
+//-----------------------------------------------------------------------------
+bool PartitionManager::rangeScanHitLess(const RangeScanHit& a, const RangeScanHit& b)
+{
+	if (a.m_scan != b.m_scan)
+		return a.m_scan < b.m_scan;
+	return a.m_order < b.m_order;
+}
+
+#ifdef FASTER_GCO
+//-----------------------------------------------------------------------------
+PartitionManager::RangeScan *PartitionManager::findDueRangeScan(const Object *obj, Real maxDist, DistanceCalculationType dc)
+{
+	RangeScan key;
+	key.m_clientID = obj->getID();
+	key.m_maxDist = maxDist;
+	key.m_dc = dc;
+
+	RangeScanVec::iterator it = std::lower_bound(m_dueRangeScans.begin(), m_dueRangeScans.end(), key, rangeScanKeyLess);
+	if (it == m_dueRangeScans.end() || rangeScanKeyLess(key, *it))
+		return NULL;
+	return &(*it);
+}
+
+//-----------------------------------------------------------------------------
+/*
+	Find the candidates of every due scan in this phase that isn't swept yet: the modules the
+	range index would let through for each cell getClosestObjects would walk, in the order it
+	would walk them. The cells are visited in memory order rather than scan by scan, so each
+	cell's range index is read once for all the scans that cover it.
+*/
+void PartitionManager::sweepRangeScans(Int phase)
+{
+	m_rangeScanVisits.clear();
+	m_rangeScanHits.clear();
+
+	for (Int s = 0; s < (Int)m_dueRangeScans.size(); ++s)
+	{
+		RangeScan& scan = m_dueRangeScans[s];
+		if (scan.m_swept || scan.m_phase != phase)
+			continue;
+		scan.m_swept = TRUE;
+
+		const Object *obj = TheGameLogic->findObjectByID(scan.m_clientID);
+		if (obj == NULL)
+			continue;
+
+		scan.m_valid = TRUE;
+		scan.m_pos = *obj->getPosition();
+		scan.m_queryRadius = getRangeQueryRadius(obj, scan.m_dc);
+		scan.m_sweptClock = theRangeIndexClock;
+		scan.m_firstCandidate = 0;
+		scan.m_numCandidates = 0;
+
+		Int cellCenterX, cellCenterY;
+		worldToCell(scan.m_pos.x, scan.m_pos.y, &cellCenterX, &cellCenterY);
+
+		RangeScanVisit visit;
+		visit.m_scan = s;
+		visit.m_order = 0;
+		Int maxRadiusLimit = getGcoRadiusLimit(scan.m_maxDist);
+		for (Int curRadius = 0; curRadius <= maxRadiusLimit; ++curRadius)
+		{
+			const OffsetVec& offsets = m_radiusVec[curRadius];
+			for (OffsetVec::const_iterator it = offsets.begin(); it != offsets.end(); ++it)
+			{
+				const PartitionCell* cell = getCellAt(cellCenterX + it->x, cellCenterY + it->y);
+				if (cell == NULL || cell->getCoiCount() == 0)
+					continue;
+
+				visit.m_cellIndex = cell - m_cells;
+				visit.m_radius = curRadius;
+				m_rangeScanVisits.push_back(visit);
+				++visit.m_order;
+			}
+		}
+	}
+
+	std::sort(m_rangeScanVisits.begin(), m_rangeScanVisits.end(), rangeScanVisitLess);
+
+	for (RangeScanVisitVec::const_iterator vit = m_rangeScanVisits.begin(); vit != m_rangeScanVisits.end(); ++vit)
+	{
+		const PartitionCell* cell = &m_cells[vit->m_cellIndex];
+		const RangeScan& scan = m_dueRangeScans[vit->m_scan];
+
+		// the same reach getClosestObjects starts out with. (looking for the closest object only
+		// ever narrows it, and anything the wider reach lets through fails the dist calc anyway.)
+		Real reach = sqrtf(scan.m_maxDist * scan.m_maxDist) + scan.m_queryRadius;
+
+		RangeScanHit hit;
+		hit.m_scan = vit->m_scan;
+		hit.m_order = vit->m_order;
+		hit.m_candidate.m_radius = vit->m_radius;
+		for (Int first = (cell->getCoiCount() - 1) & ~31; first >= 0; first -= 32)
+		{
+			UnsignedInt nearMask = cell->getRangeIndexMask(first, scan.m_pos.x, scan.m_pos.y, reach);
+			for (Int bit = 31; nearMask != 0; --bit)
+			{
+				if ((nearMask & (1U << bit)) == 0)
+					continue;
+				nearMask &= ~(1U << bit);
+
+				hit.m_candidate.m_module = cell->getRangeIndexModule(first + bit);
+				m_rangeScanHits.push_back(hit);
+			}
+		}
+	}
+
+	// back into the order each scan walks its cells in. (stable, to keep the order within a cell.)
+	std::stable_sort(m_rangeScanHits.begin(), m_rangeScanHits.end(), rangeScanHitLess);
+
+	for (RangeScanHitVec::const_iterator hit = m_rangeScanHits.begin(); hit != m_rangeScanHits.end(); ++hit)
+	{
+		RangeScan& scan = m_dueRangeScans[hit->m_scan];
+		if (scan.m_numCandidates == 0)
+			scan.m_firstCandidate = (Int)m_rangeScanCandidates.size();
+		++scan.m_numCandidates;
+		m_rangeScanCandidates.push_back(hit->m_candidate);
+	}
+}
+
+//-----------------------------------------------------------------------------
+/// true if the scan's candidates are still what walking the cells would find for obj right now.
+bool PartitionManager::isRangeScanCurrent(const RangeScan *scan, const Object *obj, Int cellCenterX, Int cellCenterY, Real queryRadius)
+{
+	if (!scan->m_valid)
+		return FALSE;
+
+	const Coord3D *pos = obj->getPosition();
+	if (pos->x != scan->m_pos.x || pos->y != scan->m_pos.y || pos->z != scan->m_pos.z)
+		return FALSE;
+
+	if (queryRadius != scan->m_queryRadius)
+		return FALSE;
+
+	if (theRangeIndexClock == scan->m_sweptClock)
+		return TRUE;
+
+	// something changed somewhere; see if it was in any of our cells.
+	Int maxRadiusLimit = getGcoRadiusLimit(scan->m_maxDist);
+	for (Int curRadius = 0; curRadius <= maxRadiusLimit; ++curRadius)
+	{
+		const OffsetVec& offsets = m_radiusVec[curRadius];
+		for (OffsetVec::const_iterator it = offsets.begin(); it != offsets.end(); ++it)
+		{
+			const PartitionCell* cell = getCellAt(cellCenterX + it->x, cellCenterY + it->y);
+			if (cell && cell->getRangeIndexStamp() > scan->m_sweptClock)
+				return FALSE;
+		}
+	}
+	return TRUE;
+}
+#endif
+
+#if (defined RTS_DEBUG || defined RTS_INTERNAL) && defined FASTER_GCO
+//-----------------------------------------------------------------------------
+/// fixed pseudo random numbers, so every run scatters the objects the same way.
+static UnsignedInt benchmarkRandom(UnsignedInt &seed)
+{
+	seed = seed*1664525 + 1013904223;
+	return seed>>8;
+}
+
+//-----------------------------------------------------------------------------
+/*
+	A range scan the way getClosestObjects did it before the range index: every COI of every
+	cell out to maxDist, found by walking the cell lists. Returns how many objects are in range.
+*/
+Int PartitionManager::benchmarkScanCellLists(const Object *obj, Real maxDist, DistanceCalculationType dc)
+{
+	// counts down, so it never meets the flags getClosestObjects counts up.
+	static Int theIterFlag = 0;
+	--theIterFlag;
+
+	DistCalcProc distProc = theDistCalcProcs[dc];
+	const Coord3D *objPos = obj->getPosition();
+	Real maxDistSqr = maxDist * maxDist;
+
+	Int cellCenterX, cellCenterY;
+	worldToCell(objPos->x, objPos->y, &cellCenterX, &cellCenterY);
+
+	Int count = 0;
+	Int maxRadiusLimit = getGcoRadiusLimit(maxDist);
+	for (Int curRadius = 0; curRadius <= maxRadiusLimit; ++curRadius)
+	{
+		const OffsetVec& offsets = m_radiusVec[curRadius];
+		for (OffsetVec::const_iterator it = offsets.begin(); it != offsets.end(); ++it)
+		{
+			PartitionCell* thisCell = getCellAt(cellCenterX + it->x, cellCenterY + it->y);
+			if (thisCell == NULL)
+				continue;
+
+			for (CellAndObjectIntersection *thisCoi = thisCell->getFirstCoiInCell(); thisCoi; thisCoi = thisCoi->getNextCoi())
+			{
+				PartitionData *thisMod = thisCoi->getModule();
+				Object *thisObj = thisMod->getObject();
+				if (thisObj == obj || thisObj == NULL)
+					continue;
+
+				if (thisMod->friend_getDoneFlag() == theIterFlag)
+					continue;
+				thisMod->friend_setDoneFlag(theIterFlag);
+
+				Real thisDistSqr;
+				Coord3D distVec;
+				if ((*distProc)(objPos, obj, thisObj->getPosition(), thisObj, thisDistSqr, distVec, maxDistSqr))
+					++count;
+			}
+		}
+	}
+	return count;
+}
+
+//-----------------------------------------------------------------------------
+/**
+	Scatter numObjects of the first infantry template over the map, then time a range scan from
+	each of them four ways: walking the cell lists (as before the range index), iterateObjectsInRange,
+	getClosestObject with the filters target acquisition uses, and the last two again with all the
+	scans queued, so they come from one sweep. Crashes if any of them disagree.
+*/
+void PartitionManager::benchmarkRangeScans(Int numObjects)
+{
+	numObjects = max(1, numObjects);
+	const Real scanRange = 150.0f;	// about the vision range of infantry
+	const DistanceCalculationType dc = FROM_BOUNDINGSPHERE_2D;
+
+	const ThingTemplate *tmpl;
+	for (tmpl = TheThingFactory->firstTemplate(); tmpl; tmpl = tmpl->friend_getNextTemplate())
+	{
+		if (tmpl->isKindOf(KINDOF_INFANTRY))
+			break;
+	}
+	if (tmpl == NULL)
+	{
+		DEBUG_CRASH(("benchmarkRangeScans - there is no infantry to scatter\n"));
+		return;
+	}
+
+	std::vector<Object *> objects;
+	objects.reserve(numObjects);
+	Team *team = ThePlayerList->getNeutralPlayer()->getDefaultTeam();
+	Real width = m_worldExtents.hi.x - m_worldExtents.lo.x;
+	Real height = m_worldExtents.hi.y - m_worldExtents.lo.y;
+	UnsignedInt seed = 12345;
+	Int i;
+	for (i = 0; i < numObjects; ++i)
+	{
+		Object *obj = TheThingFactory->newObject(tmpl, team);
+		Coord3D pos;
+		pos.x = m_worldExtents.lo.x + width * (benchmarkRandom(seed) % 10000) / 10000.0f;
+		pos.y = m_worldExtents.lo.y + height * (benchmarkRandom(seed) % 10000) / 10000.0f;
+		pos.z = TheTerrainLogic->getGroundHeight(pos.x, pos.y);
+		obj->setPosition(&pos);
+		objects.push_back(obj);
+	}
+
+	// put them in their cells.
+	update();
+
+	Int64 freq, start, end;
+	QueryPerformanceFrequency((LARGE_INTEGER *)&freq);
+
+	// the cell lists.
+	Int cellListCount = 0;
+	QueryPerformanceCounter((LARGE_INTEGER *)&start);
+	for (i = 0; i < numObjects; ++i)
+	{
+		cellListCount += benchmarkScanCellLists(objects[i], scanRange, dc);
+	}
+	QueryPerformanceCounter((LARGE_INTEGER *)&end);
+	double cellListSeconds = (double)(end - start) / (double)freq;
+
+	// the range index, all objects in range.
+	Int iterateCount = 0;
+	QueryPerformanceCounter((LARGE_INTEGER *)&start);
+	for (i = 0; i < numObjects; ++i)
+	{
+		SimpleObjectIterator *iter = iterateObjectsInRange(objects[i], scanRange, dc);
+		iterateCount += iter->getCount();
+		iter->deleteInstance();
+	}
+	QueryPerformanceCounter((LARGE_INTEGER *)&end);
+	double iterateSeconds = (double)(end - start) / (double)freq;
+
+	// the range index, closest object only.
+	PartitionFilterAlive filterAlive;
+	UnsignedInt closestChecksum = 0;
+	QueryPerformanceCounter((LARGE_INTEGER *)&start);
+	for (i = 0; i < numObjects; ++i)
+	{
+		PartitionFilterRelationship filterTeam(objects[i], PartitionFilterRelationship::ALLOW_ENEMIES | PartitionFilterRelationship::ALLOW_NEUTRAL);
+		PartitionFilter *filters[] = { &filterTeam, &filterAlive, NULL };
+		Object *closest = getClosestObject(objects[i], scanRange, dc, filters);
+		closestChecksum = closestChecksum*31 + (closest ? closest->getID() : INVALID_ID);
+	}
+	QueryPerformanceCounter((LARGE_INTEGER *)&end);
+	double closestSeconds = (double)(end - start) / (double)freq;
+
+	// both again, from one sweep. (the sweep happens in the first call.)
+	for (i = 0; i < numObjects; ++i)
+	{
+		queueRangeScan(objects[i], scanRange, dc, TheGameLogic->getFrame(), PHASE_NORMAL);
+	}
+	prepareRangeScans();
+
+	Int sweptCount = 0;
+	UnsignedInt sweptChecksum = 0;
+	QueryPerformanceCounter((LARGE_INTEGER *)&start);
+	for (i = 0; i < numObjects; ++i)
+	{
+		SimpleObjectIterator *iter = iterateObjectsInRange(objects[i], scanRange, dc);
+		sweptCount += iter->getCount();
+		iter->deleteInstance();
+
+		PartitionFilterRelationship filterTeam(objects[i], PartitionFilterRelationship::ALLOW_ENEMIES | PartitionFilterRelationship::ALLOW_NEUTRAL);
+		PartitionFilter *filters[] = { &filterTeam, &filterAlive, NULL };
+		Object *closest = getClosestObject(objects[i], scanRange, dc, filters);
+		sweptChecksum = sweptChecksum*31 + (closest ? closest->getID() : INVALID_ID);
+	}
+	QueryPerformanceCounter((LARGE_INTEGER *)&end);
+	double sweptSeconds = (double)(end - start) / (double)freq;
+
+	m_dueRangeScans.clear();
+	m_rangeScanCandidates.clear();
+
+	DEBUG_ASSERTCRASH(cellListCount == iterateCount && iterateCount == sweptCount && closestChecksum == sweptChecksum,
+		("benchmarkRangeScans - the scans disagree (%d %d %d, %8.8X %8.8X)\n", cellListCount, iterateCount, sweptCount, closestChecksum, sweptChecksum));
+	DEBUG_LOG(("benchmarkRangeScans - %d %s scanning %.0f around each, %d in range in all:\n",
+		numObjects, tmpl->getName().str(), scanRange, iterateCount));
+	DEBUG_LOG(("  cell lists %f sec, range index %f sec, closest with filters %f sec, both from one sweep %f sec\n",
+		cellListSeconds, iterateSeconds, closestSeconds, sweptSeconds));
+
+	for (i = 0; i < numObjects; ++i)
+	{
+		TheGameLogic->destroyObject(objects[i]);
+	}
+}
+#endif
+
 //-----------------------------------------------------------------------------
 SimpleObjectIterator* PartitionManager::iteratePotentialCollisions(
 	const Coord3D* pos, 
@@ -4545,13 +5221,64 @@ bool PartitionManager::isClearLineOfSightTerrain(const Object* obj, const Coord3
 void PartitionManager::crc( Xfer *xfer )
 {
 
-	for (Int i=0; i<m_totalCellCount; ++i)
+	/*
+		a deep CRC is written out for diffing, so it gets every cell. so does a legacy light CRC,
+		so games with older clients and old replays get the same CRC they always did.
+	*/
+	CRCKernel kernel = xfer->getCRCKernel();
+	if( xfer->getXferMode() != XFER_CRC || kernel == CRC_KERNEL_LEGACY )
 	{
-		m_cells[i].crc(xfer);
+		for (Int i=0; i<m_totalCellCount; ++i)
+		{
+			m_cells[i].crc(xfer);
+		}
+		return;
+	}
+
+	/*
+		with a newer kernel, the light CRC is of the CRC of each row of cells instead. the shroud
+		of every cell for every player adds up to a lot of data on big maps, but very little of it
+		changes between CRCs, so a row is only recomputed when a cell in it has changed.
+	*/
+	bool noCachedCRCs = BitIsSet(xfer->getOptions(), XO_NO_CACHED_CRCS);
+	for (Int y=0; y<m_cellCountY; ++y)
+	{
+		if (noCachedCRCs)
+		{
+			// a full recompute, for checking the cache against (see GameLogic::verifyCachedCRCs)
+			UnsignedInt fullCRC = calcRowCRC(y, kernel);
+			DEBUG_ASSERTCRASH(m_rowCRCDirty[y] || fullCRC == m_rowCRC[y], ("Cached CRC of partition row %d is stale on frame %d (0x%8.8X, should be 0x%8.8X)\n",
+				y, TheGameLogic->getFrame(), m_rowCRC[y], fullCRC));
+			xfer->xferUnsignedInt(&fullCRC);
+			continue;
+		}
+
+		if (m_rowCRCDirty[y])
+		{
+			m_rowCRC[y] = calcRowCRC(y, kernel);
+			m_rowCRCDirty[y] = FALSE;
+		}
+		xfer->xferUnsignedInt(&m_rowCRC[y]);
 	}
 
 }  // end crc
 
+// ------------------------------------------------------------------------------------------------
+UnsignedInt PartitionManager::calcRowCRC( Int y, CRCKernel kernel )
+{
+	XferCRC xferCRC(kernel);
+	xferCRC.open("rowCRC");
+
+	PartitionCell *cell = &m_cells[y * m_cellCountX];
+	for (Int x=0; x<m_cellCountX; ++x, ++cell)
+	{
+		xferCRC.xferSnapshot(cell);
+	}
+
+	xferCRC.close();
+	return xferCRC.getCRC();
+}
+
 // ------------------------------------------------------------------------------------------------
 /** Xfer Method
 	* Version Info:
@@ -4611,6 +5338,9 @@ void PartitionManager::xfer( Xfer *xfer )
 
 	}  // end for i
 
+	if( xfer->getXferMode() == XFER_LOAD )
+		m_rowCRCDirty.assign( m_cellCountY, TRUE );
+
 	// when loading tell the partition manager to rethink and refresh all shroud information
 	if( xfer->getXferMode() == XFER_LOAD )
 	{
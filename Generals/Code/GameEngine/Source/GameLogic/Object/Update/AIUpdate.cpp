@@ -457,6 +457,11 @@ void AIUpdateInterface::doPathfind( PathfindServicesInterface *pathfinder )
 		}
 	} 
 	computePath(pathfinder, &m_requestedDestination);
+	if (TheAI->pathfinder()->isSearchSuspended()) {
+		// Ran out of pathfind time this frame, stay queued so the search resumes next frame.
+		m_waitingForPath = TRUE;
+		return;
+	}
 	if (m_isFinalGoal && isDoingGroundMovement() && getPath()) {
 		TheAI->pathfinder()->updateGoal(getObject(), getPath()->getLastNode()->getPosition(),
 			getPath()->getLastNode()->getLayer());
@@ -1652,6 +1657,33 @@ bool AIUpdateInterface::computeQuickPath( const Coord3D *destination )
  * Invoke the pathfinder to compute a path to the desired location.
  */
 bool AIUpdateInterface::computePath( PathfindServicesInterface *pathServices, Coord3D *destination )
+{
+	// A time sliced search may not finish this frame, so hang on to the path we're following, and 
+	// keep following it until the search does.  Everything below still starts without a path.
+	Path *keepPath = NULL;
+	bool keepIsAttackPath = m_isAttackPath;
+	if (!m_isBlockedAndStuck && TheAI->pathfinder()->isSlicingSearches()) {
+		keepPath = m_path;
+		m_path = NULL;
+	}
+	bool ok = computePathNow(pathServices, destination);
+	if (keepPath) {
+		if (m_path==NULL && TheAI->pathfinder()->isSearchSuspended()) {
+			m_path = keepPath;
+			m_isAttackPath = keepIsAttackPath;
+			setLocomotorGoalPositionOnPath();
+		} else {
+			keepPath->deleteInstance();
+		}
+	}
+	return ok;
+}
+
+//-------------------------------------------------------------------------------------------------
+/**
+ * Compute a path to the destination, starting over from no path (unless we're stuck).
+ */
+bool AIUpdateInterface::computePathNow( PathfindServicesInterface *pathServices, Coord3D *destination )
 {
 
 	if (!m_isBlockedAndStuck)	{
@@ -1711,6 +1743,11 @@ bool AIUpdateInterface::computePath( PathfindServicesInterface *pathServices, Co
 		}	else {
 			theNewPath = pathServices->findPath( getObject(), m_locomotorSet, getObject()->getPosition(), 
 				destination);
+			if (theNewPath==NULL && TheAI->pathfinder()->isSearchSuspended()) {
+				// The search finishes on a later frame.  (computePath puts back the path we had.)
+				TheAI->pathfinder()->setIgnoreObstacleID( INVALID_ID );
+				return FALSE;
+			}
 		}
 	}
 	if (theNewPath==NULL && m_path==NULL) {
@@ -4388,6 +4425,13 @@ Object* AIUpdateInterface::getNextMoodTarget( bool calledByAI, bool calledDuring
 		flags |= AI::UNFOGGED;
 	}
 
+	// we'll most likely be idle and looking from the same range at the next check, so get
+	// that scan swept with everyone else's. (findClosestEnemy looks from our bounding sphere.)
+	if (calledByAI)
+	{
+		ThePartitionManager->queueRangeScan(obj, rangeToFindWithin, FROM_BOUNDINGSPHERE_2D, m_nextMoodCheckTime, getUpdatePhase());
+	}
+
 	Object *newVictim = TheAI->findClosestEnemy(obj, rangeToFindWithin, flags, getAttackInfo());
 
 /*
@@ -139,6 +139,10 @@ UpdateSleepTime AutoFindHealingUpdate::update()
 
 	//Periodic scanning (expensive)
 	Object *healUnit = scanClosestTarget();
+
+	// we'll probably still want healing next time, so get the next scan swept with everyone else's.
+	ThePartitionManager->queueRangeScan( obj, data->m_scanRange, FROM_CENTER_2D,
+		TheGameLogic->getFrame() + m_nextScanFrames + 1, getUpdatePhase() );
 	if(healUnit)
 	{
 		ai->aiGetHealed(healUnit, CMD_FROM_AI);
@@ -155,7 +159,7 @@ Object* AutoFindHealingUpdate::scanClosestTarget()
 	Object *bestTarget = NULL;
 	Real closestDistSqr=0;
 
-	ObjectIterator *iter = ThePartitionManager->iterateObjectsInRange( me->getPosition(), data->m_scanRange, FROM_CENTER_2D );
+	ObjectIterator *iter = ThePartitionManager->iterateObjectsInRange( me, data->m_scanRange, FROM_CENTER_2D );
 	MemoryPoolObjectHolder hold(iter);
 
 	for( Object *other = iter->first(); other; other = iter->next() )
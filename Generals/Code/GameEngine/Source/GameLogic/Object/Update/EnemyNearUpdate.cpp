@@ -35,8 +35,10 @@
 #include "Common/Xfer.h"
 #include "GameClient/Drawable.h"
 #include "GameLogic/Module/EnemyNearUpdate.h"
+#include "GameLogic/GameLogic.h"
 #include "GameLogic/Object.h"
 #include "GameLogic/AI.h"
+#include "GameLogic/PartitionManager.h"
 #include "GameLogic/Module/AIUpdate.h"
 
 //-------------------------------------------------------------------------------------------------
@@ -72,6 +74,10 @@ void EnemyNearUpdate::checkForEnemies( void )
 		Real visionRange = getObject()->getVisionRange();
 		Object* enemy = TheAI->findClosestEnemy( getObject(), visionRange, AI::CAN_SEE );
 		m_enemyNear = (enemy != NULL);
+
+		// findClosestEnemy looks from our bounding sphere; get the next check swept with everyone else's.
+		ThePartitionManager->queueRangeScan( getObject(), visionRange, FROM_BOUNDINGSPHERE_2D,
+			TheGameLogic->getFrame() + m_enemyScanDelay + 1, getUpdatePhase() );
 	}
 	else
 	{
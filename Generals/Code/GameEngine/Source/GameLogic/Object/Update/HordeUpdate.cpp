@@ -274,6 +274,10 @@ UpdateSleepTime HordeUpdate::update( void )
 		SimpleObjectIterator *iter = ThePartitionManager->iterateObjectsInRange(getObject(), md->m_minDist, FROM_BOUNDINGSPHERE_3D, filters);
 		MemoryPoolObjectHolder hold(iter);
 
+		// infantry sleep until the next check; vehicles wait until we're past the refresh interval.
+		UnsignedInt nextCheckFrame = m_lastHordeRefreshFrame + md->m_updateRate + (isInfantry ? 0 : 1);
+		ThePartitionManager->queueRangeScan(getObject(), md->m_minDist, FROM_BOUNDINGSPHERE_3D, nextCheckFrame, getUpdatePhase());
+
 		if ((iter->getCount() >= md->m_minCount - 1) )//we really are in the thick part of the horde
 		{
 			m_inHorde = TRUE;
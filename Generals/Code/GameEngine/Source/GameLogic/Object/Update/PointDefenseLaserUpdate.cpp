@@ -145,7 +145,9 @@ UpdateSleepTime PointDefenseLaserUpdate::update()
 	}
 	m_nextScanFrames = data->m_scanFrames;
 
-	//Periodic scanning (expensive)
+	//Periodic scanning (expensive), with the next one swept along with everyone else's
+	ThePartitionManager->queueRangeScan( me, data->m_scanRange, FROM_CENTER_2D,
+		TheGameLogic->getFrame() + m_nextScanFrames + 1, getUpdatePhase() );
 	if( scanClosestTarget() )
 	{
 		//1 frame can make a big difference so fire ASAP!
@@ -251,7 +253,7 @@ Object* PointDefenseLaserUpdate::scanClosestTarget()
 	bonus.clear();
 	Real fireRange = data->m_weaponTemplate->getAttackRange( bonus );
 
-	ObjectIterator *iter = ThePartitionManager->iterateObjectsInRange( me->getPosition(), data->m_scanRange, FROM_CENTER_2D );
+	ObjectIterator *iter = ThePartitionManager->iterateObjectsInRange( me, data->m_scanRange, FROM_CENTER_2D );
 	MemoryPoolObjectHolder hold(iter);
 
 	for( Object *other = iter->first(); other; other = iter->next() )
@@ -41,6 +41,7 @@
 #include "GameClient/InGameUI.h"
 #include "GameClient/ParticleSys.h"
 #include "GameLogic/Damage.h"
+#include "GameLogic/GameLogic.h"
 #include "GameLogic/Object.h"
 #include "GameLogic/PartitionManager.h"
 #include "GameLogic/Module/ContainModule.h"
@@ -202,6 +203,10 @@ UpdateSleepTime StealthDetectorUpdate::update( void )
 	SimpleObjectIterator *iter = ThePartitionManager->iterateObjectsInRange(
 								self, visionRange, FROM_CENTER_2D, filters); 
 	MemoryPoolObjectHolder hold(iter);
+
+	// we'll do this again when we wake up; get it swept with everyone else's.
+	ThePartitionManager->queueRangeScan( self, visionRange, FROM_CENTER_2D,
+		TheGameLogic->getFrame() + data->m_updateRate, getUpdatePhase() );
 	for (Object *them = iter->first(); them; them = iter->next())
 	{
 		if ( them->isEffectivelyDead() )
@@ -103,13 +103,15 @@ void UpdateModule::crc( Xfer *xfer )
 /** Xfer method
 	* Version Info;
 	* 1: Initial version 
+	* 2: m_sleepySequence
+	* 3: Removed m_sleepySequence
 	*/
 // ------------------------------------------------------------------------------------------------
 void UpdateModule::xfer( Xfer *xfer )
 {
 
 	// version
-	const XferVersion currentVersion = 1;
+	const XferVersion currentVersion = 3;
 	XferVersion version = currentVersion;
 	xfer->xferVersion( &version, currentVersion );
 
@@ -177,6 +179,13 @@ void UpdateModule::xfer( Xfer *xfer )
 	}
 #endif
 
+	// the sleepy update wheel's tie breaker, which went with it
+	if (version == 2)
+	{
+		UnsignedInt sleepySequence = 0;
+		xfer->xferUnsignedInt( &sleepySequence );
+	}
+
 	// m_indexInLogic is not saved -- it's restored in gamelogic::postprocess.
 	if( xfer->getXferMode() == XFER_LOAD )
 	{
@@ -1618,6 +1618,7 @@ Weapon::Weapon(const WeaponTemplate* tmpl, WeaponSlotType wslot)
 	m_numShotsForCurBarrel = 	m_template->getShotsPerBarrel();
 	m_lastFireFrame = 0;
 	m_suspendFXFrame = TheGameLogic->getFrame() + m_template->getSuspendFXDelay();
+	m_ownerCRC = NULL;
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -1639,6 +1640,7 @@ Weapon::Weapon(const Weapon& that)
 	this->m_numShotsForCurBarrel = m_template->getShotsPerBarrel();
 	this->m_lastFireFrame = 0;
 	this->m_suspendFXFrame = that.getSuspendFXFrame();
+	this->m_ownerCRC = NULL;
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -1662,6 +1664,7 @@ Weapon& Weapon::operator=(const Weapon& that)
 		this->m_suspendFXFrame = that.getSuspendFXFrame();
 		this->m_numShotsForCurBarrel = m_template->getShotsPerBarrel();
 		this->m_projectileStreamID = INVALID_ID;
+		invalidateCRC();
 	}
 	return *this;
 }
@@ -1719,6 +1722,7 @@ void Weapon::setClipPercentFull(Real percent, bool allowReduction)
 	Int ammo = REAL_TO_INT_FLOOR(m_template->getClipSize() * percent);
 	if (ammo > m_ammoInClip || (allowReduction && ammo < m_ammoInClip))
 	{
+		invalidateCRC();
 		m_ammoInClip = ammo;
 		m_status = m_ammoInClip ? OUT_OF_AMMO : READY_TO_FIRE;
 		//CRCDEBUG_LOG(("Weapon::setClipPercentFull() just set m_status to %d (ammo in clip is %d)\n", m_status, m_ammoInClip));
@@ -1732,6 +1736,7 @@ void Weapon::setClipPercentFull(Real percent, bool allowReduction)
 //-------------------------------------------------------------------------------------------------
 void Weapon::rebuildScatterTargets()
 {
+	invalidateCRC();
 	m_scatterTargetsUnused.clear();
 	Int scatterTargetsCount = m_template->getScatterTargetsVector().size();
 	if (scatterTargetsCount)
@@ -1750,6 +1755,7 @@ void Weapon::reloadWithBonus(const Object *sourceObj, const WeaponBonus& bonus,
 			&& !sourceObj->isReloadTimeShared())
 		return;	// don't restart our reload delay.
 
+	invalidateCRC();
 	m_ammoInClip = m_template->getClipSize();
 	if (m_ammoInClip <= 0)
 		m_ammoInClip = 0x7fffffff;	// 0 == unlimited (or effectively so)
@@ -2221,6 +2227,7 @@ void Weapon::newProjectileFired(const Object *sourceObj, const Object *projectil
 	Object* projectileStream = TheGameLogic->findObjectByID(m_projectileStreamID);
 	if( projectileStream == NULL )
 	{
+		invalidateCRC();
 		m_projectileStreamID = INVALID_ID;	// reset, since it might have been "valid" but deleted out from under us
 		const ThingTemplate* pst = TheThingFactory->findTemplate(m_template->getProjectileStreamName());
 		projectileStream = TheThingFactory->newObject( pst, sourceObj->getControllingPlayer()->getDefaultTeam() );
@@ -2351,6 +2358,7 @@ bool Weapon::privateFireWeapon(
 				}
 			}
 
+			invalidateCRC();
 			--m_maxShotCount;
 			--m_ammoInClip;	// so we can use the delay between shots on the mine clearing weapon
 			if (m_ammoInClip <= 0 && m_template->getAutoReloadsClip())
@@ -2386,6 +2394,7 @@ bool Weapon::privateFireWeapon(
 	bool reloaded = false;
 	if (m_ammoInClip > 0)
 	{
+		invalidateCRC();
 		Int barrelCount = sourceObj->getDrawable()->getBarrelCount(m_wslot);
 		if (m_curBarrel >= barrelCount)
 		{
@@ -3246,6 +3255,7 @@ void Weapon::loadPostProcess( void )
 		if( projectileStream == NULL )
 		{
 			m_projectileStreamID = INVALID_ID;
+			invalidateCRC();
 		}
 	}
 }
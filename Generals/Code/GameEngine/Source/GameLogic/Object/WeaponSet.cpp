@@ -179,6 +179,7 @@ WeaponSet::WeaponSet()
 	DEBUG_ASSERTCRASH(DAMAGE_NUM_TYPES <= 32, ("m_totalDamageTypeMask will need to be enlarged in WeaponSet"));
 	m_hasPitchLimit = false;
 	m_hasDamageWeapon = false;
+	m_ownerCRC = NULL;
 	for (Int i = 0; i < WEAPONSLOT_COUNT; ++i)
 		m_weapons[i] = NULL;
 }
@@ -265,6 +266,7 @@ void WeaponSet::xfer( Xfer *xfer )
 					wt = m_curWeaponTemplateSet->getNth((WeaponSlotType)0);
 				}
 				m_weapons[i] = TheWeaponStore->allocateNewWeapon(wt, (WeaponSlotType)i);
+				m_weapons[i]->friend_setOwnerCRC(m_ownerCRC);
 			}
 			xfer->xferSnapshot(m_weapons[i]);
 		}
@@ -316,6 +318,7 @@ void WeaponSet::updateWeaponSet(const Object* obj)
 			if (set->getNth((WeaponSlotType)i))
 			{
 				m_weapons[i] = TheWeaponStore->allocateNewWeapon(set->getNth((WeaponSlotType)i), (WeaponSlotType)i);
+				m_weapons[i]->friend_setOwnerCRC(m_ownerCRC);
 				m_weapons[i]->loadAmmoNow(obj);	// start 'em all with full clips.
 				m_filledWeaponSlotMask |= (1 << i);
 				m_totalAntiMask |= m_weapons[i]->getAntiMask();
@@ -332,6 +335,8 @@ void WeaponSet::updateWeaponSet(const Object* obj)
 			}
 		}
 		m_curWeaponTemplateSet = set;
+		if (m_ownerCRC)
+			m_ownerCRC->invalidate();
 		//DEBUG_LOG(("WeaponSet::updateWeaponSet -- changed curweapon to %s\n",getCurWeapon()->getName().str()));
 	}
 }
@@ -29,6 +29,7 @@
 
 //#include "PreRTS.h"	// This must go first in EVERY cpp file int the GameEngine
 
+#include "Common/AssetPrefetcher.h"
 #include "Common/AudioAffect.h"
 //#include "Common/AudioHandleSpecialValues.h"
 #include "Common/BuildAssistant.h"
@@ -107,6 +108,55 @@
 
 DECLARE_PERF_TIMER(SleepyMaintenance)
 
+#if defined(RTS_DEBUG) || defined(RTS_INTERNAL)
+// -benchmarkSleepyUpdates: what keeping the sleepy updates in a heap costs, against the updates
+// themselves. (the perf timers above are compiled out; see NO_PERF_TIMERS.)
+static Int64 theSleepyBenchmarkHeapTicks = 0;		///< pushing, rebalancing and erasing heap entries
+static Int64 theSleepyBenchmarkLoopTicks = 0;		///< the whole sleepy update loop, updates and all
+static Int64 theSleepyBenchmarkHeapSizes = 0;		///< the heap's size, summed over the frames
+static Int theSleepyBenchmarkWakes = 0;
+static Int theSleepyBenchmarkFrames = 0;
+
+class SleepyBenchmarkTimer
+{
+public:
+	SleepyBenchmarkTimer( Int64 *total ) : m_total(TheGlobalData->m_benchmarkSleepyUpdates > 0 ? total : NULL)
+	{
+		if (m_total)
+			QueryPerformanceCounter((LARGE_INTEGER *)&m_start);
+	}
+	~SleepyBenchmarkTimer()
+	{
+		if (m_total)
+		{
+			Int64 end;
+			QueryPerformanceCounter((LARGE_INTEGER *)&end);
+			*m_total += end - m_start;
+		}
+	}
+private:
+	Int64 *m_total;
+	Int64 m_start;
+};
+#define SLEEPY_BENCHMARK_TIMER(total) SleepyBenchmarkTimer sleepyBenchmarkTimer(&total)
+
+static void logSleepyUpdateBenchmark( void )
+{
+	Int64 freq;
+	QueryPerformanceFrequency((LARGE_INTEGER *)&freq);
+	Real frames = (Real)theSleepyBenchmarkFrames;
+	Real usecPerTick = 1000000.0f / (Real)freq;
+	DEBUG_LOG(("benchmarkSleepyUpdates - %d frames, %.0f sleepy updates in the heap and %.1f woken per frame:\n",
+		theSleepyBenchmarkFrames, theSleepyBenchmarkHeapSizes / frames, theSleepyBenchmarkWakes / frames));
+	DEBUG_LOG(("  heap upkeep %.2f usec per frame (%.3f usec per wake), sleepy update loop %.2f usec per frame\n",
+		theSleepyBenchmarkHeapTicks * usecPerTick / frames,
+		theSleepyBenchmarkWakes > 0 ? theSleepyBenchmarkHeapTicks * usecPerTick / theSleepyBenchmarkWakes : 0.0f,
+		theSleepyBenchmarkLoopTicks * usecPerTick / frames));
+}
+#else
+#define SLEEPY_BENCHMARK_TIMER(total)
+#endif
+
 #include "Common/UnitTimings.h" //Contains the DO_UNIT_TIMINGS define jba.		 
 // If defined, the game times various units.
 #ifdef DO_UNIT_TIMINGS
@@ -182,6 +232,41 @@ static Waypoint * findNamedWaypoint(AsciiString name)
 	return NULL;
 }
 
+// ------------------------------------------------------------------------------------------------
+/** Start reading the files the drawables of the map's objects will load, while the objects are
+	* being created. The sounds of their templates are only played once the map is loaded, so they
+	* are just read through in the background. */
+// ------------------------------------------------------------------------------------------------
+void GameLogic::startPrefetchingMapAssets( void )
+{
+	Bool soundOn = TheAudio && (TheAudio->isOn( AudioAffect_Sound ) || TheAudio->isOn( AudioAffect_Sound3D ) || TheAudio->isOn( AudioAffect_Speech ));
+
+	FilenameList filenames;
+	FilenameList audioFilenames;
+	std::set<const ThingTemplate *> templatesWithAudio;	// a map has lots of the same few things
+	for (MapObject *pMapObj = MapObject::getFirstMapObject(); pMapObj; pMapObj = pMapObj->getNext()) 
+	{
+		const ThingTemplate *thingTemplate = pMapObj->getThingTemplate();
+		if( thingTemplate == NULL )
+			continue;
+
+		const ModuleInfo &drawModules = thingTemplate->getDrawModuleInfo();
+		for( Int i = 0; i < drawModules.getCount(); ++i )
+		{
+			const ModuleData *data = drawModules.getNthData( i );
+			if( data )
+				data->getAssetFilenames( filenames );
+		}
+
+		if( soundOn && templatesWithAudio.insert( thingTemplate ).second )
+			thingTemplate->getAudioFilenames( audioFilenames );
+	}
+
+	if( TheAssetPrefetcher == NULL )
+		TheAssetPrefetcher = createAssetPrefetcher();
+	TheAssetPrefetcher->start( filenames, audioFilenames );
+}
+
 // ------------------------------------------------------------------------------------------------
 // ------------------------------------------------------------------------------------------------
 void setFPMode( void )
@@ -206,6 +291,17 @@ void setFPMode( void )
 	_controlfp(newVal, _MCW_PC | _MCW_RC);
 }
 
+// ------------------------------------------------------------------------------------------------
+const char *TheCRCSectionNames[] = 
+{
+	"Objects",
+	"ThePartitionManager",
+	"ThePlayerList",
+	"TheAI",
+
+	NULL
+};
+
 // ------------------------------------------------------------------------------------------------
 /** GameLogic class constructor */
 // ------------------------------------------------------------------------------------------------
@@ -215,6 +311,9 @@ GameLogic::GameLogic( void )
 	//Initializations missing and necessary 
 	m_background = NULL;
 	m_CRC = 0;
+	for (Int i = 0; i < CRC_SECTION_COUNT; ++i)
+		m_crcSections[i] = 0;
+	m_noCachedCRCs = FALSE;
 	m_isInUpdate = FALSE;
 
 	m_rankPointsToAddAtGameStart = 0;
@@ -1139,6 +1238,9 @@ void GameLogic::startNewGame( bool saveGame )
 
 	// load a map
 	TheTerrainLogic->loadMap( TheGlobalData->m_mapName, false );
+
+	if( saveGame == FALSE )
+		startPrefetchingMapAssets();
 	// anytime the world's size changes, must reset the partition mgr
 	//ThePartitionManager->init();
 
@@ -1613,8 +1715,16 @@ void GameLogic::startNewGame( bool saveGame )
 	if( saveGame == FALSE )
 	{
 
+		Int numMapObjects = 0;
+		Int numMapObjectsDone = 0;
+		for (pMapObj = MapObject::getFirstMapObject(); pMapObj; pMapObj = pMapObj->getNext()) 
+			++numMapObjects;
+
 		for (pMapObj = MapObject::getFirstMapObject(); pMapObj; pMapObj = pMapObj->getNext()) 
 		{
+			++numMapObjectsDone;
+			if( TheAssetPrefetcher )
+				TheAssetPrefetcher->update();	// queue what was found in the models read so far
 		
 			if (pMapObj->getFlag(FLAG_BRIDGE_FLAGS) || pMapObj->getFlag(FLAG_ROAD_FLAGS)) {
 				continue;	// roads & bridges are special cased in the terrain side.
@@ -1698,14 +1808,26 @@ void GameLogic::startNewGame( bool saveGame )
 		
 			if(timeGetTime() > timer + 500)
 			{
-				if(progressCount < LOAD_PROGRESS_MAX_ALL_THE_FREAKN_OBJECTS)
-					progressCount ++;
+				// the objects, and the files being read ahead for them, both count toward the progress
+				Int numDone = numMapObjectsDone;
+				Int numTotal = numMapObjects;
+				if( TheAssetPrefetcher )
+				{
+					numDone += TheAssetPrefetcher->getNumDone();
+					numTotal += TheAssetPrefetcher->getNumFiles();
+				}
+				progressCount = LOAD_PROGRESS_LOOP_ALL_THE_FREAKN_OBJECTS + 
+					(LOAD_PROGRESS_MAX_ALL_THE_FREAKN_OBJECTS - LOAD_PROGRESS_LOOP_ALL_THE_FREAKN_OBJECTS) * numDone / numTotal;
 				updateLoadProgress(progressCount);
 				timer = timeGetTime();
 			}
 
 		}	// for, loading map objects
 
+		// the textures of the last models still get read while the client preloads
+		if( TheAssetPrefetcher )
+			TheAssetPrefetcher->update();
+
 	}  // end if, not loading save game
 
 	#ifdef DUMP_PERF_STATS
@@ -1779,6 +1901,13 @@ void GameLogic::startNewGame( bool saveGame )
 		}
 	}
 
+	// whatever was read ahead and still hasn't been asked for won't be
+	if( TheAssetPrefetcher )
+	{
+		delete TheAssetPrefetcher;
+		TheAssetPrefetcher = NULL;
+	}
+
 	//put this here somewhat randomly.
 	TheControlBar->hideCommunicator( FALSE );
 
@@ -2057,6 +2186,14 @@ void GameLogic::startNewGame( bool saveGame )
 	if (TheGameSpyInfo)
 		TheGameSpyInfo->updateAdditionalGameSpyDisconnections(1);
 
+#if (defined(RTS_DEBUG) || defined(RTS_INTERNAL)) && defined(FASTER_GCO)
+	if (TheGlobalData->m_benchmarkRangeScans > 0)
+	{
+		ThePartitionManager->benchmarkRangeScans(TheGlobalData->m_benchmarkRangeScans);
+		TheGameEngine->setQuitting(TRUE);
+	}
+#endif
+
 }  // end startNewGame
 
 //-----------------------------------------------------------------------------------------
@@ -2187,28 +2324,34 @@ void GameLogic::processDestroyList( void )
 			and rebalancing the entire heap afterwards, at least for real-world maps, since an individual
 			rebalance is O(log N) and a full rebalance is O(N)... so unless you are deleting the majority
 			of the objects in the world every frame, we come out well ahead this way.)
-		*/
 
-		const Int MAX_SUO = 256;
-		UpdateModulePtr sleepyUpdatesForThisObject[MAX_SUO];
-		Int numSUO = 0;
+			the erase order shapes the heap, and so the order of updates due on the same frame, so 
+			don't change it.
+		*/
 
-		for (std::vector<UpdateModulePtr>::iterator it2 = m_sleepyUpdates.begin(); it2 != m_sleepyUpdates.end(); ++it2)
 		{
-			UpdateModulePtr u = *it2;
-			if (u->friend_getObject() == currentObject && numSUO < MAX_SUO)
+			SLEEPY_BENCHMARK_TIMER(theSleepyBenchmarkHeapTicks);
+			const Int MAX_SUO = 256;
+			UpdateModulePtr sleepyUpdatesForThisObject[MAX_SUO];
+			Int numSUO = 0;
+
+			for (std::vector<UpdateModulePtr>::iterator it2 = m_sleepyUpdates.begin(); it2 != m_sleepyUpdates.end(); ++it2)
 			{
-				sleepyUpdatesForThisObject[numSUO++] = u;
+				UpdateModulePtr u = *it2;
+				if (u->friend_getObject() == currentObject && numSUO < MAX_SUO)
+				{
+					sleepyUpdatesForThisObject[numSUO++] = u;
+				}
 			}
-		}
 
-		for (--numSUO; numSUO >= 0; --numSUO)
-		{
-			// have to re-get idx each time since each call to erase might change others.
-			Int idx = sleepyUpdatesForThisObject[numSUO]->friend_getIndexInLogic();
-			DEBUG_ASSERTCRASH(m_sleepyUpdates[idx] == sleepyUpdatesForThisObject[numSUO], ("Hmm, expected update mismatch here"));
-			eraseSleepyUpdate(idx);
-			DEBUG_ASSERTCRASH(sleepyUpdatesForThisObject[numSUO]->friend_getIndexInLogic() == -1, ("Hmm, expected index to be -1 here"));
+			for (--numSUO; numSUO >= 0; --numSUO)
+			{
+				// have to re-get idx each time since each call to erase might change others.
+				Int idx = sleepyUpdatesForThisObject[numSUO]->friend_getIndexInLogic();
+				DEBUG_ASSERTCRASH(m_sleepyUpdates[idx] == sleepyUpdatesForThisObject[numSUO], ("Hmm, expected update mismatch here"));
+				eraseSleepyUpdate(idx);
+				DEBUG_ASSERTCRASH(sleepyUpdatesForThisObject[numSUO]->friend_getIndexInLogic() == -1, ("Hmm, expected index to be -1 here"));
+			}
 		}
 
 		currentObject->removeFromList(&m_objList);//remove from object list
@@ -2704,7 +2847,10 @@ void GameLogic::friend_awakenUpdateModule(Object* obj, UpdateModulePtr u, Unsign
 		u->friend_setNextCallFrame(whenToWakeUp);
 
 		// rebalance.
-		rebalanceSleepyUpdate(idx);
+		{
+			SLEEPY_BENCHMARK_TIMER(theSleepyBenchmarkHeapTicks);
+			rebalanceSleepyUpdate(idx);
+		}
 		
 		// validate. (harmless except in debug mode)
 		validateSleepyUpdate();
@@ -3164,6 +3310,11 @@ void GameLogic::update( void )
 		TheRecorder->UPDATE();
 	}
 
+	// collect the range scans the updates said they would do this frame
+	{
+		ThePartitionManager->prepareRangeScans();
+	}
+
 	// process client commands
 	{
 		processCommandList( TheCommandList );
@@ -3195,6 +3346,7 @@ void GameLogic::update( void )
 #endif
 
 	{
+		SLEEPY_BENCHMARK_TIMER(theSleepyBenchmarkLoopTicks);
 		while (!m_sleepyUpdates.empty())
 		{
 			UpdateModulePtr u = peekSleepyUpdate();
@@ -3233,12 +3385,30 @@ void GameLogic::update( void )
 
 			// else defer it till next frame and re-push it
 			u->friend_setNextCallFrame(now + sleepLen);
-			rebalanceSleepyUpdate(0);
+			{
+				SLEEPY_BENCHMARK_TIMER(theSleepyBenchmarkHeapTicks);
+				rebalanceSleepyUpdate(0);
+			}
+#if defined(RTS_DEBUG) || defined(RTS_INTERNAL)
+			++theSleepyBenchmarkWakes;
+#endif
 		}
 	}
 
 	validateSleepyUpdate();
 
+#if defined(RTS_DEBUG) || defined(RTS_INTERNAL)
+	if (TheGlobalData->m_benchmarkSleepyUpdates > 0)
+	{
+		theSleepyBenchmarkHeapSizes += m_sleepyUpdates.size();
+		if (++theSleepyBenchmarkFrames == TheGlobalData->m_benchmarkSleepyUpdates)
+		{
+			logSleepyUpdateBenchmark();
+			TheGameEngine->setQuitting(TRUE);
+		}
+	}
+#endif
+
 	// update the Artificial Intelligence system
 	{
 		TheAI->UPDATE();
@@ -3264,6 +3434,10 @@ void GameLogic::update( void )
 	// reset the command list, destroying all messages
 	TheCommandList->reset();
 
+	// anything still waiting on the stream has to outlive the frame arena, then rewind it
+	TheMessageStream->promoteMessages();
+	TheGameMessageArena->reset();
+
 	TheWeaponStore->UPDATE();	
 	TheLocomotorStore->UPDATE();	
 	TheVictoryConditions->UPDATE();
@@ -3390,6 +3564,7 @@ void GameLogic::registerObject( Object *obj )
 #endif
 		{
 			DEBUG_ASSERTCRASH(u->friend_getNextCallFrame() >= now, ("you may not specify a zero initial sleep time for sleepy modules (%d %d)",u->friend_getNextCallFrame(),now));
+			SLEEPY_BENCHMARK_TIMER(theSleepyBenchmarkHeapTicks);
 			pushSleepyUpdate(u);
 		}
 	}
@@ -3474,11 +3649,14 @@ UnsignedInt GameLogic::getCRC( Int mode, AsciiString deepCRCFileName )
 
 	LatchRestore<bool> latch(inCRCGen, !isInGameLogicUpdate());
 
+	// everyone in the game has to use the same kernel.
+	CRCKernel kernel = TheGameInfo ? TheGameInfo->getCRCKernel() : CRC_KERNEL_LEGACY;
+
 	XferCRC *xferCRC;
 	AsciiString marker;
 	if (deepCRCFileName.isNotEmpty())
 	{
-		xferCRC = NEW XferDeepCRC;
+		xferCRC = NEW XferDeepCRC(kernel);
 		xferCRC->open(deepCRCFileName.str());
 	}
 	else
@@ -3493,17 +3671,24 @@ UnsignedInt GameLogic::getCRC( Int mode, AsciiString deepCRCFileName )
 		// granular than this because it can capture changes between two frames.
 		if (isInGameLogicUpdate() && g_keepCRCSaves && m_frame < 5)
 		{
-			xferCRC = NEW XferDeepCRC;
+			xferCRC = NEW XferDeepCRC(kernel);
 			crcName.format("logicFrame%d.crc", (m_frame%5));
 		}
 		else
 #endif // DEBUG_CRC
 		{
-			xferCRC = NEW XferCRC;
+			xferCRC = NEW XferCRC(kernel);
 			crcName = "lightCRC";
 		}
 		xferCRC->open(crcName);
 	}
+	if (m_noCachedCRCs)
+		xferCRC->setOptions(XO_NO_CACHED_CRCS);
+#ifdef DEBUG_CRC
+	// clean objects would not log their CRCs otherwise
+	if (g_logObjectCRCs)
+		xferCRC->setOptions(XO_NO_CACHED_CRCS);
+#endif // DEBUG_CRC
 
 	// calculate CRCs
 	Object *obj;
@@ -3517,7 +3702,7 @@ UnsignedInt GameLogic::getCRC( Int mode, AsciiString deepCRCFileName )
 	xferCRC->xferAsciiString(&marker);
 	for( obj = m_objList; obj; obj=obj->getNextObject() )
 	{
-		xferCRC->xferSnapshot( obj );
+		xferCRC->xferCachedSnapshot( obj, obj->friend_getCachedCRC() );
 	}
 	UnsignedInt seed = GetGameLogicRandomSeedCRC();
 	if (isInGameLogicUpdate())
@@ -3533,9 +3718,11 @@ UnsignedInt GameLogic::getCRC( Int mode, AsciiString deepCRCFileName )
 	{
 		xferCRC->xferUnsignedInt( &seed );
 	}
+	m_crcSections[CRC_SECTION_OBJECTS] = xferCRC->getCRC();
 	marker = "MARKER:ThePartitionManager";
 	xferCRC->xferAsciiString(&marker);
 	xferCRC->xferSnapshot( ThePartitionManager );
+	m_crcSections[CRC_SECTION_PARTITION] = xferCRC->getCRC();
 	if (isInGameLogicUpdate())
 	{
 		CRCGEN_LOG(("CRC after partition manager for frame %d is 0x%8.8X\n", m_frame, xferCRC->getCRC()));
@@ -3557,7 +3744,8 @@ UnsignedInt GameLogic::getCRC( Int mode, AsciiString deepCRCFileName )
 
 	marker = "MARKER:ThePlayerList";
 	xferCRC->xferAsciiString(&marker);
-	xferCRC->xferSnapshot( ThePlayerList );
+	xferCRC->xferCachedSnapshot( ThePlayerList, ThePlayerList->friend_getCachedCRC() );
+	m_crcSections[CRC_SECTION_PLAYERS] = xferCRC->getCRC();
 	if (isInGameLogicUpdate())
 	{
 		CRCGEN_LOG(("CRC after PlayerList for frame %d is 0x%8.8X\n", m_frame, xferCRC->getCRC()));
@@ -3566,6 +3754,7 @@ UnsignedInt GameLogic::getCRC( Int mode, AsciiString deepCRCFileName )
 	marker = "MARKER:TheAI";
 	xferCRC->xferAsciiString(&marker);
 	xferCRC->xferSnapshot( TheAI );
+	m_crcSections[CRC_SECTION_AI] = xferCRC->getCRC();
 	if (isInGameLogicUpdate())
 	{
 		CRCGEN_LOG(("CRC after AI for frame %d is 0x%8.8X\n", m_frame, xferCRC->getCRC()));
@@ -3581,6 +3770,9 @@ UnsignedInt GameLogic::getCRC( Int mode, AsciiString deepCRCFileName )
 	xferCRC->close();
 
 	UnsignedInt theCRC = xferCRC->getCRC();
+#ifdef DEBUG_CRC
+	bool usedCachedCRCs = xferCRC->getXferMode() == XFER_CRC && kernel != CRC_KERNEL_LEGACY && !m_noCachedCRCs;
+#endif // DEBUG_CRC
 
 	delete xferCRC;
 	xferCRC = NULL;
@@ -3589,9 +3781,56 @@ UnsignedInt GameLogic::getCRC( Int mode, AsciiString deepCRCFileName )
 	{
 		CRCGEN_LOG(("CRC for frame %d is 0x%8.8X\n", m_frame, theCRC));
 	}
+
+#ifdef DEBUG_CRC
+	if (g_verifyIncrementalCRC && usedCachedCRCs)
+	{
+		verifyCachedCRCs(theCRC);
+	}
+#endif // DEBUG_CRC
+
 	return theCRC;
 }
 
+// ------------------------------------------------------------------------------------------------
+/** -VerifyIncrementalCRC: recompute the CRC without any CachedCRC and make sure it is the one
+	we just got from the cached values. XferCRC::xferCachedSnapshot asserts on each stale cache
+	it finds along the way, and on a mismatch we write a deep CRC of the frame for diffing */
+// ------------------------------------------------------------------------------------------------
+void GameLogic::verifyCachedCRCs( UnsignedInt crc )
+{
+	UnsignedInt cachedSections[CRC_SECTION_COUNT];
+	Int i;
+	for (i = 0; i < CRC_SECTION_COUNT; ++i)
+		cachedSections[i] = m_crcSections[i];
+
+	UnsignedInt fullCRC;
+	{
+		LatchRestore<bool> latch(m_noCachedCRCs, TRUE);
+		fullCRC = getCRC(CRC_RECALC);
+	}
+
+	if (fullCRC != crc)
+	{
+		static const char *sectionNames[CRC_SECTION_COUNT] = { "Objects", "ThePartitionManager", "ThePlayerList", "TheAI" };
+		for (i = 0; i < CRC_SECTION_COUNT; ++i)
+		{
+			if (m_crcSections[i] != cachedSections[i])
+				break;
+		}
+		DEBUG_CRASH(("Cached CRC 0x%8.8X for frame %d is not the full CRC 0x%8.8X, first wrong at MARKER:%s\n",
+			crc, m_frame, fullCRC, (i < CRC_SECTION_COUNT) ? sectionNames[i] : "???"));
+
+		AsciiString deepCRCFileName;
+		deepCRCFileName.format("cachedCRCMismatch%d.crc", m_frame);
+		getCRC(CRC_RECALC, deepCRCFileName);
+	}
+
+	// keep the sections of the CRC we are actually going to use
+	for (i = 0; i < CRC_SECTION_COUNT; ++i)
+		m_crcSections[i] = cachedSections[i];
+}
+
 // ------------------------------------------------------------------------------------------------
 /** A new GameLogic object has been constructed, therefore create
  * a corresponding drawable and bind them together. */
@@ -3838,6 +4077,13 @@ TerrainLogic *GameLogic::createTerrainLogic( void )
 	return NEW TerrainLogic;
 }
 
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+AssetPrefetcher *GameLogic::createAssetPrefetcher( void )
+{
+	return NEW AssetPrefetcher;
+}
+
 // ------------------------------------------------------------------------------------------------
 void GameLogic::setBuildableStatusOverride(const ThingTemplate* tt, BuildableStatus bs)
 {
@@ -4137,13 +4383,16 @@ void GameLogic::prepareLogicForObjectLoad( void )
 	*		 this version breaks compatibility with previous versions. (CBD)
 	* 5: Added xfering the BuildAssistant's sell list.
 	* 9: Added m_rankPointsToAddAtGameStart, or else on a load game, your RestartGame button will forget your exp
+	* 10: Added m_nextSleepySequence
+	* 11: Added the pathfinder's queue & path cache
+	* 12: Removed m_nextSleepySequence
 	*/	
 // ------------------------------------------------------------------------------------------------
 void GameLogic::xfer( Xfer *xfer )
 {
 
 	// version
-	const XferVersion currentVersion = 9;
+	const XferVersion currentVersion = 12;
 	XferVersion version = currentVersion;
 	xfer->xferVersion( &version, currentVersion );
 
@@ -4456,6 +4705,20 @@ void GameLogic::xfer( Xfer *xfer )
 		xfer->xferInt(&m_rankPointsToAddAtGameStart);
 	}
 
+	// the sleepy update sequence numbers went with the sleepy update wheel.
+	if (version >= 10 && version < 12)
+	{
+		UnsignedInt nextSleepySequence = 0;
+		xfer->xferUnsignedInt(&nextSleepySequence);
+	}
+
+	// the pathfinder isn't a block of its own; its map was rebuilt above (see newMap), so this
+	// only restores what it was in the middle of.
+	if (version >= 11)
+	{
+		xfer->xferSnapshot( TheAI->pathfinder() );
+	}
+
 }  // end xfer
 
 // ------------------------------------------------------------------------------------------------
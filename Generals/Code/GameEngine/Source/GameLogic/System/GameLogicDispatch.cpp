@@ -451,7 +451,8 @@ void GameLogic::logicMessageDispatcher( GameMessage *msg, void *userData )
 			if (currentlySelectedGroup)
 				TheAI->destroyGroup(currentlySelectedGroup);
 			currentlySelectedGroup = NULL;
-			TheGameLogic->clearGameData();
+			// there is nobody to show the score screen to when running headless
+			TheGameLogic->clearGameData(!TheGlobalData->m_headless);
 			break;
 
 		}  // end clear game data
@@ -37,6 +37,7 @@
 #include "Common/MultiplayerSettings.h"
 #include "Common/PlayerTemplate.h"
 #include "Common/Xfer.h"
+#include "Common/XferCRC.h"
 #include "GameNetwork/FileTransfer.h"
 #include "GameNetwork/GameInfo.h"
 #include "GameNetwork/GameSpy/ThreadUtils.h"
@@ -78,6 +79,7 @@ void GameSlot::reset()
 	m_origPlayerTemplate = -1;
 	m_origStartPos = -1;
 	m_origColor = -1;
+	m_capabilities = 0;
 }
 
 void GameSlot::saveOffOriginalInfo( void )
@@ -303,6 +305,9 @@ void GameInfo::init( void )
 void GameInfo::reset( void )
 {
 	m_crcInterval = NET_CRC_INTERVAL;
+	// shared paths change where units go, so they're only on if the host asked for them (and everyone has them).
+	m_sharedPaths = TheGlobalData ? TheGlobalData->m_sharedPaths : FALSE;
+	m_slicedPathSearches = TheGlobalData ? TheGlobalData->m_slicedPathSearches : FALSE;
 	m_inGame = false;
 	m_inProgress = false;
 	m_gameID = 0;
@@ -686,6 +691,51 @@ void GameInfo::setSeed( Int seed )
 	m_seed = seed;
 }
 
+bool GameInfo::doAllPlayersHaveCapability( UnsignedInt capability ) const
+{
+	Int numHumans = 0;
+	for (Int i=0; i<MAX_SLOTS; ++i)
+	{
+		const GameSlot *slot = getConstSlot(i);
+		if (slot && slot->isHuman())
+		{
+			if ((slot->getCapabilities() & capability) != capability)
+				return FALSE;
+			++numHumans;
+		}
+	}
+	return numHumans > 0;
+}
+
+/** Every peer works this out from the same slot list, so they all agree on it.  A slot that
+	* didn't advertise the newer kernel (an older build, or a game from before slots advertised
+	* anything) keeps the whole game on the legacy one. */
+CRCKernel GameInfo::getCRCKernel( void ) const
+{
+	if (doAllPlayersHaveCapability(GAME_CAPABILITY_CRC_KERNEL_LANES))
+		return CRC_KERNEL_LANES;
+	return CRC_KERNEL_LEGACY;
+}
+
+/** The host asks for shared paths, but they're only on when every player can share them. */
+bool GameInfo::getSharedPaths( void ) const
+{
+	return m_sharedPaths && doAllPlayersHaveCapability(GAME_CAPABILITY_SHARED_PATHS);
+}
+
+/** Flow fields come with shared paths, but a player whose build shares paths without them would
+	* search where everyone else traces a field, so they need their own capability. */
+bool GameInfo::getFlowFields( void ) const
+{
+	return getSharedPaths() && doAllPlayersHaveCapability(GAME_CAPABILITY_FLOW_FIELDS);
+}
+
+/** Likewise for time sliced path searches. */
+bool GameInfo::getSlicedPathSearches( void ) const
+{
+	return m_slicedPathSearches && doAllPlayersHaveCapability(GAME_CAPABILITY_SLICED_PATH_SEARCHES);
+}
+
 void GameInfo::setSlotPointer( Int index, GameSlot *slot )
 {
 	if (index < 0 || index >= MAX_SLOTS)
@@ -882,6 +932,12 @@ bool GameInfo::isSandbox(void)
 
 static const char slotListID		= 'S';
 
+UnsignedInt GetLocalGameCapabilities( void )
+{
+	return GAME_CAPABILITY_CRC_KERNEL_LANES | GAME_CAPABILITY_SHARED_PATHS | GAME_CAPABILITY_SLICED_PATH_SEARCHES |
+		GAME_CAPABILITY_FLOW_FIELDS;
+}
+
 AsciiString GameInfoToAsciiString( const GameInfo *game )
 {
 	if (!game)
@@ -914,6 +970,24 @@ AsciiString GameInfoToAsciiString( const GameInfo *game )
 	AsciiString optionsString;
 	optionsString.format("M=%2.2x%s;MC=%X;MS=%d;SD=%d;C=%d;", game->getMapContentsMask(), newMapName.str(),
 		game->getMapCRC(), game->getMapSize(), game->getSeed(), game->getCRCInterval());
+	// older versions don't know CK, and use the legacy kernel when it's missing.  CK is only
+	// non-legacy when every player advertised the newer kernel, so none of them is that old.
+	if (game->getCRCKernel() != CRC_KERNEL_LEGACY)
+	{
+		AsciiString kernelString;
+		kernelString.format("CK=%d;", game->getCRCKernel());
+		optionsString.concat(kernelString);
+	}
+	// likewise SP, which is only set when every player can share paths; older versions never do.
+	if (game->getSharedPaths())
+	{
+		optionsString.concat("SP=1;");
+	}
+	// and SS, for time sliced path searches.
+	if (game->getSlicedPathSearches())
+	{
+		optionsString.concat("SS=1;");
+	}
 	optionsString.concat(slotListID);
 	optionsString.concat('=');
 	for (Int i=0; i<MAX_SLOTS; ++i)
@@ -924,13 +998,14 @@ AsciiString GameInfoToAsciiString( const GameInfo *game )
 		{
 			AsciiString name = WideCharStringToMultiByte(slot->getName().str()).c_str();
 			
-			str.format( "H%s,%X,%d,%c%c,%d,%d,%d,%d,%d:",
+			// the capabilities go last; older versions stop reading after the NAT behavior.
+			str.format( "H%s,%X,%d,%c%c,%d,%d,%d,%d,%d,%X:",
 				name.str(), slot->getIP(), slot->getPort(),
 				(slot->isAccepted()?'T':'F'),
 				(slot->hasMap()?'T':'F'),
 				slot->getColor(), slot->getPlayerTemplate(),
 				slot->getStartPos(), slot->getTeamNumber(),
-				slot->getNATBehavior() );
+				slot->getNATBehavior(), slot->getCapabilities() );
 		}
 		else if (slot && slot->isAI())
 		{
@@ -991,6 +1066,9 @@ bool ParseAsciiStringToGameInfo(GameInfo *game, AsciiString options)
 	Int seed = 0;
 	Int crc = 100;
 	bool sawCRC = FALSE;
+	Int crcKernel = CRC_KERNEL_LEGACY;
+	bool sharedPaths = FALSE;
+	bool slicedPathSearches = FALSE;
 
 	bool sawMap, sawMapCRC, sawMapSize, sawSeed, sawSlotlist;
 	sawMap = sawMapCRC = sawMapSize = sawSeed = sawSlotlist = FALSE;
@@ -1070,6 +1148,24 @@ bool ParseAsciiStringToGameInfo(GameInfo *game, AsciiString options)
 			crc = atoi(val.str());
 			sawCRC = TRUE;
 		}
+		else if (key.compare("CK") == 0)
+		{
+			crcKernel = atoi(val.str());
+			if (crcKernel < CRC_KERNEL_LEGACY || crcKernel >= CRC_KERNEL_COUNT)
+			{
+				optionsOk = false;
+				DEBUG_LOG(("ParseAsciiStringToGameInfo - CRC kernel %d is newer than ours, quitting\n", crcKernel));
+				break;
+			}
+		}
+		else if (key.compare("SP") == 0)
+		{
+			sharedPaths = (atoi(val.str()) != 0);
+		}
+		else if (key.compare("SS") == 0)
+		{
+			slicedPathSearches = (atoi(val.str()) != 0);
+		}
 		else if (key.getLength() == 1 && *key.str() == slotListID)
 		{
 			sawSlotlist = true;
@@ -1247,6 +1343,15 @@ bool ParseAsciiStringToGameInfo(GameInfo *game, AsciiString options)
 							}
 							newSlot[i].setNATBehavior(NATType);
 							DEBUG_LOG(("ParseAsciiStringToGameInfo - NAT behavior is %X\n", NATType));
+
+							// Read the capabilities, which older versions don't send
+							slotValue = strtok_r(NULL, ",",&slotPos);
+							UnsignedInt capabilities = 0;
+							if (slotValue.isNotEmpty())
+							{
+								sscanf(slotValue.str(), "%x", &capabilities);
+							}
+							newSlot[i].setCapabilities(capabilities);
 						}// case 'H':
 						break;
 						case 'C':
@@ -1428,6 +1533,13 @@ bool ParseAsciiStringToGameInfo(GameInfo *game, AsciiString options)
 		game->setMapContentsMask(mapContentsMask);
 		game->setSeed(seed);
 		game->setCRCInterval(crc);
+		// the kernel follows from the slots' capabilities; CK is there for older versions to refuse.
+		if (game->getCRCKernel() != crcKernel)
+		{
+			DEBUG_LOG(("ParseAsciiStringToGameInfo - CK=%d doesn't match the slots' kernel %d\n", crcKernel, game->getCRCKernel()));
+		}
+		game->setSharedPaths(sharedPaths);
+		game->setSlicedPathSearches(slicedPathSearches);
 
 		return true;
 	}
@@ -1450,17 +1562,48 @@ void SkirmishGameInfo::crc( Xfer *xfer )
 }  // end crc
 
 // ------------------------------------------------------------------------------------------------
-/** Xfer Method */
+/** Xfer Method
+	* Version Info:
+	* 2: slot names
+	* 3: m_crcKernel
+	* 4: m_sharedPaths
+	* 5: m_slicedPathSearches
+	* 6: slot capabilities, which the CRC kernel now follows from */
 // ------------------------------------------------------------------------------------------------
 void SkirmishGameInfo::xfer( Xfer *xfer )
 {
-	const XferVersion currentVersion = 2;	
+	const XferVersion currentVersion = 6;	
 	XferVersion version = currentVersion; 
 	xfer->xferVersion( &version, currentVersion );
 
 
 	xfer->xferInt(&m_preorderMask);
 	xfer->xferInt(&m_crcInterval);
+	Int crcKernel = getCRCKernel();
+	if (version >= 3)
+	{
+		xfer->xferInt(&crcKernel);
+	}
+	else
+	{
+		crcKernel = CRC_KERNEL_LEGACY;
+	}
+	if (version >= 4)
+	{
+		xfer->xferBool(&m_sharedPaths);
+	}
+	else
+	{
+		m_sharedPaths = FALSE;
+	}
+	if (version >= 5)
+	{
+		xfer->xferBool(&m_slicedPathSearches);
+	}
+	else
+	{
+		m_slicedPathSearches = FALSE;
+	}
 	xfer->xferBool(&m_inGame);
 	xfer->xferBool(&m_inProgress);
 	xfer->xferBool(&m_surrendered);
@@ -1509,6 +1652,21 @@ void SkirmishGameInfo::xfer( Xfer *xfer )
  		Int origPlayerTemplate=m_slot[slot]->getOriginalPlayerTemplate();
 		xfer->xferInt(&origPlayerTemplate);
 
+		UnsignedInt capabilities=m_slot[slot]->getCapabilities();
+		if (version >= 6)
+		{
+			xfer->xferUnsignedInt(&capabilities);
+		}
+		else
+		{
+			// before slots kept their capabilities, the game kept just its options.
+			capabilities = (crcKernel == CRC_KERNEL_LANES) ? GAME_CAPABILITY_CRC_KERNEL_LANES : 0;
+			if (m_sharedPaths)
+				capabilities |= GAME_CAPABILITY_SHARED_PATHS | GAME_CAPABILITY_FLOW_FIELDS;
+			if (m_slicedPathSearches)
+				capabilities |= GAME_CAPABILITY_SLICED_PATH_SEARCHES;
+		}
+
 		if( xfer->getXferMode() == XFER_LOAD ) {
 			m_slot[slot]->setState((SlotState)state, name);
 			if (isAccepted) m_slot[slot]->setAccept();
@@ -1522,6 +1680,7 @@ void SkirmishGameInfo::xfer( Xfer *xfer )
 			m_slot[slot]->setColor(color);
 			m_slot[slot]->setStartPos(startPos);
 			m_slot[slot]->setPlayerTemplate(playerTemplate);
+			m_slot[slot]->setCapabilities(capabilities);
 		}
 	}
 
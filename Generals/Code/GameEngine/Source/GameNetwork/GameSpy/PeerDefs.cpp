@@ -544,6 +544,7 @@ void GameSpyInfo::markAsStagingRoomHost( void )
 
 	m_localStagingRoom.setLocalIP(m_externalIP);
 	newSlot.setIP(m_externalIP);
+	newSlot.setCapabilities(GetLocalGameCapabilities());
 
 	m_localStagingRoom.setSlot(0,newSlot);
 	m_localStagingRoom.setLocalName(m_localName);
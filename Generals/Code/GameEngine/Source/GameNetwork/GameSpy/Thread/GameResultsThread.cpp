@@ -227,6 +227,8 @@ static void WrapHTTP( const std::string& hostname, std::string& results )
 
 void GameResultsThreadClass::Thread_Function()
 {
+	ScopedMemoryPoolThreadCache threadCache;	// hand our cached pool blocks back on the way out
+
 	try {
 	_set_se_translator( DumpExceptionInfo ); // Hook that allows stack trace.
 	GameResultsRequest req;
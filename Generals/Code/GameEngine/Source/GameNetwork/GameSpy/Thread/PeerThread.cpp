@@ -1158,6 +1158,8 @@ static UnsignedInt localIP = 0;
 
 void PeerThreadClass::Thread_Function()
 {
+	ScopedMemoryPoolThreadCache threadCache;	// hand our cached pool blocks back on the way out
+
 	try {
 	_set_se_translator( DumpExceptionInfo ); // Hook that allows stack trace.
 
@@ -827,6 +827,8 @@ static void getPreorderCallback(int localid, int profileid, persisttype_t type,
 
 void PSThreadClass::Thread_Function()
 {
+	ScopedMemoryPoolThreadCache threadCache;	// hand our cached pool blocks back on the way out
+
 	try {
 	_set_se_translator( DumpExceptionInfo ); // Hook that allows stack trace.
 	/*********
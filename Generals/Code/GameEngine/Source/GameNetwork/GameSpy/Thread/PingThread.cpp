@@ -247,6 +247,8 @@ AsciiString Pinger::getPingString( Int timeout )
 
 void PingThreadClass::Thread_Function()
 {
+	ScopedMemoryPoolThreadCache threadCache;	// hand our cached pool blocks back on the way out
+
 	try {
 	_set_se_translator( DumpExceptionInfo ); // Hook that allows stack trace.
 	PingRequest req;
@@ -640,6 +640,7 @@ void LANAPI::RequestGameJoin( LANGameInfo *game, UnsignedInt ip /* = 0 */ )
 	GetStringFromRegistry("\\ergc", "", s);
 	strncpy(msg.GameToJoin.serial, s.str(), g_maxSerialLength);
 	msg.GameToJoin.serial[g_maxSerialLength-1] = '\0';
+	msg.GameToJoin.capabilities = GetLocalGameCapabilities() | g_lanCapabilitiesTag;
 
 	sendMessage(&msg, ip);
 
@@ -913,6 +914,7 @@ void LANAPI::RequestGameCreate( UnicodeString gameName, bool isDirectConnect )
 	newSlot.setLastHeard(0);
 	newSlot.setLogin(m_userName);
 	newSlot.setHost(m_hostName);
+	newSlot.setCapabilities(GetLocalGameCapabilities());
 
 	myGame->setSlot(0,newSlot);
 	myGame->setNext(NULL);
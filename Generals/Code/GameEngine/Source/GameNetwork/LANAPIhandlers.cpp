@@ -347,6 +347,10 @@ void LANAPI::handleRequestJoin( LANMessage *msg, UnsignedInt senderIP )
 						newSlot.setPort(NETWORK_BASE_PORT_NUMBER);
 						newSlot.setLastHeard(timeGetTime());
 						newSlot.setSerial(msg->GameToJoin.serial);
+						if ((msg->GameToJoin.capabilities & g_lanCapabilitiesTagMask) == g_lanCapabilitiesTag)
+						{
+							newSlot.setCapabilities(msg->GameToJoin.capabilities & ~g_lanCapabilitiesTagMask);
+						}
 						m_currentGame->setSlot(player,newSlot);
 						DEBUG_LOG(("LANAPI::handleRequestJoin - added player %ls at ip 0x%08x to the game\n", msg->name, senderIP));
 
@@ -409,6 +413,7 @@ void LANAPI::handleJoinAccept( LANMessage *msg, UnsignedInt senderIP )
 				slot.setLastHeard(0);
 				slot.setLogin(m_userName);
 				slot.setHost(m_hostName);
+				slot.setCapabilities(GetLocalGameCapabilities());
 				m_currentGame->setSlot(pos, slot);
 
 				m_currentGame->getLANSlot(0)->setHost(msg->hostName);
@@ -0,0 +1,36 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include "Common/AssetPrefetcher.h"
+
+// TheSuperHackers @performance Looks through the .w3d files that are read ahead for the textures
+// their meshes and particle emitters name, and has those read through as well, so they are cached
+// by the time the texture loader opens them.
+
+class W3DAssetPrefetcher : public AssetPrefetcher
+{
+protected:
+	virtual bool isScannedFile(const char *path) const;
+	virtual void scanFile(const char *data, Int size);
+	virtual void queueFoundFile(const char *name);
+
+private:
+	void scanChunks(const char *data, Int size, Int depth);
+	void foundName(const char *name, Int maxLength);
+};
@@ -319,6 +319,7 @@ public:
 	// ugh, hack
 	virtual const W3DModelDrawModuleData* getAsW3DModelDrawModuleData() const { return this; }
 	virtual StaticGameLODLevel getMinimumRequiredGameLOD() const { return m_minLODRequired;}
+	virtual void getAssetFilenames( FilenameList &filenames ) const;
 
 private:
 	static void parseConditionState( INI* ini, void *instance, void * /*store*/, const void* /*userData*/ );
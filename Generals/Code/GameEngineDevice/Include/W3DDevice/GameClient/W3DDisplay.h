@@ -144,6 +144,8 @@ public:
 	static RTS3DInterfaceScene *m_3DInterfaceScene;	///< our 3d interface scene that draws last (for 3d mouse cursor, etc)
 	static W3DAssetManager *m_assetManager;		///< W3D asset manager
 
+	static void initScenesAndAssets( void );	///< create the file system, scenes and asset manager
+
 	void drawFPSStats( void );								///< draw the fps on the screen
 	virtual Real getAverageFPS( void );								///< return the average FPS.
 	virtual Int getLastFrameDrawCalls( void );				///< returns the number of draw calls issued in the previous frame
@@ -199,4 +201,20 @@ protected:
 
 };  // end W3DDisplay
 
+//=============================================================================
+/** The display used when running headless. It brings up WW3D without a render
+	* device, keeping the scenes and asset manager so that drawables still load
+	* their models and the logic still gets the bones it reads from them. */
+class W3DDisplayDummy : public DisplayDummy
+{
+
+public:
+	W3DDisplayDummy();
+	~W3DDisplayDummy();
+
+	virtual void init( void );
+	virtual void reset( void );
+
+};  // end W3DDisplayDummy
+
 #endif  // end __W3DDISPLAY_H_
@@ -40,6 +40,7 @@
 // SYSTEM INCLUDES ////////////////////////////////////////////////////////////
 
 // USER INCLUDES //////////////////////////////////////////////////////////////
+#include "Common/GlobalData.h"
 #include "GameClient/GameClient.h"
 #include "W3DDevice/GameClient/W3DParticleSys.h"
 #include "W3DDevice/GameClient/W3DDisplay.h"
@@ -96,7 +97,7 @@ protected:
 	virtual Mouse *createMouse( void );											///< factory for the mouse
 
 	/// factory for creating TheDisplay
-	virtual Display *createGameDisplay( void ) { return NEW W3DDisplay; }
+	virtual Display *createGameDisplay( void );
 
 	/// factory for creating TheInGameUI
 	virtual InGameUI *createInGameUI( void ) { return NEW W3DInGameUI; }	
@@ -126,5 +127,11 @@ inline Mouse *W3DGameClient::createMouse( void )
 	TheWin32Mouse = mouse;   ///< global cheat for the WndProc()
 	return mouse;
 }
+inline Display *W3DGameClient::createGameDisplay( void )
+{
+	if (TheGlobalData->m_headless)
+		return NEW W3DDisplayDummy;
+	return NEW W3DDisplay;
+}
 
 #endif  // end __W3DGAMEINTERFACE_H_
@@ -40,6 +40,7 @@
 
 // USER INCLUDES //////////////////////////////////////////////////////////////
 #include "GameLogic/GameLogic.h"
+#include "W3DDevice/Common/W3DAssetPrefetcher.h"
 #include "W3DDevice/GameLogic/W3DTerrainLogic.h"
 #include "W3DDevice/GameLogic/W3DGhostObject.h"
 
@@ -63,6 +64,7 @@ protected:
 	/// factory for TheTerrainLogic, called from init()
 	virtual TerrainLogic *createTerrainLogic( void ) { return NEW W3DTerrainLogic; };
 	virtual GhostObjectManager *createGhostObjectManager(void) { return NEW W3DGhostObjectManager; }
+	virtual AssetPrefetcher *createAssetPrefetcher( void ) { return NEW W3DAssetPrefetcher; }
 
 };  // end class W3DGameLogic
 
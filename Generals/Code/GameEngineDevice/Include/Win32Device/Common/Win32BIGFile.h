@@ -38,21 +38,25 @@
 class Win32BIGFile : public ArchiveFile
 {
 	public:
-		Win32BIGFile();
+		Win32BIGFile(const AsciiString& name);
 		virtual ~Win32BIGFile();
 
 		virtual bool					getFileInfo(const AsciiString& filename, FileInfo *fileInfo) const;	///< fill in the fileInfo struct with info about the requested file.
 		virtual File*					openFile( const Char *filename, Int access = 0 );///< Open the specified file within the BIG file
+		virtual bool					readFileData( const ArchivedFileInfo *fileInfo, char *buffer );	///< Copy the data of one of our files into buffer. Safe to call from any thread.
 		virtual void					closeAllFiles( void );									///< Close all file opened in this BIG file
 		virtual AsciiString		getName( void );												///< Returns the name of the BIG file
 		virtual AsciiString		getPath( void );												///< Returns full path and name of BIG file
 		virtual void					setSearchPriority( Int new_priority );	///< Set this BIG file's search priority
 		virtual void					close( void );													///< Close this BIG file
+		virtual const char*		mapData( void );												///< Map the whole BIG file into memory, the first time one of its files is opened
 
 	protected:
 
 		AsciiString		m_name;		///< BIG file name
 		AsciiString		m_path;		///< BIG file path
+		void* volatile	m_readHandle;	///< our own handle to the BIG file for readFileData(), opened when it is first needed
+		bool					m_mapTried;		///< mapData() has tried to map the BIG file, whether it could or not
 };
 
 #endif // __WIN32BIGFILE_H
\ No newline at end of file
@@ -0,0 +1,124 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "W3DDevice/Common/W3DAssetPrefetcher.h"
+
+#include "WWLib/chunkio.h"
+#include "WW3D2/w3d_file.h"
+
+// Deep enough for any mesh or emitter, and keeps a broken file from running down the worker's stack.
+static const Int MAX_CHUNK_DEPTH = 8;
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+bool W3DAssetPrefetcher::isScannedFile(const char *path) const
+{
+	Int len = strlen(path);
+	return len > 4 && stricmp(path + len - 4, ".w3d") == 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+void W3DAssetPrefetcher::scanFile(const char *data, Int size)
+{
+	scanChunks(data, size, 0);
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Pass on the name of every texture in the chunks in data. The file hasn't been checked by anyone
+	* yet, so nothing is read past the end of the chunk it's in. */
+//-------------------------------------------------------------------------------------------------
+void W3DAssetPrefetcher::scanChunks(const char *data, Int size, Int depth)
+{
+	while (size >= (Int)sizeof(ChunkHeader))
+	{
+		ChunkHeader header;
+		memcpy(&header, data, sizeof(header));
+		data += sizeof(header);
+		size -= sizeof(header);
+
+		Int chunkSize = (Int)header.Get_Size();
+		if (chunkSize > size)
+			return;	// not a chunk, or the file is cut short
+
+		switch (header.Get_Type())
+		{
+			case W3D_CHUNK_TEXTURE_NAME:
+				foundName(data, chunkSize);
+				break;
+
+			case W3D_CHUNK_EMITTER_INFO:
+				if (chunkSize >= (Int)sizeof(W3dEmitterInfoStruct))
+				{
+					const W3dEmitterInfoStruct *info = (const W3dEmitterInfoStruct *)data;
+					foundName(info->TextureFilename, sizeof(info->TextureFilename));
+				}
+				break;
+
+			// the chunks the texture names are in, older files don't always say they hold other chunks
+			case W3D_CHUNK_MESH:
+			case W3D_CHUNK_PRELIT_UNLIT:
+			case W3D_CHUNK_PRELIT_VERTEX:
+			case W3D_CHUNK_PRELIT_LIGHTMAP_MULTI_PASS:
+			case W3D_CHUNK_PRELIT_LIGHTMAP_MULTI_TEXTURE:
+			case W3D_CHUNK_TEXTURES:
+			case W3D_CHUNK_TEXTURE:
+			case W3D_CHUNK_EMITTER:
+				if (depth < MAX_CHUNK_DEPTH)
+					scanChunks(data, chunkSize, depth + 1);
+				break;
+
+			default:
+				if (header.Get_Sub_Chunk_Flag() && depth < MAX_CHUNK_DEPTH)
+					scanChunks(data, chunkSize, depth + 1);
+				break;
+		}
+
+		data += chunkSize;
+		size -= chunkSize;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Pass on the zero terminated name at the start of the maxLength bytes at name, if it is one. */
+//-------------------------------------------------------------------------------------------------
+void W3DAssetPrefetcher::foundName(const char *name, Int maxLength)
+{
+	const char *end = (const char *)memchr(name, 0, maxLength);
+	if (end != NULL && end != name && end - name < _MAX_PATH - (Int)strlen(TGA_DIR_PATH))
+		foundFile(name, (Int)(end - name));
+}
+
+//-------------------------------------------------------------------------------------------------
+/** The texture loader goes for the .dds of a texture before the .tga the model names, so read
+	* through the one it will find. */
+//-------------------------------------------------------------------------------------------------
+void W3DAssetPrefetcher::queueFoundFile(const char *name)
+{
+	AsciiString path;
+	path.format("%s%s", TGA_DIR_PATH, name);
+
+	const char *extension = path.reverseFind('.');
+	if (extension != NULL)
+	{
+		AsciiString ddsPath;
+		ddsPath.format("%.*s.dds", (Int)(extension - path.str()), path.str());
+		if (warmFile(ddsPath))
+			return;
+	}
+	warmFile(path);
+}
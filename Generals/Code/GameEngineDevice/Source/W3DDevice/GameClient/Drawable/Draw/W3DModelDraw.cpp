@@ -1112,6 +1112,28 @@ void W3DModelDrawModuleData::preloadAssets( TimeOfDay timeOfDay, Real scale ) co
 
 }
 
+//-------------------------------------------------------------------------------------------------
+/** Only the models themselves; the animations and textures they use aren't known until they are loaded */
+//-------------------------------------------------------------------------------------------------
+void W3DModelDrawModuleData::getAssetFilenames( FilenameList &filenames ) const
+{
+
+	for( ModelConditionVector::const_iterator it = m_conditionStates.begin(); 
+			 it != m_conditionStates.end(); 
+			 ++it )
+	{
+
+		if( it->m_modelName.isNotEmpty() )
+		{
+			AsciiString filename;
+			filename.format( "%s%s.w3d", W3D_DIR_PATH, it->m_modelName.str() );
+			filenames.insert( filename );
+		}
+
+	}
+
+}
+
 //-------------------------------------------------------------------------------------------------
 AsciiString W3DModelDrawModuleData::getBestModelNameForWB(const ModelConditionFlags& c) const
 {
@@ -1333,7 +1333,8 @@ HeightMapRenderObjClass::HeightMapRenderObjClass(void)
 	m_waypointBuffer = NEW W3DWaypointBuffer;
 #ifdef DO_ROADS
 	m_roadBuffer = NULL;
-	m_roadBuffer = NEW W3DRoadBuffer;
+	if (!TheGlobalData->m_headless)
+		m_roadBuffer = NEW W3DRoadBuffer;
 #endif
 #ifdef DO_SCORCH
 	m_vertexScorch = NULL;
@@ -1342,12 +1343,15 @@ HeightMapRenderObjClass::HeightMapRenderObjClass(void)
 	clearAllScorches();
 #endif
 #if defined(RTS_DEBUG) || defined(RTS_INTERNAL)
-	if (TheGlobalData->m_shroudOn)
+	if (TheGlobalData->m_shroudOn && !TheGlobalData->m_headless)
 		m_shroud = NEW W3DShroud;
 	else
 		m_shroud = NULL;
 #else
-	m_shroud = NEW W3DShroud;
+	if (!TheGlobalData->m_headless)
+		m_shroud = NEW W3DShroud;
+	else
+		m_shroud = NULL;
 #endif
 	DX8Wrapper::SetCleanupHook(this);
 }
@@ -2571,7 +2575,8 @@ Int HeightMapRenderObjClass::initHeightData(Int x, Int y, WorldHeightMap *pMap,
 	if (m_shroud)
 		m_shroud->init(m_map,TheGlobalData->m_partitionCellSize,TheGlobalData->m_partitionCellSize);
 #ifdef DO_ROADS
-	m_roadBuffer->setMap(m_map);
+	if (m_roadBuffer)
+		m_roadBuffer->setMap(m_map);
 #endif
 	HeightSampleType *data = NULL;
 	if (pMap) {
@@ -2601,6 +2606,13 @@ Int HeightMapRenderObjClass::initHeightData(Int x, Int y, WorldHeightMap *pMap,
 		m_minHeight = minHt * MAP_HEIGHT_SCALE;
 		m_maxHeight = maxHt * MAP_HEIGHT_SCALE;
 
+		// headless keeps only the heights the logic reads; there is nothing to render into.
+		if (TheGlobalData->m_headless)
+		{
+			m_halfResMesh = TheGlobalData->m_useHalfHeightMap;
+			return 0;
+		}
+
 		if (!m_extraBlendTilePositions)
 		{	//Need to allocate memory
 			m_extraBlendTilePositions = NEW Int[DEFAULT_MAX_MAP_EXTRABLEND_TILES];
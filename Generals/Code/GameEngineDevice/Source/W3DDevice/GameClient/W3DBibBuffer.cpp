@@ -218,7 +218,8 @@ W3DBibBuffer::W3DBibBuffer(void)
 	clearAllBibs();
 	m_indexBibSize = INITIAL_BIB_INDEX;
 	m_vertexBibSize = INITIAL_BIB_VERTEX;
-	allocateBibBuffers();
+	if (!TheGlobalData->m_headless)
+		allocateBibBuffers();	// no render device to allocate in when headless
 
 	m_bibTexture = NEW_REF(TextureClass, ("TBBib.tga"));
 	m_highlightBibTexture = NEW_REF(TextureClass, ("TBRedBib.tga"));
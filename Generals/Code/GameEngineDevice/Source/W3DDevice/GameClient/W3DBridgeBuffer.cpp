@@ -729,7 +729,8 @@ W3DBridgeBuffer::W3DBridgeBuffer(void)
 	m_curNumBridgeVertices=0;
 	m_curNumBridgeIndices=0;
 	clearAllBridges();
-	allocateBridgeBuffers();
+	if (!TheGlobalData->m_headless)
+		allocateBridgeBuffers();	// no render device to allocate in when headless
 	m_initialized = true;
 }
 
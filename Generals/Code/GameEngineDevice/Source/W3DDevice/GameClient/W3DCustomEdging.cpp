@@ -290,7 +290,8 @@ W3DCustomEdging::W3DCustomEdging(void)
 	m_vertexEdging = NULL;
 	m_indexEdging = NULL;
 	clearAllEdging();
-	allocateEdgingBuffers();
+	if (!TheGlobalData->m_headless)
+		allocateEdgingBuffers();	// no render device to allocate in when headless
 	m_initialized = true;
 }
 
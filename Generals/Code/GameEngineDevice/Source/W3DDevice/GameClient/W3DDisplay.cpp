@@ -351,27 +351,13 @@ void W3DDisplay::init2DScene( void )
 
 }  // end init2DScene
 
-// W3DDisplay::init ===========================================================
-/** Initialize or re-initialize the W3D display system.  Here we need to
-  * create our window, and get our 3D hardware setup and online */
+// W3DDisplay::initScenesAndAssets ============================================
+/** Create the W3D file system, the scenes and the asset manager. None of these
+	* touch the render device, so the headless display shares them with the real one. */
 //=============================================================================
-void W3DDisplay::init( void )
+void W3DDisplay::initScenesAndAssets( void )
 {
 
-	//
-	// call our base class init, this method should be able to handle re-entry
-	// with its own logic
-	//
-	Display::init();
-
-	// handle re-entry for ourselves
-	if( m_initialized )
-	{
-
-		/// @todo W3DDisplay needs RE-init logic!
-		return;
-
-	}  // end if
 	// Override the W3D File system
 	TheW3DFileSystem = NEW W3DFileSystem;
 
@@ -392,6 +378,39 @@ void W3DDisplay::init( void )
 	if( TheGlobalData->m_wireframe )
 		m_3DScene->Set_Polygon_Mode( SceneClass::LINE );
 #endif
+
+	// create a new asset manager
+	m_assetManager = NEW W3DAssetManager;
+	m_assetManager->Register_Prototype_Loader(&_ParticleEmitterLoader );
+	m_assetManager->Register_Prototype_Loader(&_AggregateLoader);
+	m_assetManager->Set_WW3D_Load_On_Demand( true );
+
+}  // end initScenesAndAssets
+
+// W3DDisplay::init ===========================================================
+/** Initialize or re-initialize the W3D display system.  Here we need to
+  * create our window, and get our 3D hardware setup and online */
+//=============================================================================
+void W3DDisplay::init( void )
+{
+
+	//
+	// call our base class init, this method should be able to handle re-entry
+	// with its own logic
+	//
+	Display::init();
+
+	// handle re-entry for ourselves
+	if( m_initialized )
+	{
+
+		/// @todo W3DDisplay needs RE-init logic!
+		return;
+
+	}  // end if
+
+	initScenesAndAssets();
+
 //============================================================================
 	// m_myLight = NEW_REF
 //============================================================================
@@ -404,13 +423,6 @@ void W3DDisplay::init( void )
 	for (lindex=0; lindex<TheGlobalData->m_numGlobalLights; lindex++) 
 		m_3DScene->setGlobalLight( m_myLight[lindex], lindex );
 
-	// create a new asset manager
-	m_assetManager = NEW W3DAssetManager;	
-	m_assetManager->Register_Prototype_Loader(&_ParticleEmitterLoader );
-	m_assetManager->Register_Prototype_Loader(&_AggregateLoader);
-	m_assetManager->Set_WW3D_Load_On_Demand( true );
-
-
 	if (TheGlobalData->m_incrementalAGPBuf)
 	{
 		SortingRendererClass::SetMinVertexBufferSize(1);
@@ -2720,3 +2732,89 @@ static void drawFramerateBar(void)
 	TheDisplay->drawFillRect(1, 1, width, 15, colorToUse);
 	prevTime = now;
 }
+
+// W3DDisplayDummy::W3DDisplayDummy ===========================================
+/** */
+//=============================================================================
+W3DDisplayDummy::W3DDisplayDummy()
+{
+
+	W3DDisplay::m_assetManager = NULL;
+	W3DDisplay::m_3DScene = NULL;
+	W3DDisplay::m_2DScene = NULL;
+	W3DDisplay::m_3DInterfaceScene = NULL;
+
+}  // end W3DDisplayDummy
+
+// W3DDisplayDummy::~W3DDisplayDummy ==========================================
+/** */
+//=============================================================================
+W3DDisplayDummy::~W3DDisplayDummy()
+{
+
+	// the views hold W3D objects, free them before we shutdown W3D
+	Display::deleteViews();
+
+	REF_PTR_RELEASE( W3DDisplay::m_3DScene );
+	REF_PTR_RELEASE( W3DDisplay::m_2DScene );
+	REF_PTR_RELEASE( W3DDisplay::m_3DInterfaceScene );
+
+	if( W3DDisplay::m_assetManager )
+	{
+		W3DDisplay::m_assetManager->Free_Assets();
+		delete W3DDisplay::m_assetManager;
+		W3DDisplay::m_assetManager = NULL;
+	}
+	WW3D::Shutdown();
+	WWMath::Shutdown();
+	delete TheW3DFileSystem;
+	TheW3DFileSystem = NULL;
+
+}  // end ~W3DDisplayDummy
+
+// W3DDisplayDummy::init ======================================================
+/** Bring up WW3D in lite mode: no D3D interface, no render device and no
+	* texture loading. Models still load on demand through the asset manager. */
+//=============================================================================
+void W3DDisplayDummy::init( void )
+{
+
+	Display::init();
+
+	W3DDisplay::initScenesAndAssets();
+
+	if (WW3D::Init( ApplicationHWnd, NULL, true ) != WW3D_ERROR_OK)
+		throw ERROR_INVALID_D3D;
+
+	WW3D::Enable_Texturing( false );
+	WW3D::Set_Prelit_Mode( WW3D::PRELIT_MODE_LIGHTMAP_MULTI_PASS );
+
+	// the tactical view sizes itself from the display
+	setWidth( TheGlobalData->m_xResolution );
+	setHeight( TheGlobalData->m_yResolution );
+	setBitDepth( W3D_DISPLAY_DEFAULT_BIT_DEPTH );
+
+}  // end init
+
+// W3DDisplayDummy::reset =====================================================
+/** Remove the objects of the previous map from the scene. */
+//=============================================================================
+void W3DDisplayDummy::reset( void )
+{
+
+	Display::reset();
+
+	SceneIterator *sceneIter = W3DDisplay::m_3DScene->Create_Iterator();
+	sceneIter->First();
+	while(!sceneIter->Is_Done()) {
+		RenderObjClass * robj = sceneIter->Current_Item();
+		robj->Add_Ref();
+		W3DDisplay::m_3DScene->Remove_Render_Object(robj);
+		robj->Release_Ref();
+		sceneIter->Next();
+	}
+	W3DDisplay::m_3DScene->Destroy_Iterator(sceneIter);
+
+	W3DDisplay::m_assetManager->Release_Unused_Assets();
+
+}  // end reset
@@ -74,6 +74,7 @@ public:
 
 void MouseThreadClass::Thread_Function()
 {
+	ScopedMemoryPoolThreadCache threadCache;	// hand our cached pool blocks back on the way out
 
 	//poll mouse and update position
 
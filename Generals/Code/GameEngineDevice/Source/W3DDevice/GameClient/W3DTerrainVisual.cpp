@@ -108,6 +108,12 @@ void W3DTerrainVisual::init( void )
 	m_terrainRenderObject = NEW_REF( HeightMapRenderObjClass, () );
 	m_terrainRenderObject->Set_Collision_Type( PICK_TYPE_TERRAIN );
 	TheTerrainRenderObject = m_terrainRenderObject;
+	m_isWaterGridRenderingEnabled = FALSE;
+
+	// with no render device there are no tracks, shadows or water to draw. The terrain
+	// render object is still needed, it holds the heights and bridges the logic reads.
+	if (TheGlobalData->m_headless)
+		return;
 
 	// initialize track drawing system
 	TheTerrainTracksRenderObjClassSystem = NEW TerrainTracksRenderObjClassSystem;
@@ -26,19 +26,54 @@
 // Bryan Cleveland, August 2002
 /////////////////////////////////////////////////////
 
+#include <windows.h>
+#include "Common/AssetPrefetcher.h"
 #include "Common/LocalFile.h"
 #include "Common/LocalFileSystem.h"
 #include "Common/RAMFile.h"
 #include "Common/StreamingArchiveFile.h"
 #include "Common/GameMemory.h"
+#include "Common/GlobalData.h"
 #include "Common/PerfTimer.h"
 #include "Win32Device/Common/Win32BIGFile.h"
 
+// Mapping a BIG file takes as much address space as the file is big, and the game is a 32 bit
+// process with all of its BIG files open at once. So a BIG file is only mapped once a file is
+// opened out of it, which leaves out the ones only ever streamed from, and only up to
+// TheGlobalData->m_maxMappedBIGFileMB of them are. The BIG files past that are read through
+// their file like before.
+static volatile LONG TheMappedBIGFileBytes = 0;
+
+//============================================================================
+// MappedBIGFileData
+//============================================================================
+/** The view of a whole BIG file. It stays mapped until the BIG file and the last of the RAM files
+	* looking into it are closed. */
+class MappedBIGFileData : public SharedArchiveData
+{
+public:
+	MappedBIGFileData(void *view, Int size) : SharedArchiveData((const char *)view, size)
+	{
+		InterlockedExchangeAdd(&TheMappedBIGFileBytes, size);
+	}
+
+protected:
+	virtual ~MappedBIGFileData()
+	{
+		UnmapViewOfFile((void *)m_data);
+		InterlockedExchangeAdd(&TheMappedBIGFileBytes, -m_size);
+	}
+};
+
 //============================================================================
 // Win32BIGFile::Win32BIGFile
 //============================================================================
 
-Win32BIGFile::Win32BIGFile()
+Win32BIGFile::Win32BIGFile(const AsciiString& name) :
+	m_name(name),
+	m_path(name),
+	m_readHandle(INVALID_HANDLE_VALUE),
+	m_mapTried(FALSE)
 {
 
 }
@@ -49,7 +84,53 @@ Win32BIGFile::Win32BIGFile()
 
 Win32BIGFile::~Win32BIGFile()
 {
+	if (m_readHandle != INVALID_HANDLE_VALUE) {
+		CloseHandle(m_readHandle);
+		m_readHandle = INVALID_HANDLE_VALUE;
+	}
+}
+
+//============================================================================
+// Win32BIGFile::mapData
+//============================================================================
+
+const char* Win32BIGFile::mapData( void )
+{
+	// the budget isn't known until GameData.ini is read, until then the file is read like before
+	if (m_data != NULL || m_mapTried || m_file == NULL || TheGlobalData == NULL) {
+		return m_data;
+	}
+	m_mapTried = TRUE;
+
+	Int size = m_file->size();
+	Int maxBytes = min(TheGlobalData->m_maxMappedBIGFileMB, 2047) * 1024 * 1024;
+	if (size <= 0 || size > maxBytes - TheMappedBIGFileBytes) {
+		DEBUG_LOG(("Win32BIGFile::mapData - not mapping %s, %d bytes are mapped already\n", m_path.str(), TheMappedBIGFileBytes));
+		return NULL;
+	}
+
+	HANDLE file = CreateFile(m_path.str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE) {
+		return NULL;
+	}
+
+	// the view keeps the mapping and the file open by itself
+	HANDLE mapping = CreateFileMapping(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	CloseHandle(file);
+	if (mapping == NULL) {
+		return NULL;
+	}
+
+	void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping);
+	if (view == NULL) {
+		DEBUG_LOG(("Win32BIGFile::mapData - could not map %s\n", m_path.str()));
+		return NULL;
+	}
+
+	attachData(NEW MappedBIGFileData(view, size));
 
+	return m_data;
 }
 
 //============================================================================
@@ -58,7 +139,7 @@ Win32BIGFile::~Win32BIGFile()
 
 File* Win32BIGFile::openFile( const Char *filename, Int access ) 
 {
-	const ArchivedFileInfo *fileInfo = getArchivedFileInfo(AsciiString(filename));
+	const ArchivedFileInfo *fileInfo = m_files.find(filename);
 
 	if (fileInfo == NULL) {
 		return NULL;
@@ -71,8 +152,30 @@ File* Win32BIGFile::openFile( const Char *filename, Int access )
 	else 
 		ramFile = newInstance( RAMFile );
 
+	// the file is named by the last part of its path, in lower case
+	const char *name = filename;
+	for (const char *c = filename; *c != 0; ++c) {
+		if (*c == '\\' || *c == '/') {
+			name = c + 1;
+		}
+	}
+	AsciiString ramFileName = name;
+	ramFileName.toLower();
+
+	// if the BIG file is mapped, the RAM file looks straight into the mapping rather than seeking
+	// and reading. Otherwise, if the file was read ahead, the RAM file takes that data over
+	bool opened;
+	char *prefetchedData = NULL;
+	Int prefetchedSize = 0;
+	if (!BitIsSet(access, File::STREAMING) && mapData() != NULL && getFileDataInMemory(fileInfo) != NULL)
+		opened = ramFile->openFromSharedData(m_sharedData, ramFileName, fileInfo->m_offset, fileInfo->m_size);
+	else if (!BitIsSet(access, File::STREAMING) && TheAssetPrefetcher != NULL && TheAssetPrefetcher->takeFile(filename, &prefetchedData, &prefetchedSize))
+		opened = ramFile->openFromBuffer(prefetchedData, ramFileName, prefetchedSize);
+	else
+		opened = ramFile->openFromArchive(m_file, ramFileName, fileInfo->m_offset, fileInfo->m_size);
+
 	ramFile->deleteOnClose();
-	if (ramFile->openFromArchive(m_file, fileInfo->m_filename, fileInfo->m_offset, fileInfo->m_size) == FALSE) {
+	if (opened == FALSE) {
 		ramFile->close();
 		ramFile = NULL;
 		return NULL;
@@ -97,6 +200,46 @@ File* Win32BIGFile::openFile( const Char *filename, Int access )
 	return localFile;
 }
 
+//============================================================================
+// Win32BIGFile::readFileData
+//============================================================================
+
+bool Win32BIGFile::readFileData( const ArchivedFileInfo *fileInfo, char *buffer )
+{
+	if (fileInfo == NULL || buffer == NULL) {
+		return FALSE;
+	}
+
+	const char *data = getFileDataInMemory(fileInfo);
+	if (data != NULL) {
+		memcpy(buffer, data, fileInfo->m_size);
+		return TRUE;
+	}
+
+	// m_file belongs to the main thread and has a read position of its own, so any other thread reads
+	// through a handle of ours, giving each read its offset instead of seeking
+	if (m_readHandle == INVALID_HANDLE_VALUE) {
+		HANDLE handle = CreateFile(m_path.str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+		if (handle == INVALID_HANDLE_VALUE) {
+			return FALSE;
+		}
+		if (InterlockedCompareExchangePointer(&m_readHandle, handle, INVALID_HANDLE_VALUE) != INVALID_HANDLE_VALUE) {
+			CloseHandle(handle);	// another thread got there first
+		}
+	}
+
+	OVERLAPPED overlapped;
+	memset(&overlapped, 0, sizeof(overlapped));
+	overlapped.Offset = fileInfo->m_offset;
+
+	DWORD bytesRead = 0;
+	if (!ReadFile(m_readHandle, buffer, fileInfo->m_size, &bytesRead, &overlapped)) {
+		return FALSE;
+	}
+
+	return bytesRead == fileInfo->m_size;
+}
+
 //============================================================================
 // Win32BIGFile::closeAllFiles
 //============================================================================
@@ -30,6 +30,7 @@
 #include "Common/AudioAffect.h"
 #include "Common/ArchiveFile.h"
 #include "Common/ArchiveFileSystem.h"
+#include "Common/ArchiveIndexCache.h"
 #include "Common/file.h"
 #include "Common/GameAudio.h"
 #include "Common/GameMemory.h"
@@ -71,14 +72,9 @@ void Win32BIGFileSystem::postProcessLoad() {
 
 ArchiveFile * Win32BIGFileSystem::openArchiveFile(const Char *filename) {
 	File *fp = TheLocalFileSystem->openFile(filename, File::READ | File::BINARY);
-	AsciiString archiveFileName;
-	archiveFileName = filename;
-	archiveFileName.toLower();
 	Int archiveFileSize = 0;
 	Int numLittleFiles = 0;
 
-	ArchiveFile *archiveFile = NEW Win32BIGFile;
-
 	DEBUG_LOG(("Win32BIGFileSystem::openArchiveFile - opening BIG file %s\n", filename));
 
 	if (fp == NULL) {
@@ -86,85 +82,100 @@ ArchiveFile * Win32BIGFileSystem::openArchiveFile(const Char *filename) {
 		return NULL;
 	}
 
-	AsciiString asciibuf;
-	char buffer[_MAX_PATH];
-	fp->read(buffer, 4); // read the "BIG" at the beginning of the file.
-	buffer[4] = 0;
-	if (strcmp(buffer, BIGFileIdentifier) != 0) {
+	Win32BIGFile *archiveFile = NEW Win32BIGFile(AsciiString(filename));
+
+	//
+	// the directory listing is parsed out of memory. the header says how big the listing is, so it
+	// is read in one go. the BIG file itself is only mapped once a file is opened out of it.
+	// if the BIG file hasn't changed since the last run, the listing from then is used instead.
+	//
+	Int size = fp->size();
+	char *headerBuffer = NULL;
+	const char *header = NULL;
+	Int headerSize = size;
+	char start[ArchiveIndexCache::HEADER_SIZE];
+	if (fp->read(start, sizeof(start)) != sizeof(start)) {
+		DEBUG_CRASH(("Error reading BIG file header in file %s", filename));
+		fp->close();
+		delete archiveFile;
+		return NULL;
+	}
+
+	if (TheArchiveIndexCache != NULL && TheArchiveIndexCache->find(AsciiString(filename), start, archiveFile)) {
+		DEBUG_LOG(("Win32BIGFileSystem::openArchiveFile - directory listing of %s is cached\n", filename));
+		archiveFile->attachFile(fp);
+		return archiveFile;
+	}
+
+	// the offset of the first file is the size of the header and directory listing together.
+	memcpy(&headerSize, start + 0x0C, 4);
+	headerSize = ntohl(headerSize);
+	if (headerSize < 0x10 || headerSize > size) {
+		headerSize = size;
+	}
+
+	headerBuffer = NEW char[headerSize];
+	fp->seek(0, File::START);
+	headerSize = fp->read(headerBuffer, headerSize);
+	header = headerBuffer;
+
+	if (headerSize < 0x10 || memcmp(header, BIGFileIdentifier, 4) != 0) {
 		DEBUG_CRASH(("Error reading BIG file identifier in file %s", filename));
+		delete [] headerBuffer;
 		fp->close();
-		fp = NULL;
+		delete archiveFile;
 		return NULL;
 	}
 
 	// read in the file size.
-	fp->read(&archiveFileSize, 4);
+	memcpy(&archiveFileSize, header + 4, 4);
 
 	DEBUG_LOG(("Win32BIGFileSystem::openArchiveFile - size of archive file is %d bytes\n", archiveFileSize));
 
-//	char t;
-
 	// read in the number of files contained in this BIG file.
 	// change the order of the bytes cause the file size is in reverse byte order for some reason.
-	fp->read(&numLittleFiles, 4);
+	memcpy(&numLittleFiles, header + 8, 4);
 	numLittleFiles = ntohl(numLittleFiles);
 
 	DEBUG_LOG(("Win32BIGFileSystem::openArchiveFile - %d are contained in archive\n", numLittleFiles));
-//	for (Int i = 0; i < 2; ++i) {
-//		t = buffer[i];
-//		buffer[i] = buffer[(4-i)-1];
-//		buffer[(4-i)-1] = t;
-//	}
 
-	// seek to the beginning of the directory listing.
-	fp->seek(0x10, File::START);
-	// read in each directory listing.
-	ArchivedFileInfo *fileInfo = NEW ArchivedFileInfo;
+	// read in each directory listing, which starts after the header.
+	archiveFile->reserveFiles(numLittleFiles);
+	ArchivedFileInfo fileInfo;
+	Int pos = 0x10;
 
+	bool complete = TRUE;
 	for (Int i = 0; i < numLittleFiles; ++i) {
 		Int filesize = 0;
 		Int fileOffset = 0;
-		fp->read(&fileOffset, 4);
-		fp->read(&filesize, 4);
-
-		filesize = ntohl(filesize);
-		fileOffset = ntohl(fileOffset);
-
-		fileInfo->m_archiveFilename = archiveFileName;
-		fileInfo->m_offset = fileOffset;
-		fileInfo->m_size = filesize;
-		
-		// read in the path name of the file.
-		Int pathIndex = -1;
-		do {
-			++pathIndex;
-			fp->read(buffer + pathIndex, 1);
-		} while (buffer[pathIndex] != 0);
-
-		Int filenameIndex = pathIndex;
-		while ((filenameIndex >= 0) && (buffer[filenameIndex] != '\\') && (buffer[filenameIndex] != '/')) {
-			--filenameIndex;
+		const char *path = header + pos + 8;
+		const char *pathEnd = (pos + 8 < headerSize) ? (const char *)memchr(path, 0, headerSize - pos - 8) : NULL;
+		if (pathEnd == NULL) {
+			DEBUG_CRASH(("BIG file %s ends in the middle of its directory listing, at file number %d", filename, i));
+			complete = FALSE;
+			break;
 		}
 
-		fileInfo->m_filename = (char *)(buffer + filenameIndex + 1);
-		fileInfo->m_filename.toLower();
-		buffer[filenameIndex + 1] = 0;
+		memcpy(&fileOffset, header + pos, 4);
+		memcpy(&filesize, header + pos + 4, 4);
 
-		AsciiString path;
-		path = buffer;
+		fileInfo.m_offset = ntohl(fileOffset);
+		fileInfo.m_size = ntohl(filesize);
 
-		AsciiString debugpath;
-		debugpath = path;
-		debugpath.concat(fileInfo->m_filename);
-//		DEBUG_LOG(("Win32BIGFileSystem::openArchiveFile - adding file %s to archive file %s, file number %d\n", debugpath.str(), fileInfo->m_archiveFilename.str(), i));
+//		DEBUG_LOG(("Win32BIGFileSystem::openArchiveFile - adding file %s to archive file %s, file number %d\n", path, filename, i));
+		archiveFile->addFile(path, &fileInfo);
 
-		archiveFile->addFile(path, fileInfo);
+		pos = pathEnd + 1 - header;
 	}
 
-	archiveFile->attachFile(fp);
+	delete [] headerBuffer;
+	headerBuffer = NULL;
 
-	delete fileInfo;
-	fileInfo = NULL;
+	if (TheArchiveIndexCache != NULL && complete) {
+		TheArchiveIndexCache->add(AsciiString(filename), start, archiveFile);
+	}
+
+	archiveFile->attachFile(fp);
 
 	// leave fp open as the archive file will be using it.
 
@@ -187,6 +198,7 @@ void Win32BIGFileSystem::closeArchiveFile(const Char *filename) {
 	DEBUG_ASSERTCRASH(stricmp(filename, MUSIC_BIG) == 0, ("Attempting to close Archive file '%s', need to add code to handle its shutdown correctly.", filename));
 
 	// may need to do some other processing here first.
+	removeFromDirectoryTree(it->second);
 	
 	delete (it->second);
 	m_archiveFileMap.erase(it);
@@ -619,6 +619,9 @@ void LoaderThreadClass::Thread_Function()
 
 		Switch_Thread();
 	}
+
+	// hand back the pool blocks this thread has cached
+	flushW3DMemPoolThreadCache();
 }
 
 // ----------------------------------------------------------------------------
@@ -458,7 +458,7 @@ static CriticalSection critSec1, critSec2, critSec3, critSec4, critSec5;
 Int APIENTRY WinMain( HINSTANCE hInstance, HINSTANCE hPrevInstance,
                       LPSTR lpCmdLine, Int nCmdShow )
 {
-
+	Int exitCode = 0;
 
 	try {
 
@@ -498,6 +498,7 @@ Int APIENTRY WinMain( HINSTANCE hInstance, HINSTANCE hPrevInstance,
 		*/
 		int argc = 1;
 		char * argv[20];
+		bool runHeadless = false;
 		argv[0] = NULL;
 
 		char *token;
@@ -507,6 +508,13 @@ Int APIENTRY WinMain( HINSTANCE hInstance, HINSTANCE hPrevInstance,
 			//added a preparse step for this flag because it affects window creation style
 			if (stricmp(token,"-win")==0)
 				ApplicationIsWindowed=true;
+			// the headless window is never shown; nothing is drawn to it
+			if (stricmp(token,"-headless")==0)
+			{
+				runHeadless=true;
+				ApplicationIsWindowed=true;
+				nCmdShow=SW_HIDE;
+			}
 			token = nextParam(NULL, "\" ");	   
 		}
 
@@ -573,7 +581,8 @@ Int APIENTRY WinMain( HINSTANCE hInstance, HINSTANCE hPrevInstance,
 
 		// TheSuperHackers @refactor The instance mutex now lives in its own class.
 
-		if (!rts::ClientInstance::initialize())
+		// headless replay simulations run side by side, so they don't hold to the single instance
+		if (!rts::ClientInstance::initialize() && !runHeadless)
 		{
 			HWND ccwindow = FindWindow(rts::ClientInstance::getFirstInstanceName(), NULL);
 			if (ccwindow)
@@ -594,7 +603,7 @@ Int APIENTRY WinMain( HINSTANCE hInstance, HINSTANCE hPrevInstance,
 		DEBUG_LOG(("CRC message is %d\n", GameMessage::MSG_LOGIC_CRC));
 
 		// run the game main loop
-		GameMain(argc, argv);
+		exitCode = GameMain(argc, argv);
 
 
 
@@ -604,6 +613,7 @@ Int APIENTRY WinMain( HINSTANCE hInstance, HINSTANCE hPrevInstance,
 	#if defined(RTS_DEBUG) || defined(RTS_INTERNAL)
 		TheMemoryPoolFactory->memoryPoolUsageReport("AAAMemStats");
 	#endif
+		writeMemoryPoolProfile();
 
 		// close the log
 		shutdownMemoryManager();
@@ -622,7 +632,7 @@ Int APIENTRY WinMain( HINSTANCE hInstance, HINSTANCE hPrevInstance,
 	TheDmaCriticalSection = NULL;
 	TheMemoryPoolCriticalSection = NULL;
 
-	return 0;
+	return exitCode;
 
 }  // end WinMain
 